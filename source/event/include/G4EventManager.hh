@@ -96,6 +96,8 @@ class G4EventManager
   private:
       void DoProcessing(G4Event* anEvent);
       void StackTracks(G4TrackVector *trackVector, G4bool IDhasAlreadySet=false);
+      G4Track* PopNextTrack(G4VTrajectory** previousTrajectory);
+      void ClearDeferredTracks();
   
       G4Event* currentEvent;
 
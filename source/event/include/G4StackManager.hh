@@ -99,6 +99,22 @@ class G4StackManager
       // If the destination is fKill, tracks are deleted.
       // If the origin is fKill, nothing happen.
 
+      void SetMaxNTrackInMemory(G4int n);
+      //  Set the maximum number of G4Track objects kept in each stack
+      // (urgent, waiting and postponed stacks). Beyond this number the
+      // tracks of lower priority are converted to compact records, see
+      // G4TrackSpillBuffer. Zero (default) means no limit.
+
+      void SetSpillToFile(G4bool val);
+      //  If true, spilled tracks are written to a temporary file instead
+      // of being kept in memory.
+
+      void SetUrgentStackOrder(G4TrackStackOrder val);
+      //  Set the order in which tracks are popped from the urgent stack:
+      // LIFO (default), highest or lowest kinetic energy first, or
+      // grouped by particle type and region (or logical volume) for
+      // cache locality. Not available if G4_USESMARTSTACK is defined.
+
       void TransferOneStackedTrack(G4ClassificationOfNewTrack origin, G4ClassificationOfNewTrack destination);
       //  Transfter one stacked track from the origin stack to the destination stack.
       // The transfered track is the one which came last to the origin stack.
@@ -119,6 +135,8 @@ class G4StackManager
       G4StackingMessenger* theMessenger;
       std::vector<G4TrackStack*> additionalWaitingStacks;
       G4int numberOfAdditionalWaitingStacks;
+      G4int maxNTrackInMemory;
+      G4bool spillToFile;
 
   public:
       void clear();
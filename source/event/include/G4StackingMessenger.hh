@@ -35,6 +35,8 @@ class G4StackManager;
 class G4UIdirectory;
 class G4UIcmdWithoutParameter;
 class G4UIcmdWithAnInteger;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
 
 // class description:
 //
@@ -44,6 +46,9 @@ class G4UIcmdWithAnInteger;
 //   /event/stack/status
 //   /event/stack/clear
 //   /event/stack/verbose
+//   /event/stack/setMaxTracksInMemory
+//   /event/stack/spillToFile
+//   /event/stack/setUrgentOrder
 
 class G4StackingMessenger: public G4UImessenger
 {
@@ -57,6 +62,9 @@ class G4StackingMessenger: public G4UImessenger
     G4UIcmdWithoutParameter* statusCmd;
     G4UIcmdWithAnInteger* clearCmd;
     G4UIcmdWithAnInteger* verboseCmd;
+    G4UIcmdWithAnInteger* maxTrackCmd;
+    G4UIcmdWithABool* spillToFileCmd;
+    G4UIcmdWithAString* urgentOrderCmd;
 };
 
 #endif
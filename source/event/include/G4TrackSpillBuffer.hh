@@ -0,0 +1,166 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//  Created : 19/Oct/2018
+//
+
+#ifndef G4TrackSpillBuffer_h
+#define G4TrackSpillBuffer_h 1
+
+#include "G4StackedTrack.hh"
+#include "G4TouchableHandle.hh"
+#include "G4Types.hh"
+#include <vector>
+#include <cstdio>
+
+class G4ParticleDefinition;
+class G4PrimaryParticle;
+class G4VProcess;
+class G4LogicalVolume;
+class G4VUserTrackInformation;
+
+// class description:
+//
+// This class is used by G4TrackStack to keep tracks out of the
+// G4Track/G4DynamicParticle allocators when the number of tracks in
+// a stack exceeds the ceiling given by G4StackManager. Each spilled
+// track is converted to a flat record (G4SpilledTrack), and the G4Track
+// is deleted. Records are grouped in chunks, one per spill, kept either
+// in memory or in a temporary file. Reference counted touchables, the
+// trajectory and the user information are kept in memory next to the
+// records. Tracks are restored chunk by chunk, in the order they were
+// spilled (newest chunk first for popping, oldest first for transfers),
+// as new G4Track objects with identical state.
+//
+// Only fresh tracks can be spilled: tracks which have been suspended
+// (current step number > 0), and tracks with an electron occupancy,
+// pre-assigned decay products or auxiliary track information, stay
+// in the G4TrackStack.
+
+struct G4SpilledTrack
+{
+  const G4ParticleDefinition* definition;
+  G4PrimaryParticle* primary;
+  const G4VProcess* creatorProcess;
+  const G4LogicalVolume* vertexVolume;
+  G4double position[3];
+  G4double direction[3];
+  G4double polarization[3];
+  G4double vertexPosition[3];
+  G4double vertexDirection[3];
+  G4double kineticEnergy;
+  G4double mass;
+  G4double charge;
+  G4double spin;
+  G4double magneticMoment;
+  G4double properTime;
+  G4double decayTime;
+  G4double globalTime;
+  G4double localTime;
+  G4double velocity;
+  G4double weight;
+  G4double vertexKineticEnergy;
+  G4int trackID;
+  G4int parentID;
+  G4int pdgCode;
+  G4int creatorModelIndex;
+  G4int status;
+  G4bool belowThreshold;
+  G4bool goodForTracking;
+  G4bool useGivenVelocity;
+};
+
+class G4TrackSpillBuffer
+{
+public:
+  G4TrackSpillBuffer();
+  ~G4TrackSpillBuffer();
+
+private:
+  G4TrackSpillBuffer(const G4TrackSpillBuffer&);
+  const G4TrackSpillBuffer& operator=(const G4TrackSpillBuffer&);
+
+public:
+  static G4bool IsSpillable(const G4StackedTrack& aStackedTrack);
+  // Returns true if the track can be converted to a record.
+
+  void Spill(const std::vector<G4StackedTrack>& tracks);
+  // Stores the given tracks as one chunk and deletes the G4Track
+  // objects. All tracks must be spillable.
+
+  G4bool Restore(std::vector<G4StackedTrack>& tracks, G4bool newest = true);
+  // Appends the tracks of the newest (or oldest) chunk to the vector,
+  // in the order they were given to Spill(). Returns false if empty.
+
+  void clearAndDestroy();
+
+  void Swap(G4TrackSpillBuffer& right);
+  // Exchanges the spilled tracks (chunks and temporary file) of the two
+  // buffers; the UseFile() setting stays with each buffer.
+
+  void SetUseFile(G4bool val);
+  // If true, records are written to a temporary file instead of
+  // being kept in memory. Applies to chunks spilled after the call.
+
+  G4int GetNTrack() const { return nTrack; }
+  G4int GetNChunk() const { return chunks.size(); }
+  G4double GetTotalEnergy() const { return totalEnergy; }
+  G4bool UseFile() const { return useFile; }
+
+private:
+  struct Handles
+  {
+    G4TouchableHandle touchable;
+    G4TouchableHandle nextTouchable;
+    G4TouchableHandle originTouchable;
+    G4VTrajectory* trajectory;
+    G4VUserTrackInformation* userInformation;
+  };
+
+  struct Chunk
+  {
+    std::vector<G4SpilledTrack> records;  // empty if in the file
+    std::vector<Handles> handles;
+    long fileOffset;
+    std::size_t nRecord;
+    G4double energy;
+  };
+
+  static void Fill(G4SpilledTrack& record, const G4Track* aTrack);
+  static G4Track* Create(const G4SpilledTrack& record, const Handles& handles);
+
+  void ReadRecords(const Chunk& chunk, std::vector<G4SpilledTrack>& records);
+  void CloseFile();
+
+  std::vector<Chunk*> chunks;
+  G4int nTrack;
+  G4double totalEnergy;
+  G4bool useFile;
+  std::FILE* file;
+  long fileEnd;
+};
+
+#endif
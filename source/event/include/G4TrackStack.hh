@@ -28,6 +28,8 @@
 //
 //
 //  Last Modification : 09/Dec/96 M.Asai
+//                      19/Oct/18 energy ordered mode and spill buffer,
+//                                locality (bucket) modes
 //
 
 
@@ -35,22 +37,59 @@
 #define G4TrackStack_h 1
 
 #include "G4StackedTrack.hh"
+#include "G4TrackSpillBuffer.hh"
 #include "G4Types.hh"
 #include <vector>
 
 class G4SmartTrackStack;
+class G4Track;
+struct G4TrackStackBuckets;
+
+enum G4TrackStackOrder
+{
+  fLastInFirstOut = 0,   // default
+  fHighEnergyFirst,      // highest kinetic energy popped first
+  fLowEnergyFirst,       // lowest kinetic energy popped first
+  fGroupByRegion,        // buckets of (particle type, region)
+  fGroupByVolume         // buckets of (particle type, logical volume)
+};
 
 // class description:
 //
 // This is a stack class used by G4StackManager. This class object
 // stores G4StackedTrack class objects in the form of bi-directional
 // linked list.
+//
+// By default tracks are popped in LIFO order. With SetOrder() the
+// stack becomes a priority queue (binary heap) on the kinetic energy;
+// ties are broken by the track ID, the newest track first.
+// With SetMaxNTrackInMemory() the number of G4Track objects held by the
+// stack is bounded: when it is exceeded, the half of the tracks with
+// the lowest priority (the bottom of a LIFO stack) is moved to a
+// G4TrackSpillBuffer, and restored when the stack runs empty.
+//
+// In the locality modes (fGroupByRegion, fGroupByVolume) tracks are
+// sorted into LIFO buckets keyed by the particle type and by the region
+// or logical volume of the track, and one bucket is emptied before the
+// next one is started, so that consecutive tracks share navigation
+// voxels, material and physics tables. The next bucket is the one which
+// received a track most recently, which keeps the order reproducible.
+// Only the order of tracking changes, not the content of the event.
+// The ceiling of SetMaxNTrackInMemory() applies to the total over all
+// buckets; when it is exceeded, the buckets which wait longest are
+// spilled first.
 
 class G4TrackStack : public std::vector<G4StackedTrack>
 {
 public:
-	G4TrackStack() : safetyValve1(0), safetyValve2(0), nstick(0) {}
-  G4TrackStack(size_t n) : safetyValve1(4*n/5), safetyValve2(4*n/5-100), nstick(100) { reserve(n);}
+	G4TrackStack() : safetyValve1(0), safetyValve2(0), nstick(0),
+    order(fLastInFirstOut), maxNTrackInMemory(0), spillThreshold(0),
+    spillBuffer(0), spillToFile(false), buckets(0), nBucketTrack(0),
+    nBucketInMemory(0) {}
+  G4TrackStack(size_t n) : safetyValve1(4*n/5), safetyValve2(4*n/5-100), nstick(100),
+    order(fLastInFirstOut), maxNTrackInMemory(0), spillThreshold(0),
+    spillBuffer(0), spillToFile(false), buckets(0), nBucketTrack(0),
+    nBucketInMemory(0) { reserve(n);}
   ~G4TrackStack();
   
 private:
@@ -59,19 +98,51 @@ private:
 	G4int operator!=(const G4TrackStack &right) const;
   
 public:
-	void PushToStack(const G4StackedTrack& aStackedTrack) { push_back(aStackedTrack); }
-	G4StackedTrack PopFromStack() { G4StackedTrack st = back(); pop_back(); return st; }
+	inline void PushToStack(const G4StackedTrack& aStackedTrack);
+	inline G4StackedTrack PopFromStack();
 	void TransferTo(G4TrackStack* aStack);
 	void TransferTo(G4SmartTrackStack* aStack);
   
         void clearAndDestroy();
+
+  void SetOrder(G4TrackStackOrder val);
+  G4TrackStackOrder GetOrder() const { return order; }
+
+  void SetMaxNTrackInMemory(G4int n, G4bool useFile = false);
+  // n = 0 means no limit; useFile selects a temporary file instead of
+  // memory for the spilled tracks.
+  G4int GetMaxNTrackInMemory() const { return maxNTrackInMemory; }
+
+private:
+  G4bool HigherPriority(const G4StackedTrack& a, const G4StackedTrack& b) const;
+  void PushHeap();
+  void PopHeap();
+  void Spill();
+  void Restore();
+  void PushToBucket(const G4StackedTrack& aStackedTrack);
+  G4StackedTrack PopFromBucket();
+  void SpillBuckets();
+  const void* LocalityKey(const G4Track* aTrack) const;
+
 private:
 	G4int safetyValve1;
   G4int safetyValve2;
 	G4int nstick;
+  G4TrackStackOrder order;
+  G4int maxNTrackInMemory;
+  G4int spillThreshold;
+  G4TrackSpillBuffer* spillBuffer;
+  G4bool spillToFile;
+  G4TrackStackBuckets* buckets;
+  G4int nBucketTrack;
+  G4int nBucketInMemory;
   
 public:
-	G4int GetNTrack() const { return size(); }
+	G4int GetNTrack() const
+  { return size() + nBucketTrack + (spillBuffer ? spillBuffer->GetNTrack() : 0); }
+  G4int GetNSpilledTrack() const
+  { return (spillBuffer ? spillBuffer->GetNTrack() : 0)
+      + nBucketTrack - nBucketInMemory; }
 	G4int GetMaxNTrack() const { return max_size(); }
   inline G4int GetSafetyValve1() const { return safetyValve1; }
 	inline G4int GetSafetyValve2() const { return safetyValve2; }
@@ -82,4 +153,22 @@ public:
   
 };
 
+inline void G4TrackStack::PushToStack(const G4StackedTrack& aStackedTrack)
+{
+  if(buckets) { PushToBucket(aStackedTrack); return; }
+  push_back(aStackedTrack);
+  if(order != fLastInFirstOut) PushHeap();
+  if(spillThreshold > 0 && G4int(size()) > spillThreshold) Spill();
+}
+
+inline G4StackedTrack G4TrackStack::PopFromStack()
+{
+  if(buckets) return PopFromBucket();
+  if(empty() && spillBuffer) Restore();
+  if(order != fLastInFirstOut) PopHeap();
+  G4StackedTrack st = back();
+  pop_back();
+  return st;
+}
+
 #endif
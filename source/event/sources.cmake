@@ -76,6 +76,7 @@ GEANT4_DEFINE_MODULE(NAME G4event
         G4StackManager.hh
         G4StackedTrack.hh
         G4StackingMessenger.hh
+        G4TrackSpillBuffer.hh
         G4TrackStack.hh
         G4TrajectoryContainer.hh
         G4UserEventAction.hh
@@ -112,6 +113,7 @@ GEANT4_DEFINE_MODULE(NAME G4event
         G4StackChecker.cc
         G4StackManager.cc
         G4StackingMessenger.cc
+        G4TrackSpillBuffer.cc
         G4TrackStack.cc
         G4TrajectoryContainer.cc
         G4UserEventAction.cc
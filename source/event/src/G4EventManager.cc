@@ -40,6 +40,7 @@
 #include "G4ApplicationState.hh"
 #include "G4TransportationManager.hh"
 #include "G4Navigator.hh"
+#include "G4VDeferredTrackGenerator.hh"
 #include "Randomize.hh"
 
 G4ThreadLocal G4EventManager* G4EventManager::fpEventManager = nullptr;
@@ -137,6 +138,7 @@ void G4EventManager::DoProcessing(G4Event* anEvent)
 #endif
 
   trackContainer->PrepareNewEvent();
+  ClearDeferredTracks();
 
 #ifdef G4_STORE_TRAJECTORY
   trajectoryContainer = nullptr;
@@ -169,7 +171,7 @@ void G4EventManager::DoProcessing(G4Event* anEvent)
 #endif
   
   G4VTrajectory* previousTrajectory;
-  while( ( track = trackContainer->PopNextTrack(&previousTrajectory) ) != 0 ) // Loop checking 12.28.2015 M.Asai
+  while( ( track = PopNextTrack(&previousTrajectory) ) != 0 ) // Loop checking 12.28.2015 M.Asai
   {
 
 #ifdef G4VERBOSE
@@ -308,6 +310,39 @@ void G4EventManager::StackTracks(G4TrackVector *trackVector,G4bool IDhasAlreadyS
   }
 }
 
+G4Track* G4EventManager::PopNextTrack(G4VTrajectory** previousTrajectory)
+{
+  // Tracks kept as records by deferred generators (e.g. optical photons)
+  // are created chunk by chunk only when the urgent and waiting stacks
+  // are exhausted, so they come after all stages of the event and the
+  // stacks hold at most one chunk. The next chunk is generated only if
+  // the stacking action killed or postponed all tracks of the previous one
+  const std::vector<G4VDeferredTrackGenerator*>& generators
+    = G4VDeferredTrackGenerator::GetGenerators();
+  if( !generators.empty() )
+  {
+    G4TrackVector deferredTracks;
+    for( auto generator : generators )
+    {
+      // Loop checking: each call consumes records of the generator
+      while( trackContainer->GetNTotalTrack()
+             - trackContainer->GetNPostponedTrack() == 0
+             && generator->HasTracks() )
+      {
+        generator->GenerateTracks(deferredTracks);
+        StackTracks(&deferredTracks);
+      }
+    }
+  }
+  return trackContainer->PopNextTrack(previousTrajectory);
+}
+
+void G4EventManager::ClearDeferredTracks()
+{
+  for( auto generator : G4VDeferredTrackGenerator::GetGenerators() )
+  { generator->Clear(); }
+}
+
 void G4EventManager::SetUserAction(G4UserEventAction* userAction)
 {
   userEventAction = userAction;
@@ -391,6 +426,7 @@ void G4EventManager::AbortCurrentEvent()
 {
   abortRequested = true;
   trackContainer->clear();
+  ClearDeferredTracks();
   if(tracking) trackManager->EventAborted();
 }
 
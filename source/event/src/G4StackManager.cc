@@ -28,6 +28,7 @@
 //
 //
 //  Last Modification : 09/Dec/96 M.Asai
+//                      19/Oct/18 track ceiling and urgent stack order
 //
 
 #include "G4StackManager.hh"
@@ -37,7 +38,8 @@
 #include "G4ios.hh"
 
 G4StackManager::G4StackManager()
-:userStackingAction(0),verboseLevel(0),numberOfAdditionalWaitingStacks(0)
+:userStackingAction(0),verboseLevel(0),numberOfAdditionalWaitingStacks(0),
+ maxNTrackInMemory(0),spillToFile(false)
 {
   theMessenger = new G4StackingMessenger(this);
 #ifdef G4_USESMARTSTACK
@@ -223,6 +225,9 @@ void G4StackManager::ReClassify()
   if( !userStackingAction ) return;
   if( GetNUrgentTrack() == 0 ) return;
   
+  // the urgent stack is taken over without restoring spilled tracks,
+  // which are read back chunk by chunk while re-classifying
+  tmpStack.SetMaxNTrackInMemory(maxNTrackInMemory,spillToFile);
   urgentStack->TransferTo(&tmpStack);
   while( tmpStack.GetNTrack() > 0 )
   {
@@ -280,6 +285,7 @@ G4int G4StackManager::PrepareNewEvent()
     G4StackedTrack aStackedTrack;
     G4TrackStack   tmpStack;
     
+    tmpStack.SetMaxNTrackInMemory(maxNTrackInMemory,spillToFile);
     postponeStack->TransferTo(&tmpStack);
     
     while( tmpStack.GetNTrack() > 0 )
@@ -338,6 +344,7 @@ void G4StackManager::SetNumberOfAdditionalWaitingStacks(G4int iAdd)
     for(int i=numberOfAdditionalWaitingStacks;i<iAdd;i++)
     {
       G4TrackStack* newStack = new G4TrackStack;
+      newStack->SetMaxNTrackInMemory(maxNTrackInMemory,spillToFile);
       additionalWaitingStacks.push_back(newStack);
     }
     numberOfAdditionalWaitingStacks = iAdd;
@@ -351,6 +358,37 @@ void G4StackManager::SetNumberOfAdditionalWaitingStacks(G4int iAdd)
   }
 }
 
+void G4StackManager::SetMaxNTrackInMemory(G4int n)
+{
+  maxNTrackInMemory = n;
+#ifndef G4_USESMARTSTACK
+  urgentStack->SetMaxNTrackInMemory(maxNTrackInMemory,spillToFile);
+#endif
+  waitingStack->SetMaxNTrackInMemory(maxNTrackInMemory,spillToFile);
+  postponeStack->SetMaxNTrackInMemory(maxNTrackInMemory,spillToFile);
+  for(int i=0;i<numberOfAdditionalWaitingStacks;i++) {
+    additionalWaitingStacks[i]->SetMaxNTrackInMemory(maxNTrackInMemory,spillToFile);
+  }
+}
+
+void G4StackManager::SetSpillToFile(G4bool val)
+{
+  spillToFile = val;
+  SetMaxNTrackInMemory(maxNTrackInMemory);
+}
+
+void G4StackManager::SetUrgentStackOrder(G4TrackStackOrder val)
+{
+#ifdef G4_USESMARTSTACK
+  if(val!=fLastInFirstOut) {
+    G4Exception("G4StackManager::SetUrgentStackOrder","Event0054",
+                JustWarning,"The urgent stack order cannot be changed for G4SmartTrackStack.");
+  }
+#else
+  urgentStack->SetOrder(val);
+#endif
+}
+
 void G4StackManager::TransferStackedTracks(G4ClassificationOfNewTrack origin, G4ClassificationOfNewTrack destination)
 {
   if(origin==destination) return;
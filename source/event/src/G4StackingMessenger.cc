@@ -33,6 +33,8 @@
 #include "G4UIdirectory.hh"
 #include "G4UIcmdWithoutParameter.hh"
 #include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
 #include "G4ios.hh"
 
 G4StackingMessenger::G4StackingMessenger(G4StackManager * fCont)
@@ -63,6 +65,34 @@ G4StackingMessenger::G4StackingMessenger(G4StackManager * fCont)
   verboseCmd->SetGuidance(" 2 : Detailed reports");
   verboseCmd->SetGuidance("Note - this value is overwritten by /event/verbose command.");
 
+  maxTrackCmd = new G4UIcmdWithAnInteger("/event/stack/setMaxTracksInMemory",this);
+  maxTrackCmd->SetGuidance("Set the maximum number of tracks kept in memory by each stack.");
+  maxTrackCmd->SetGuidance("Beyond it, the tracks of lower priority are stored as compact");
+  maxTrackCmd->SetGuidance("records and restored when the stack runs empty.");
+  maxTrackCmd->SetGuidance(" 0 : no limit (default)");
+  maxTrackCmd->SetParameterName("nTrack",false);
+  maxTrackCmd->SetRange("nTrack>=0");
+  maxTrackCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  spillToFileCmd = new G4UIcmdWithABool("/event/stack/spillToFile",this);
+  spillToFileCmd->SetGuidance("Write the tracks exceeding /event/stack/setMaxTracksInMemory");
+  spillToFileCmd->SetGuidance("to a temporary file instead of keeping them in memory.");
+  spillToFileCmd->SetParameterName("flag",true);
+  spillToFileCmd->SetDefaultValue(true);
+  spillToFileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  urgentOrderCmd = new G4UIcmdWithAString("/event/stack/setUrgentOrder",this);
+  urgentOrderCmd->SetGuidance("Set the order in which tracks are taken from the urgent stack.");
+  urgentOrderCmd->SetGuidance(" LIFO       : last in first out (default)");
+  urgentOrderCmd->SetGuidance(" highEnergy : highest kinetic energy first");
+  urgentOrderCmd->SetGuidance(" lowEnergy  : lowest kinetic energy first");
+  urgentOrderCmd->SetGuidance(" byRegion   : tracks grouped by particle type and region,");
+  urgentOrderCmd->SetGuidance("              one group after the other");
+  urgentOrderCmd->SetGuidance(" byVolume   : tracks grouped by particle type and logical volume");
+  urgentOrderCmd->SetParameterName("order",false);
+  urgentOrderCmd->SetCandidates("LIFO highEnergy lowEnergy byRegion byVolume");
+  urgentOrderCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
 }
 
 G4StackingMessenger::~G4StackingMessenger()
@@ -70,6 +100,9 @@ G4StackingMessenger::~G4StackingMessenger()
   delete statusCmd;
   delete clearCmd;
   delete verboseCmd;
+  delete maxTrackCmd;
+  delete spillToFileCmd;
+  delete urgentOrderCmd;
   delete stackDir;
 }
 
@@ -109,5 +142,26 @@ void G4StackingMessenger::SetNewValue(G4UIcommand * command,G4String newValues)
   {
     fContainer->SetVerboseLevel(verboseCmd->GetNewIntValue(newValues));
   }
+  else if( command==maxTrackCmd )
+  {
+    fContainer->SetMaxNTrackInMemory(maxTrackCmd->GetNewIntValue(newValues));
+  }
+  else if( command==spillToFileCmd )
+  {
+    fContainer->SetSpillToFile(spillToFileCmd->GetNewBoolValue(newValues));
+  }
+  else if( command==urgentOrderCmd )
+  {
+    if(newValues=="highEnergy")
+    { fContainer->SetUrgentStackOrder(fHighEnergyFirst); }
+    else if(newValues=="lowEnergy")
+    { fContainer->SetUrgentStackOrder(fLowEnergyFirst); }
+    else if(newValues=="byRegion")
+    { fContainer->SetUrgentStackOrder(fGroupByRegion); }
+    else if(newValues=="byVolume")
+    { fContainer->SetUrgentStackOrder(fGroupByVolume); }
+    else
+    { fContainer->SetUrgentStackOrder(fLastInFirstOut); }
+  }
 }
 
@@ -0,0 +1,276 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//  Created : 19/Oct/2018
+//
+
+#include "G4TrackSpillBuffer.hh"
+#include "G4Track.hh"
+#include "G4DynamicParticle.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4VTrajectory.hh"
+#include "G4VUserTrackInformation.hh"
+#include "G4ios.hh"
+
+#include <utility>
+
+G4TrackSpillBuffer::G4TrackSpillBuffer()
+: nTrack(0), totalEnergy(0.), useFile(false), file(0), fileEnd(0)
+{}
+
+G4TrackSpillBuffer::~G4TrackSpillBuffer()
+{
+  clearAndDestroy();
+}
+
+G4bool G4TrackSpillBuffer::IsSpillable(const G4StackedTrack& aStackedTrack)
+{
+  const G4Track* aTrack = aStackedTrack.GetTrack();
+  if(aTrack->GetCurrentStepNumber() != 0) return false;
+  if(aTrack->GetAuxiliaryTrackInformationMap() != 0) return false;
+  const G4DynamicParticle* dp = aTrack->GetDynamicParticle();
+  if(dp->GetElectronOccupancy() != 0) return false;
+  if(dp->GetPreAssignedDecayProducts() != 0) return false;
+  return true;
+}
+
+void G4TrackSpillBuffer::Fill(G4SpilledTrack& record, const G4Track* aTrack)
+{
+  const G4DynamicParticle* dp = aTrack->GetDynamicParticle();
+  record.definition = dp->GetDefinition();
+  record.primary = dp->GetPrimaryParticle();
+  record.creatorProcess = aTrack->GetCreatorProcess();
+  record.vertexVolume = aTrack->GetLogicalVolumeAtVertex();
+  const G4ThreeVector& pos = aTrack->GetPosition();
+  const G4ThreeVector& dir = dp->GetMomentumDirection();
+  const G4ThreeVector& pol = dp->GetPolarization();
+  const G4ThreeVector& vpos = aTrack->GetVertexPosition();
+  const G4ThreeVector& vdir = aTrack->GetVertexMomentumDirection();
+  for(G4int i = 0; i < 3; i++) {
+    record.position[i] = pos[i];
+    record.direction[i] = dir[i];
+    record.polarization[i] = pol[i];
+    record.vertexPosition[i] = vpos[i];
+    record.vertexDirection[i] = vdir[i];
+  }
+  record.kineticEnergy = dp->GetKineticEnergy();
+  record.mass = dp->GetMass();
+  record.charge = dp->GetCharge();
+  record.spin = dp->GetSpin();
+  record.magneticMoment = dp->GetMagneticMoment();
+  record.properTime = dp->GetProperTime();
+  record.decayTime = dp->GetPreAssignedDecayProperTime();
+  record.globalTime = aTrack->GetGlobalTime();
+  record.localTime = aTrack->GetLocalTime();
+  record.velocity = aTrack->GetVelocity();
+  record.weight = aTrack->GetWeight();
+  record.vertexKineticEnergy = aTrack->GetVertexKineticEnergy();
+  record.trackID = aTrack->GetTrackID();
+  record.parentID = aTrack->GetParentID();
+  record.pdgCode = dp->GetPDGcode();
+  record.creatorModelIndex = aTrack->GetCreatorModelID();
+  record.status = aTrack->GetTrackStatus();
+  record.belowThreshold = aTrack->IsBelowThreshold();
+  record.goodForTracking = aTrack->IsGoodForTracking();
+  record.useGivenVelocity = aTrack->UseGivenVelocity();
+}
+
+G4Track* G4TrackSpillBuffer::Create(const G4SpilledTrack& record,
+                                    const Handles& handles)
+{
+  G4ThreeVector dir(record.direction[0],record.direction[1],
+                    record.direction[2]);
+  G4DynamicParticle* dp =
+    new G4DynamicParticle(record.definition,dir,record.kineticEnergy);
+  dp->SetMass(record.mass);
+  dp->SetCharge(record.charge);
+  dp->SetSpin(record.spin);
+  dp->SetMagneticMoment(record.magneticMoment);
+  dp->SetPolarization(record.polarization[0],record.polarization[1],
+                      record.polarization[2]);
+  dp->SetProperTime(record.properTime);
+  dp->SetPreAssignedDecayProperTime(record.decayTime);
+  dp->SetPrimaryParticle(record.primary);
+  if(record.definition->GetPDGEncoding() == 0)
+  { dp->SetPDGcode(record.pdgCode); }
+
+  G4ThreeVector pos(record.position[0],record.position[1],
+                    record.position[2]);
+  G4Track* aTrack = new G4Track(dp,record.globalTime,pos);
+  aTrack->SetLocalTime(record.localTime);
+  aTrack->SetWeight(record.weight);
+  aTrack->SetTrackID(record.trackID);
+  aTrack->SetParentID(record.parentID);
+  aTrack->SetTrackStatus(G4TrackStatus(record.status));
+  aTrack->SetBelowThresholdFlag(record.belowThreshold);
+  aTrack->SetGoodForTrackingFlag(record.goodForTracking);
+  aTrack->SetVelocity(record.velocity);
+  aTrack->UseGivenVelocity(record.useGivenVelocity);
+  aTrack->SetCreatorProcess(record.creatorProcess);
+  aTrack->SetCreatorModelIndex(record.creatorModelIndex);
+  aTrack->SetVertexPosition(G4ThreeVector(record.vertexPosition[0],
+                                          record.vertexPosition[1],
+                                          record.vertexPosition[2]));
+  aTrack->SetVertexMomentumDirection(G4ThreeVector(record.vertexDirection[0],
+                                                   record.vertexDirection[1],
+                                                   record.vertexDirection[2]));
+  aTrack->SetVertexKineticEnergy(record.vertexKineticEnergy);
+  aTrack->SetLogicalVolumeAtVertex(record.vertexVolume);
+  aTrack->SetTouchableHandle(handles.touchable);
+  aTrack->SetNextTouchableHandle(handles.nextTouchable);
+  aTrack->SetOriginTouchableHandle(handles.originTouchable);
+  aTrack->SetUserInformation(handles.userInformation);
+  return aTrack;
+}
+
+void G4TrackSpillBuffer::Spill(const std::vector<G4StackedTrack>& tracks)
+{
+  if(tracks.empty()) return;
+
+  Chunk* chunk = new Chunk;
+  chunk->nRecord = tracks.size();
+  chunk->fileOffset = -1;
+  chunk->energy = 0.;
+  chunk->records.resize(tracks.size());
+  chunk->handles.resize(tracks.size());
+
+  for(std::size_t i = 0; i < tracks.size(); i++) {
+    G4Track* aTrack = tracks[i].GetTrack();
+    Fill(chunk->records[i],aTrack);
+    Handles& h = chunk->handles[i];
+    h.touchable = aTrack->GetTouchableHandle();
+    h.nextTouchable = aTrack->GetNextTouchableHandle();
+    h.originTouchable = aTrack->GetOriginTouchableHandle();
+    h.trajectory = tracks[i].GetTrajectory();
+    h.userInformation = aTrack->GetUserInformation();
+    chunk->energy += aTrack->GetDynamicParticle()->GetTotalEnergy();
+    // the user information now belongs to the record
+    aTrack->SetUserInformation(0);
+    delete aTrack;
+  }
+
+  if(useFile) {
+    if(!file) { file = std::tmpfile(); fileEnd = 0; }
+    if(file && std::fseek(file,fileEnd,SEEK_SET) == 0 &&
+       std::fwrite(&chunk->records[0],sizeof(G4SpilledTrack),
+                   chunk->nRecord,file) == chunk->nRecord) {
+      chunk->fileOffset = fileEnd;
+      fileEnd += long(chunk->nRecord*sizeof(G4SpilledTrack));
+      std::vector<G4SpilledTrack>().swap(chunk->records);
+    } else {
+      G4Exception("G4TrackSpillBuffer::Spill","Event0060",JustWarning,
+                  "Cannot write to the temporary file, tracks are kept in memory.");
+      useFile = false;
+    }
+  }
+
+  chunks.push_back(chunk);
+  nTrack += chunk->nRecord;
+  totalEnergy += chunk->energy;
+}
+
+void G4TrackSpillBuffer::ReadRecords(const Chunk& chunk,
+                                     std::vector<G4SpilledTrack>& records)
+{
+  records.resize(chunk.nRecord);
+  if(!file || std::fseek(file,chunk.fileOffset,SEEK_SET) != 0 ||
+     std::fread(&records[0],sizeof(G4SpilledTrack),chunk.nRecord,file)
+       != chunk.nRecord) {
+    G4Exception("G4TrackSpillBuffer::ReadRecords","Event0061",
+                FatalException,"Cannot read spilled tracks back.");
+  }
+}
+
+G4bool G4TrackSpillBuffer::Restore(std::vector<G4StackedTrack>& tracks,
+                                   G4bool newest)
+{
+  if(chunks.empty()) return false;
+
+  std::vector<Chunk*>::iterator itr = newest ? chunks.end()-1 : chunks.begin();
+  Chunk* chunk = *itr;
+  chunks.erase(itr);
+
+  std::vector<G4SpilledTrack> fromFile;
+  const std::vector<G4SpilledTrack>* records = &chunk->records;
+  if(chunk->fileOffset >= 0) {
+    ReadRecords(*chunk,fromFile);
+    records = &fromFile;
+    // the space of the last chunk of the file can be reused
+    if(chunk->fileOffset + long(chunk->nRecord*sizeof(G4SpilledTrack))
+       == fileEnd) { fileEnd = chunk->fileOffset; }
+  }
+
+  tracks.reserve(tracks.size() + chunk->nRecord);
+  for(std::size_t i = 0; i < chunk->nRecord; i++) {
+    G4Track* aTrack = Create((*records)[i],chunk->handles[i]);
+    tracks.push_back(G4StackedTrack(aTrack,chunk->handles[i].trajectory));
+  }
+
+  nTrack -= chunk->nRecord;
+  totalEnergy -= chunk->energy;
+  delete chunk;
+  if(chunks.empty()) { totalEnergy = 0.; CloseFile(); }
+  return true;
+}
+
+void G4TrackSpillBuffer::clearAndDestroy()
+{
+  for(std::size_t i = 0; i < chunks.size(); i++) {
+    Chunk* chunk = chunks[i];
+    for(std::size_t j = 0; j < chunk->handles.size(); j++) {
+      delete chunk->handles[j].trajectory;
+      delete chunk->handles[j].userInformation;
+    }
+    delete chunk;
+  }
+  chunks.clear();
+  nTrack = 0;
+  totalEnergy = 0.;
+  CloseFile();
+}
+
+void G4TrackSpillBuffer::Swap(G4TrackSpillBuffer& right)
+{
+  chunks.swap(right.chunks);
+  std::swap(nTrack,right.nTrack);
+  std::swap(totalEnergy,right.totalEnergy);
+  std::swap(file,right.file);
+  std::swap(fileEnd,right.fileEnd);
+}
+
+void G4TrackSpillBuffer::SetUseFile(G4bool val)
+{
+  useFile = val;
+}
+
+void G4TrackSpillBuffer::CloseFile()
+{
+  if(file) {
+    std::fclose(file);
+    file = 0;
+  }
+  fileEnd = 0;
+}
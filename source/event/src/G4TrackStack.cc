@@ -31,10 +31,37 @@
 #include "G4SmartTrackStack.hh"
 #include "G4VTrajectory.hh"
 #include "G4Track.hh"
+#include "G4VTouchable.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+// Buckets of the locality modes; nonEmpty holds (lastPush, index) of
+// the buckets with tracks, so the next bucket is its last element
+struct G4TrackStackBuckets
+{
+  typedef std::pair<const G4ParticleDefinition*,const void*> Key;
+  std::map<Key,std::size_t> index;
+  std::vector<G4TrackStack*> stacks;
+  std::vector<G4long> lastPush;
+  std::set<std::pair<G4long,std::size_t> > nonEmpty;
+  G4long nPush;
+  G4TrackStack* current;
+  std::size_t currentIndex;
+
+  G4TrackStackBuckets() : nPush(0), current(0), currentIndex(0) {}
+  ~G4TrackStackBuckets()
+  { for(std::size_t i = 0; i < stacks.size(); i++) delete stacks[i]; }
+};
 
 G4TrackStack::~G4TrackStack()
 {
   clearAndDestroy();
+  delete spillBuffer;
+  delete buckets;
 }
 
 void G4TrackStack::clearAndDestroy()
@@ -44,17 +71,62 @@ void G4TrackStack::clearAndDestroy()
     delete (*i).GetTrajectory();
   }
   clear();
+  if(spillBuffer) spillBuffer->clearAndDestroy();
+  spillThreshold = maxNTrackInMemory;
+  if(buckets) {
+    for(std::size_t i = 0; i < buckets->stacks.size(); i++)
+      buckets->stacks[i]->clearAndDestroy();
+    buckets->nonEmpty.clear();
+    buckets->current = 0;
+    nBucketTrack = 0;
+    nBucketInMemory = 0;
+  }
 }
 
 void G4TrackStack::TransferTo(G4TrackStack* aStack) {
-  for(iterator i = begin(); i != end(); i++) aStack->push_back(*i);
+  // an empty stack of the same order takes over the tracks as they are,
+  // the spilled ones are not restored and spilled again
+  if(!buckets && !aStack->buckets && aStack->order == order &&
+     aStack->GetNTrack() == 0) {
+    std::vector<G4StackedTrack>::swap(*aStack);
+    if(spillBuffer && spillBuffer->GetNTrack() > 0) {
+      if(!aStack->spillBuffer) {
+        aStack->spillBuffer = new G4TrackSpillBuffer;
+        aStack->spillBuffer->SetUseFile(aStack->spillToFile);
+      }
+      aStack->spillBuffer->Swap(*spillBuffer);
+    }
+    spillThreshold = maxNTrackInMemory;
+    aStack->spillThreshold = aStack->maxNTrackInMemory;
+    return;
+  }
+  if(buckets) {
+    for(std::size_t i = 0; i < buckets->stacks.size(); i++) {
+      nBucketTrack -= buckets->stacks[i]->GetNTrack();
+      buckets->stacks[i]->TransferTo(aStack);
+    }
+    buckets->nonEmpty.clear();
+    buckets->current = 0;
+    nBucketInMemory = 0;
+  }
+  // spilled tracks are older (or of lower priority) than those in memory
+  if(spillBuffer) {
+    std::vector<G4StackedTrack> chunk;
+    while(spillBuffer->Restore(chunk,false)) {
+      for(iterator i = chunk.begin(); i != chunk.end(); i++)
+        aStack->PushToStack(*i);
+      chunk.clear();
+    }
+  }
+  for(iterator i = begin(); i != end(); i++) aStack->PushToStack(*i);
   clear();
+  spillThreshold = maxNTrackInMemory;
 }
 
 
 void G4TrackStack::TransferTo(G4SmartTrackStack * aStack)
 {
-  while(size()) { aStack->PushToStack(PopFromStack()); }
+  while(GetNTrack()) { aStack->PushToStack(PopFromStack()); }
 }
 
 
@@ -64,5 +136,199 @@ G4double G4TrackStack::getTotalEnergy(void) const
 	for (const_iterator i = begin(); i != end(); i++) {
 		totalEnergy += (*i).GetTrack()->GetDynamicParticle()->GetTotalEnergy();
 	}
+  if(spillBuffer) totalEnergy += spillBuffer->GetTotalEnergy();
+  if(buckets) {
+    for(std::size_t i = 0; i < buckets->stacks.size(); i++)
+      totalEnergy += buckets->stacks[i]->getTotalEnergy();
+  }
 	return totalEnergy;
 }
+
+void G4TrackStack::SetOrder(G4TrackStackOrder val)
+{
+  if(val == order) return;
+
+  // the stacked tracks are put aside while the layout changes
+  G4TrackStack tmpStack;
+  TransferTo(&tmpStack);
+  delete buckets;
+  buckets = 0;
+
+  order = val;
+  if(order == fGroupByRegion || order == fGroupByVolume)
+  { buckets = new G4TrackStackBuckets; }
+  tmpStack.TransferTo(this);
+}
+
+void G4TrackStack::SetMaxNTrackInMemory(G4int n, G4bool useFile)
+{
+  maxNTrackInMemory = (n > 1) ? n : 0;
+  spillToFile = useFile;
+  spillThreshold = maxNTrackInMemory;
+  if(maxNTrackInMemory > 0 && !spillBuffer) spillBuffer = new G4TrackSpillBuffer;
+  if(spillBuffer) spillBuffer->SetUseFile(useFile);
+  // buckets only keep a spill buffer, the ceiling is applied here
+  if(buckets) {
+    for(std::size_t i = 0; i < buckets->stacks.size(); i++) {
+      G4TrackStack* aStack = buckets->stacks[i];
+      if(maxNTrackInMemory > 0 && !aStack->spillBuffer)
+      { aStack->spillBuffer = new G4TrackSpillBuffer; }
+      if(aStack->spillBuffer) aStack->spillBuffer->SetUseFile(useFile);
+    }
+  }
+}
+
+G4bool G4TrackStack::HigherPriority(const G4StackedTrack& a,
+                                    const G4StackedTrack& b) const
+{
+  // true if a has to be popped before b
+  G4double ea = a.GetTrack()->GetKineticEnergy();
+  G4double eb = b.GetTrack()->GetKineticEnergy();
+  if(ea != eb) return (order == fHighEnergyFirst) ? (ea > eb) : (ea < eb);
+  return a.GetTrack()->GetTrackID() > b.GetTrack()->GetTrackID();
+}
+
+void G4TrackStack::PushHeap()
+{
+  // the top of the heap (front) is moved to the back by PopHeap
+  std::push_heap(begin(), end(),
+    [this](const G4StackedTrack& a, const G4StackedTrack& b)
+    { return HigherPriority(b,a); });
+}
+
+void G4TrackStack::PopHeap()
+{
+  std::pop_heap(begin(), end(),
+    [this](const G4StackedTrack& a, const G4StackedTrack& b)
+    { return HigherPriority(b,a); });
+}
+
+void G4TrackStack::Spill()
+{
+  // Select the lower half in priority, which is the bottom of the
+  // vector for a LIFO stack, and keep tracks which cannot be spilled
+  iterator last = begin() + size()/2;
+  if(order != fLastInFirstOut) {
+    std::sort(begin(), end(),
+      [this](const G4StackedTrack& a, const G4StackedTrack& b)
+      { return HigherPriority(b,a); });
+  }
+  iterator firstSpilled = std::stable_partition(begin(), last,
+    [](const G4StackedTrack& st)
+    { return !G4TrackSpillBuffer::IsSpillable(st); });
+
+  std::vector<G4StackedTrack> chunk(firstSpilled, last);
+  spillBuffer->Spill(chunk);
+  erase(firstSpilled, last);
+
+  if(order != fLastInFirstOut) {
+    std::make_heap(begin(), end(),
+      [this](const G4StackedTrack& a, const G4StackedTrack& b)
+      { return HigherPriority(b,a); });
+  }
+
+  // do not try again for every push if most tracks could not be spilled
+  if(G4int(size()) > maxNTrackInMemory/2)
+  { spillThreshold = size() + maxNTrackInMemory/2; }
+}
+
+const void* G4TrackStack::LocalityKey(const G4Track* aTrack) const
+{
+  // primaries have no touchable yet and share the null key
+  const G4VTouchable* touchable = aTrack->GetTouchable();
+  const G4VPhysicalVolume* pv = touchable ? touchable->GetVolume() : 0;
+  if(!pv) return 0;
+  const G4LogicalVolume* lv = pv->GetLogicalVolume();
+  if(order == fGroupByRegion) return lv->GetRegion();
+  return lv;
+}
+
+void G4TrackStack::PushToBucket(const G4StackedTrack& aStackedTrack)
+{
+  const G4Track* aTrack = aStackedTrack.GetTrack();
+  G4TrackStackBuckets::Key key(aTrack->GetParticleDefinition(),
+                               LocalityKey(aTrack));
+  std::size_t idx;
+  std::map<G4TrackStackBuckets::Key,std::size_t>::const_iterator itr =
+    buckets->index.find(key);
+  if(itr != buckets->index.end()) {
+    idx = itr->second;
+  } else {
+    idx = buckets->stacks.size();
+    buckets->index[key] = idx;
+    G4TrackStack* aStack = new G4TrackStack;
+    if(maxNTrackInMemory > 0) {
+      aStack->spillBuffer = new G4TrackSpillBuffer;
+      aStack->spillBuffer->SetUseFile(spillToFile);
+    }
+    buckets->stacks.push_back(aStack);
+    buckets->lastPush.push_back(0);
+  }
+  G4TrackStack* aStack = buckets->stacks[idx];
+  if(aStack->GetNTrack() > 0)
+  { buckets->nonEmpty.erase(std::make_pair(buckets->lastPush[idx],idx)); }
+  aStack->PushToStack(aStackedTrack);
+  buckets->lastPush[idx] = ++(buckets->nPush);
+  buckets->nonEmpty.insert(std::make_pair(buckets->lastPush[idx],idx));
+  ++nBucketTrack;
+  ++nBucketInMemory;
+  if(spillThreshold > 0 && nBucketInMemory > spillThreshold) SpillBuckets();
+}
+
+G4StackedTrack G4TrackStack::PopFromBucket()
+{
+  G4TrackStack* current = buckets->current;
+  if(!current || current->GetNTrack() == 0) {
+    // the bucket which received a track most recently is next
+    buckets->currentIndex = buckets->nonEmpty.rbegin()->second;
+    current = buckets->stacks[buckets->currentIndex];
+    buckets->current = current;
+  }
+  G4int nInMemory = current->size();
+  G4StackedTrack st = current->PopFromStack();
+  nBucketInMemory += G4int(current->size()) - nInMemory;
+  --nBucketTrack;
+  if(current->GetNTrack() == 0) {
+    std::size_t idx = buckets->currentIndex;
+    buckets->nonEmpty.erase(std::make_pair(buckets->lastPush[idx],idx));
+  }
+  return st;
+}
+
+void G4TrackStack::SpillBuckets()
+{
+  // The tracks in memory of the buckets which received a track least
+  // recently are spilled, down to half of the ceiling; the current
+  // bucket is spilled last
+  std::set<std::pair<G4long,std::size_t> >::const_iterator itr;
+  for(G4int pass = 0; pass < 2; pass++) {
+    for(itr = buckets->nonEmpty.begin(); itr != buckets->nonEmpty.end()
+        && nBucketInMemory > maxNTrackInMemory/2; itr++) {
+      G4TrackStack* aStack = buckets->stacks[itr->second];
+      if((aStack == buckets->current) != (pass == 1)) continue;
+      iterator firstSpilled = std::stable_partition(aStack->begin(),
+        aStack->end(), [](const G4StackedTrack& st)
+        { return !G4TrackSpillBuffer::IsSpillable(st); });
+      if(firstSpilled == aStack->end()) continue;
+      std::vector<G4StackedTrack> chunk(firstSpilled, aStack->end());
+      aStack->spillBuffer->Spill(chunk);
+      aStack->erase(firstSpilled, aStack->end());
+      nBucketInMemory -= G4int(chunk.size());
+    }
+  }
+
+  // do not try again for every push if most tracks could not be spilled
+  spillThreshold = std::max(maxNTrackInMemory,
+                            nBucketInMemory + maxNTrackInMemory/2);
+}
+
+void G4TrackStack::Restore()
+{
+  spillBuffer->Restore(*this);
+  if(order != fLastInFirstOut) {
+    std::make_heap(begin(), end(),
+      [this](const G4StackedTrack& a, const G4StackedTrack& b)
+      { return HigherPriority(b,a); });
+  }
+  spillThreshold = maxNTrackInMemory;
+}
@@ -65,6 +65,7 @@
 // valid for each region detector.
 
 // History:
+// - 19.10.18 Added declaration of a uniform field value
 // - 09.06.15 John Apostolakis, Fix to push G4FieldManager* to equation
 // - 05.11.03 John Apostolakis, Added Min/MaximumEpsilonStep
 // - 20.06.03 John Apostolakis, Abstract & ability to ConfigureForTrack
@@ -75,6 +76,7 @@
 #define G4FIELDMANAGER_HH 1
 
 #include "globals.hh"
+#include "G4ThreeVector.hh"
 
 class G4Field;
 class G4MagneticField;
@@ -163,6 +165,16 @@ class G4FieldManager
      inline void     SetFieldChangesEnergy(G4bool value);
        //  For electric field this should be true
        //  For magnetic field this should be false
+
+     inline void     SetUniformFieldValue(const G4ThreeVector& fieldValue);
+     inline void     ClearUniformFieldValue();
+     inline G4bool   HasUniformFieldValue() const;
+     inline const G4ThreeVector& GetUniformFieldValue() const;
+       //  Declare that the magnetic field is uniform, with the given value,
+       //  in the volumes using this field manager. Charged particles are
+       //  then propagated along exact helices instead of integrating the
+       //  equation of motion. Field managers of different volumes declaring
+       //  different values describe a piecewise uniform field.
     
     virtual G4FieldManager* Clone() const;
     //Needed for multi-threading, create a clone of this object
@@ -209,6 +221,9 @@ class G4FieldManager
      G4double  fEpsilonMin; 
      G4double  fEpsilonMax;
 
+     //     Uniform magnetic field declared for the volumes of this manager
+     G4bool         fUniformField;
+     G4ThreeVector  fUniformFieldValue;
 };
 
 // Our current design and implementation expect that a particular
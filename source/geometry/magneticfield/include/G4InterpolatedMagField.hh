@@ -0,0 +1,173 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+// class G4InterpolatedMagField
+//
+// Class description:
+//
+// Magnetic field map defined on a regular grid of nodes, either Cartesian
+// (x,y,z) or cylindrical (r,phi,z), and interpolated trilinearly or
+// tricubically (Catmull-Rom) between the nodes. Outside the map the field
+// is zero. A cylindrical map covering the full phi range is periodic in
+// phi; a map with a single node along an axis is constant along that axis
+// (e.g. an axially symmetric solenoid map with one phi node).
+//
+// The node values are stored in single precision in tiles of 4x4x4 nodes,
+// so that the 8 (or 64) nodes used by one interpolation lie in the same
+// or in neighbouring tiles. Node values are given as (Bx,By,Bz) for
+// Cartesian maps and as (Br,Bphi,Bz) for cylindrical maps.
+//
+// The map can be written and read back in a binary format:
+//   char[8]    "G4BFMAP1"
+//   G4int      geometry (0 Cartesian, 1 cylindrical)
+//   G4int[3]   number of nodes along each axis
+//   G4double[6] minimum and maximum of each axis (Geant4 units)
+//   G4float[]  node values, three components per node, first axis fastest
+//              (in Geant4 units)
+// in the native byte order of the machine.
+//
+// The node values are shared by the clones of the field: they must be
+// filled before the field is cloned for the worker threads.
+
+// History:
+// - Created. 19/Oct/2018
+// --------------------------------------------------------------------
+
+#ifndef G4INTERPOLATEDMAGFIELD_HH
+#define G4INTERPOLATEDMAGFIELD_HH
+
+#include <vector>
+#include <memory>
+
+#include "G4Types.hh"
+#include "G4String.hh"
+#include "G4ThreeVector.hh"
+#include "G4MagneticField.hh"
+
+class G4InterpolatedMagField : public G4MagneticField
+{
+  public:  // with description
+
+    enum MapGeometry { kCartesian = 0, kCylindrical = 1 };
+    enum Interpolation { kTrilinear, kTricubic };
+
+    G4InterpolatedMagField( MapGeometry geometry,
+                            G4int n0, G4double min0, G4double max0,
+                            G4int n1, G4double min1, G4double max1,
+                            G4int n2, G4double min2, G4double max2,
+                            Interpolation interpolation = kTrilinear );
+      // Create a map of n0 x n1 x n2 nodes with zero field. The axes are
+      // (x,y,z) for Cartesian maps and (r,phi,z) for cylindrical maps.
+
+    G4InterpolatedMagField( const G4String& binaryFileName,
+                            Interpolation interpolation = kTrilinear );
+      // Create a map from a file in the binary format.
+
+    virtual ~G4InterpolatedMagField();
+
+    G4InterpolatedMagField( const G4InterpolatedMagField& r );
+    G4InterpolatedMagField& operator = ( const G4InterpolatedMagField& p );
+      // Copy constructor & assignment operator. Node values are shared.
+
+    virtual void GetFieldValue( const G4double Point[4],
+                                      G4double* Bfield ) const;
+
+    virtual void GetFieldValues( G4int nPoints,
+                                 const G4double* Points,
+                                       G4double* Bfields ) const;
+      // Evaluate the field at nPoints points at once.
+
+    virtual G4Field* Clone() const;
+
+    void SetNodeValue( G4int i0, G4int i1, G4int i2,
+                       const G4ThreeVector& value );
+    G4ThreeVector GetNodeValue( G4int i0, G4int i1, G4int i2 ) const;
+      // Field at a node, in the components of the map geometry.
+
+    void ReadBinary( const G4String& fileName );
+    void WriteBinary( const G4String& fileName ) const;
+      // Read or write the map in the binary format. Reading replaces the
+      // geometry and the nodes of the map.
+
+    inline void SetInterpolation( Interpolation interpolation );
+    inline Interpolation GetInterpolation() const;
+
+    inline void SetOrigin( const G4ThreeVector& origin );
+    inline const G4ThreeVector& GetOrigin() const;
+      // Position of the origin of the map in the global frame.
+
+    inline void SetScaleFactor( G4double factor );
+    inline G4double GetScaleFactor() const;
+      // Factor applied to the interpolated field.
+
+    inline MapGeometry GetMapGeometry() const;
+    inline G4int GetNumberOfNodes( G4int axis ) const;
+
+  private:
+
+    void SetUpGrid( MapGeometry geometry,
+                    const G4int nNodes[3], const G4double minVal[3],
+                    const G4double maxVal[3] );
+      // Check the axes and allocate the tiled storage.
+
+    inline size_t NodeOffset( G4int i0, G4int i1, G4int i2 ) const;
+      // Offset of the first component of a node in the tiled storage.
+
+    G4bool AxisWeights( G4int axis, G4double u, G4int order,
+                        G4int* index, G4double* weight ) const;
+      // Compute the nodes and interpolation weights along one axis for
+      // an interpolation of order 2 (linear) or 4 (cubic). Return false
+      // if u is outside the map.
+
+    template <G4int K>
+    void Accumulate( const G4int index[3][4], const G4double weight[3][4],
+                     G4double value[3] ) const;
+      // Weighted sum of the K x K x K nodes.
+
+    void Evaluate( const G4double* point, G4double* Bfield ) const;
+
+  private:
+
+    static const G4int kTileBits = 2;
+    static const G4int kTileMask = (1<<kTileBits)-1;
+
+    MapGeometry   fGeometry;
+    Interpolation fInterpolation;
+    G4int    fNNodes[3];
+    G4int    fNTiles[3];
+    G4double fMin[3], fMax[3];
+    G4double fStep[3], fInvStep[3];
+    G4bool   fPeriodic[3];
+
+    G4ThreeVector fOrigin;
+    G4double fScaleFactor;
+
+    std::shared_ptr< std::vector<G4float> > fValues;
+};
+
+#include "G4InterpolatedMagField.icc"
+
+#endif
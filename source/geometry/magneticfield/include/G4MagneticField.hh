@@ -60,6 +60,15 @@ class G4MagneticField : public G4Field
 
      virtual void  GetFieldValue( const G4double Point[4],
                                         G4double *Bfield ) const = 0;
+
+     virtual void  GetFieldValues( G4int nPoints,
+                                   const G4double *Points,
+                                         G4double *Bfields ) const;
+       // Evaluate the field at nPoints points at once: 'Points' holds
+       // (x,y,z,t) for each point and 'Bfields' receives the 3 field
+       // components of each point. By default calls GetFieldValue() for
+       // each point; fields with a cheaper vectorised evaluation (e.g.
+       // field maps) can override it.
 };
 
 #endif /* G4MAGNETIC_FIELD_DEF */
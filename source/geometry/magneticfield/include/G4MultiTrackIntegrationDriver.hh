@@ -0,0 +1,141 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+// class G4MultiTrackIntegrationDriver
+//
+// Class description:
+//
+// Driver which advances several charged tracks at once in a magnetic
+// field, integrating the usual equation of motion with the Dormand-Prince
+// RK5(4)7M (745) method. The tracks occupy the lanes of a batch and take
+// their Runge-Kutta stages in lock-step: the state of the batch is stored
+// as one array per component across the lanes, so that each stage is a
+// loop over lanes, and the field is obtained for all active lanes with one
+// call to G4MagneticField::GetFieldValues(). Each lane has its own step
+// size control and stops when its requested length is integrated.
+// The laboratory time of flight is integrated with position and momentum
+// (dt/ds = 1/v), and the field is evaluated at the time of each stage.
+//
+// Intended for transport modes handling baskets of tracks; the single
+// track drivers remain used by G4ChordFinder.
+
+// History:
+// - Created. 19/Oct/2018
+// --------------------------------------------------------------------
+
+#ifndef G4MultiTrackIntegrationDriver_HH
+#define G4MultiTrackIntegrationDriver_HH
+
+#include <vector>
+
+#include "G4Types.hh"
+#include "G4FieldTrack.hh"
+
+class G4MagneticField;
+
+class G4MultiTrackIntegrationDriver
+{
+  public:  // with description
+
+    G4MultiTrackIntegrationDriver( G4MagneticField* field,
+                                   G4int maxLanes = 16,
+                                   G4double hminimum = 1.0e-5 );
+      // The batch holds at most maxLanes tracks; longer lists of tracks
+      // are advanced in successive batches. Steps are not shrunk below
+      // hminimum: a trial step not longer than hminimum is accepted
+      // without error control, as done by G4MagInt_Driver.
+
+    ~G4MultiTrackIntegrationDriver();
+
+    G4MultiTrackIntegrationDriver(const G4MultiTrackIntegrationDriver&)
+      = delete;
+    G4MultiTrackIntegrationDriver&
+      operator=(const G4MultiTrackIntegrationDriver&) = delete;
+
+    G4int AccurateAdvance( G4int nTracks,
+                           G4FieldTrack tracks[],
+                           const G4double stepLengths[],
+                           G4double eps,
+                           G4bool succeeded[] );
+      // Integrate each track over its step length with relative accuracy
+      // eps. The tracks are replaced by their state at the end of the
+      // integrated length; succeeded[i] is false if track i could not be
+      // integrated over its whole length. Returns the number of tracks
+      // that succeeded. The charge is taken from each G4FieldTrack.
+
+    inline void SetField( G4MagneticField* field );
+    inline G4MagneticField* GetField() const;
+
+    inline void  SetMaxNoSteps( G4int maxSteps );
+    inline G4int GetMaxNoSteps() const;
+      // Maximum number of steps per lane in one call.
+
+    inline G4int GetMaxLanes() const;
+
+    inline G4long GetNumberOfSteps() const;
+    inline G4long GetNumberOfFieldEvaluations() const;
+    inline void   ClearStatistics();
+      // Number of trial steps and of field evaluations (points).
+
+  private:
+
+    void AdvanceBatch( G4int nLanes, G4FieldTrack tracks[],
+                       const G4double stepLengths[], G4double eps,
+                       G4bool succeeded[] );
+      // Integrate up to fMaxLanes tracks in lock-step.
+
+    void EvaluateRhs( G4int nLanes, const G4double* y, G4double* dydx );
+      // Right-hand side of the equation of motion for the active lanes.
+
+  private:
+
+    static const G4int fNoVars = 7;      // Position, momentum and time
+    static const G4int fNoStages = 7;
+
+    G4MagneticField* fField;
+    G4int    fMaxLanes;
+    G4double fMinimumStep;
+    G4int    fMaxNoSteps;
+
+    // Batch state, stored component by component: y[var*fMaxLanes+lane]
+    //
+    std::vector<G4double> fY, fYTemp, fYOut, fK;
+    std::vector<G4double> fCof, fMassSq, fLength, fTarget, fStep, fTrialStep;
+    std::vector<G4int>    fNoSteps;
+    std::vector<G4bool>   fActive;
+
+    // Gathered input and output of the batched field evaluation
+    //
+    std::vector<G4int>    fActiveLanes;
+    std::vector<G4double> fPoints, fFields;
+
+    G4long fNoTrialSteps;
+    G4long fNoFieldEvaluations;
+};
+
+#include "G4MultiTrackIntegrationDriver.icc"
+
+#endif
@@ -82,6 +82,8 @@ GEANT4_DEFINE_MODULE(NAME G4magneticfield
         G4ImplicitEuler.hh
         G4IntegrationDriver.hh
         G4IntegrationDriver.icc
+        G4InterpolatedMagField.hh
+        G4InterpolatedMagField.icc
         G4LineCurrentMagField.hh
         G4LineSection.hh
         G4MagErrorStepper.hh
@@ -98,6 +100,8 @@ GEANT4_DEFINE_MODULE(NAME G4magneticfield
         G4ModifiedMidpoint.hh
         G4ModifiedMidpoint.icc
         G4MonopoleEq.hh
+        G4MultiTrackIntegrationDriver.hh
+        G4MultiTrackIntegrationDriver.icc
         G4MagneticField.hh
         G4NystromRK4.hh
         G4QuadrupoleMagField.hh
@@ -156,6 +160,7 @@ GEANT4_DEFINE_MODULE(NAME G4magneticfield
         G4HelixMixedStepper.cc
         G4HelixSimpleRunge.cc
         G4ImplicitEuler.cc
+        G4InterpolatedMagField.cc
         G4LineCurrentMagField.cc
         G4LineSection.cc
         G4MagErrorStepper.cc
@@ -168,6 +173,7 @@ GEANT4_DEFINE_MODULE(NAME G4magneticfield
         G4MagneticField.cc
         G4ModifiedMidpoint.cc
         G4MonopoleEq.cc
+        G4MultiTrackIntegrationDriver.cc
         G4NystromRK4.cc
         G4QuadrupoleMagField.cc
         G4RepleteEofM.cc
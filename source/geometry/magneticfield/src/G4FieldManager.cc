@@ -46,7 +46,9 @@ G4FieldManager::G4FieldManager(G4Field       *detectorField,
      fDefault_Delta_One_Step_Value(0.01),    // mm
      fDefault_Delta_Intersection_Val(0.001), // mm
      fEpsilonMin( fEpsilonMinDefault ),
-     fEpsilonMax( fEpsilonMaxDefault)
+     fEpsilonMax( fEpsilonMaxDefault),
+     fUniformField( false ),
+     fUniformFieldValue( 0., 0., 0. )
 { 
    fDelta_One_Step_Value= fDefault_Delta_One_Step_Value;
    fDelta_Intersection_Val= fDefault_Delta_Intersection_Val;
@@ -67,7 +69,9 @@ G4FieldManager::G4FieldManager(G4MagneticField *detectorField)
      fDefault_Delta_One_Step_Value(0.01),    // mm
      fDefault_Delta_Intersection_Val(0.001), // mm
      fEpsilonMin( fEpsilonMinDefault ),
-     fEpsilonMax( fEpsilonMaxDefault)
+     fEpsilonMax( fEpsilonMaxDefault),
+     fUniformField( false ),
+     fUniformFieldValue( 0., 0., 0. )
 {
    fChordFinder= new G4ChordFinder( detectorField );
    fDelta_One_Step_Value= fDefault_Delta_One_Step_Value;
@@ -108,6 +112,8 @@ G4FieldManager* G4FieldManager::Clone() const
         aFM->fDefault_Delta_One_Step_Value = this->fDefault_Delta_One_Step_Value;
         aFM->fDelta_Intersection_Val = this->fDelta_Intersection_Val;
         aFM->fDelta_One_Step_Value = this->fDelta_One_Step_Value;
+        aFM->fUniformField = this->fUniformField;
+        aFM->fUniformFieldValue = this->fUniformFieldValue;
         //TODO: Should we really add to the store the cloned FM? Who will use this?
     }
     catch ( ... )
@@ -0,0 +1,481 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+// class G4InterpolatedMagField implementation
+//
+// --------------------------------------------------------------------
+
+#include "G4InterpolatedMagField.hh"
+#include "G4PhysicalConstants.hh"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+  const char kMagic[8] = { 'G','4','B','F','M','A','P','1' };
+}
+
+// --------------------------------------------------------------------
+
+G4InterpolatedMagField::
+G4InterpolatedMagField( MapGeometry geometry,
+                        G4int n0, G4double min0, G4double max0,
+                        G4int n1, G4double min1, G4double max1,
+                        G4int n2, G4double min2, G4double max2,
+                        Interpolation interpolation )
+  : G4MagneticField(), fGeometry(geometry), fInterpolation(interpolation),
+    fOrigin(0.,0.,0.), fScaleFactor(1.)
+{
+  G4int nNodes[3] = { n0, n1, n2 };
+  G4double minVal[3] = { min0, min1, min2 };
+  G4double maxVal[3] = { max0, max1, max2 };
+  SetUpGrid( geometry, nNodes, minVal, maxVal );
+}
+
+// --------------------------------------------------------------------
+
+G4InterpolatedMagField::
+G4InterpolatedMagField( const G4String& binaryFileName,
+                        Interpolation interpolation )
+  : G4MagneticField(), fGeometry(kCartesian), fInterpolation(interpolation),
+    fOrigin(0.,0.,0.), fScaleFactor(1.)
+{
+  ReadBinary( binaryFileName );
+}
+
+// --------------------------------------------------------------------
+
+G4InterpolatedMagField::~G4InterpolatedMagField()
+{
+}
+
+// --------------------------------------------------------------------
+
+G4InterpolatedMagField::
+G4InterpolatedMagField( const G4InterpolatedMagField& r )
+  : G4MagneticField(r), fGeometry(r.fGeometry),
+    fInterpolation(r.fInterpolation), fOrigin(r.fOrigin),
+    fScaleFactor(r.fScaleFactor), fValues(r.fValues)
+{
+  for( G4int i=0; i<3; ++i )
+  {
+    fNNodes[i] = r.fNNodes[i];
+    fNTiles[i] = r.fNTiles[i];
+    fMin[i] = r.fMin[i];
+    fMax[i] = r.fMax[i];
+    fStep[i] = r.fStep[i];
+    fInvStep[i] = r.fInvStep[i];
+    fPeriodic[i] = r.fPeriodic[i];
+  }
+}
+
+// --------------------------------------------------------------------
+
+G4InterpolatedMagField&
+G4InterpolatedMagField::operator = ( const G4InterpolatedMagField& p )
+{
+  if (&p == this) return *this;
+  G4MagneticField::operator=(p);
+  fGeometry = p.fGeometry;
+  fInterpolation = p.fInterpolation;
+  fOrigin = p.fOrigin;
+  fScaleFactor = p.fScaleFactor;
+  fValues = p.fValues;
+  for( G4int i=0; i<3; ++i )
+  {
+    fNNodes[i] = p.fNNodes[i];
+    fNTiles[i] = p.fNTiles[i];
+    fMin[i] = p.fMin[i];
+    fMax[i] = p.fMax[i];
+    fStep[i] = p.fStep[i];
+    fInvStep[i] = p.fInvStep[i];
+    fPeriodic[i] = p.fPeriodic[i];
+  }
+  return *this;
+}
+
+// --------------------------------------------------------------------
+
+G4Field* G4InterpolatedMagField::Clone() const
+{
+  return new G4InterpolatedMagField(*this);
+}
+
+// --------------------------------------------------------------------
+
+void G4InterpolatedMagField::SetUpGrid( MapGeometry geometry,
+                                        const G4int nNodes[3],
+                                        const G4double minVal[3],
+                                        const G4double maxVal[3] )
+{
+  fGeometry = geometry;
+  for( G4int i=0; i<3; ++i )
+  {
+    if( nNodes[i] < 1 || (nNodes[i] > 1 && !(maxVal[i] > minVal[i])) )
+    {
+      G4ExceptionDescription message;
+      message << "Invalid axis " << i << " of the field map:" << G4endl
+              << "  number of nodes = " << nNodes[i]
+              << ", range = [" << minVal[i] << ", " << maxVal[i] << "]";
+      G4Exception("G4InterpolatedMagField::SetUpGrid()", "GeomField0002",
+                  FatalException, message);
+      return;
+    }
+    fNNodes[i] = nNodes[i];
+    fNTiles[i] = (nNodes[i]+kTileMask) >> kTileBits;
+    fMin[i] = minVal[i];
+    fMax[i] = maxVal[i];
+
+    // A cylindrical map spanning the full phi range is periodic: the node
+    // after the last one is the first one
+    //
+    fPeriodic[i] = (geometry == kCylindrical) && (i == 1) && (nNodes[i] > 1)
+                && (std::fabs(maxVal[i]-minVal[i]-twopi) < 1.e-9);
+    if( nNodes[i] == 1 )
+    {
+      fStep[i] = 0.;
+      fInvStep[i] = 0.;
+    }
+    else
+    {
+      fStep[i] = (maxVal[i]-minVal[i]) / (fPeriodic[i] ? nNodes[i]
+                                                        : nNodes[i]-1);
+      fInvStep[i] = 1./fStep[i];
+    }
+  }
+  if( geometry == kCylindrical && minVal[0] < 0. )
+  {
+    G4ExceptionDescription message;
+    message << "Negative minimum radius of the field map: " << minVal[0];
+    G4Exception("G4InterpolatedMagField::SetUpGrid()", "GeomField0002",
+                FatalException, message);
+  }
+
+  size_t nTiles = size_t(fNTiles[0])*fNTiles[1]*fNTiles[2];
+  fValues.reset( new std::vector<G4float>( 3*(nTiles << (3*kTileBits)),
+                                           0.f ) );
+}
+
+// --------------------------------------------------------------------
+
+void G4InterpolatedMagField::SetNodeValue( G4int i0, G4int i1, G4int i2,
+                                           const G4ThreeVector& value )
+{
+  if( i0 < 0 || i0 >= fNNodes[0] || i1 < 0 || i1 >= fNNodes[1]
+   || i2 < 0 || i2 >= fNNodes[2] )
+  {
+    G4ExceptionDescription message;
+    message << "Node (" << i0 << "," << i1 << "," << i2
+            << ") is outside the field map.";
+    G4Exception("G4InterpolatedMagField::SetNodeValue()", "GeomField0002",
+                FatalException, message);
+    return;
+  }
+  G4float* node = &(*fValues)[NodeOffset(i0,i1,i2)];
+  node[0] = G4float(value.x());
+  node[1] = G4float(value.y());
+  node[2] = G4float(value.z());
+}
+
+// --------------------------------------------------------------------
+
+G4ThreeVector
+G4InterpolatedMagField::GetNodeValue( G4int i0, G4int i1, G4int i2 ) const
+{
+  const G4float* node = &(*fValues)[NodeOffset(i0,i1,i2)];
+  return G4ThreeVector( node[0], node[1], node[2] );
+}
+
+// --------------------------------------------------------------------
+
+G4bool G4InterpolatedMagField::AxisWeights( G4int axis, G4double u,
+                                            G4int order, G4int* index,
+                                            G4double* weight ) const
+{
+  const G4int n = fNNodes[axis];
+  if( n == 1 )
+  {
+    for( G4int k=0; k<order; ++k )  { index[k] = 0; weight[k] = 0.; }
+    weight[0] = 1.;
+    return true;
+  }
+
+  G4double s = (u-fMin[axis])*fInvStep[axis];
+  G4int i;
+  if( fPeriodic[axis] )
+  {
+    s -= n*std::floor(s/n);
+    i = G4int(s);
+    if( i >= n )  { i = n-1; }
+  }
+  else
+  {
+    if( s < 0. || s > n-1 )  { return false; }
+    i = G4int(s);
+    if( i > n-2 )  { i = n-2; }
+  }
+  G4double t = s-i;
+
+  if( order == 2 )
+  {
+    index[0] = i;
+    index[1] = i+1;
+    weight[0] = 1.-t;
+    weight[1] = t;
+  }
+  else
+  {
+    // Catmull-Rom weights of the nodes i-1, i, i+1 and i+2
+    //
+    G4double t2 = t*t, t3 = t2*t;
+    weight[0] = 0.5*(-t3 + 2.*t2 - t);
+    weight[1] = 0.5*(3.*t3 - 5.*t2 + 2.);
+    weight[2] = 0.5*(-3.*t3 + 4.*t2 + t);
+    weight[3] = 0.5*(t3 - t2);
+    for( G4int k=0; k<4; ++k )  { index[k] = i-1+k; }
+  }
+
+  // Wrap the nodes of periodic axes, replicate the border nodes otherwise
+  //
+  for( G4int k=0; k<order; ++k )
+  {
+    if( index[k] < 0 )
+    {
+      index[k] = fPeriodic[axis] ? index[k]+n : 0;
+    }
+    else if( index[k] >= n )
+    {
+      index[k] = fPeriodic[axis] ? index[k]-n : n-1;
+    }
+  }
+  return true;
+}
+
+// --------------------------------------------------------------------
+
+template <G4int K>
+void G4InterpolatedMagField::Accumulate( const G4int index[3][4],
+                                         const G4double weight[3][4],
+                                         G4double value[3] ) const
+{
+  const G4float* values = &(*fValues)[0];
+  G4double b0 = 0., b1 = 0., b2 = 0.;
+  for( G4int k2=0; k2<K; ++k2 )
+  {
+    for( G4int k1=0; k1<K; ++k1 )
+    {
+      const G4double w12 = weight[2][k2]*weight[1][k1];
+      if( w12 == 0. )  { continue; }
+      for( G4int k0=0; k0<K; ++k0 )
+      {
+        const G4float* node
+          = values + NodeOffset(index[0][k0], index[1][k1], index[2][k2]);
+        const G4double w = w12*weight[0][k0];
+        b0 += w*node[0];
+        b1 += w*node[1];
+        b2 += w*node[2];
+      }
+    }
+  }
+  value[0] = b0;
+  value[1] = b1;
+  value[2] = b2;
+}
+
+// --------------------------------------------------------------------
+
+void G4InterpolatedMagField::Evaluate( const G4double* point,
+                                       G4double* Bfield ) const
+{
+  const G4double x = point[0]-fOrigin.x();
+  const G4double y = point[1]-fOrigin.y();
+  const G4double z = point[2]-fOrigin.z();
+
+  G4double u[3];
+  G4double cosPhi = 1., sinPhi = 0.;
+  if( fGeometry == kCartesian )
+  {
+    u[0] = x;
+    u[1] = y;
+  }
+  else
+  {
+    const G4double r = std::sqrt(x*x+y*y);
+    if( r > 0. )
+    {
+      cosPhi = x/r;
+      sinPhi = y/r;
+    }
+    u[0] = r;
+    u[1] = (fNNodes[1] > 1) ? std::atan2(y,x) : 0.;
+  }
+  u[2] = z;
+
+  const G4int order = (fInterpolation == kTricubic) ? 4 : 2;
+  G4int index[3][4];
+  G4double weight[3][4];
+  for( G4int i=0; i<3; ++i )
+  {
+    if( !AxisWeights( i, u[i], order, index[i], weight[i] ) )
+    {
+      Bfield[0] = Bfield[1] = Bfield[2] = 0.;
+      return;
+    }
+  }
+
+  G4double b[3];
+  if( order == 4 )  { Accumulate<4>( index, weight, b ); }
+  else              { Accumulate<2>( index, weight, b ); }
+
+  if( fGeometry == kCartesian )
+  {
+    Bfield[0] = fScaleFactor*b[0];
+    Bfield[1] = fScaleFactor*b[1];
+  }
+  else
+  {
+    Bfield[0] = fScaleFactor*(b[0]*cosPhi - b[1]*sinPhi);
+    Bfield[1] = fScaleFactor*(b[0]*sinPhi + b[1]*cosPhi);
+  }
+  Bfield[2] = fScaleFactor*b[2];
+}
+
+// --------------------------------------------------------------------
+
+void G4InterpolatedMagField::GetFieldValue( const G4double Point[4],
+                                                  G4double* Bfield ) const
+{
+  Evaluate( Point, Bfield );
+}
+
+// --------------------------------------------------------------------
+
+void G4InterpolatedMagField::GetFieldValues( G4int nPoints,
+                                             const G4double* Points,
+                                                   G4double* Bfields ) const
+{
+  for( G4int i=0; i<nPoints; ++i )
+  {
+    Evaluate( Points+4*i, Bfields+3*i );
+  }
+}
+
+// --------------------------------------------------------------------
+
+void G4InterpolatedMagField::ReadBinary( const G4String& fileName )
+{
+  std::ifstream in( fileName, std::ios::in | std::ios::binary );
+  char magic[8];
+  G4int geometry = -1;
+  G4int nNodes[3];
+  G4double minMax[6];
+  if( in )
+  {
+    in.read( magic, sizeof(magic) );
+    in.read( reinterpret_cast<char*>(&geometry), sizeof(geometry) );
+    in.read( reinterpret_cast<char*>(nNodes), sizeof(nNodes) );
+    in.read( reinterpret_cast<char*>(minMax), sizeof(minMax) );
+  }
+  if( !in || std::memcmp( magic, kMagic, sizeof(kMagic) ) != 0
+   || (geometry != kCartesian && geometry != kCylindrical) )
+  {
+    G4ExceptionDescription message;
+    message << "Cannot read field map from file " << fileName
+            << ": missing file or invalid header.";
+    G4Exception("G4InterpolatedMagField::ReadBinary()", "GeomField0002",
+                FatalException, message);
+    return;
+  }
+
+  G4double minVal[3] = { minMax[0], minMax[2], minMax[4] };
+  G4double maxVal[3] = { minMax[1], minMax[3], minMax[5] };
+  SetUpGrid( MapGeometry(geometry), nNodes, minVal, maxVal );
+
+  // Read one row of nodes along the first axis at a time
+  //
+  std::vector<G4float> row( 3*fNNodes[0] );
+  for( G4int i2=0; i2<fNNodes[2] && in; ++i2 )
+  {
+    for( G4int i1=0; i1<fNNodes[1] && in; ++i1 )
+    {
+      in.read( reinterpret_cast<char*>(&row[0]), row.size()*sizeof(G4float) );
+      for( G4int i0=0; i0<fNNodes[0]; ++i0 )
+      {
+        G4float* node = &(*fValues)[NodeOffset(i0,i1,i2)];
+        node[0] = row[3*i0];
+        node[1] = row[3*i0+1];
+        node[2] = row[3*i0+2];
+      }
+    }
+  }
+  if( !in )
+  {
+    G4ExceptionDescription message;
+    message << "Field map file " << fileName << " is truncated.";
+    G4Exception("G4InterpolatedMagField::ReadBinary()", "GeomField0002",
+                FatalException, message);
+  }
+}
+
+// --------------------------------------------------------------------
+
+void G4InterpolatedMagField::WriteBinary( const G4String& fileName ) const
+{
+  std::ofstream out( fileName, std::ios::out | std::ios::binary );
+  G4int geometry = fGeometry;
+  G4double minMax[6] = { fMin[0], fMax[0], fMin[1], fMax[1],
+                         fMin[2], fMax[2] };
+  out.write( kMagic, sizeof(kMagic) );
+  out.write( reinterpret_cast<const char*>(&geometry), sizeof(geometry) );
+  out.write( reinterpret_cast<const char*>(fNNodes), sizeof(fNNodes) );
+  out.write( reinterpret_cast<const char*>(minMax), sizeof(minMax) );
+
+  std::vector<G4float> row( 3*fNNodes[0] );
+  for( G4int i2=0; i2<fNNodes[2]; ++i2 )
+  {
+    for( G4int i1=0; i1<fNNodes[1]; ++i1 )
+    {
+      for( G4int i0=0; i0<fNNodes[0]; ++i0 )
+      {
+        const G4float* node = &(*fValues)[NodeOffset(i0,i1,i2)];
+        row[3*i0] = node[0];
+        row[3*i0+1] = node[1];
+        row[3*i0+2] = node[2];
+      }
+      out.write( reinterpret_cast<const char*>(&row[0]),
+                 row.size()*sizeof(G4float) );
+    }
+  }
+  if( !out )
+  {
+    G4ExceptionDescription message;
+    message << "Cannot write field map to file " << fileName;
+    G4Exception("G4InterpolatedMagField::WriteBinary()", "GeomField0002",
+                JustWarning, message);
+  }
+}
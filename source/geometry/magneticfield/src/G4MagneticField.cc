@@ -50,3 +50,13 @@ G4MagneticField& G4MagneticField::operator = (const G4MagneticField &p)
   G4Field::operator=(p); 
   return *this;
 }
+
+void G4MagneticField::GetFieldValues( G4int nPoints,
+                                      const G4double *Points,
+                                            G4double *Bfields ) const
+{
+  for( G4int i=0; i<nPoints; ++i )
+  {
+    GetFieldValue( Points+4*i, Bfields+3*i );
+  }
+}
@@ -0,0 +1,350 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+// class G4MultiTrackIntegrationDriver implementation
+//
+// --------------------------------------------------------------------
+
+#include "G4MultiTrackIntegrationDriver.hh"
+#include "G4MagneticField.hh"
+#include "G4PhysicalConstants.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  // Butcher table of the Dormand-Prince RK5(4)7M method (see
+  // G4DormandPrince745): stage coefficients, the last row giving the
+  // 5th order solution, and differences with the embedded 4th order one
+  //
+  const G4double a[7][6] =
+  {
+    { 0., 0., 0., 0., 0., 0. },
+    { 1.0/5.0, 0., 0., 0., 0., 0. },
+    { 3.0/40.0, 9.0/40.0, 0., 0., 0., 0. },
+    { 44.0/45.0, -56.0/15.0, 32.0/9.0, 0., 0., 0. },
+    { 19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0,
+      0., 0. },
+    { 9017.0/3168.0, -355.0/33.0, 46732.0/5247.0, 49.0/176.0,
+      -5103.0/18656.0, 0. },
+    { 35.0/384.0, 0., 500.0/1113.0, 125.0/192.0, -2187.0/6784.0,
+      11.0/84.0 }
+  };
+  const G4double e[7] =
+  {
+    -(35.0/384.0 - 5179.0/57600.0), 0.,
+    -(500.0/1113.0 - 7571.0/16695.0), -(125.0/192.0 - 393.0/640.0),
+    -(-2187.0/6784.0 + 92097.0/339200.0), -(11.0/84.0 - 187.0/2100.0),
+    1.0/40.0
+  };
+
+  // Step size control, as in G4MagInt_Driver for a 4th order error
+  //
+  const G4double safety = 0.9;
+  const G4double pshrnk = -1.0/4.0;
+  const G4double pgrow = -1.0/5.0;
+  const G4double maxStepIncrease = 5.0;
+  const G4double errcon = std::pow( maxStepIncrease/safety, 1.0/pgrow );
+}
+
+// --------------------------------------------------------------------
+
+G4MultiTrackIntegrationDriver::
+G4MultiTrackIntegrationDriver( G4MagneticField* field, G4int maxLanes,
+                               G4double hminimum )
+  : fField(field), fMaxLanes(maxLanes), fMinimumStep(hminimum),
+    fMaxNoSteps(10000), fNoTrialSteps(0), fNoFieldEvaluations(0)
+{
+  if( fMaxLanes < 1 )
+  {
+    G4ExceptionDescription message;
+    message << "Invalid number of lanes: " << maxLanes;
+    G4Exception("G4MultiTrackIntegrationDriver::G4MultiTrackIntegrationDriver()",
+                "GeomField0002", FatalException, message);
+  }
+  const size_t nLanes = fMaxLanes;
+  fY.resize( fNoVars*nLanes );
+  fYTemp.resize( fNoVars*nLanes );
+  fYOut.resize( fNoVars*nLanes );
+  fK.resize( fNoStages*fNoVars*nLanes );
+  fCof.resize( nLanes );
+  fMassSq.resize( nLanes );
+  fLength.resize( nLanes );
+  fTarget.resize( nLanes );
+  fStep.resize( nLanes );
+  fTrialStep.resize( nLanes );
+  fNoSteps.resize( nLanes );
+  fActive.resize( nLanes );
+  fActiveLanes.reserve( nLanes );
+  fPoints.resize( 4*nLanes );
+  fFields.resize( 3*nLanes );
+}
+
+// --------------------------------------------------------------------
+
+G4MultiTrackIntegrationDriver::~G4MultiTrackIntegrationDriver()
+{
+}
+
+// --------------------------------------------------------------------
+
+G4int
+G4MultiTrackIntegrationDriver::AccurateAdvance( G4int nTracks,
+                                                G4FieldTrack tracks[],
+                                                const G4double stepLengths[],
+                                                G4double eps,
+                                                G4bool succeeded[] )
+{
+  if( fField == nullptr )
+  {
+    G4Exception("G4MultiTrackIntegrationDriver::AccurateAdvance()",
+                "GeomField0003", FatalException, "No field is set.");
+    return 0;
+  }
+
+  for( G4int first = 0; first < nTracks; first += fMaxLanes )
+  {
+    G4int nLanes = std::min( fMaxLanes, nTracks-first );
+    AdvanceBatch( nLanes, tracks+first, stepLengths+first, eps,
+                  succeeded+first );
+  }
+  return G4int( std::count( succeeded, succeeded+nTracks, true ) );
+}
+
+// --------------------------------------------------------------------
+
+void
+G4MultiTrackIntegrationDriver::AdvanceBatch( G4int nLanes,
+                                             G4FieldTrack tracks[],
+                                             const G4double stepLengths[],
+                                             G4double eps,
+                                             G4bool succeeded[] )
+{
+  const G4int L = fMaxLanes;
+  G4double* y = &fY[0];
+  G4double* yTemp = &fYTemp[0];
+  G4double* yOut = &fYOut[0];
+  G4double* k = &fK[0];
+
+  // Load the lanes; unused lanes are inactive with zero state
+  //
+  G4int nActive = 0;
+  for( G4int lane = 0; lane < L; ++lane )
+  {
+    fActive[lane] = false;
+    fTrialStep[lane] = 0.;
+    if( lane >= nLanes )
+    {
+      for( G4int v = 0; v < fNoVars; ++v )  { y[v*L+lane] = 0.; }
+      continue;
+    }
+    const G4FieldTrack& track = tracks[lane];
+    G4ThreeVector position = track.GetPosition();
+    G4ThreeVector momentum = track.GetMomentum();
+    y[0*L+lane] = position.x();
+    y[1*L+lane] = position.y();
+    y[2*L+lane] = position.z();
+    y[3*L+lane] = momentum.x();
+    y[4*L+lane] = momentum.y();
+    y[5*L+lane] = momentum.z();
+    y[6*L+lane] = track.GetLabTimeOfFlight();
+    fCof[lane] = track.GetCharge()*CLHEP::eplus*CLHEP::c_light;
+    fMassSq[lane] = track.GetRestMass()*track.GetRestMass();
+    fLength[lane] = 0.;
+    fTarget[lane] = stepLengths[lane];
+    fStep[lane] = stepLengths[lane];
+    fNoSteps[lane] = 0;
+    succeeded[lane] = true;
+    if( stepLengths[lane] > 0. && momentum.mag2() > 0. )
+    {
+      fActive[lane] = true;
+      ++nActive;
+    }
+  }
+
+  EvaluateRhs( nLanes, y, k );   // First stage; afterwards taken from the
+                                 // last stage of the accepted step (FSAL)
+  while( nActive > 0 )
+  {
+    for( G4int lane = 0; lane < L; ++lane )
+    {
+      fTrialStep[lane] = fActive[lane]
+        ? std::min( fStep[lane], fTarget[lane]-fLength[lane] ) : 0.;
+    }
+    const G4double* h = &fTrialStep[0];
+
+    // Stages 2 to 7, all lanes together; the argument of the last stage
+    // is the 5th order solution
+    //
+    for( G4int s = 1; s < fNoStages; ++s )
+    {
+      G4double* yStage = (s == fNoStages-1) ? yOut : yTemp;
+      for( G4int v = 0; v < fNoVars; ++v )
+      {
+        for( G4int lane = 0; lane < L; ++lane )
+        {
+          G4double sum = 0.;
+          for( G4int j = 0; j < s; ++j )
+          {
+            sum += a[s][j]*k[(j*fNoVars+v)*L+lane];
+          }
+          yStage[v*L+lane] = y[v*L+lane] + h[lane]*sum;
+        }
+      }
+      EvaluateRhs( nLanes, yStage, k+s*fNoVars*L );
+    }
+
+    // Error estimate and step size control of each lane
+    //
+    const G4double inv_eps_sq = 1.0/(eps*eps);
+    for( G4int lane = 0; lane < nLanes; ++lane )
+    {
+      if( !fActive[lane] )  { continue; }
+      ++fNoTrialSteps;
+
+      G4double err[fNoVars];
+      for( G4int v = 0; v < fNoVars; ++v )
+      {
+        G4double sum = 0.;
+        for( G4int j = 0; j < fNoStages; ++j )
+        {
+          sum += e[j]*k[(j*fNoVars+v)*L+lane];
+        }
+        err[v] = h[lane]*sum;
+      }
+      const G4double eps_pos = eps*std::max( h[lane], fMinimumStep );
+      const G4double errpos_sq = (err[0]*err[0] + err[1]*err[1]
+                                + err[2]*err[2]) / (eps_pos*eps_pos);
+      const G4double mom_sq = y[3*L+lane]*y[3*L+lane]
+                            + y[4*L+lane]*y[4*L+lane]
+                            + y[5*L+lane]*y[5*L+lane];
+      const G4double errmom_sq = (err[3]*err[3] + err[4]*err[4]
+                                + err[5]*err[5]) / mom_sq * inv_eps_sq;
+      const G4double errmax_sq = std::max( errpos_sq, errmom_sq );
+
+      // The time is not part of the error estimate, as in G4MagInt_Driver;
+      // a step of at most the minimum length is taken as it is
+      //
+      if( errmax_sq <= 1.0 || h[lane] <= fMinimumStep )
+      {
+        // Step accepted: move the lane and reuse the last stage
+        //
+        for( G4int v = 0; v < fNoVars; ++v )
+        {
+          y[v*L+lane] = yOut[v*L+lane];
+          k[v*L+lane] = k[((fNoStages-1)*fNoVars+v)*L+lane];
+        }
+        fLength[lane] += h[lane];
+        fStep[lane] = (errmax_sq > errcon*errcon)
+          ? safety*h[lane]*std::pow( errmax_sq, 0.5*pgrow )
+          : maxStepIncrease*h[lane];
+        if( fTarget[lane]-fLength[lane] <= CLHEP::perMillion*fMinimumStep )
+        {
+          fActive[lane] = false;
+          --nActive;
+          continue;
+        }
+      }
+      else
+      {
+        // Step rejected: retry shorter, by no more than a factor of 10
+        // and not below the minimum step
+        //
+        fStep[lane] = std::max( safety*h[lane]
+                                *std::pow( errmax_sq, 0.5*pshrnk ),
+                                0.1*h[lane] );
+        fStep[lane] = std::max( fStep[lane], fMinimumStep );
+      }
+      if( ++fNoSteps[lane] >= fMaxNoSteps )
+      {
+        succeeded[lane] = false;
+        fActive[lane] = false;
+        --nActive;
+      }
+    }
+  }
+
+  // Store the final state of the tracks
+  //
+  for( G4int lane = 0; lane < nLanes; ++lane )
+  {
+    G4FieldTrack& track = tracks[lane];
+    track.SetPosition( G4ThreeVector( y[0*L+lane], y[1*L+lane],
+                                      y[2*L+lane] ) );
+    track.SetMomentum( G4ThreeVector( y[3*L+lane], y[4*L+lane],
+                                      y[5*L+lane] ) );
+    track.SetLabTimeOfFlight( y[6*L+lane] );
+    track.SetCurveLength( track.GetCurveLength() + fLength[lane] );
+  }
+}
+
+// --------------------------------------------------------------------
+
+void G4MultiTrackIntegrationDriver::EvaluateRhs( G4int nLanes,
+                                                 const G4double* y,
+                                                       G4double* dydx )
+{
+  const G4int L = fMaxLanes;
+
+  // Gather the positions of the active lanes and get the field at all of
+  // them in one call
+  //
+  fActiveLanes.clear();
+  for( G4int lane = 0; lane < nLanes; ++lane )
+  {
+    if( !fActive[lane] )  { continue; }
+    G4double* point = &fPoints[4*fActiveLanes.size()];
+    point[0] = y[0*L+lane];
+    point[1] = y[1*L+lane];
+    point[2] = y[2*L+lane];
+    point[3] = y[6*L+lane];
+    fActiveLanes.push_back( lane );
+  }
+  const G4int nActive = G4int(fActiveLanes.size());
+  if( nActive == 0 )  { return; }
+  fField->GetFieldValues( nActive, &fPoints[0], &fFields[0] );
+  fNoFieldEvaluations += nActive;
+
+  for( G4int i = 0; i < nActive; ++i )
+  {
+    const G4int lane = fActiveLanes[i];
+    const G4double* B = &fFields[3*i];
+    const G4double px = y[3*L+lane], py = y[4*L+lane], pz = y[5*L+lane];
+    const G4double mom_sq = px*px + py*py + pz*pz;
+    const G4double inv_mom = 1.0/std::sqrt( mom_sq );
+    const G4double cof = fCof[lane]*inv_mom;
+
+    dydx[0*L+lane] = px*inv_mom;
+    dydx[1*L+lane] = py*inv_mom;
+    dydx[2*L+lane] = pz*inv_mom;
+    dydx[3*L+lane] = cof*(py*B[2] - pz*B[1]);
+    dydx[4*L+lane] = cof*(pz*B[0] - px*B[2]);
+    dydx[5*L+lane] = cof*(px*B[1] - py*B[0]);
+    dydx[6*L+lane] = std::sqrt( mom_sq + fMassSq[lane] )*inv_mom
+                   / CLHEP::c_light;   // 1/v
+  }
+}
@@ -39,6 +39,8 @@
 //
 //   - fgInstance
 //     Ptr to the unique instance of class
+//   - fNumberOfThreads
+//     Number of threads sharing the construction of the voxel headers
 
 // Author:
 // 26.07.95 P.Kent Initial version, including optimisation Build
@@ -48,9 +50,11 @@
 
 #include <vector>
 #include "G4Types.hh"
+#include "G4String.hh"
 #include "G4SmartVoxelStat.hh"
 
 class G4VPhysicalVolume;
+class G4LogicalVolume;
 
 class G4GeometryManager
 {
@@ -74,6 +78,26 @@ class G4GeometryManager
       // Set the maximum extent of the world volume. The operation is
       // allowed only if NO solids have been created already.
 
+    void SetNumberOfOptimisationThreads(G4int nThreads);
+    G4int GetNumberOfOptimisationThreads() const;
+      // Set/get the number of threads building concurrently the voxel
+      // optimisation of independent logical volumes, when closing the
+      // whole geometry. The default (1) builds all voxels sequentially;
+      // 0 uses as many threads as the available cores. Effective only in
+      // multi-threaded builds and when closing the geometry on the master.
+
+    void SetOptimisationFile(const G4String& fileName);
+    const G4String& GetOptimisationFile() const;
+      // Set/get the file storing the voxel optimisation across jobs.
+      // When closing the whole geometry, voxels are retrieved from the file
+      // if it matches the geometry; otherwise they are built and the file
+      // is (re)written. An empty name (default) disables the file.
+
+    void UpdateSafetyGrid(G4LogicalVolume* lv);
+      // Rebuild the grid of safety lower bounds of the logical volume
+      // according to its current resolution, if the geometry is closed.
+      // Otherwise the grid is built when the geometry is next closed.
+
     static G4GeometryManager* GetInstance();
       // Return ptr to singleton instance of the class, creating it if
       // not existing.
@@ -95,10 +119,23 @@ class G4GeometryManager
 
     void BuildOptimisations(G4bool allOpt, G4bool verbose=false);
     void BuildOptimisations(G4bool allOpt, G4VPhysicalVolume* vol);
+    void BuildOptimisationsParallel(G4bool allOpt, G4bool verbose,
+                                    G4int nThreads);
     void DeleteOptimisations();
     void DeleteOptimisations(G4VPhysicalVolume* vol);
+    G4bool RetrieveOptimisations(G4bool allOpt, G4bool verbose);
+    static void BuildSafetyGrid(G4LogicalVolume* lv);
+    static void DeleteSafetyGrid(G4LogicalVolume* lv);
     static void ReportVoxelStats( std::vector<G4SmartVoxelStat> & stats,
-                                  G4double totalCpuTime );
+                                  G4double totalCpuTime,
+                                  G4double totalRealTime = 0.0,
+                                  G4int nThreads = 1 );
+
+  private:
+
+    G4int fNumberOfThreads;
+    G4String fOptimisationFile;
+
     static G4ThreadLocal G4GeometryManager* fgInstance;
     static G4ThreadLocal G4bool fIsClosed;
 };
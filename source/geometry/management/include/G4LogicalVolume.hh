@@ -73,6 +73,10 @@
 //    - Pointer (possibly 0) to user Step limit object for this node.
 //    G4SmartVoxelHeader* fVoxel
 //    - Pointer (possibly 0) to optimisation info objects.
+//    G4SafetyGrid* fSafetyGrid
+//    - Pointer (possibly 0) to the grid of safety lower bounds.
+//    G4int fSafetyGridResolution
+//    - Number of cells of the safety grid along its longest side.
 //    G4bool fOptimise
 //    - Flag to identify if optimisation should be applied or not.
 //    G4bool fRootRegion
@@ -130,6 +134,7 @@ class G4VSensitiveDetector;
 class G4VSolid;
 class G4UserLimits;
 class G4SmartVoxelHeader;
+class G4SafetyGrid;
 class G4VisAttributes;
 class G4FastSimulationManager;
 class G4MaterialCutsCouple;
@@ -294,6 +299,18 @@ class G4LogicalVolume
     inline G4SmartVoxelHeader* GetVoxelHeader() const;
     inline void SetVoxelHeader(G4SmartVoxelHeader *pVoxel);
       // Gets and sets current VoxelHeader.
+
+    inline G4SafetyGrid* GetSafetyGrid() const;
+    inline void SetSafetyGrid(G4SafetyGrid* pGrid);
+      // Gets and sets the grid of lower bounds of the safety, used by
+      // the navigator in place of the exact computation when the bound
+      // is large enough.
+    inline G4int GetSafetyGridResolution() const;
+    inline void SetSafetyGridResolution(G4int nCells);
+      // Gets and sets the number of cells along the longest side of the
+      // safety grid built for this volume when closing the geometry;
+      // zero (default) means no grid. The grid is built only for volumes
+      // whose daughters are all placements.
     
     inline G4double GetSmartless() const;
     inline void SetSmartless(G4double s);
@@ -406,6 +423,10 @@ class G4LogicalVolume
       // Pointer (possibly 0) to user Step limit object for this node.
     G4SmartVoxelHeader* fVoxel;
       // Pointer (possibly 0) to optimisation info objects.
+    G4SafetyGrid* fSafetyGrid;
+      // Pointer (possibly 0) to the grid of safety lower bounds.
+    G4int fSafetyGridResolution;
+      // Number of cells of the safety grid along its longest side.
     G4bool fOptimise;
       // Flag to identify if optimisation should be applied or not.
     G4bool fRootRegion;
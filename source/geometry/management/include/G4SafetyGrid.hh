@@ -0,0 +1,110 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// $Id:$
+//
+// --------------------------------------------------------------------
+// GEANT 4 class header file
+//
+// G4SafetyGrid
+//
+// Class description:
+//
+// Regular grid of lower bounds of the isotropic safety, spanning the
+// bounding box of a logical volume whose daughters are all placements.
+// The value held by a cell is the safety at the cell centre, as computed
+// by the mother and daughter solids, reduced by the half diagonal of the
+// cell: since the distance to the nearest boundary varies at most as
+// fast as the point moves, it is a lower bound of the safety at any
+// point of the cell.
+// Cells are filled on first use, so that only the regions actually
+// visited by tracks are computed; filling is thread-safe and cells
+// computed by one thread are shared by all the others.
+// Grids are owned by G4GeometryManager, which creates them when closing
+// the geometry for the logical volumes with a non-zero resolution set.
+
+// History:
+// - Created. 19/Oct/2018
+// --------------------------------------------------------------------
+
+#ifndef G4SAFETYGRID_HH
+#define G4SAFETYGRID_HH
+
+#include <vector>
+#include <atomic>
+
+#include "G4Types.hh"
+#include "G4ThreeVector.hh"
+#include "G4AffineTransform.hh"
+
+class G4LogicalVolume;
+
+class G4SafetyGrid
+{
+  public:  // with description
+
+    G4SafetyGrid(G4LogicalVolume* pVolume, G4int nCells);
+      // Constructor, taking the mother logical volume and the number of
+      // cells along the longest side of its bounding box. The grid is
+      // empty until queried.
+   ~G4SafetyGrid();
+      // Destructor.
+
+    inline G4double GetSafety(const G4ThreeVector& localPoint);
+      // Returns a lower bound of the isotropic safety at the given point,
+      // in the reference frame of the mother volume. Points outside the
+      // grid get zero.
+    inline G4double GetCellHalfDiagonal() const;
+      // Returns the half diagonal of a cell, i.e. the largest amount by
+      // which the bound can underestimate the safety at the cell centre.
+
+    inline G4int GetNoCells() const;
+    G4int GetNoFilledCells() const;
+      // Return the total number of cells and those filled so far.
+
+    G4SafetyGrid(const G4SafetyGrid&) = delete;
+    G4SafetyGrid& operator=(const G4SafetyGrid&) = delete;
+
+  private:
+
+    G4double ComputeCell(G4int index);
+      // Computes the bound for the cell with the given index and stores it.
+
+  private:
+
+    G4LogicalVolume* fVolume;
+    std::vector<G4AffineTransform> fDaughterTransforms;
+      // Transformations from the mother to the daughters frames.
+    std::vector<std::atomic<G4float>> fCells;
+      // Bounds of the cells; negative values mark cells not yet computed.
+    G4ThreeVector fMin, fCellSize;
+    G4int fNx, fNy, fNz;
+    G4double fInvCellX, fInvCellY, fInvCellZ;
+    G4double fHalfDiagonal;
+};
+
+#include "G4SafetyGrid.icc"
+
+#endif
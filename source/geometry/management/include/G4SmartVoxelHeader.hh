@@ -63,6 +63,7 @@
 #include "G4SmartVoxelNode.hh"
 
 #include <vector>
+#include <iostream>
 
 // Forward declarations
 class G4LogicalVolume;
@@ -114,6 +115,14 @@ class G4SmartVoxelHeader
     G4bool AllSlicesEqual() const;
       // True if all slices equal (after collection).
 
+    G4bool Store(std::ostream& out) const;
+      // Writes the header, with its nodes and sub-headers, to the binary
+      // stream. Slices sharing a node or header are written once.
+    static G4SmartVoxelHeader* Retrieve(std::istream& in, G4int nVolumes);
+      // Creates a header from the binary stream, as written by Store().
+      // Returns 0 if the data are invalid or incomplete, or if a node
+      // refers to a volume number outside [0,nVolumes).
+
   public:  // without description
 
     G4bool operator == (const G4SmartVoxelHeader& pHead) const;
@@ -132,6 +141,13 @@ class G4SmartVoxelHeader
 
   protected:
 
+    G4SmartVoxelHeader();
+      // Constructor for an empty header, filled by Retrieve().
+
+    static G4SmartVoxelHeader* Retrieve(std::istream& in, G4int nVolumes,
+                                        G4int depth);
+      // Retrieves a header at the given depth of refinement.
+
     //  `Worker' / operation functions:
 
     void BuildVoxels(G4LogicalVolume* pVolume);
@@ -54,7 +54,8 @@ class G4SmartVoxelStat
     G4SmartVoxelStat( const G4LogicalVolume *theVolume,
                       const G4SmartVoxelHeader *theVoxel,
                             G4double theSysTime,
-                            G4double theUserTime );
+                            G4double theUserTime,
+                            G4double theRealTime = 0.0 );
       // Construct information on one volume's voxels
 
     const G4LogicalVolume *GetVolume() const;
@@ -71,6 +72,9 @@ class G4SmartVoxelStat
   
     G4double GetTotalTime() const;
       // Get total amount of CPU time needed to build voxels
+
+    G4double GetRealTime() const;
+      // Get elapsed real time needed to build voxels
   
     G4long GetNumberHeads() const;
       // Get number of voxel headers used in the volume
@@ -94,6 +98,7 @@ class G4SmartVoxelStat
   
     G4double sysTime;
     G4double userTime;
+    G4double realTime;
   
     G4long heads;
     G4long nodes;
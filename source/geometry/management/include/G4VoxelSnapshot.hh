@@ -0,0 +1,98 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// $Id:$
+//
+// --------------------------------------------------------------------
+// GEANT 4 class header file
+//
+// G4VoxelSnapshot
+//
+// Class description:
+//
+// Binary file holding the smart voxels of the logical volumes of a
+// geometry, so that repeated jobs with the same geometry retrieve them
+// instead of computing them again when closing the geometry.
+// Only volumes whose daughters are all placements are stored; voxels of
+// volumes with a replicated or parameterised daughter are always built.
+// Each volume is stored with a digest of its content (daughters with
+// their positions, the parameters and the extent of their solids); the
+// file is rejected as a whole if the volumes of the geometry do not
+// match those stored. The file starts with an identifier, a format
+// version, a byte order mark and the voxel constants of voxeldefs.hh,
+// data being written in the native representation.
+
+// History:
+// - Created. 19/Oct/2018
+// --------------------------------------------------------------------
+
+#ifndef G4VOXELSNAPSHOT_HH
+#define G4VOXELSNAPSHOT_HH
+
+#include <vector>
+#include <cstdint>
+
+#include "G4Types.hh"
+#include "G4String.hh"
+
+class G4LogicalVolume;
+class G4SmartVoxelHeader;
+
+class G4VoxelSnapshot
+{
+  public:  // with description
+
+    G4VoxelSnapshot(const G4String& fileName);
+      // Constructor, taking the name of the file.
+   ~G4VoxelSnapshot();
+      // Destructor.
+
+    G4bool Store(G4bool allOpts) const;
+      // Writes the voxels of the volumes in the logical volume store;
+      // allOpts is the optimisation flag the voxels were built with.
+      // The file is first written under a temporary name and renamed
+      // when complete. Returns false in case of failure.
+
+    G4bool Retrieve(G4bool allOpts,
+                    std::vector<G4SmartVoxelHeader*>& heads) const;
+      // Reads the voxels stored for the given optimisation flag, indexed
+      // as the logical volume store (null for volumes not stored).
+      // Returns false, with no headers, if the file is missing, invalid
+      // or does not match the geometry.
+
+    static G4bool IsStorable(const G4LogicalVolume* pVolume);
+      // Returns true if the voxels of the volume can be stored.
+
+  private:
+
+    static std::uint64_t Digest(const G4LogicalVolume* pVolume);
+      // Computes the digest of the content of the volume.
+
+  private:
+
+    G4String fFileName;
+};
+
+#endif
@@ -58,6 +58,8 @@ GEANT4_DEFINE_MODULE(NAME G4geometrymng
         G4Region.hh
         G4Region.icc
         G4RegionStore.hh
+        G4SafetyGrid.hh
+        G4SafetyGrid.icc
         G4ScaleTransform.hh
         G4ScaleTransform.icc
         G4SmartVoxelHeader.hh
@@ -85,6 +87,7 @@ GEANT4_DEFINE_MODULE(NAME G4geometrymng
         G4VVolumeMaterialScanner.hh
         G4VoxelLimits.hh
         G4VoxelLimits.icc
+        G4VoxelSnapshot.hh
         geomwdefs.hh
         meshdefs.hh
         voxeldefs.hh
@@ -107,6 +110,7 @@ GEANT4_DEFINE_MODULE(NAME G4geometrymng
         G4ReflectedSolid.cc
         G4Region.cc
         G4RegionStore.cc
+        G4SafetyGrid.cc
         G4SmartVoxelHeader.cc
         G4SmartVoxelNode.cc
         G4SmartVoxelProxy.cc
@@ -120,6 +124,7 @@ GEANT4_DEFINE_MODULE(NAME G4geometrymng
         G4VSolid.cc
         G4VTouchable.cc
         G4VoxelLimits.cc
+        G4VoxelSnapshot.cc
     GRANULAR_DEPENDENCIES
         G4globman
         G4graphics_reps
@@ -35,7 +35,10 @@
 // --------------------------------------------------------------------
 
 #include <iomanip>
+#include <algorithm>
+#include <atomic>
 #include "G4Timer.hh"
+#include "G4Threading.hh"
 #include "G4GeometryManager.hh"
 #include "G4SystemOfUnits.hh"
 
@@ -46,8 +49,11 @@
 // Needed for building optimisations
 //
 #include "G4LogicalVolumeStore.hh"
+#include "G4LogicalVolume.hh"
 #include "G4VPhysicalVolume.hh"
 #include "G4SmartVoxelHeader.hh"
+#include "G4SafetyGrid.hh"
+#include "G4VoxelSnapshot.hh"
 #include "voxeldefs.hh"
 
 // Needed for setting the extent for tolerance value
@@ -68,6 +74,7 @@ G4ThreadLocal G4bool G4GeometryManager::fIsClosed = false;
 // ***************************************************************************
 //
 G4GeometryManager::G4GeometryManager() 
+  : fNumberOfThreads(1)
 {
 }
 
@@ -97,10 +104,15 @@ G4bool G4GeometryManager::CloseGeometry(G4bool pOptimise, G4bool verbose,
     {
       BuildOptimisations(pOptimise, pVolume);
     }
-    else
+    else if (fOptimisationFile.empty())
     {
       BuildOptimisations(pOptimise, verbose);
     }
+    else if (!RetrieveOptimisations(pOptimise, verbose))
+    {
+      BuildOptimisations(pOptimise, verbose);
+      G4VoxelSnapshot(fOptimisationFile).Store(pOptimise);
+    }
     fIsClosed=true;
   }
   return true;
@@ -160,6 +172,53 @@ G4GeometryManager* G4GeometryManager::GetInstanceIfExist()
   return fgInstance;
 }
 
+// ***************************************************************************
+// Sets/returns the number of threads used for building the optimisation.
+// ***************************************************************************
+//
+void G4GeometryManager::SetNumberOfOptimisationThreads(G4int nThreads)
+{
+  if (nThreads < 0)
+  {
+    std::ostringstream message;
+    message << "Invalid number of threads: " << nThreads << G4endl
+            << "Number of threads must be positive, or 0 for all cores.";
+    G4Exception("G4GeometryManager::SetNumberOfOptimisationThreads()",
+                "GeomMgt1001", JustWarning, message);
+    return;
+  }
+  fNumberOfThreads = nThreads;
+}
+
+G4int G4GeometryManager::GetNumberOfOptimisationThreads() const
+{
+  return fNumberOfThreads;
+}
+
+// ***************************************************************************
+// Sets/gets the file storing the voxel optimisation across jobs.
+// ***************************************************************************
+//
+void G4GeometryManager::SetOptimisationFile(const G4String& fileName)
+{
+  fOptimisationFile = fileName;
+}
+
+const G4String& G4GeometryManager::GetOptimisationFile() const
+{
+  return fOptimisationFile;
+}
+
+// ***************************************************************************
+// Rebuilds the grid of safety lower bounds of a logical volume, after its
+// resolution has been changed with the geometry already closed.
+// ***************************************************************************
+//
+void G4GeometryManager::UpdateSafetyGrid(G4LogicalVolume* lv)
+{
+  if (fIsClosed)  { BuildSafetyGrid(lv); }
+}
+
 // ***************************************************************************
 // Creates optimisation info. Builds all voxels if allOpts=true
 // otherwise it builds voxels only for replicated volumes.
@@ -167,6 +226,16 @@ G4GeometryManager* G4GeometryManager::GetInstanceIfExist()
 //
 void G4GeometryManager::BuildOptimisations(G4bool allOpts, G4bool verbose)
 {
+#ifdef G4MULTITHREADED
+   G4int nThreads = (fNumberOfThreads > 0) ? fNumberOfThreads
+                                           : G4Threading::G4GetNumberOfCores();
+   if ((nThreads > 1) && G4Threading::IsMasterThread())
+   {
+     BuildOptimisationsParallel(allOpts, verbose, nThreads);
+     return;
+   }
+#endif
+
    G4Timer timer;
    G4Timer allTimer;
    std::vector<G4SmartVoxelStat> stats;
@@ -186,6 +255,7 @@ void G4GeometryManager::BuildOptimisations(G4bool allOpts, G4bool verbose)
      head = volume->GetVoxelHeader();
      delete head;
      volume->SetVoxelHeader(0);
+     BuildSafetyGrid(volume);
      if (    ( (volume->IsToOptimise())
             && (volume->GetNoDaughters()>=kMinVoxelVolumesLevel1&&allOpts) )
           || ( (volume->GetNoDaughters()==1)
@@ -216,7 +286,8 @@ void G4GeometryManager::BuildOptimisations(G4bool allOpts, G4bool verbose)
          timer.Stop();
          stats.push_back( G4SmartVoxelStat( volume, head,
                                             timer.GetSystemElapsed(),
-                                            timer.GetUserElapsed() ) );
+                                            timer.GetUserElapsed(),
+                                            timer.GetRealElapsed() ) );
        }
      }
      else
@@ -233,10 +304,141 @@ void G4GeometryManager::BuildOptimisations(G4bool allOpts, G4bool verbose)
   {
      allTimer.Stop();
      ReportVoxelStats( stats, allTimer.GetSystemElapsed()
-                            + allTimer.GetUserElapsed() );
+                            + allTimer.GetUserElapsed(),
+                       allTimer.GetRealElapsed() );
   }
 }
 
+// ***************************************************************************
+// Creates optimisation info as BuildOptimisations(allOpts, verbose), sharing
+// the construction of the voxel headers among nThreads threads.
+// Volumes whose daughters are all placements are independent of each other
+// and are voxelised concurrently, largest first. Volumes holding a replica
+// or parameterised daughter are voxelised beforehand on the calling thread,
+// since their voxelisation updates the transformation of the daughter and
+// possibly solids shared with other volumes.
+// Headers are attached to the volumes on the calling thread, once all
+// threads have completed.
+// ***************************************************************************
+//
+void G4GeometryManager::BuildOptimisationsParallel(G4bool allOpts,
+                                                   G4bool verbose,
+                                                   G4int nThreads)
+{
+   G4Timer timer;
+   G4Timer allTimer;
+   std::vector<G4SmartVoxelStat> stats;
+   if (verbose)  { allTimer.Start(); }
+
+   G4LogicalVolumeStore* Store = G4LogicalVolumeStore::GetInstance();
+   std::vector<G4LogicalVolume*> volumes;
+   G4LogicalVolume* volume;
+   G4SmartVoxelHeader* head;
+
+   for (size_t n=0; n<Store->size(); ++n)
+   {
+     volume=(*Store)[n];
+     head = volume->GetVoxelHeader();
+     delete head;
+     volume->SetVoxelHeader(0);
+     BuildSafetyGrid(volume);
+
+     G4bool replicated = (volume->GetNoDaughters()==1)
+                      && (volume->GetDaughter(0)->IsReplicated()==true);
+     if (    ( (volume->IsToOptimise())
+            && (volume->GetNoDaughters()>=kMinVoxelVolumesLevel1&&allOpts) )
+          || ( replicated
+            && (volume->GetDaughter(0)->GetRegularStructureId()!=1) ) )
+     {
+       if (!replicated)
+       {
+         volumes.push_back(volume);
+         continue;
+       }
+       if (verbose) timer.Start();
+       head = new G4SmartVoxelHeader(volume);
+       volume->SetVoxelHeader(head);
+       if (verbose)
+       {
+         timer.Stop();
+         stats.push_back( G4SmartVoxelStat( volume, head,
+                                            timer.GetSystemElapsed(),
+                                            timer.GetUserElapsed(),
+                                            timer.GetRealElapsed() ) );
+       }
+     }
+   }
+
+   std::sort(volumes.begin(), volumes.end(),
+             [](const G4LogicalVolume* a, const G4LogicalVolume* b)
+             { return a->GetNoDaughters() > b->GetNoDaughters(); });
+
+   const size_t nVolumes = volumes.size();
+   std::vector<G4SmartVoxelHeader*> heads(nVolumes, 0);
+   std::vector<G4double> realTimes(nVolumes, 0.0);
+   std::atomic<size_t> next(0);
+
+   auto buildHeaders = [&](G4bool helper)
+   {
+     if (helper)
+     {
+       // Helper threads need their own copy of the per-thread data of
+       // volumes (solids and transformations) as set on the master
+       //
+       const_cast<G4LVManager&>(G4LogicalVolume::GetSubInstanceManager())
+         .SlaveCopySubInstanceArray();
+       const_cast<G4PVManager&>(G4VPhysicalVolume::GetSubInstanceManager())
+         .SlaveCopySubInstanceArray();
+     }
+     G4Timer volTimer;
+     for (size_t i=next++; i<nVolumes; i=next++)
+     {
+       volTimer.Start();
+       heads[i] = new G4SmartVoxelHeader(volumes[i]);
+       volTimer.Stop();
+       realTimes[i] = volTimer.GetRealElapsed();
+     }
+     if (helper)
+     {
+       G4LogicalVolume::Clean();
+       G4VPhysicalVolume::Clean();
+     }
+   };
+
+   G4int nUsed = (nVolumes < size_t(nThreads)) ? G4int(nVolumes) : nThreads;
+   std::vector<G4Thread> helpers;
+   for (G4int t=1; t<nUsed; ++t)
+   {
+     helpers.push_back(G4Thread(buildHeaders, true));
+   }
+   buildHeaders(false);
+   for (size_t t=0; t<helpers.size(); ++t)
+   {
+     G4THREADJOIN(helpers[t]);
+   }
+
+   for (size_t i=0; i<nVolumes; ++i)
+   {
+     volumes[i]->SetVoxelHeader(heads[i]);
+     if (verbose)
+     {
+       // CPU time used by a single thread is not available from the
+       // process timers: the elapsed real time is reported instead
+       //
+       stats.push_back( G4SmartVoxelStat( volumes[i], heads[i], 0.0,
+                                          realTimes[i], realTimes[i] ) );
+     }
+   }
+
+   if (verbose)
+   {
+     allTimer.Stop();
+     ReportVoxelStats( stats, allTimer.GetSystemElapsed()
+                            + allTimer.GetUserElapsed(),
+                       allTimer.GetRealElapsed(), (nUsed>1) ? nUsed : 1 );
+   }
+}
+
 // ***************************************************************************
 // Creates optimisation info for the specified volumes subtree.
 // ***************************************************************************
@@ -255,6 +457,7 @@ void G4GeometryManager::BuildOptimisations(G4bool allOpts,
    G4SmartVoxelHeader* head = tVolume->GetVoxelHeader();
    delete head;
    tVolume->SetVoxelHeader(0);
+   BuildSafetyGrid(tVolume);
    if (    ( (tVolume->IsToOptimise())
           && (tVolume->GetNoDaughters()>=kMinVoxelVolumesLevel1&&allOpts) )
         || ( (tVolume->GetNoDaughters()==1)
@@ -308,6 +511,7 @@ void G4GeometryManager::DeleteOptimisations()
     tVolume=(*Store)[n];
     delete tVolume->GetVoxelHeader();
     tVolume->SetVoxelHeader(0);
+    DeleteSafetyGrid(tVolume);
   }
 }
 
@@ -327,6 +531,7 @@ void G4GeometryManager::DeleteOptimisations(G4VPhysicalVolume* pVolume)
   if (!tVolume) { return DeleteOptimisations(); }
   delete tVolume->GetVoxelHeader();
   tVolume->SetVoxelHeader(0);
+  DeleteSafetyGrid(tVolume);
 
   // Scan recursively the associated logical volume tree
   //
@@ -337,6 +542,96 @@ void G4GeometryManager::DeleteOptimisations(G4VPhysicalVolume* pVolume)
   }
 }
 
+// ***************************************************************************
+// Creates optimisation info as BuildOptimisations(allOpts, verbose), taking
+// the voxels stored in the optimisation file. Voxels of volumes not stored,
+// i.e. holding a replicated or parameterised daughter, are built.
+// Returns false, leaving the volumes untouched, if the file is missing or
+// does not match the geometry.
+// ***************************************************************************
+//
+G4bool G4GeometryManager::RetrieveOptimisations(G4bool allOpts,
+                                                G4bool verbose)
+{
+   G4Timer timer;
+   if (verbose)  { timer.Start(); }
+
+   std::vector<G4SmartVoxelHeader*> heads;
+   if (!G4VoxelSnapshot(fOptimisationFile).Retrieve(allOpts, heads))
+   {
+     return false;
+   }
+
+   G4LogicalVolumeStore* Store = G4LogicalVolumeStore::GetInstance();
+   G4LogicalVolume* volume;
+   G4SmartVoxelHeader* head;
+   G4int nRetrieved = 0, nBuilt = 0;
+
+   for (size_t n=0; n<Store->size(); ++n)
+   {
+     volume=(*Store)[n];
+     head = volume->GetVoxelHeader();
+     delete head;
+     volume->SetVoxelHeader(0);
+     BuildSafetyGrid(volume);
+     if (    ( (volume->IsToOptimise())
+            && (volume->GetNoDaughters()>=kMinVoxelVolumesLevel1&&allOpts) )
+          || ( (volume->GetNoDaughters()==1)
+            && (volume->GetDaughter(0)->IsReplicated()==true)
+            && (volume->GetDaughter(0)->GetRegularStructureId()!=1) ) )
+     {
+       if (heads[n])
+       {
+         volume->SetVoxelHeader(heads[n]);
+         heads[n] = 0;
+         ++nRetrieved;
+       }
+       else
+       {
+         volume->SetVoxelHeader(new G4SmartVoxelHeader(volume));
+         ++nBuilt;
+       }
+     }
+     delete heads[n];
+   }
+
+   if (verbose)
+   {
+     timer.Stop();
+     G4cout << "G4GeometryManager::RetrieveOptimisations()" << G4endl
+            << "    Voxels of " << nRetrieved << " volumes retrieved from "
+            << fOptimisationFile << ", " << nBuilt << " built, in "
+            << timer.GetRealElapsed() << " s" << G4endl;
+   }
+   return true;
+}
+
+// ***************************************************************************
+// Creates the grid of safety lower bounds for the logical volume, if a
+// resolution is set and its daughters are all placements, replacing any
+// existing one. Cells are computed later, when first queried.
+// ***************************************************************************
+//
+void G4GeometryManager::BuildSafetyGrid(G4LogicalVolume* lv)
+{
+  DeleteSafetyGrid(lv);
+  if ( (lv->GetSafetyGridResolution() > 0)
+    && (lv->CharacteriseDaughters() == kNormal) )
+  {
+    lv->SetSafetyGrid(new G4SafetyGrid(lv, lv->GetSafetyGridResolution()));
+  }
+}
+
+// ***************************************************************************
+// Deletes the grid of safety lower bounds of the logical volume, if any.
+// ***************************************************************************
+//
+void G4GeometryManager::DeleteSafetyGrid(G4LogicalVolume* lv)
+{
+  delete lv->GetSafetyGrid();
+  lv->SetSafetyGrid(0);
+}
+
 // ***************************************************************************
 // Sets the maximum extent of the world volume. The operation is allowed only
 // if NO solids have been created already.
@@ -362,7 +657,9 @@ void G4GeometryManager::SetWorldMaximumExtent(G4double extent)
 //
 void
 G4GeometryManager::ReportVoxelStats( std::vector<G4SmartVoxelStat> & stats,
-                                     G4double totalCpuTime )
+                                     G4double totalCpuTime,
+                                     G4double totalRealTime,
+                                     G4int nThreads )
 {
   G4cout << "G4GeometryManager::ReportVoxelStats -- Voxel Statistics"
          << G4endl << G4endl;
@@ -380,6 +677,14 @@ G4GeometryManager::ReportVoxelStats( std::vector<G4SmartVoxelStat> & stats,
   G4cout << "    Total CPU time elapsed for geometry optimisation: " 
          << std::setprecision(2) << totalCpuTime << " seconds"
          << std::setprecision(6) << G4endl;
+  G4cout << "    Total real time elapsed for geometry optimisation: "
+         << std::setprecision(2) << totalRealTime << " seconds"
+         << std::setprecision(6) << G4endl;
+  if (nThreads > 1)
+  {
+    G4cout << "    Voxels built concurrently by " << nThreads
+           << " threads; CPU time per volume is its real time." << G4endl;
+  }
  
   //
   // First list: sort by total CPU time
@@ -391,10 +696,10 @@ G4GeometryManager::ReportVoxelStats( std::vector<G4SmartVoxelStat> & stats,
   if (nPrint)
   {
     G4cout << "\n    Voxelisation: top CPU users:" << G4endl;
-    G4cout << "    Percent   Total CPU    System CPU       Memory  Volume\n"
-           << "    -------   ----------   ----------     --------  ----------"
+    G4cout << "    Percent   Total CPU    System CPU    Real time       Memory  Volume\n"
+           << "    -------   ----------   ----------   ----------     --------  ----------"
            << G4endl;
-    //         12345678901.234567890123.234567890123.234567890123k .
+    //         12345678901.234567890123.234567890123.234567890123.234567890123k .
   }
 
   for(i=0;i<nPrint;++i)
@@ -414,6 +719,7 @@ G4GeometryManager::ReportVoxelStats( std::vector<G4SmartVoxelStat> & stats,
            << std::setw(11) << perc
            << std::setw(13) << total
            << std::setw(13) << system
+           << std::setw(13) << stats[i].GetRealTime()
            << std::setw(13) << (stats[i].GetMemoryUse()+512)/1024
            << "k " << std::setiosflags(std::ios::left)
            << stats[i].GetVolume()->GetName()
@@ -0,0 +1,171 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// $Id:$
+//
+// class G4SafetyGrid Implementation
+//
+// --------------------------------------------------------------------
+
+#include <cmath>
+
+#include "G4SafetyGrid.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4GeometryTolerance.hh"
+
+namespace
+{
+  const G4int kMaxCellsPerAxis = 256;
+}
+
+// ********************************************************************
+// Constructor
+//
+// Lays out the cells over the bounding box of the mother solid, with
+// nCells cells along its longest side, and caches the transformations
+// of the daughters.
+// ********************************************************************
+//
+G4SafetyGrid::G4SafetyGrid(G4LogicalVolume* pVolume, G4int nCells)
+  : fVolume(pVolume), fNx(1), fNy(1), fNz(1),
+    fInvCellX(0.), fInvCellY(0.), fInvCellZ(0.), fHalfDiagonal(0.)
+{
+  if (nCells > kMaxCellsPerAxis)
+  {
+    std::ostringstream message;
+    message << "Resolution too high for volume " << pVolume->GetName()
+            << ": " << nCells << " cells requested." << G4endl
+            << "Resolution limited to " << kMaxCellsPerAxis << " cells.";
+    G4Exception("G4SafetyGrid::G4SafetyGrid()", "GeomMgt1002",
+                JustWarning, message);
+    nCells = kMaxCellsPerAxis;
+  }
+  if (nCells < 1)  { nCells = 1; }
+
+  G4ThreeVector pMax;
+  pVolume->GetSolid()->BoundingLimits(fMin, pMax);
+  const G4ThreeVector extent = pMax - fMin;
+  const G4double maxExtent = std::max(extent.x(),
+                                      std::max(extent.y(), extent.z()));
+  if (maxExtent > 0)
+  {
+    const G4double size = maxExtent/nCells;
+    fNx = std::max(1, G4int(std::ceil(extent.x()/size - 1.e-9)));
+    fNy = std::max(1, G4int(std::ceil(extent.y()/size - 1.e-9)));
+    fNz = std::max(1, G4int(std::ceil(extent.z()/size - 1.e-9)));
+    fCellSize.set(extent.x()/fNx, extent.y()/fNy, extent.z()/fNz);
+    if (fCellSize.x() > 0)  { fInvCellX = 1./fCellSize.x(); }
+    if (fCellSize.y() > 0)  { fInvCellY = 1./fCellSize.y(); }
+    if (fCellSize.z() > 0)  { fInvCellZ = 1./fCellSize.z(); }
+    fHalfDiagonal = 0.5*fCellSize.mag();
+  }
+
+  std::vector<std::atomic<G4float>> cells(fNx*fNy*fNz);
+  fCells.swap(cells);
+  for (size_t i=0; i<fCells.size(); ++i)
+  {
+    fCells[i].store(-1.f, std::memory_order_relaxed);
+  }
+
+  const G4int nDaughters = pVolume->GetNoDaughters();
+  fDaughterTransforms.reserve(nDaughters);
+  for (G4int i=0; i<nDaughters; ++i)
+  {
+    const G4VPhysicalVolume* daughter = pVolume->GetDaughter(i);
+    G4AffineTransform tf(daughter->GetRotation(),
+                         daughter->GetTranslation());
+    tf.Invert();
+    fDaughterTransforms.push_back(tf);
+  }
+}
+
+// ********************************************************************
+// Destructor
+// ********************************************************************
+//
+G4SafetyGrid::~G4SafetyGrid()
+{
+}
+
+// ********************************************************************
+// GetNoFilledCells
+// ********************************************************************
+//
+G4int G4SafetyGrid::GetNoFilledCells() const
+{
+  G4int nFilled = 0;
+  for (size_t i=0; i<fCells.size(); ++i)
+  {
+    if (fCells[i].load(std::memory_order_relaxed) >= 0)  { ++nFilled; }
+  }
+  return nFilled;
+}
+
+// ********************************************************************
+// ComputeCell
+//
+// The safety at the centre is the smallest of the distance to the
+// mother surface and the distances to the daughters; it is null if
+// the centre lies outside the mother or within a daughter.
+// Concurrent threads may compute the same cell, in which case they
+// store identical values.
+// ********************************************************************
+//
+G4double G4SafetyGrid::ComputeCell(G4int index)
+{
+  const G4int ix = index % fNx;
+  const G4int iy = (index / fNx) % fNy;
+  const G4int iz = index / (fNx*fNy);
+  const G4ThreeVector centre(fMin.x() + (ix + 0.5)*fCellSize.x(),
+                             fMin.y() + (iy + 0.5)*fCellSize.y(),
+                             fMin.z() + (iz + 0.5)*fCellSize.z());
+  const G4double threshold = fHalfDiagonal
+    + G4GeometryTolerance::GetInstance()->GetSurfaceTolerance();
+
+  G4double safety = 0.;
+  const G4VSolid* motherSolid = fVolume->GetSolid();
+  if (motherSolid->Inside(centre) == kInside)
+  {
+    safety = motherSolid->DistanceToOut(centre);
+    const G4int nDaughters = G4int(fDaughterTransforms.size());
+    for (G4int i=0; i<nDaughters && safety>threshold; ++i)
+    {
+      const G4VSolid* daughterSolid =
+        fVolume->GetDaughter(i)->GetLogicalVolume()->GetSolid();
+      const G4double daughterSafety = daughterSolid
+        ->DistanceToIn(fDaughterTransforms[i].TransformPoint(centre));
+      if (daughterSafety < safety)  { safety = daughterSafety; }
+    }
+  }
+
+  G4double bound = safety - threshold;
+  if (bound < 0.)  { bound = 0.; }
+  G4float value = G4float(bound);
+  if (value > bound)  { value = std::nextafter(value, 0.f); }
+  fCells[index].store(value, std::memory_order_relaxed);
+  return value;
+}
@@ -42,6 +42,8 @@
 // 14.07.95 Initial version - stubb definitions only
 // --------------------------------------------------------------------
 
+#include <algorithm>
+
 #include "G4SmartVoxelHeader.hh"
 
 #include "G4ios.hh"
@@ -55,6 +57,23 @@
 #include "G4VSolid.hh"
 #include "G4VPVParameterisation.hh"
 
+namespace
+{
+  // Tags identifying the contents of a slice in a stored header
+  //
+  enum { kSharedSlice = 0, kNodeSlice = 1, kHeaderSlice = 2 };
+
+  template <class T> inline void PutValue(std::ostream& out, const T& value)
+  {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <class T> inline G4bool GetValue(std::istream& in, T& value)
+  {
+    return in.read(reinterpret_cast<char*>(&value), sizeof(T)).good();
+  }
+}
+
 // ***************************************************************************
 // Constructor for topmost header, to begin voxel construction at a
 // given logical volume.
@@ -119,6 +138,17 @@ G4SmartVoxelHeader::G4SmartVoxelHeader(G4LogicalVolume* pVolume,
   BuildVoxelsWithinLimits(pVolume,pLimits,pCandidates);
 }
 
+// ***************************************************************************
+// Protected constructor:
+// creates an empty header, to be filled by Retrieve().
+// ***************************************************************************
+//
+G4SmartVoxelHeader::G4SmartVoxelHeader()
+  : fminEquivalent(0), fmaxEquivalent(0), faxis(kUndefined),
+    fparamAxis(kUndefined), fmaxExtent(0.), fminExtent(0.)
+{
+}
+
 // ***************************************************************************
 // Destructor:
 // deletes all proxies and underlying objects.
@@ -1297,6 +1327,152 @@ G4bool G4SmartVoxelHeader::AllSlicesEqual() const
   return true;
 }
 
+// ***************************************************************************
+// Writes the header to a binary stream: axes, equivalent slice numbers and
+// extent, then the slices in order. A slice sharing the proxy of the
+// previous one is written as a tag only; otherwise the node contents or
+// the sub-header follow the tag.
+// ***************************************************************************
+//
+G4bool G4SmartVoxelHeader::Store(std::ostream& out) const
+{
+  PutValue(out, G4int(faxis));
+  PutValue(out, G4int(fparamAxis));
+  PutValue(out, fminEquivalent);
+  PutValue(out, fmaxEquivalent);
+  PutValue(out, fminExtent);
+  PutValue(out, fmaxExtent);
+
+  const G4int nSlices = fslices.size();
+  PutValue(out, nSlices);
+  const G4SmartVoxelProxy* lastProxy = 0;
+  for (G4int i=0; i<nSlices; ++i)
+  {
+    const G4SmartVoxelProxy* proxy = fslices[i];
+    if (proxy == lastProxy)
+    {
+      PutValue(out, G4int(kSharedSlice));
+      continue;
+    }
+    lastProxy = proxy;
+    if (proxy->IsHeader())
+    {
+      PutValue(out, G4int(kHeaderSlice));
+      if (!proxy->GetHeader()->Store(out))  { return false; }
+    }
+    else
+    {
+      const G4SmartVoxelNode* node = proxy->GetNode();
+      const G4int nContained = node->GetNoContained();
+      PutValue(out, G4int(kNodeSlice));
+      PutValue(out, node->GetMinEquivalentSliceNo());
+      PutValue(out, node->GetMaxEquivalentSliceNo());
+      PutValue(out, nContained);
+      for (G4int k=0; k<nContained; ++k)
+      {
+        PutValue(out, node->GetVolume(k));
+      }
+    }
+  }
+  return out.good();
+}
+
+// ***************************************************************************
+// Creates a header from a binary stream, as written by Store().
+// ***************************************************************************
+//
+G4SmartVoxelHeader* G4SmartVoxelHeader::Retrieve(std::istream& in,
+                                                 G4int nVolumes)
+{
+  return Retrieve(in, nVolumes, 0);
+}
+
+// ***************************************************************************
+// Creates a header from a binary stream, checking the consistency of the
+// data read. The header is deleted and 0 returned at the first error.
+// Slices are at most kMaxVoxelNodes, or one per replica.
+// Refinement never exceeds three levels, so that a deeper nesting reveals
+// corrupted data.
+// ***************************************************************************
+//
+G4SmartVoxelHeader* G4SmartVoxelHeader::Retrieve(std::istream& in,
+                                                 G4int nVolumes,
+                                                 G4int depth)
+{
+  if (depth > 3)  { return 0; }
+
+  G4int axis, paramAxis, nSlices;
+  G4SmartVoxelHeader* head = new G4SmartVoxelHeader();
+  if ( !GetValue(in, axis) || !GetValue(in, paramAxis)
+    || !GetValue(in, head->fminEquivalent)
+    || !GetValue(in, head->fmaxEquivalent)
+    || !GetValue(in, head->fminExtent) || !GetValue(in, head->fmaxExtent)
+    || !GetValue(in, nSlices)
+    || (axis < kXAxis) || (axis > kUndefined)
+    || (paramAxis < kXAxis) || (paramAxis > kUndefined)
+    || (nSlices < 1) || (nSlices > std::max(kMaxVoxelNodes, nVolumes)) )
+  {
+    delete head;
+    return 0;
+  }
+  head->faxis = EAxis(axis);
+  head->fparamAxis = EAxis(paramAxis);
+  head->fslices.reserve(nSlices);
+
+  for (G4int i=0; i<nSlices; ++i)
+  {
+    G4int tag;
+    G4SmartVoxelProxy* proxy = 0;
+    if (!GetValue(in, tag))  { break; }
+    if (tag == kSharedSlice)
+    {
+      if (i > 0)  { proxy = head->fslices[i-1]; }
+    }
+    else if (tag == kHeaderSlice)
+    {
+      G4SmartVoxelHeader* subHead = Retrieve(in, nVolumes, depth+1);
+      if (subHead)  { proxy = new G4SmartVoxelProxy(subHead); }
+    }
+    else if (tag == kNodeSlice)
+    {
+      G4int minEquivalent, maxEquivalent, nContained, volume;
+      if ( GetValue(in, minEquivalent) && GetValue(in, maxEquivalent)
+        && GetValue(in, nContained)
+        && (nContained >= 0) && (nContained <= nVolumes) )
+      {
+        G4SmartVoxelNode* node = new G4SmartVoxelNode();
+        node->SetMinEquivalentSliceNo(minEquivalent);
+        node->SetMaxEquivalentSliceNo(maxEquivalent);
+        node->Reserve(nContained);
+        G4int k = 0;
+        for (; k<nContained; ++k)
+        {
+          if ( !GetValue(in, volume)
+            || (volume < 0) || (volume >= nVolumes) )  { break; }
+          node->Insert(volume);
+        }
+        if (k == nContained)
+        {
+          proxy = new G4SmartVoxelProxy(node);
+        }
+        else
+        {
+          delete node;
+        }
+      }
+    }
+    if (!proxy)  { break; }
+    head->fslices.push_back(proxy);
+  }
+
+  if (G4int(head->fslices.size()) != nSlices)
+  {
+    delete head;
+    return 0;
+  }
+  return head;
+}
+
 // ***************************************************************************
 // Streaming operator for debugging.
 // ***************************************************************************
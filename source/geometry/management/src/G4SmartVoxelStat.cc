@@ -49,11 +49,13 @@
 G4SmartVoxelStat::G4SmartVoxelStat( const G4LogicalVolume *theVolume,
                                     const G4SmartVoxelHeader *theVoxel,
                                           G4double theSysTime,
-                                          G4double theUserTime )
+                                          G4double theUserTime,
+                                          G4double theRealTime )
     : volume(theVolume),
       voxel(theVoxel),
       sysTime(theSysTime),
       userTime(theUserTime),
+      realTime(theRealTime),
       heads(1),
       nodes(0),
       pointers(0)
@@ -90,6 +92,11 @@ G4double G4SmartVoxelStat::GetTotalTime() const
   return sysTime + userTime;
 }
 
+G4double G4SmartVoxelStat::GetRealTime() const
+{
+  return realTime;
+}
+
 G4long G4SmartVoxelStat::GetNumberHeads() const
 {
   return heads;
@@ -0,0 +1,336 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// $Id:$
+//
+// class G4VoxelSnapshot Implementation
+//
+// --------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#if defined(WIN32)
+  #include <process.h>
+#else
+  #include <unistd.h>
+#endif
+
+#include "G4VoxelSnapshot.hh"
+#include "G4SmartVoxelHeader.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4VoxelLimits.hh"
+#include "G4AffineTransform.hh"
+#include "voxeldefs.hh"
+
+namespace
+{
+  const char kIdentifier[8] = { 'G','4','V','O','X','E','L','S' };
+  const G4int kVersion = 2;
+  const std::uint32_t kByteOrderMark = 0x01020304;
+
+  // Voxel optimisation constants the stored voxels were built with
+  //
+  const G4int kVoxelConstants[4] = { kMaxVoxelNodes, kMinVoxelVolumesLevel1,
+                                     kMinVoxelVolumesLevel2,
+                                     kMinVoxelVolumesLevel3 };
+
+  template <class T> inline void PutValue(std::ostream& out, const T& value)
+  {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <class T> inline G4bool GetValue(std::istream& in, T& value)
+  {
+    return in.read(reinterpret_cast<char*>(&value), sizeof(T)).good();
+  }
+
+  // 64 bits FNV-1a hash
+  //
+  inline void Hash(std::uint64_t& digest, const void* data, size_t size)
+  {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i=0; i<size; ++i)
+    {
+      digest ^= bytes[i];
+      digest *= 0x100000001b3ULL;
+    }
+  }
+
+  template <class T> inline void HashValue(std::uint64_t& digest, T value)
+  {
+    Hash(digest, &value, sizeof(T));
+  }
+
+  inline void HashString(std::uint64_t& digest, const G4String& s)
+  {
+    HashValue(digest, s.size());
+    Hash(digest, s.data(), s.size());
+  }
+
+  // Hashes the parameters of the solid, as printed by StreamInfo()
+  //
+  void HashSolid(std::uint64_t& digest, const G4VSolid* solid)
+  {
+    std::ostringstream os;
+    os.precision(17);
+    solid->StreamInfo(os);
+    HashString(digest, os.str());
+  }
+
+  void HashExtent(std::uint64_t& digest, const G4VSolid* solid,
+                  const G4AffineTransform& transform)
+  {
+    const G4VoxelLimits noLimits;
+    for (G4int axis=kXAxis; axis<=kZAxis; ++axis)
+    {
+      G4double emin = 0., emax = 0.;
+      solid->CalculateExtent(EAxis(axis), noLimits, transform, emin, emax);
+      HashValue(digest, emin);
+      HashValue(digest, emax);
+    }
+  }
+}
+
+// ********************************************************************
+// Constructor
+// ********************************************************************
+//
+G4VoxelSnapshot::G4VoxelSnapshot(const G4String& fileName)
+  : fFileName(fileName)
+{
+}
+
+// ********************************************************************
+// Destructor
+// ********************************************************************
+//
+G4VoxelSnapshot::~G4VoxelSnapshot()
+{
+}
+
+// ********************************************************************
+// IsStorable
+// ********************************************************************
+//
+G4bool G4VoxelSnapshot::IsStorable(const G4LogicalVolume* pVolume)
+{
+  return pVolume->CharacteriseDaughters() == kNormal;
+}
+
+// ********************************************************************
+// Digest
+//
+// Covers what the voxels are built from: the solid of the volume and
+// the daughters, with the parameters of their solids, their
+// transformation and the extent of their solid in the mother frame,
+// as well as the optimisation parameters.
+// ********************************************************************
+//
+std::uint64_t G4VoxelSnapshot::Digest(const G4LogicalVolume* pVolume)
+{
+  std::uint64_t digest = 0xcbf29ce484222325ULL;
+
+  const G4VSolid* solid = pVolume->GetSolid();
+  HashString(digest, solid->GetEntityType());
+  HashSolid(digest, solid);
+  HashExtent(digest, solid, G4AffineTransform());
+  HashValue(digest, pVolume->GetSmartless());
+  HashValue(digest, G4int(pVolume->IsToOptimise()));
+
+  const G4int nDaughters = pVolume->GetNoDaughters();
+  HashValue(digest, nDaughters);
+  for (G4int i=0; i<nDaughters; ++i)
+  {
+    const G4VPhysicalVolume* daughter = pVolume->GetDaughter(i);
+    const G4VSolid* daughterSolid = daughter->GetLogicalVolume()->GetSolid();
+    const G4RotationMatrix* rotation = daughter->GetRotation();
+    const G4ThreeVector translation = daughter->GetTranslation();
+
+    HashString(digest, daughter->GetName());
+    HashValue(digest, daughter->GetCopyNo());
+    HashString(digest, daughterSolid->GetEntityType());
+    HashSolid(digest, daughterSolid);
+    HashValue(digest, translation.x());
+    HashValue(digest, translation.y());
+    HashValue(digest, translation.z());
+    if (rotation)
+    {
+      HashValue(digest, rotation->xx());
+      HashValue(digest, rotation->xy());
+      HashValue(digest, rotation->xz());
+      HashValue(digest, rotation->yx());
+      HashValue(digest, rotation->yy());
+      HashValue(digest, rotation->yz());
+      HashValue(digest, rotation->zx());
+      HashValue(digest, rotation->zy());
+      HashValue(digest, rotation->zz());
+    }
+    HashExtent(digest, daughterSolid,
+               G4AffineTransform(rotation, translation));
+  }
+  return digest;
+}
+
+// ********************************************************************
+// Store
+// ********************************************************************
+//
+G4bool G4VoxelSnapshot::Store(G4bool allOpts) const
+{
+  // The temporary file is private to this process, so that jobs sharing
+  // the same file never publish or remove each other's partial output
+  //
+  std::ostringstream tmpStream;
+#if defined(WIN32)
+  tmpStream << fFileName << "." << _getpid() << ".tmp";
+#else
+  tmpStream << fFileName << "." << getpid() << ".tmp";
+#endif
+  const G4String tmpName = tmpStream.str();
+  std::ofstream out(tmpName, std::ios::out | std::ios::binary);
+  if (!out)
+  {
+    G4String message = "Cannot open file " + tmpName + " for writing.";
+    G4Exception("G4VoxelSnapshot::Store()", "GeomMgt1002",
+                JustWarning, message);
+    return false;
+  }
+
+  const G4LogicalVolumeStore* store = G4LogicalVolumeStore::GetInstance();
+  const G4int nVolumes = store->size();
+  std::vector<G4int> stored;
+  for (G4int n=0; n<nVolumes; ++n)
+  {
+    const G4LogicalVolume* volume = (*store)[n];
+    if (volume->GetVoxelHeader() && IsStorable(volume))
+    {
+      stored.push_back(n);
+    }
+  }
+
+  out.write(kIdentifier, sizeof(kIdentifier));
+  PutValue(out, kVersion);
+  PutValue(out, kByteOrderMark);
+  PutValue(out, kVoxelConstants);
+  PutValue(out, G4int(allOpts));
+  PutValue(out, nVolumes);
+  PutValue(out, G4int(stored.size()));
+
+  G4bool ok = out.good();
+  for (size_t i=0; (i<stored.size()) && ok; ++i)
+  {
+    const G4LogicalVolume* volume = (*store)[stored[i]];
+    const G4String& name = volume->GetName();
+    PutValue(out, stored[i]);
+    PutValue(out, G4int(name.size()));
+    out.write(name.data(), name.size());
+    PutValue(out, Digest(volume));
+    PutValue(out, volume->GetNoDaughters());
+    ok = volume->GetVoxelHeader()->Store(out);
+  }
+  out.close();
+  ok = ok && !out.fail();
+
+  if (!ok || std::rename(tmpName.c_str(), fFileName.c_str()) != 0)
+  {
+    std::remove(tmpName.c_str());
+    G4String message = "Failed writing voxels to file " + fFileName + " !";
+    G4Exception("G4VoxelSnapshot::Store()", "GeomMgt1002",
+                JustWarning, message);
+    return false;
+  }
+  return true;
+}
+
+// ********************************************************************
+// Retrieve
+// ********************************************************************
+//
+G4bool G4VoxelSnapshot::Retrieve(G4bool allOpts,
+                                 std::vector<G4SmartVoxelHeader*>& heads) const
+{
+  heads.clear();
+  std::ifstream in(fFileName, std::ios::in | std::ios::binary);
+  if (!in)  { return false; }
+
+  const G4LogicalVolumeStore* store = G4LogicalVolumeStore::GetInstance();
+  const G4int nVolumes = store->size();
+
+  char identifier[sizeof(kIdentifier)];
+  G4int version = 0, opts = 0, nStored = 0, nEntries = 0;
+  G4int constants[4] = { 0, 0, 0, 0 };
+  std::uint32_t byteOrderMark = 0;
+  in.read(identifier, sizeof(identifier));
+  G4bool ok = in.good()
+           && (std::memcmp(identifier, kIdentifier, sizeof(kIdentifier)) == 0)
+           && GetValue(in, version) && (version == kVersion)
+           && GetValue(in, byteOrderMark) && (byteOrderMark == kByteOrderMark)
+           && GetValue(in, constants)
+           && (std::memcmp(constants, kVoxelConstants, sizeof(constants)) == 0)
+           && GetValue(in, opts) && (opts == G4int(allOpts))
+           && GetValue(in, nStored) && (nStored == nVolumes)
+           && GetValue(in, nEntries) && (nEntries >= 0)
+           && (nEntries <= nVolumes);
+
+  if (ok)  { heads.assign(nVolumes, (G4SmartVoxelHeader*)0); }
+  for (G4int i=0; (i<nEntries) && ok; ++i)
+  {
+    G4int index = -1, nameSize = -1, nDaughters = -1;
+    std::uint64_t digest = 0;
+    ok = GetValue(in, index) && (index >= 0) && (index < nVolumes)
+      && !heads[index] && GetValue(in, nameSize) && (nameSize >= 0);
+    if (!ok)  { break; }
+
+    const G4LogicalVolume* volume = (*store)[index];
+    std::vector<char> name(nameSize);
+    ok = (nameSize == G4int(volume->GetName().size()))
+      && in.read(name.data(), nameSize).good()
+      && (volume->GetName().compare(0, nameSize, name.data(), nameSize) == 0)
+      && GetValue(in, digest) && (digest == Digest(volume))
+      && GetValue(in, nDaughters) && (nDaughters == volume->GetNoDaughters())
+      && IsStorable(volume);
+    if (ok)
+    {
+      heads[index] = G4SmartVoxelHeader::Retrieve(in, nDaughters);
+      ok = (heads[index] != 0);
+    }
+  }
+
+  if (!ok)
+  {
+    for (size_t n=0; n<heads.size(); ++n)  { delete heads[n]; }
+    heads.clear();
+    G4String message = "Voxels in file " + fFileName
+                     + " do not match the geometry and will be rebuilt.";
+    G4Exception("G4VoxelSnapshot::Retrieve()", "GeomMgt1002",
+                JustWarning, message);
+  }
+  return ok;
+}
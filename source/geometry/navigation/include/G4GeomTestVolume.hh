@@ -35,6 +35,10 @@
 //
 // Checks for inconsistencies in the geometric boundaries of a physical
 // volume and the boundaries of all its immediate daughters.
+// The check can be applied to the whole tree, once per mother logical
+// volume, testing only sisters with intersecting bounding boxes and
+// sharing the work among threads; the overlaps found can be written
+// to a report file in comma-separated format.
 
 // Author: G.Cosmo, CERN
 // --------------------------------------------------------------------
@@ -42,6 +46,7 @@
 #define G4GeomTestVolume_hh
 
 #include "G4ThreeVector.hh"
+#include "G4String.hh"
 
 class G4VPhysicalVolume;
 class G4GeomTestLogger;
@@ -69,6 +74,14 @@ class G4GeomTestVolume
     G4int GetErrorsThreshold() const;
     void SetErrorsThreshold(G4int max);
       // Get/Set maximum number of errors to report (default set to 1)
+    G4int GetNumberOfThreads() const;
+    void SetNumberOfThreads(G4int n);
+      // Get/Set number of threads used by TestOverlapsInTree() (default
+      // set to 1). Effective only in multi-threaded builds
+    const G4String& GetReportFile() const;
+    void SetReportFile(const G4String& fileName);
+      // Get/Set name of the file where TestOverlapsInTree() writes the
+      // overlaps found, one per line (default none)
 
     void TestRecursiveOverlap( G4int sLevel=0, G4int depth=-1 );
       // Activate overlaps check, propagating recursively to the daughters,
@@ -77,6 +90,14 @@ class G4GeomTestVolume
       // Be careful: depending on the complexity of the geometry, this
       // could require long computational time
 
+    G4int TestOverlapsInTree( G4int sLevel=0, G4int depth=-1 );
+      // Perform the same check as TestRecursiveOverlap(), over the same
+      // levels of the tree, but only once for each distinct mother logical
+      // volume. Sisters are tested against each other only if their
+      // bounding boxes intersect and the daughters to be checked are shared
+      // among the configured number of threads. Returns the number of
+      // overlaps found
+
   private:
 
     G4VPhysicalVolume *target;        // Target volume
@@ -84,6 +105,8 @@ class G4GeomTestVolume
     G4int resolution;                 // Number of points to test
     G4int maxErr;                     // Maximum number of errors to report
     G4bool verbosity;                 // Verbosity level for overlaps check
+    G4int nThreads;                   // Threads used for the tree check
+    G4String reportFile;              // Report file for the tree check
 };
 
 #endif
@@ -48,6 +48,7 @@
 class G4UIdirectory;
 class G4UIcommand;
 class G4UIcmdWithoutParameter;
+class G4UIcmdWithAString;
 class G4UIcmdWithABool;
 class G4UIcmdWithAnInteger;
 class G4UIcmdWithADoubleAndUnit;
@@ -73,13 +74,18 @@ class G4GeometryMessenger : public G4UImessenger
     void SetVerbosity(G4String newValue);
     void SetCheckMode(G4String newValue);
     void SetPushFlag(G4String newValue);
+    void SetTouchablePool(G4String newValue);
+    void SetSafetyGrid(G4String newValue);
     void RecursiveOverlapTest();
 
     G4UIdirectory             *geodir, *navdir, *testdir;
     G4UIcmdWithABool          *chkCmd, *pchkCmd, *verCmd;
-    G4UIcmdWithoutParameter   *recCmd, *resCmd;
+    G4UIcmdWithoutParameter   *recCmd, *resCmd, *idxCmd;
+    G4UIcmdWithAString        *repCmd, *ofilCmd;
     G4UIcmdWithADoubleAndUnit *tolCmd;
-    G4UIcmdWithAnInteger      *verbCmd, *rslCmd, *rcsCmd, *rcdCmd, *errCmd;
+    G4UIcmdWithAnInteger      *verbCmd, *rslCmd, *rcsCmd, *rcdCmd, *errCmd,
+                              *poolCmd, *othrCmd, *thrCmd;
+    G4UIcommand               *sgrCmd;
 
     G4double      tol;
     G4int         recLevel, recDepth;
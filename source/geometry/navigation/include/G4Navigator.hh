@@ -268,6 +268,14 @@ class G4Navigator
   inline void   SetPushVerbosity(G4bool mode);
     // Set/unset verbosity for pushed tracks (default is true).
 
+  void SetTouchablePoolSize(G4int size);
+  inline G4int GetTouchablePoolSize() const;
+    // Set/get the number of touchables kept by the Navigator for reuse
+    // in LocateGlobalPointAndUpdateTouchableHandle() (default is 0, no
+    // pool). A pooled touchable is updated in place, rather than a new
+    // one being allocated at each volume change, once the pool holds
+    // the last reference to it.
+
   void PrintState() const;
     // Print the internal state of the Navigator (for debugging).
     // The level of detail is according to the verbosity.
@@ -356,6 +364,10 @@ class G4Navigator
                             G4double moveLenSq) const;
     // Log and checks for steps larger than the tolerance
 
+  G4TouchableHandle GetPooledTouchableHandle(G4VPhysicalVolume* pPhysVol);
+    // Return a touchable for the current history, recycling a pooled
+    // touchable no longer referenced outside the pool if any.
+
  protected:  // without description
 
   G4double kCarTolerance, fMinStep, fSqTol;
@@ -503,6 +515,11 @@ class G4Navigator
   G4ReplicaNavigation freplicaNav;
   G4RegularNavigation fregularNav;
   G4VoxelSafety       *fpVoxelSafety;
+
+  // Touchables for reuse
+  //
+  std::vector<G4TouchableHandle> fTouchablePool;
+  std::size_t fTouchablePoolSize, fTouchablePoolCursor;
 };
 
 #include "G4Navigator.icc"
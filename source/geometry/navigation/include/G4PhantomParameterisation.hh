@@ -38,6 +38,7 @@
 
 // History:
 // - Created.    P. Arce, May 2007
+// - Added run-length encoded material runs along x, 19/Oct/2018
 // *********************************************************************
 
 #ifndef G4PhantomParameterisation_HH
@@ -159,6 +160,20 @@ class G4PhantomParameterisation : public G4VPVParameterisation
                                    G4double contZ ) const;
       // Check that the voxels fill it completely.
 
+    void BuildMaterialRuns();
+      // Run-length encode the voxel materials along x: for each (y,z) row
+      // store the x index where every run of voxels with the same material
+      // starts. Invoked by BuildContainerSolid(); it must be invoked again
+      // if the materials or material indices are changed afterwards.
+
+    inline G4bool HasMaterialRuns() const;
+      // Return true if the material runs are available.
+
+    void GetMaterialRun( size_t nx, size_t ny, size_t nz,
+                         size_t& firstX, size_t& lastX ) const;
+      // Return the first and last x index of the run of voxels with the
+      // same material as voxel (nx,ny,nz) in its row.
+
   private:
 
     void ComputeVoxelIndices(const G4int copyNo, size_t& nx,
@@ -196,6 +211,12 @@ class G4PhantomParameterisation : public G4VPVParameterisation
 
     G4bool bSkipEqualMaterials;
       // Flag to skip surface when two voxel have same material or not
+
+    std::vector<size_t> fRunRowOffset;
+      // Index in fRunStartX of the first run of each (y,z) row; it has
+      // one extra entry holding the total number of runs.
+    std::vector<size_t> fRunStartX;
+      // x index where each material run starts.
 };
 
 #include "G4PhantomParameterisation.icc"
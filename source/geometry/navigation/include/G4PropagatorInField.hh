@@ -34,6 +34,8 @@
 // This class performs the navigation/propagation of a particle/track 
 // in a magnetic field. The field is in general non-uniform.
 // For the calculation of the path, it relies on the class G4ChordFinder.
+// In volumes whose field manager declares a uniform field value, the
+// path is instead computed as an exact helix.
 //
 // Key Method: ComputeStep(..)
 
@@ -42,6 +44,7 @@
 // 25.10.96 John Apostolakis,  design and implementation 
 // 25.03.97 John Apostolakis,  adaptation for G4Transportation and cleanup
 //  8.11.02 John Apostolakis,  changes to enable use of safety in intersecting
+// 19.10.18 Helix propagation in volumes with a declared uniform field
 // ---------------------------------------------------------------------------
 
 #ifndef G4PropagatorInField_hh 
@@ -205,6 +208,34 @@ class G4PropagatorInField
                                G4VPhysicalVolume* physVol);
    void ReportStuckParticle( G4int noZeroSteps, G4double proposedStep,
                             G4double lastTriedStep, G4VPhysicalVolume* physVol);
+
+ private:  // Helix propagation in uniform field
+
+   G4bool PrepareHelix();
+     // Return true if the current field manager declares a uniform field
+     // and the equation of motion is the usual one for a magnetic field;
+     // if so keep the field value and the charge coefficient.
+
+   void AdvanceHelix( const G4FieldTrack& startState,
+                            G4double      curveLength,
+                            G4FieldTrack& endState ) const;
+     // Move along the exact helix from startState by curveLength.
+
+   G4double HelixChordLimitedStep( const G4FieldTrack& startState,
+                                         G4double      trialStepLength ) const;
+     // Length of helix whose chord misses it by less than delta chord, or
+     // the remaining safety if larger, limited to trialStepLength.
+
+   G4bool LocateHelixIntersection( const G4FieldTrack&  startState,
+                                   const G4FieldTrack&  endState,
+                                   const G4ThreeVector& trialPointE,
+                                         G4FieldTrack&  intersection,
+                                         G4bool&        recalculatedEndPt );
+     // Find the point of the helix from startState to endState within
+     // delta intersection of a boundary, starting from the intersection
+     // trialPointE of its chord. Refines the chord around the point until
+     // it converges. Same conventions as for
+     // G4VIntersectionLocator::EstimateIntersectionPoint().
                              
  private:
    // ----------------------------------------------------------------------
@@ -286,6 +317,12 @@ class G4PropagatorInField
    G4bool         fFirstStepInVolume; 
    G4bool         fLastStepInVolume; 
    G4bool         fNewTrack;
+
+   G4bool         fUseHelix;
+   G4ThreeVector  fHelixField;
+   G4double       fHelixCof;
+       // Helix propagation for the current step: uniform field value and
+       // charge coefficient of the equation of motion
 };
 
 // Inline methods.
@@ -98,9 +98,10 @@ class G4RegularNavigation
                                 G4int& blockedReplicaNo,
                                 G4VPhysicalVolume* pCurrentPhysical);
       // Compute the step skipping surfaces when they separate voxels with
-      // equal materials. Loop to voxels until a different material is found:
-      // invokes G4NormalNavigation::ComputeStep() in each voxel and move the
-      // point to the next voxel.
+      // equal materials. Traverse the voxels with a 3D-DDA until a different
+      // material is found, using the material runs of the parameterisation
+      // along x; the step length in each voxel is recorded in
+      // G4RegularNavigationHelper.
 
     G4double ComputeSafety( const G4ThreeVector& localPoint,
                             const G4NavigationHistory& history,
@@ -121,6 +122,13 @@ class G4RegularNavigation
 
   private:
 
+    void SetUpDDAAxis( G4double pos, G4double dir, G4int index,
+                       G4double half, G4double wall, G4int& step,
+                       G4double& tMax, G4double& tDelta ) const;
+      // Initialise the 3D-DDA traversal along one axis: direction of the
+      // index increment, distance to the next voxel wall and distance to
+      // cross a whole voxel.
+
     G4int fverbose;
     G4bool fcheck;
 
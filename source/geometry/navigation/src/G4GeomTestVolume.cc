@@ -35,13 +35,234 @@
 // --------------------------------------------------------------------
 
 #include <set>
+#include <vector>
+#include <sstream>
+#include <iomanip>
+#include <atomic>
+#include <fstream>
+#include <algorithm>
 
 #include "G4GeomTestVolume.hh"
 
 #include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
 #include "G4VPhysicalVolume.hh"
 #include "G4LogicalVolume.hh"
 #include "G4VSolid.hh"
+#include "G4AffineTransform.hh"
+#include "G4UnitsTable.hh"
+#include "G4Threading.hh"
+#include "Randomize.hh"
+
+namespace
+{
+  // Overlap detected by TestOverlapsInTree()
+  //
+  struct G4GeomTestOverlap
+  {
+    enum Type { kMother, kSister, kIncluded, kVolume };
+
+    Type type;
+    const G4LogicalVolume* mother;
+    const G4VPhysicalVolume* volume;
+    const G4VPhysicalVolume* sister;
+    G4ThreeVector point;   // Local point in the overlapped volume
+    G4double depth;        // Overlap depth, if measured
+  };
+
+  // Daughters of a mother logical volume, with their bounding boxes
+  // in the mother's frame and, for each daughter, the sisters whose
+  // bounding boxes intersect its own
+  //
+  struct G4GeomTestMother
+  {
+    const G4LogicalVolume* logical;
+    G4VSolid* solid;
+    std::vector<const G4VPhysicalVolume*> volumes;
+    std::vector<G4VSolid*> solids;
+    std::vector<G4AffineTransform> transforms;
+    std::vector<G4ThreeVector> bmin, bmax;
+    std::vector< std::vector<G4int> > candidates;
+  };
+
+  // Range of daughters of a mother, checked as a unit of work
+  //
+  struct G4GeomTestTask
+  {
+    size_t mother;
+    G4int first, last;
+  };
+
+  const G4int kDaughtersPerTask = 8;
+
+  inline G4bool BoxesIntersect( const G4GeomTestMother& m, G4int i, G4int j )
+  {
+    return !( m.bmin[j].x() > m.bmax[i].x() || m.bmax[j].x() < m.bmin[i].x()
+           || m.bmin[j].y() > m.bmax[i].y() || m.bmax[j].y() < m.bmin[i].y()
+           || m.bmin[j].z() > m.bmax[i].z() || m.bmax[j].z() < m.bmin[i].z() );
+  }
+
+  inline G4bool InBox( const G4GeomTestMother& m, G4int j,
+                       const G4ThreeVector& p )
+  {
+    return !( p.x() < m.bmin[j].x() || p.x() > m.bmax[j].x()
+           || p.y() < m.bmin[j].y() || p.y() > m.bmax[j].y()
+           || p.z() < m.bmin[j].z() || p.z() > m.bmax[j].z() );
+  }
+
+  // Collects the daughters of a mother and their bounding boxes, and
+  // finds the pairs of sisters whose boxes intersect by sweeping the
+  // boxes sorted along the axis of largest extent. Each daughter solid
+  // not yet in 'warmed' generates one surface point here, so that solids
+  // filling caches on their first call to GetPointOnSurface() (e.g. the
+  // list of primitives of a G4BooleanSolid) do so before the helper
+  // threads share them.
+  // Returns the number of candidate pairs
+  //
+  G4long IndexMother( const G4LogicalVolume* logical, G4GeomTestMother& m,
+                      std::set<const G4VSolid*>& warmed )
+  {
+    G4int nDaughter = logical->GetNoDaughters();
+    m.logical = logical;
+    m.solid = logical->GetSolid();
+    m.volumes.resize(nDaughter);
+    m.solids.resize(nDaughter);
+    m.transforms.resize(nDaughter);
+    m.bmin.resize(nDaughter);
+    m.bmax.resize(nDaughter);
+    m.candidates.resize(nDaughter);
+
+    G4ThreeVector tmin(kInfinity,kInfinity,kInfinity), tmax = -tmin;
+    for (G4int i=0; i<nDaughter; ++i)
+    {
+      G4VPhysicalVolume* daughter = logical->GetDaughter(i);
+      m.volumes[i] = daughter;
+      m.solids[i] = daughter->GetLogicalVolume()->GetSolid();
+      if (warmed.insert(m.solids[i]).second)
+      {
+        m.solids[i]->GetPointOnSurface();
+      }
+      m.transforms[i] = G4AffineTransform( daughter->GetRotation(),
+                                           daughter->GetTranslation() );
+      G4ThreeVector pmin, pmax;
+      m.solids[i]->BoundingLimits(pmin, pmax);
+      G4ThreeVector bmin(kInfinity,kInfinity,kInfinity), bmax = -bmin;
+      for (G4int k=0; k<8; ++k)
+      {
+        G4ThreeVector corner( (k&1) ? pmax.x() : pmin.x(),
+                              (k&2) ? pmax.y() : pmin.y(),
+                              (k&4) ? pmax.z() : pmin.z() );
+        G4ThreeVector p = m.transforms[i].TransformPoint(corner);
+        bmin.set( std::min(bmin.x(),p.x()), std::min(bmin.y(),p.y()),
+                  std::min(bmin.z(),p.z()) );
+        bmax.set( std::max(bmax.x(),p.x()), std::max(bmax.y(),p.y()),
+                  std::max(bmax.z(),p.z()) );
+      }
+      m.bmin[i] = bmin;
+      m.bmax[i] = bmax;
+      tmin.set( std::min(tmin.x(),bmin.x()), std::min(tmin.y(),bmin.y()),
+                std::min(tmin.z(),bmin.z()) );
+      tmax.set( std::max(tmax.x(),bmax.x()), std::max(tmax.y(),bmax.y()),
+                std::max(tmax.z(),bmax.z()) );
+    }
+
+    G4ThreeVector extent = tmax - tmin;
+    G4int axis = (extent.x() >= extent.y()) ? 0 : 1;
+    if (extent.z() > extent[axis])  { axis = 2; }
+
+    std::vector<G4int> order(nDaughter);
+    for (G4int i=0; i<nDaughter; ++i)  { order[i] = i; }
+    std::sort(order.begin(), order.end(), [&m,axis](G4int a, G4int b)
+              { return m.bmin[a][axis] < m.bmin[b][axis]; });
+
+    G4long nPairs = 0;
+    for (G4int a=0; a<nDaughter; ++a)
+    {
+      G4int i = order[a];
+      for (G4int b=a+1; b<nDaughter; ++b)
+      {
+        G4int j = order[b];
+        if (m.bmin[j][axis] > m.bmax[i][axis])  { break; }
+        if (BoxesIntersect(m, i, j))
+        {
+          m.candidates[i].push_back(j);
+          m.candidates[j].push_back(i);
+          ++nPairs;
+        }
+      }
+    }
+    return nPairs;
+  }
+
+  // Checks daughters [first,last) of a mother against the mother and
+  // their candidate sisters, as done by G4PVPlacement::CheckOverlaps()
+  //
+  void CheckDaughters( const G4GeomTestMother& m, G4int first, G4int last,
+                       G4int res, G4double tol, G4int maxErr,
+                       std::vector<G4GeomTestOverlap>& overlaps )
+  {
+    for (G4int i=first; i<last; ++i)
+    {
+      G4VSolid* solid = m.solids[i];
+      const G4AffineTransform& Tm = m.transforms[i];
+      const std::vector<G4int>& sisters = m.candidates[i];
+      G4int trials = 0;
+
+      for (G4int n=0; (n<res) && (trials<maxErr); ++n)
+      {
+        G4ThreeVector mp = Tm.TransformPoint(solid->GetPointOnSurface());
+
+        if (m.solid->Inside(mp)==kOutside)
+        {
+          G4double distin = m.solid->DistanceToIn(mp);
+          if (distin > tol)
+          {
+            ++trials;
+            G4GeomTestOverlap overlap = { G4GeomTestOverlap::kMother,
+              m.logical, m.volumes[i], 0, mp, distin };
+            overlaps.push_back(overlap);
+          }
+        }
+
+        for (size_t k=0; (k<sisters.size()) && (trials<maxErr); ++k)
+        {
+          G4int j = sisters[k];
+          if (!InBox(m, j, mp))  { continue; }
+          G4ThreeVector md = m.transforms[j].InverseTransformPoint(mp);
+          if (m.solids[j]->Inside(md)==kInside)
+          {
+            G4double distout = m.solids[j]->DistanceToOut(md);
+            if (distout > tol)
+            {
+              ++trials;
+              G4GeomTestOverlap overlap = { G4GeomTestOverlap::kSister,
+                m.logical, m.volumes[i], m.volumes[j], md, distout };
+              overlaps.push_back(overlap);
+            }
+          }
+        }
+      }
+
+      // Check that no candidate sister is fully included in the volume,
+      // with a single point generated on the surface of the sister
+      //
+      for (size_t k=0; (k<sisters.size()) && (trials<maxErr) && (res>0); ++k)
+      {
+        G4int j = sisters[k];
+        G4ThreeVector mp =
+          m.transforms[j].TransformPoint(m.solids[j]->GetPointOnSurface());
+        G4ThreeVector msi = Tm.InverseTransformPoint(mp);
+        if (solid->Inside(msi)==kInside)
+        {
+          ++trials;
+          G4GeomTestOverlap overlap = { G4GeomTestOverlap::kIncluded,
+            m.logical, m.volumes[i], m.volumes[j], msi, 0. };
+          overlaps.push_back(overlap);
+        }
+      }
+    }
+  }
+}
 
 //
 // Constructor
@@ -51,7 +272,8 @@ G4GeomTestVolume::G4GeomTestVolume( G4VPhysicalVolume *theTarget,
                                     G4int numberOfPoints,
                                     G4bool theVerbosity )
   : target(theTarget), tolerance(theTolerance),
-    resolution(numberOfPoints), maxErr(1), verbosity(theVerbosity)
+    resolution(numberOfPoints), maxErr(1), verbosity(theVerbosity),
+    nThreads(1), reportFile("")
 {;}
 
 //
@@ -123,6 +345,38 @@ void G4GeomTestVolume::SetErrorsThreshold(G4int max)
   maxErr = max;
 }
 
+//
+// Get number of threads for the tree check
+//
+G4int G4GeomTestVolume::GetNumberOfThreads() const
+{
+  return nThreads;
+}
+
+//
+// Set number of threads for the tree check
+//
+void G4GeomTestVolume::SetNumberOfThreads(G4int n)
+{
+  nThreads = (n > 0) ? n : 1;
+}
+
+//
+// Get report file name
+//
+const G4String& G4GeomTestVolume::GetReportFile() const
+{
+  return reportFile;
+}
+
+//
+// Set report file name
+//
+void G4GeomTestVolume::SetReportFile(const G4String& fileName)
+{
+  reportFile = fileName;
+}
+
 //
 // TestRecursiveOverlap
 //
@@ -173,3 +427,225 @@ void G4GeomTestVolume::TestRecursiveOverlap( G4int slevel, G4int depth )
     vTest.TestRecursiveOverlap( slevel,depth );
   }
 }
+
+//
+// TestOverlapsInTree
+//
+G4int G4GeomTestVolume::TestOverlapsInTree( G4int slevel, G4int depth )
+{
+  // Levels of the tree tested by TestRecursiveOverlap(), with the
+  // target at level 0
+  //
+  if (depth == 0)  { return 0; }
+  G4int firstLevel = (slevel > 1) ? slevel-1 : 0;
+  G4int lastLevel = (depth > 0) ? depth-1 : -1;
+
+  std::vector<G4GeomTestOverlap> overlaps;
+
+  // The target is checked alone against its own mother and sisters
+  //
+  if ((firstLevel == 0) && (target->GetMotherLogical()))
+  {
+    if (target->CheckOverlaps(resolution, tolerance, verbosity, maxErr))
+    {
+      G4GeomTestOverlap overlap = { G4GeomTestOverlap::kVolume,
+        target->GetMotherLogical(), target, 0, G4ThreeVector(), 0. };
+      overlaps.push_back(overlap);
+    }
+  }
+
+  // Collect the distinct mother logical volumes whose daughters are
+  // placed at the levels to be tested
+  //
+  std::vector<const G4LogicalVolume*> mothers;
+  std::set<const G4LogicalVolume*> selected;
+  typedef std::pair<const G4LogicalVolume*, G4int> G4LevelVolume;
+  std::set<G4LevelVolume> visited;
+  std::vector<G4LevelVolume> stack;
+  stack.push_back(G4LevelVolume(target->GetLogicalVolume(), 0));
+  while (!stack.empty())
+  {
+    G4LevelVolume item = stack.back();
+    stack.pop_back();
+    if (!visited.insert(item).second)  { continue; }
+
+    const G4LogicalVolume* logical = item.first;
+    G4int nDaughter = logical->GetNoDaughters();
+    G4int level = item.second + 1;
+    if ((nDaughter == 0) || ((lastLevel >= 0) && (level > lastLevel)))
+    {
+      continue;
+    }
+    if ((level >= firstLevel) && selected.insert(logical).second)
+    {
+      mothers.push_back(logical);
+    }
+    std::set<const G4LogicalVolume*> daughters;
+    for (G4int i=0; i<nDaughter; ++i)
+    {
+      const G4LogicalVolume* daughter =
+        logical->GetDaughter(i)->GetLogicalVolume();
+      if (daughters.insert(daughter).second)
+      {
+        stack.push_back(G4LevelVolume(daughter, level));
+      }
+    }
+  }
+
+  // Index the daughters of each mother. Replicated and parameterised
+  // volumes are checked here by their own CheckOverlaps(), since the
+  // parameterisation modifies shared solids and transformations
+  //
+  std::vector<G4GeomTestMother> indexed;
+  indexed.reserve(mothers.size());
+  std::vector<G4GeomTestTask> tasks;
+  std::set<const G4VSolid*> warmed;
+  G4long nVolumes = 0, nPairs = 0;
+  for (size_t n=0; n<mothers.size(); ++n)
+  {
+    const G4LogicalVolume* logical = mothers[n];
+    G4VPhysicalVolume* daughter = logical->GetDaughter(0);
+    if (daughter->IsReplicated())
+    {
+      ++nVolumes;
+      if (daughter->CheckOverlaps(resolution, tolerance, verbosity, maxErr))
+      {
+        G4GeomTestOverlap overlap = { G4GeomTestOverlap::kVolume,
+          logical, daughter, 0, G4ThreeVector(), 0. };
+        overlaps.push_back(overlap);
+      }
+      continue;
+    }
+    indexed.push_back(G4GeomTestMother());
+    nPairs += IndexMother(logical, indexed.back(), warmed);
+    G4int nDaughter = logical->GetNoDaughters();
+    nVolumes += nDaughter;
+    for (G4int first=0; first<nDaughter; first+=kDaughtersPerTask)
+    {
+      G4GeomTestTask task = { indexed.size()-1, first,
+                              std::min(first+kDaughtersPerTask, nDaughter) };
+      tasks.push_back(task);
+    }
+  }
+
+  // Check the daughters, sharing the tasks among threads. Helper threads
+  // seed their random engine per task, for reproducible results
+  //
+  std::vector< std::vector<G4GeomTestOverlap> > results(tasks.size());
+  std::atomic<size_t> next(0);
+  auto checkTasks = [&](G4bool helper)
+  {
+    for (size_t t=next++; t<tasks.size(); t=next++)
+    {
+      if (helper)  { G4Random::setTheSeed(G4long(t+1)); }
+      CheckDaughters(indexed[tasks[t].mother], tasks[t].first, tasks[t].last,
+                     resolution, tolerance, maxErr, results[t]);
+    }
+  };
+
+  G4int nUsed = 1;
+#ifdef G4MULTITHREADED
+  nUsed = (tasks.size() < size_t(nThreads)) ? G4int(tasks.size()) : nThreads;
+#endif
+  if (nUsed > 1)
+  {
+    std::vector<G4Thread> helpers;
+    for (G4int t=0; t<nUsed; ++t)
+    {
+      helpers.push_back(G4Thread(checkTasks, true));
+    }
+    for (size_t t=0; t<helpers.size(); ++t)
+    {
+      G4THREADJOIN(helpers[t]);
+    }
+  }
+  else
+  {
+    checkTasks(false);
+  }
+  for (size_t t=0; t<results.size(); ++t)
+  {
+    overlaps.insert(overlaps.end(), results[t].begin(), results[t].end());
+  }
+
+  // Report the overlaps found
+  //
+  for (size_t n=0; (n<overlaps.size()) && verbosity; ++n)
+  {
+    const G4GeomTestOverlap& ov = overlaps[n];
+    if (ov.type == G4GeomTestOverlap::kVolume)  { continue; }
+    std::ostringstream message;
+    message << "Overlap is detected for volume "
+            << ov.volume->GetName() << ':' << ov.volume->GetCopyNo()
+            << G4endl;
+    switch (ov.type)
+    {
+      case G4GeomTestOverlap::kMother:
+        message << "          with its mother volume " << ov.mother->GetName()
+                << G4endl << "          at mother local point " << ov.point
+                << ", overlapping by at least: "
+                << G4BestUnit(ov.depth, "Length");
+        break;
+      case G4GeomTestOverlap::kSister:
+        message << "          with " << ov.sister->GetName() << ':'
+                << ov.sister->GetCopyNo() << " volume's" << G4endl
+                << "          local point " << ov.point << ", "
+                << "overlapping by at least: "
+                << G4BestUnit(ov.depth, "Length");
+        break;
+      default:
+        message << "          apparently fully encapsulating volume "
+                << ov.sister->GetName() << ':' << ov.sister->GetCopyNo()
+                << "          at the same level !";
+        break;
+    }
+    G4Exception("G4GeomTestVolume::TestOverlapsInTree()",
+                "GeomNav1002", JustWarning, message);
+  }
+
+  if (!reportFile.empty())
+  {
+    std::ofstream report(reportFile);
+    if (!report)
+    {
+      std::ostringstream message;
+      message << "Cannot open report file " << reportFile << " !";
+      G4Exception("G4GeomTestVolume::TestOverlapsInTree()",
+                  "GeomNav1002", JustWarning, message);
+    }
+    else
+    {
+      static const char* types[] = { "mother", "sister", "included", "volume" };
+      report << "# type,mother,volume,copy,sister,sister_copy,"
+             << "x[mm],y[mm],z[mm],depth[mm]" << std::endl;
+      report << std::setprecision(9);
+      for (size_t n=0; n<overlaps.size(); ++n)
+      {
+        const G4GeomTestOverlap& ov = overlaps[n];
+        report << types[ov.type] << ',' << ov.mother->GetName() << ','
+               << ov.volume->GetName() << ',' << ov.volume->GetCopyNo() << ',';
+        if (ov.sister)
+        {
+          report << ov.sister->GetName() << ',' << ov.sister->GetCopyNo();
+        }
+        else
+        {
+          report << ',';
+        }
+        report << ',' << ov.point.x()/mm << ',' << ov.point.y()/mm << ','
+               << ov.point.z()/mm << ',' << ov.depth/mm << std::endl;
+      }
+    }
+  }
+
+  if (verbosity)
+  {
+    G4cout << "Checked " << nVolumes << " volumes in " << mothers.size()
+           << " distinct mother volumes, testing " << nPairs
+           << " pairs of sisters with intersecting extents, using "
+           << nUsed << " thread(s): " << overlaps.size()
+           << " overlaps found." << G4endl;
+  }
+
+  return G4int(overlaps.size());
+}
@@ -36,17 +36,22 @@
 // --------------------------------------------------------------------
 
 #include <iomanip>
+#include <sstream>
 
 #include "G4GeometryMessenger.hh"
 
 #include "G4TransportationManager.hh"
 #include "G4GeometryManager.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4LogicalVolume.hh"
 #include "G4VPhysicalVolume.hh"
 #include "G4Navigator.hh"
 
 #include "G4UIdirectory.hh"
 #include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
 #include "G4UIcmdWithoutParameter.hh"
+#include "G4UIcmdWithAString.hh"
 #include "G4UIcmdWithABool.hh"
 #include "G4UIcmdWithAnInteger.hh"
 #include "G4UIcmdWithADoubleAndUnit.hh"
@@ -111,6 +116,59 @@ G4GeometryMessenger::G4GeometryMessenger(G4TransportationManager* tman)
   pchkCmd->SetDefaultValue(true);
   pchkCmd->AvailableForStates(G4State_Idle);
 
+  poolCmd = new G4UIcmdWithAnInteger( "/geometry/navigator/touchable_pool", this );
+  poolCmd->SetGuidance( "Set the number of touchables kept by the navigator" );
+  poolCmd->SetGuidance( "for reuse on volume changes. A touchable in the pool" );
+  poolCmd->SetGuidance( "is updated in place, instead of a new one being" );
+  poolCmd->SetGuidance( "allocated, once no track or step refers to it." );
+  poolCmd->SetGuidance( "By default no pool is used (size 0)." );
+  poolCmd->SetParameterName("size",true);
+  poolCmd->SetDefaultValue(0);
+  poolCmd->SetRange("size >=0");
+  poolCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  othrCmd = new G4UIcmdWithAnInteger( "/geometry/navigator/optimisation_threads", this );
+  othrCmd->SetGuidance( "Set the number of threads building concurrently the" );
+  othrCmd->SetGuidance( "voxel optimisation of independent logical volumes" );
+  othrCmd->SetGuidance( "when the geometry is closed. 0 uses all the cores." );
+  othrCmd->SetGuidance( "By default voxels are built sequentially (1)." );
+  othrCmd->SetGuidance( "NOTE: this command has effect -only- if Geant4 has" );
+  othrCmd->SetGuidance( "      been installed in multi-threaded mode!" );
+  othrCmd->SetParameterName("nThreads",true);
+  othrCmd->SetDefaultValue(1);
+  othrCmd->SetRange("nThreads >=0");
+  othrCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  ofilCmd = new G4UIcmdWithAString( "/geometry/navigator/optimisation_file", this );
+  ofilCmd->SetGuidance( "Set the file storing the voxel optimisation across jobs." );
+  ofilCmd->SetGuidance( "When closing the geometry, voxels are read from the file" );
+  ofilCmd->SetGuidance( "if it matches the geometry; otherwise they are built and" );
+  ofilCmd->SetGuidance( "written to the file. Voxels of volumes with replicated or" );
+  ofilCmd->SetGuidance( "parameterised daughters are always built." );
+  ofilCmd->SetGuidance( "Use 'none' to disable the file (default)." );
+  ofilCmd->SetParameterName("fileName",false);
+  ofilCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  sgrCmd = new G4UIcommand( "/geometry/navigator/safety_grid", this );
+  sgrCmd->SetGuidance( "Set the resolution of the grid of safety lower bounds" );
+  sgrCmd->SetGuidance( "of a logical volume, as the number of cells along the" );
+  sgrCmd->SetGuidance( "longest side of its extent. When the bound in the cell" );
+  sgrCmd->SetGuidance( "is large enough, it is returned by the navigator in" );
+  sgrCmd->SetGuidance( "place of the exact isotropic safety. 0 disables the" );
+  sgrCmd->SetGuidance( "grid (default). The grid is built at once if the geometry" );
+  sgrCmd->SetGuidance( "is closed, otherwise when closing it, and only for volumes" );
+  sgrCmd->SetGuidance( "with placement daughters only." );
+  G4UIparameter* lvPar = new G4UIparameter("volume", 's', false);
+  lvPar->SetGuidance("Name of the logical volume.");
+  sgrCmd->SetParameter(lvPar);
+  G4UIparameter* cellPar = new G4UIparameter("nCells", 'i', true);
+  cellPar->SetGuidance("Number of cells along the longest side.");
+  cellPar->SetParameterRange("nCells >= 0");
+  cellPar->SetDefaultValue(32);
+  sgrCmd->SetParameter(cellPar);
+  sgrCmd->AvailableForStates(G4State_Idle);
+  sgrCmd->SetToBeBroadcasted(false);
+
   //
   // Geometry verification test commands
   //
@@ -171,6 +229,33 @@ G4GeometryMessenger::G4GeometryMessenger(G4TransportationManager* tman)
   recCmd->SetGuidance( "NOTE: it may take a very long time," );
   recCmd->SetGuidance( "      depending on the geometry complexity !");
   recCmd->AvailableForStates(G4State_Idle);
+
+  thrCmd = new G4UIcmdWithAnInteger( "/geometry/test/threads", this );
+  thrCmd->SetGuidance( "Set the number of threads sharing the overlap check" );
+  thrCmd->SetGuidance( "started with /geometry/test/indexed_run." );
+  thrCmd->SetGuidance( "NOTE: this command has effect -only- if Geant4 has" );
+  thrCmd->SetGuidance( "      been installed in multi-threaded mode!" );
+  thrCmd->SetParameterName("threads",true);
+  thrCmd->SetDefaultValue(1);
+  thrCmd->SetRange("threads >=1");
+  thrCmd->AvailableForStates(G4State_Idle);
+
+  repCmd = new G4UIcmdWithAString( "/geometry/test/report_file", this );
+  repCmd->SetGuidance( "Set the file where /geometry/test/indexed_run writes" );
+  repCmd->SetGuidance( "the overlaps found, one per line in comma-separated" );
+  repCmd->SetGuidance( "format. By default no report file is written." );
+  repCmd->SetParameterName("file_name",true);
+  repCmd->SetDefaultValue("");
+  repCmd->AvailableForStates(G4State_Idle);
+
+  idxCmd = new G4UIcmdWithoutParameter( "/geometry/test/indexed_run", this );
+  idxCmd->SetGuidance( "Start running the overlap check on the whole tree." );
+  idxCmd->SetGuidance( "Same check as /geometry/test/run, applied once for" );
+  idxCmd->SetGuidance( "each distinct mother logical volume. Sisters are only" );
+  idxCmd->SetGuidance( "tested against each other if their extents intersect," );
+  idxCmd->SetGuidance( "and the daughters are shared among the threads set" );
+  idxCmd->SetGuidance( "with /geometry/test/threads." );
+  idxCmd->AvailableForStates(G4State_Idle);
 }
 
 //
@@ -180,8 +265,9 @@ G4GeometryMessenger::~G4GeometryMessenger()
 {
   delete verCmd; delete recCmd; delete rslCmd;
   delete resCmd; delete rcsCmd; delete rcdCmd; delete errCmd;
-  delete tolCmd;
-  delete verbCmd; delete pchkCmd; delete chkCmd;
+  delete tolCmd; delete thrCmd; delete repCmd; delete idxCmd;
+  delete verbCmd; delete pchkCmd; delete chkCmd; delete poolCmd;
+  delete othrCmd; delete sgrCmd; delete ofilCmd;
   delete geodir; delete navdir; delete testdir;
   delete tvolume;
 }
@@ -222,6 +308,20 @@ G4GeometryMessenger::SetNewValue( G4UIcommand* command, G4String newValues )
   else if (command == chkCmd) {
     SetCheckMode( newValues );
   }
+  else if (command == poolCmd) {
+    SetTouchablePool( newValues );
+  }
+  else if (command == othrCmd) {
+    G4GeometryManager::GetInstance()
+      ->SetNumberOfOptimisationThreads(othrCmd->GetNewIntValue( newValues ));
+  }
+  else if (command == ofilCmd) {
+    G4GeometryManager::GetInstance()
+      ->SetOptimisationFile( (newValues == "none") ? G4String("") : newValues );
+  }
+  else if (command == sgrCmd) {
+    SetSafetyGrid( newValues );
+  }
   else if (command == tolCmd) {
     Init();
     tol = tolCmd->GetNewDoubleValue( newValues )
@@ -252,6 +352,21 @@ G4GeometryMessenger::SetNewValue( G4UIcommand* command, G4String newValues )
     RecursiveOverlapTest();
     G4cout << "Geometry overlaps check completed !" << G4endl;
   }
+  else if (command == thrCmd) {
+    Init();
+    tvolume->SetNumberOfThreads(thrCmd->GetNewIntValue( newValues ));
+  }
+  else if (command == repCmd) {
+    Init();
+    tvolume->SetReportFile(newValues);
+  }
+  else if (command == idxCmd) {
+    Init();
+    G4cout << "Running geometry overlaps check on the whole tree..." << G4endl;
+    CheckGeometry();
+    tvolume->TestOverlapsInTree( recLevel, recDepth );
+    G4cout << "Geometry overlaps check completed !" << G4endl;
+  }
 }
 
 //
@@ -321,6 +436,43 @@ G4GeometryMessenger::SetCheckMode(G4String input)
   navigator->CheckMode(mode);
 }
 
+//
+// Set navigator touchable pool size
+//
+void
+G4GeometryMessenger::SetTouchablePool(G4String input)
+{
+  G4int size = poolCmd->GetNewIntValue(input);
+  G4Navigator* navigator = tmanager->GetNavigatorForTracking();
+  navigator->SetTouchablePoolSize(size);
+}
+
+//
+// Set the resolution of the safety grid of a logical volume
+//
+void
+G4GeometryMessenger::SetSafetyGrid(G4String input)
+{
+  G4String name;
+  G4int nCells = 0;
+  std::istringstream is(input);
+  is >> name >> nCells;
+  G4LogicalVolume* volume
+    = G4LogicalVolumeStore::GetInstance()->GetVolume(name, false);
+  if (!volume)
+  {
+    std::ostringstream message;
+    message << "Logical volume " << name << " NOT found in store !"
+            << G4endl
+            << "          Command /geometry/navigator/safety_grid ignored.";
+    G4Exception("G4GeometryMessenger::SetSafetyGrid()",
+                "GeomNav1001", JustWarning, message);
+    return;
+  }
+  volume->SetSafetyGridResolution(nCells);
+  G4GeometryManager::GetInstance()->UpdateSafetyGrid(volume);
+}
+
 //
 // Set navigator verbosity for push notifications
 //
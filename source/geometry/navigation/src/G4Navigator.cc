@@ -44,6 +44,7 @@
 #include "G4VPhysicalVolume.hh"
 
 #include "G4VoxelSafety.hh"
+#include "G4SafetyGrid.hh"
 
 // Constant determining how precise normals should be (how close to unit
 // vectors). If exceeded, warnings will be issued.
@@ -57,7 +58,8 @@ static const G4double kToleranceNormalCheck = CLHEP::perThousand;
 //
 G4Navigator::G4Navigator()
   : fWasLimitedByGeometry(false), fVerbose(0),
-    fTopPhysical(0), fCheck(false), fPushed(false), fWarnPush(true)
+    fTopPhysical(0), fCheck(false), fPushed(false), fWarnPush(true),
+    fTouchablePoolSize(0), fTouchablePoolCursor(0)
 {
   fActive= false; 
   fLastTriedStepComputation= false;
@@ -1819,6 +1821,7 @@ G4double G4Navigator::ComputeSafety( const G4ThreeVector &pGlobalpoint,
     G4VPhysicalVolume *motherPhysical = fHistory.GetTopVolume();
     G4LogicalVolume *motherLogical = motherPhysical->GetLogicalVolume();
     G4SmartVoxelHeader* pVoxelHeader = motherLogical->GetVoxelHeader();
+    G4SafetyGrid* pSafetyGrid = motherLogical->GetSafetyGrid();
     G4ThreeVector localPoint = ComputeLocalPoint(pGlobalpoint);
 
     if ( fHistory.GetTopVolumeType()!=kReplica )
@@ -1826,6 +1829,19 @@ G4double G4Navigator::ComputeSafety( const G4ThreeVector &pGlobalpoint,
       switch(CharacteriseDaughters(motherLogical))
       {
         case kNormal:
+          if ( pSafetyGrid )
+          {
+            // Use the precomputed lower bound if it satisfies the request
+            // or is within a cell size of the exact value; else fall back
+            // to the exact computation below
+            //
+            newSafety = pSafetyGrid->GetSafety(localPoint);
+            if ( (newSafety >= pMaxLength)
+              || (newSafety >= pSafetyGrid->GetCellHalfDiagonal()) )
+            {
+              break;
+            }
+          }
           if ( pVoxelHeader )
           {
 #ifdef G4NEW_SAFETY
@@ -2081,6 +2097,53 @@ G4TouchableHistoryHandle G4Navigator::CreateTouchableHistoryHandle() const
   return G4TouchableHistoryHandle( CreateTouchableHistory() );
 }
 
+// ********************************************************************
+// SetTouchablePoolSize
+// ********************************************************************
+//
+void G4Navigator::SetTouchablePoolSize(G4int size)
+{
+  fTouchablePoolSize = (size > 0) ? size : 0;
+  if( fTouchablePool.size() > fTouchablePoolSize )
+  {
+    fTouchablePool.resize( fTouchablePoolSize );
+  }
+  fTouchablePoolCursor = 0;
+}
+
+// ********************************************************************
+// GetPooledTouchableHandle
+//
+// A pooled touchable whose only remaining reference is the pool's own
+// can be updated in place: nobody else can observe the change.
+// ********************************************************************
+//
+G4TouchableHandle
+G4Navigator::GetPooledTouchableHandle(G4VPhysicalVolume* pPhysVol)
+{
+  const std::size_t nPooled = fTouchablePool.size();
+  for( std::size_t i=0; i<nPooled; ++i )
+  {
+    if( ++fTouchablePoolCursor >= nPooled )  { fTouchablePoolCursor = 0; }
+    G4TouchableHandle& pooled = fTouchablePool[fTouchablePoolCursor];
+    if( pooled.Count() == 1 )
+    {
+      pooled->UpdateYourself( pPhysVol, &fHistory );
+      return pooled;
+    }
+  }
+  G4TouchableHandle touchable = CreateTouchableHistory();
+  if( pPhysVol == 0 )
+  {
+    touchable->UpdateYourself( pPhysVol, &fHistory );
+  }
+  if( nPooled < fTouchablePoolSize )
+  {
+    fTouchablePool.push_back( touchable );
+  }
+  return touchable;
+}
+
 // ********************************************************************
 // PrintState
 // ********************************************************************
@@ -42,6 +42,8 @@
 #include "G4VVolumeMaterialScanner.hh"
 #include "G4GeometryTolerance.hh"
 
+#include <algorithm>
+
 //------------------------------------------------------------------
 G4PhantomParameterisation::G4PhantomParameterisation()
   : fVoxelHalfX(0.), fVoxelHalfY(0.), fVoxelHalfZ(0.),
@@ -69,6 +71,8 @@ BuildContainerSolid( G4VPhysicalVolume *pMotherPhysical )
   fContainerWallY = fNoVoxelY * fVoxelHalfY;
   fContainerWallZ = fNoVoxelZ * fVoxelHalfZ;
 
+  BuildMaterialRuns();
+
   // CheckVoxelsFillContainer();
 }
 
@@ -81,6 +85,8 @@ BuildContainerSolid( G4VSolid *pMotherSolid )
   fContainerWallY = fNoVoxelY * fVoxelHalfY;
   fContainerWallZ = fNoVoxelZ * fVoxelHalfZ;
 
+  BuildMaterialRuns();
+
   // CheckVoxelsFillContainer();
 }
 
@@ -227,6 +233,66 @@ CheckVoxelsFillContainer( G4double contX, G4double contY, G4double contZ ) const
 }
   
  
+//------------------------------------------------------------------
+void G4PhantomParameterisation::BuildMaterialRuns()
+{
+  fRunRowOffset.clear();
+  fRunStartX.clear();
+
+  if( (fNoVoxel == 0) || fMaterials.empty() )  { return; }
+
+  // Voxels are compared by material, not by index, as done when skipping
+  // surfaces of voxels with equal materials; ComputeMaterial() is used
+  // there and here, so that a derived parameterisation is respected
+  //
+  size_t nRows = fNoVoxelY*fNoVoxelZ;
+  fRunRowOffset.reserve( nRows+1 );
+  for( size_t row = 0; row < nRows; ++row )
+  {
+    fRunRowOffset.push_back( fRunStartX.size() );
+    size_t copyNo = row*fNoVoxelX;
+    G4Material* prevMate = ComputeMaterial( G4int(copyNo), 0, 0 );
+    fRunStartX.push_back( 0 );
+    for( size_t nx = 1; nx < fNoVoxelX; ++nx )
+    {
+      G4Material* mate = ComputeMaterial( G4int(copyNo+nx), 0, 0 );
+      if( mate != prevMate )
+      {
+        fRunStartX.push_back( nx );
+        prevMate = mate;
+      }
+    }
+  }
+  fRunRowOffset.push_back( fRunStartX.size() );
+}
+
+
+//------------------------------------------------------------------
+void G4PhantomParameterisation::
+GetMaterialRun( size_t nx, size_t ny, size_t nz,
+                size_t& firstX, size_t& lastX ) const
+{
+  if( fRunRowOffset.empty() )
+  {
+    firstX = lastX = nx;
+    return;
+  }
+
+  size_t row = ny + fNoVoxelY*nz;
+  std::vector<size_t>::const_iterator rowBegin
+    = fRunStartX.begin() + fRunRowOffset[row];
+  std::vector<size_t>::const_iterator rowEnd
+    = fRunStartX.begin() + fRunRowOffset[row+1];
+
+  // First run starting after nx; the run of nx is the previous one
+  //
+  std::vector<size_t>::const_iterator next
+    = std::upper_bound( rowBegin, rowEnd, nx );
+  firstX = *(next-1);
+  lastX = (next == rowEnd) ? fNoVoxelX-1 : *next-1;
+}
+
+
 //------------------------------------------------------------------
 G4int G4PhantomParameterisation::
 GetReplicaNo( const G4ThreeVector& localPoint, const G4ThreeVector& localDir )
@@ -41,6 +41,7 @@
 // ---------------------------------------------------------------------------
 
 #include <iomanip>
+#include <typeinfo>
 
 #include "G4PropagatorInField.hh"
 #include "G4ios.hh"
@@ -52,6 +53,7 @@
 #include "G4VCurvedTrajectoryFilter.hh"
 #include "G4ChordFinder.hh"
 #include "G4MultiLevelLocator.hh"
+#include "G4Mag_UsualEqRhs.hh"
 
 ///////////////////////////////////////////////////////////////////////////
 //
@@ -77,7 +79,10 @@ G4PropagatorInField::G4PropagatorInField( G4Navigator    *theNavigator,
     fVerbTracePiF(false),
     fFirstStepInVolume(true),
     fLastStepInVolume(true),
-    fNewTrack(true)
+    fNewTrack(true),
+    fUseHelix(false),
+    fHelixField(0.,0.,0.),
+    fHelixCof(0.)
 {
   if(fDetectorFieldMgr) { fEpsilonStep = fDetectorFieldMgr->GetMaximumEpsilonStep();}
   else                  { fEpsilonStep= 1.0e-5; } 
@@ -232,6 +237,10 @@ G4PropagatorInField::ComputeStep(
   // case that CurrentFieldManager has changed from the one of previous step
   RefreshIntersectionLocator();
 
+  // In a declared uniform field the path is an exact helix
+  //
+  fUseHelix = PrepareHelix();
+
   // G4cout << "G4PiF: Epsilon of current step - raw= " << raw_epsilon
   //        << " final= " << epsilon << G4endl;
 
@@ -327,13 +336,22 @@ G4PropagatorInField::ComputeStep(
 
     // Integrate as far as "chord miss" rule allows.
     //
-    s_length_taken = GetChordFinder()->AdvanceChordLimited( 
-                             CurrentState,    // Position & velocity
-                             h_TrialStepSize,
-                             fEpsilonStep,
-                             fPreviousSftOrigin,
-                             fPreviousSafety
-                             );
+    if( fUseHelix )
+    {
+      s_length_taken = HelixChordLimitedStep( SubStepStartState,
+                                              h_TrialStepSize );
+      AdvanceHelix( SubStepStartState, s_length_taken, CurrentState );
+    }
+    else
+    {
+      s_length_taken = GetChordFinder()->AdvanceChordLimited( 
+                               CurrentState,    // Position & velocity
+                               h_TrialStepSize,
+                               fEpsilonStep,
+                               fPreviousSftOrigin,
+                               fPreviousSafety
+                               );
+    }
     //  CurrentState is now updated with the final position and velocity. 
 
     fFull_CurveLen_of_LastAttempt = s_length_taken;
@@ -362,11 +380,22 @@ G4PropagatorInField::ComputeStep(
        //   of vol(A), if it exists. Start with point E as first "estimate".
        G4bool recalculatedEndPt= false;
        
-       G4bool found_intersection = fIntersectionLocator->
-         EstimateIntersectionPoint( SubStepStartState, CurrentState, 
+       G4bool found_intersection;
+       if( fUseHelix )
+       {
+         found_intersection = 
+           LocateHelixIntersection( SubStepStartState, CurrentState,
                                     InterSectionPointE, IntersectPointVelct_G,
-                                    recalculatedEndPt, fPreviousSafety,
-                                    fPreviousSftOrigin);
+                                    recalculatedEndPt );
+       }
+       else
+       {
+         found_intersection = fIntersectionLocator->
+           EstimateIntersectionPoint( SubStepStartState, CurrentState, 
+                                      InterSectionPointE, IntersectPointVelct_G,
+                                      recalculatedEndPt, fPreviousSafety,
+                                      fPreviousSftOrigin);
+       }
        intersects = found_intersection;
        if( found_intersection )
        {        
@@ -526,6 +555,170 @@ G4PropagatorInField::ComputeStep(
   return TruePathLength;
 }
 
+///////////////////////////////////////////////////////////////////////////
+//
+// Helix propagation in a declared uniform magnetic field
+
+G4bool G4PropagatorInField::PrepareHelix()
+{
+  if( !fCurrentFieldMgr->HasUniformFieldValue() )  { return false; }
+
+  // Only the usual equation of motion has the helix as exact solution:
+  // derived equations (spin, energy loss, ...) are integrated
+  //
+  G4EquationOfMotion* equation = GetCurrentEquationOfMotion();
+  if( (equation == nullptr) || (typeid(*equation) != typeid(G4Mag_UsualEqRhs)) )
+  {
+    return false;
+  }
+  fHelixField = fCurrentFieldMgr->GetUniformFieldValue();
+  fHelixCof = static_cast<G4Mag_UsualEqRhs*>(equation)->FCof();
+  return true;
+}
+
+void G4PropagatorInField::AdvanceHelix( const G4FieldTrack& startState,
+                                              G4double      curveLength,
+                                              G4FieldTrack& endState ) const
+{
+  // The momentum direction turns around the field with angular velocity
+  // (per unit length) omega = FCof * B / |p|
+  //
+  const G4ThreeVector momentum = startState.GetMomentum();
+  const G4double momentumMag = momentum.mag();
+  const G4ThreeVector direction = momentum / momentumMag;
+  const G4ThreeVector omega = (fHelixCof / momentumMag) * fHelixField;
+  const G4double omegaMag = omega.mag();
+
+  G4ThreeVector position = startState.GetPosition();
+  G4ThreeVector newDirection = direction;
+
+  const G4double angle = omegaMag * curveLength;
+  if( angle < 1.0e-12 )
+  {
+    position += curveLength * direction;
+  }
+  else
+  {
+    const G4ThreeVector axis = omega / omegaMag;
+    const G4ThreeVector dirParallel = (direction * axis) * axis;
+    const G4ThreeVector dirPerp = direction - dirParallel;
+    const G4ThreeVector axisCrossPerp = axis.cross(dirPerp);
+    const G4double sinA = std::sin(angle);
+    const G4double cosA = std::cos(angle);
+    const G4double halfSin = std::sin(0.5*angle);
+    const G4double oneMinusCos = 2.0*halfSin*halfSin;  // Avoid cancellation
+
+    position += curveLength * dirParallel
+              + (sinA / omegaMag) * dirPerp
+              - (oneMinusCos / omegaMag) * axisCrossPerp;
+    newDirection = dirParallel + cosA * dirPerp - sinA * axisCrossPerp;
+  }
+
+  endState = startState;
+  endState.SetPosition( position );
+  endState.SetMomentum( momentumMag * newDirection );
+  endState.SetCurveLength( startState.GetCurveLength() + curveLength );
+}
+
+G4double
+G4PropagatorInField::HelixChordLimitedStep( const G4FieldTrack& startState,
+                                                  G4double trialStepLength ) const
+{
+  const G4ThreeVector momentum = startState.GetMomentum();
+  const G4double curvature = std::fabs(fHelixCof)
+                           * momentum.cross(fHelixField).mag()
+                           / momentum.mag2();
+  if( curvature <= 0. )  { return trialStepLength; }  // Straight line
+
+  // Arc whose sagitta is delta chord, turning by at most one radian
+  //
+  const G4double deltaChord =
+    fCurrentFieldMgr->GetChordFinder()->GetDeltaChord();
+  G4double stepLength = std::min( std::sqrt( 8.0 * deltaChord / curvature ),
+                                  1.0 / curvature );
+
+  // An arc shorter than the remaining safety cannot reach any boundary
+  //
+  if( fUseSafetyForOptimisation )
+  {
+    G4double safety = fPreviousSafety
+      - (startState.GetPosition() - fPreviousSftOrigin).mag();
+    stepLength = std::max( stepLength, safety );
+  }
+  return std::min( stepLength, trialStepLength );
+}
+
+G4bool
+G4PropagatorInField::LocateHelixIntersection( const G4FieldTrack&  startState,
+                                              const G4FieldTrack&  endState,
+                                              const G4ThreeVector& trialPointE,
+                                                    G4FieldTrack&  intersection,
+                                                    G4bool&  recalculatedEndPt )
+{
+  const G4int maxIterations = 100;
+  const G4double deltaIntersection = fCurrentFieldMgr->GetDeltaIntersection();
+  const G4double curveStart = startState.GetCurveLength();
+
+  G4ThreeVector pointA = startState.GetPosition();
+  G4ThreeVector pointB = endState.GetPosition();
+  G4ThreeVector pointE = trialPointE;
+  G4double curveA = curveStart;
+  G4double curveB = endState.GetCurveLength();
+  G4double newSafety, linearStepLength;
+  G4ThreeVector pointE2;
+
+  recalculatedEndPt = false;
+  for( G4int iter = 0; iter < maxIterations; ++iter )
+  {
+    // Point G of the helix estimated from the position of E along chord AB
+    //
+    G4double chordAB = (pointB - pointA).mag();
+    G4double fraction = (chordAB > 0.) ? (pointE - pointA).mag() / chordAB
+                                       : 0.;
+    if( fraction > 1. )  { fraction = 1.; }
+    G4double curveG = curveA + fraction * (curveB - curveA);
+    AdvanceHelix( startState, curveG - curveStart, intersection );
+    G4ThreeVector pointG = intersection.GetPosition();
+
+    if( (pointG - pointE).mag() < deltaIntersection )
+    {
+      // As for the intersection locators, the point returned is E on
+      // the boundary, with the momentum and curve length of G
+      //
+      intersection.SetPosition( pointE );
+      return true;
+    }
+
+    if( IntersectChord( pointA, pointG, newSafety, linearStepLength, pointE2 ) )
+    {
+      // The boundary is between A and G
+      //
+      pointB = pointG;
+      curveB = curveG;
+    }
+    else
+    {
+      // The boundary is between G and B
+      //
+      fNavigator->LocateGlobalPointWithinVolume( pointG );
+      pointA = pointG;
+      curveA = curveG;
+      if( !IntersectChord( pointA, pointB, newSafety,
+                           linearStepLength, pointE2 ) )
+      {
+        return false;   // The helix passes by the boundary cut by the chord
+      }
+    }
+    pointE = pointE2;
+  }
+
+  // Not converged: end the step at the last point before the boundary
+  //
+  AdvanceHelix( startState, curveA - curveStart, intersection );
+  recalculatedEndPt = true;
+  return false;
+}
+
 ///////////////////////////////////////////////////////////////////////////
 //
 // Dumps status of propagator.
@@ -155,8 +155,6 @@ G4double G4RegularNavigation::ComputeStepSkippingEqualMaterials(
   }
 
 
-  G4double ourStep = 0.;
-
   // To get replica No: transform local point to the reference system of the
   // param container volume
   //
@@ -171,93 +169,160 @@ G4double G4RegularNavigation::ComputeStepSkippingEqualMaterials(
   //
   containerPoint = history.GetTransform(ide-1).TransformPoint(containerPoint);
 
-  // Store previous voxel translation to move localPoint by the difference
-  // with the new one
-  //
-  G4ThreeVector prevVoxelTranslation = containerPoint - localPoint;
-
-  // Do not use the expression below: There are cases where the
-  // fLastLocatedPointLocal does not give the correct answer
-  // (particle reaching a wall and bounced back, particle travelling through
-  // the wall that is deviated in an step, ...; these are pathological cases
-  // that give wrong answers in G4PhantomParameterisation::GetReplicaNo()
-  //
-  // G4ThreeVector prevVoxelTranslation = param->GetTranslation( copyNo );
-
   G4int copyNo = param->GetReplicaNo(containerPoint,localDirection);
 
   G4Material* currentMate = param->ComputeMaterial( copyNo, 0, 0 );
-  G4VSolid* voxelBox = pCurrentPhysical->GetLogicalVolume()->GetSolid();
 
-  G4VSolid* containerSolid = param->GetContainerSolid();
-  G4Material* nextMate;
+  // Traverse the voxel grid with a 3D-DDA: integer voxel indices are
+  // advanced along the axis whose wall is closest, tMax being the distance
+  // to the next wall in each axis and tDelta the distance to cross a whole
+  // voxel. No solid is queried and no replica number is recomputed
+  //
+  const G4int nVoxX = G4int(param->GetNoVoxelX());
+  const G4int nVoxY = G4int(param->GetNoVoxelY());
+  const G4int nVoxZ = G4int(param->GetNoVoxelZ());
+  const G4double halfX = param->GetVoxelHalfX();
+  const G4double halfY = param->GetVoxelHalfY();
+  const G4double halfZ = param->GetVoxelHalfZ();
+  const G4double wallX = nVoxX*halfX;
+  const G4double wallY = nVoxY*halfY;
+  const G4double wallZ = nVoxZ*halfZ;
+
+  G4int ix = copyNo%nVoxX;
+  G4int iy = (copyNo/nVoxX)%nVoxY;
+  G4int iz = copyNo/(nVoxX*nVoxY);
+
+  G4int stepX, stepY, stepZ;
+  G4double tMaxX, tMaxY, tMaxZ, tDeltaX, tDeltaY, tDeltaZ;
+  SetUpDDAAxis( containerPoint.x(), localDirection.x(), ix, halfX, wallX,
+                stepX, tMaxX, tDeltaX );
+  SetUpDDAAxis( containerPoint.y(), localDirection.y(), iy, halfY, wallY,
+                stepY, tMaxY, tDeltaY );
+  SetUpDDAAxis( containerPoint.z(), localDirection.z(), iz, halfZ, wallZ,
+                stepZ, tMaxZ, tDeltaZ );
+
+  // Material runs along x tell if the next voxel in x has the same
+  // material without looking it up
+  //
+  G4bool useRuns = (stepX != 0) && param->HasMaterialRuns();
+  size_t runFirstX = ix, runLastX = ix;
+  if( useRuns )  { param->GetMaterialRun( ix, iy, iz, runFirstX, runLastX ); }
+
+  const G4ThreeVector startPoint = containerPoint;
+  G4int startCopyNo = copyNo;
+  G4double tEntry = 0.;     // Distance at which the current voxel is entered
+  G4double tExit;
   G4bool bFirstStep = true;
-  G4double newStep;
-  G4double totalNewStep = 0.;
 
   // Loop while same material is found 
   //
   for( ;; )
   {
-    newStep = voxelBox->DistanceToOut( localPoint, localDirection );
+    tExit = tMaxX;
+    G4int axis = 0;
+    if( tMaxY < tExit )  { tExit = tMaxY; axis = 1; }
+    if( tMaxZ < tExit )  { tExit = tMaxZ; axis = 2; }
 
-    if( (bFirstStep) && (newStep < currentProposedStepLength) )
+    if( (bFirstStep) && (tExit < currentProposedStepLength) )
     {
       exiting  = true;
     }
     bFirstStep = false;
- 
-    newStep += kCarTolerance;   // Avoid precision problems
-    ourStep += newStep;
-    totalNewStep += newStep;
 
     // Physical process is limiting the step, don't continue
     //
-    if(std::fabs(totalNewStep-currentProposedStepLength) < kCarTolerance)
-    { 
-      return currentProposedStepLength;
-    }
-    if(totalNewStep > currentProposedStepLength) 
-    { 
+    if( tExit+kCarTolerance > currentProposedStepLength-kCarTolerance )
+    {
       G4RegularNavigationHelper::Instance()->
-        AddStepLength(copyNo, newStep-totalNewStep+currentProposedStepLength);
-      return currentProposedStepLength;
+        AddStepLength( copyNo, currentProposedStepLength-tEntry );
+      tExit = currentProposedStepLength-kCarTolerance;
+      break;
+    }
+    G4RegularNavigationHelper::Instance()->
+      AddStepLength( copyNo, tExit-tEntry );
+
+    // Move to the next voxel; stop at the wall of the container
+    //
+    G4bool sameMate = false;
+    if( axis == 0 )
+    {
+      ix += stepX;
+      if( ix < 0 || ix >= nVoxX )  { break; }
+      tMaxX += tDeltaX;
+      sameMate = useRuns && size_t(ix) >= runFirstX && size_t(ix) <= runLastX;
+    }
+    else if( axis == 1 )
+    {
+      iy += stepY;
+      if( iy < 0 || iy >= nVoxY )  { break; }
+      tMaxY += tDeltaY;
     }
     else
     {
-      G4RegularNavigationHelper::Instance()->AddStepLength( copyNo, newStep );
+      iz += stepZ;
+      if( iz < 0 || iz >= nVoxZ )  { break; }
+      tMaxZ += tDeltaZ;
     }
+    copyNo = ix + nVoxX*(iy + nVoxY*iz);
+    tEntry = tExit;
 
-
-    // Move container point until wall of voxel
+    // Check if material of next voxel is the same as that of the current voxel
     //
-    containerPoint += newStep*localDirection;
-    if( containerSolid->Inside( containerPoint ) != kInside )
+    if( !sameMate )
     {
-      break;
+      if( param->ComputeMaterial( copyNo, 0, 0 ) != currentMate )  { break; }
+      if( useRuns )
+      {
+        param->GetMaterialRun( ix, iy, iz, runFirstX, runLastX );
+      }
     }
+  }
 
-    // Get copyNo and translation of new voxel
-    //
-    copyNo = param->GetReplicaNo(containerPoint,localDirection);
-    G4ThreeVector voxelTranslation = param->GetTranslation( copyNo );
-
-    //    G4cout << " copyNo " << copyNo << " = " << pCurrentPhysical->GetCopyNo() << G4endl;
-    // Move local point until wall of voxel and then put it in the new voxel
-    // local coordinates
-    //
-    localPoint += newStep*localDirection;
-    localPoint += prevVoxelTranslation - voxelTranslation;
+  // Put the local point at the entry of the last voxel visited, in the
+  // local coordinates of that voxel
+  //
+  if( copyNo != startCopyNo )
+  {
+    ix = copyNo%nVoxX;
+    iy = (copyNo/nVoxX)%nVoxY;
+    iz = copyNo/(nVoxX*nVoxY);
+    G4ThreeVector voxelTranslation( (2*ix+1)*halfX - wallX,
+                                    (2*iy+1)*halfY - wallY,
+                                    (2*iz+1)*halfZ - wallZ );
+    localPoint = startPoint + (tEntry+kCarTolerance)*localDirection
+               - voxelTranslation;
+  }
 
-    prevVoxelTranslation = voxelTranslation;
+  return tExit+kCarTolerance;   // Avoid precision problems
+}
 
-    // Check if material of next voxel is the same as that of the current voxel
-    nextMate = param->ComputeMaterial( copyNo, 0, 0 );
 
-    if( currentMate != nextMate ) { break; }
+//------------------------------------------------------------------
+void G4RegularNavigation::SetUpDDAAxis( G4double pos, G4double dir,
+                                        G4int index, G4double half,
+                                        G4double wall, G4int& step,
+                                        G4double& tMax,
+                                        G4double& tDelta ) const
+{
+  if( dir > 0. )
+  {
+    step = 1;
+    tDelta = 2.*half/dir;
+    tMax = ((2*index+2)*half - wall - pos)/dir;
   }
-
-  return ourStep;
+  else if( dir < 0. )
+  {
+    step = -1;
+    tDelta = -2.*half/dir;
+    tMax = (2*index*half - wall - pos)/dir;
+  }
+  else
+  {
+    step = 0;
+    tDelta = kInfinity;
+    tMax = kInfinity;
+  }
+  if( tMax < 0. )  { tMax = 0.; }
 }
 
 
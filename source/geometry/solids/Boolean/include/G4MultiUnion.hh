@@ -38,6 +38,10 @@
 //   The constituent solids are stored with their respective location in an
 //   instance of "G4Node". An instance of "G4MultiUnion" is subsequently
 //   composed of one or several nodes.
+//   The inverse transformations of the nodes are computed once when the
+//   nodes are added. Optionally, a bounding volume hierarchy over the
+//   nodes can be used in place of the voxelization, which scales better
+//   for unions of thousands of components.
 
 // History:
 // 06.04.17 G.Cosmo - Imported implementation in Geant4 for VecGeom migration
@@ -55,6 +59,7 @@
 #include "G4Vector3D.hh"
 #include "G4SurfBits.hh"
 #include "G4Voxelizer.hh"
+#include "G4FacetBVH.hh"
 
 class G4Polyhedron;
 
@@ -64,7 +69,7 @@ class G4MultiUnion : public G4VSolid
 
   public:
 
-    G4MultiUnion() : G4VSolid("") {}
+    G4MultiUnion() : G4VSolid(""), fUseBVH(false) {}
     G4MultiUnion(const G4String& name);
     ~G4MultiUnion();
 
@@ -131,6 +136,11 @@ class G4MultiUnion : public G4VSolid
       // Finalize and prepare for use. User MUST call it once before
       // navigation use.
 
+    inline void SetUseBVH(G4bool flag);
+    inline G4bool GetUseBVH() const;
+      // Build a bounding volume hierarchy of the nodes in Voxelize(),
+      // instead of the voxelization. Off by default.
+
     EInside InsideNoVoxels(const G4ThreeVector& aPoint) const;
     inline G4Voxelizer& GetVoxels() const;
 
@@ -151,6 +161,17 @@ class G4MultiUnion : public G4VSolid
 
     EInside InsideWithExclusion(const G4ThreeVector& aPoint,
                                 G4SurfBits* bits = 0) const;
+    EInside InsideWithExclusion(const G4ThreeVector& aPoint,
+                                G4SurfBits* bits,
+                                std::vector<G4int>& candidates) const;
+      // Also return the candidates for the point, for reuse by the caller
+    G4int GetCandidates(const G4ThreeVector& aPoint,
+                        std::vector<G4int>& candidates,
+                        G4SurfBits* exclusion = 0) const;
+      // Nodes whose bounding box contains the point, from the hierarchy
+      // or from the voxelization
+    G4double DistanceToInBVH(const G4ThreeVector& aPoint,
+                             const G4ThreeVector& aDirection) const;
     G4int SafetyFromOutsideNumberNode(const G4ThreeVector& aPoint,
                                       G4double& safety) const;
     G4double DistanceToInCandidates(const G4ThreeVector& aPoint,
@@ -159,10 +180,12 @@ class G4MultiUnion : public G4VSolid
                                     G4SurfBits& bits) const;
 
     // Conversion utilities
-    inline G4ThreeVector GetLocalPoint(const G4Transform3D& trans,
+    inline G4ThreeVector GetLocalPoint(G4int node,
                                        const G4ThreeVector& gpoint) const;
-    inline G4ThreeVector GetLocalVector(const G4Transform3D& trans,
+    inline G4ThreeVector GetLocalVector(G4int node,
                                        const G4ThreeVector& gvec) const;
+    inline G4double SphereDistance(G4int node,
+                                   const G4ThreeVector& gpoint) const;
     inline G4ThreeVector GetGlobalPoint(const G4Transform3D& trans,
                                        const G4ThreeVector& lpoint) const;
     inline G4ThreeVector GetGlobalVector(const G4Transform3D& trans,
@@ -177,9 +200,20 @@ class G4MultiUnion : public G4VSolid
       G4VSolid* solid;
     };
 
+    struct G4MultiUnionFrame
+    {
+      G4Transform3D inverse;       // Global to local transformation
+      G4Transform3D rotation;      // Global to local rotation
+      G4ThreeVector centre;        // Bounding sphere of the node,
+      G4double radius;             // in the global frame
+    };
+
     std::vector<G4VSolid*> fSolids;
     std::vector<G4Transform3D> fTransformObjs;
+    std::vector<G4MultiUnionFrame> fFrames;
     G4Voxelizer fVoxels;           // Pointer to the vozelized solid
+    G4FacetBVH fBVH;               // Hierarchy of the nodes (optional)
+    G4bool fUseBVH;
     G4double       fCubicVolume;   // Cubic Volume
     G4double       fSurfaceArea;   // Surface Area
     G4double       kRadTolerance;  // Cached radial tolerance
@@ -219,33 +253,50 @@ inline void G4MultiUnion::SetAccurateSafety(G4bool flag)
   fAccurate = flag;
 }
 
+//______________________________________________________________________________
+inline void G4MultiUnion::SetUseBVH(G4bool flag)
+{
+  fUseBVH = flag;
+}
+
+//______________________________________________________________________________
+inline G4bool G4MultiUnion::GetUseBVH() const
+{
+  return fUseBVH;
+}
+
 //______________________________________________________________________________
 inline
-G4ThreeVector G4MultiUnion::GetLocalPoint(const G4Transform3D& trans,
+G4ThreeVector G4MultiUnion::GetLocalPoint(G4int node,
                                           const G4ThreeVector& global) const
 {
   // Returns local point coordinates converted from the global frame defined
-  // by the transformation. This is defined by multiplying the inverse
-  // transformation with the global vector.
+  // by the transformation of the node. This is defined by multiplying the
+  // inverse transformation, computed in AddNode(), with the global vector.
 
-  return trans.inverse()*G4Point3D(global);
+  return fFrames[node].inverse*G4Point3D(global);
 }
 
 //______________________________________________________________________________
 inline
-G4ThreeVector G4MultiUnion::GetLocalVector(const G4Transform3D& trans,
+G4ThreeVector G4MultiUnion::GetLocalVector(G4int node,
                                            const G4ThreeVector& global) const
 {
-  // Returns local point coordinates converted from the global frame defined
-  // by the transformation. This is defined by multiplying the inverse
-  // transformation with the global vector.
+  // Returns local vector components converted from the global frame defined
+  // by the transformation of the node, applying the inverse rotation only.
 
-  G4Rotate3D rot;
-  G4Translate3D transl ;
-  G4Scale3D scale;
+  return fFrames[node].rotation*G4Vector3D(global);
+}
 
-  trans.getDecomposition(scale,rot,transl);
-  return rot.inverse()*G4Vector3D(global);
+//______________________________________________________________________________
+inline
+G4double G4MultiUnion::SphereDistance(G4int node,
+                                      const G4ThreeVector& global) const
+{
+  // Returns a lower bound of the distance from the node, from its bounding
+  // sphere; negative if the point is inside the sphere.
+
+  return (global - fFrames[node].centre).mag() - fFrames[node].radius;
 }
 
 //______________________________________________________________________________
@@ -57,7 +57,7 @@ namespace
 
 //______________________________________________________________________________
 G4MultiUnion::G4MultiUnion(const G4String& name)
-  : G4VSolid(name), fAccurate(false),
+  : G4VSolid(name), fUseBVH(false), fAccurate(false),
     fRebuildPolyhedron(false), fpPolyhedron(0)
 {
   SetName(name);
@@ -78,6 +78,24 @@ void G4MultiUnion::AddNode(G4VSolid& solid, G4Transform3D& trans)
 {
   fSolids.push_back(&solid);
   fTransformObjs.push_back(trans);  // Store a local copy of transformations
+
+  // Precompute the inverse transformation and the bounding sphere of the
+  // node, the radius being the half diagonal of its local bounding box
+  //
+  G4Rotate3D rot;
+  G4Translate3D transl;
+  G4Scale3D scale;
+  trans.getDecomposition(scale,rot,transl);
+
+  G4ThreeVector min, max;
+  solid.BoundingLimits(min, max);
+
+  G4MultiUnionFrame frame;
+  frame.inverse = trans.inverse();
+  frame.rotation = rot.inverse();
+  frame.centre = GetGlobalPoint(trans, 0.5*(min + max));
+  frame.radius = 0.5*(max - min).mag();
+  fFrames.push_back(frame);
 }
 
 //______________________________________________________________________________
@@ -89,7 +107,7 @@ G4VSolid* G4MultiUnion::Clone() const
 // Copy constructor
 //______________________________________________________________________________
 G4MultiUnion::G4MultiUnion(const G4MultiUnion& rhs)
-  : G4VSolid(rhs),fCubicVolume (rhs.fCubicVolume),
+  : G4VSolid(rhs), fUseBVH(rhs.fUseBVH), fCubicVolume (rhs.fCubicVolume),
     fSurfaceArea (rhs.fSurfaceArea),
     kRadTolerance(rhs.kRadTolerance), fAccurate(false),
     fRebuildPolyhedron(false), fpPolyhedron(0)
@@ -99,7 +117,8 @@ G4MultiUnion::G4MultiUnion(const G4MultiUnion& rhs)
 // Fake default constructor for persistency
 //______________________________________________________________________________
 G4MultiUnion::G4MultiUnion( __void__& a )
-  : G4VSolid(a), fCubicVolume (0.), fSurfaceArea (0.), kRadTolerance(0.),
+  : G4VSolid(a), fUseBVH(false),
+    fCubicVolume (0.), fSurfaceArea (0.), kRadTolerance(0.),
     fAccurate(false), fRebuildPolyhedron(false), fpPolyhedron(0)
 {
 }
@@ -164,10 +183,9 @@ G4MultiUnion::DistanceToInNoVoxels(const G4ThreeVector& aPoint,
   for (G4int i = 0 ; i < numNodes ; ++i)
   {
     G4VSolid& solid = *fSolids[i];
-    const G4Transform3D& transform = fTransformObjs[i];
 
-    localPoint = GetLocalPoint(transform, aPoint);
-    localDirection = GetLocalVector(transform, direction);
+    localPoint = GetLocalPoint(i, aPoint);
+    localDirection = GetLocalVector(i, direction);
 
     G4double distance = solid.DistanceToIn(localPoint, localDirection);
     if (minDistance > distance) minDistance = distance;
@@ -189,10 +207,9 @@ G4double G4MultiUnion::DistanceToInCandidates(const G4ThreeVector& aPoint,
   {
     G4int candidate = candidates[i];
     G4VSolid& solid = *fSolids[candidate];
-    const G4Transform3D& transform = fTransformObjs[candidate];
 
-    localPoint = GetLocalPoint(transform, aPoint);
-    localDirection = GetLocalVector(transform, direction);
+    localPoint = GetLocalPoint(candidate, aPoint);
+    localDirection = GetLocalVector(candidate, direction);
     G4double distance = solid.DistanceToIn(localPoint, localDirection);
     if (minDistance > distance) minDistance = distance;
     bits.SetBitNumber(candidate);
@@ -215,6 +232,8 @@ G4double G4MultiUnion::DistanceToInCandidates(const G4ThreeVector& aPoint,
 G4double G4MultiUnion::DistanceToIn(const G4ThreeVector& aPoint,
                                     const G4ThreeVector& aDirection) const
 {
+  if (!fBVH.IsEmpty())  { return DistanceToInBVH(aPoint, aDirection); }
+
   G4double minDistance = kInfinity;
   G4ThreeVector direction = aDirection.unit();
   G4double shift = fVoxels.DistanceToFirst(aPoint, direction);
@@ -245,6 +264,59 @@ G4double G4MultiUnion::DistanceToIn(const G4ThreeVector& aPoint,
   return minDistance;
 }
 
+//______________________________________________________________________________
+G4double G4MultiUnion::DistanceToInBVH(const G4ThreeVector& aPoint,
+                                       const G4ThreeVector& aDirection) const
+{
+  // The nodes whose bounding box is crossed are visited from the closest
+  // along the direction; nodes beyond the closest intersection found are
+  // not tested.
+
+  G4ThreeVector direction = aDirection.unit();
+  G4double minDistance = kInfinity;
+
+  auto visitor = [&](const G4int* candidates, G4int count, G4double)
+  {
+    for (G4int i = 0; i < count; ++i)
+    {
+      G4int candidate = candidates[i];
+      G4VSolid& solid = *fSolids[candidate];
+      G4double distance = solid.DistanceToIn(GetLocalPoint(candidate, aPoint),
+                                      GetLocalVector(candidate, direction));
+      if (minDistance > distance) minDistance = distance;
+      if (minDistance == 0) return -1.;
+    }
+    return minDistance;
+  };
+  fBVH.TraverseRay(aPoint, direction, kInfinity, visitor);
+
+  return minDistance;
+}
+
+//______________________________________________________________________________
+G4int G4MultiUnion::GetCandidates(const G4ThreeVector& aPoint,
+                                  std::vector<G4int>& candidates,
+                                  G4SurfBits* exclusion) const
+{
+  if (fBVH.IsEmpty())
+  {
+    return fVoxels.GetCandidatesVoxelArray(aPoint, candidates, exclusion);
+  }
+
+  candidates.clear();
+  auto visitor = [&](const G4int* nodes, G4int count, G4double limit)
+  {
+    for (G4int i = 0; i < count; ++i)
+    {
+      if (!exclusion || !(*exclusion)[nodes[i]])
+        candidates.push_back(nodes[i]);
+    }
+    return limit;
+  };
+  fBVH.TraverseNearest(aPoint, 0., visitor);
+  return candidates.size();
+}
+
 //______________________________________________________________________________
 G4double G4MultiUnion::DistanceToOutNoVoxels(const G4ThreeVector& aPoint,
                                              const G4ThreeVector& aDirection,
@@ -271,8 +343,8 @@ G4double G4MultiUnion::DistanceToOutNoVoxels(const G4ThreeVector& aPoint,
     {
       G4VSolid& solid = *fSolids[i];
       const G4Transform3D& transform = fTransformObjs[i];
-      localPoint = GetLocalPoint(transform, currentPoint);
-      localDirection = GetLocalVector(transform, direction);
+      localPoint = GetLocalPoint(i, currentPoint);
+      localDirection = GetLocalVector(i, direction);
       EInside location = solid.Inside(localPoint);
       if (location != EInside::kOutside)
       {
@@ -331,7 +403,7 @@ G4double G4MultiUnion::DistanceToOutVoxels(const G4ThreeVector& aPoint,
   G4int numNodes = 2*fSolids.size();
   G4int count=0;
 
-  if (fVoxels.GetCandidatesVoxelArray(aPoint, candidates))
+  if (GetCandidates(aPoint, candidates))
   {
     // For normal case for which we presume the point is inside
     G4ThreeVector localPoint, localDirection, localNormal;
@@ -356,11 +428,10 @@ G4double G4MultiUnion::DistanceToOutVoxels(const G4ThreeVector& aPoint,
         // numerically the propagated point will be on its surface
 
         G4VSolid& solid = *fSolids[candidate];
-        const G4Transform3D& transform = fTransformObjs[candidate];
 
         // The coordinates of the point are modified so as to fit the
         // intrinsic solid local frame:
-        localPoint = GetLocalPoint(transform, currentPoint);
+        localPoint = GetLocalPoint(candidate, currentPoint);
 
         // DistanceToOut at least for Trd sometimes return non-zero value
         // even from points that are outside. Therefore, this condition
@@ -371,7 +442,7 @@ G4double G4MultiUnion::DistanceToOutVoxels(const G4ThreeVector& aPoint,
         {
           notOutside = true;
 
-          localDirection = GetLocalVector(transform, direction);
+          localDirection = GetLocalVector(candidate, direction);
 
           // propagate with solid.DistanceToOut
           G4double shift = solid.DistanceToOut(localPoint, localDirection,
@@ -398,7 +469,8 @@ G4double G4MultiUnion::DistanceToOutVoxels(const G4ThreeVector& aPoint,
 
         // the current component will be ignored
         exclusion.SetBitNumber(maxCandidate);
-        EInside location = InsideWithExclusion(currentPoint, &exclusion);
+        EInside location = InsideWithExclusion(currentPoint, &exclusion,
+                                               candidates);
 
         // perform a Inside
         // it should be excluded current solid from checking
@@ -414,11 +486,8 @@ G4double G4MultiUnion::DistanceToOutVoxels(const G4ThreeVector& aPoint,
         // if inside another component, redo 1 to 3 but add the next
         // DistanceToOut on top of the previous.
 
-        // and fill the candidates for the corresponding voxel (just
-        // exiting current component along direction)
-        candidates.clear();
-
-        fVoxels.GetCandidatesVoxelArray(currentPoint, candidates, &exclusion);
+        // the candidates for the corresponding voxel (just exiting current
+        // component along direction) were filled by InsideWithExclusion()
         exclusion.ResetBitNumber(maxCandidate);
       }
     }
@@ -431,6 +500,15 @@ G4double G4MultiUnion::DistanceToOutVoxels(const G4ThreeVector& aPoint,
 //______________________________________________________________________________
 EInside G4MultiUnion::InsideWithExclusion(const G4ThreeVector& aPoint,
                                           G4SurfBits* exclusion) const
+{
+  std::vector<G4int> candidates;
+  return InsideWithExclusion(aPoint, exclusion, candidates);
+}
+
+//______________________________________________________________________________
+EInside G4MultiUnion::InsideWithExclusion(const G4ThreeVector& aPoint,
+                                          G4SurfBits* exclusion,
+                                          std::vector<G4int>& candidates) const
 {
   // Classify point location with respect to solid:
   //  o eInside       - inside the solid
@@ -446,7 +524,6 @@ EInside G4MultiUnion::InsideWithExclusion(const G4ThreeVector& aPoint,
   G4ThreeVector localPoint;
   EInside location = EInside::kOutside;
 
-  std::vector<G4int> candidates;
   std::vector<G4MultiUnionSurface> surfaces;
 
   // TODO: test if it works well and if so measure performance
@@ -456,16 +533,15 @@ EInside G4MultiUnion::InsideWithExclusion(const G4ThreeVector& aPoint,
   // TODO: eventually GetVoxel should be inlined here, early exit if any
   //       binary search is -1
 
-  G4int limit = fVoxels.GetCandidatesVoxelArray(aPoint, candidates, exclusion);
+  G4int limit = GetCandidates(aPoint, candidates, exclusion);
   for (G4int i = 0 ; i < limit ; ++i)
   {
     G4int candidate = candidates[i];
     G4VSolid& solid = *fSolids[candidate];
-    const G4Transform3D& transform = fTransformObjs[candidate];
 
     // The coordinates of the point are modified so as to fit the intrinsic
     // solid local frame:
-    localPoint = GetLocalPoint(transform, aPoint);
+    localPoint = GetLocalPoint(candidate, aPoint);
     location = solid.Inside(localPoint);
     if (location == EInside::kInside) return EInside::kInside;
     else if (location == EInside::kSurface)
@@ -533,11 +609,10 @@ EInside G4MultiUnion::InsideNoVoxels(const G4ThreeVector& aPoint) const
   for (G4int i = 0 ; i < numNodes ; ++i)
   {
     G4VSolid& solid = *fSolids[i];
-    G4Transform3D transform = GetTransformation(i);
 
     // The coordinates of the point are modified so as to fit the
     // intrinsic solid local frame:
-    localPoint = GetLocalPoint(transform, aPoint);
+    localPoint = GetLocalPoint(i, aPoint);
 
     location = solid.Inside(localPoint);
 
@@ -662,7 +737,7 @@ G4ThreeVector G4MultiUnion::SurfaceNormal(const G4ThreeVector& aPoint) const
   // on a vertice remain to be treated
 
   // determine weather we are in voxel area
-  if (fVoxels.GetCandidatesVoxelArray(aPoint, candidates))
+  if (GetCandidates(aPoint, candidates))
   {
     G4int limit = candidates.size();
     for (G4int i = 0 ; i < limit ; ++i)
@@ -672,7 +747,7 @@ G4ThreeVector G4MultiUnion::SurfaceNormal(const G4ThreeVector& aPoint) const
 
       // The coordinates of the point are modified so as to fit the intrinsic
       // solid local frame:
-      localPoint = GetLocalPoint(transform, aPoint);
+      localPoint = GetLocalPoint(candidate, aPoint);
       G4VSolid& solid = *fSolids[candidate];
       EInside location = solid.Inside(localPoint);
 
@@ -698,7 +773,7 @@ G4ThreeVector G4MultiUnion::SurfaceNormal(const G4ThreeVector& aPoint) const
     // on none of the solids, the point was not on the surface
     G4VSolid& solid = *fSolids[node];
     const G4Transform3D& transform = fTransformObjs[node];
-    localPoint = GetLocalPoint(transform, aPoint);
+    localPoint = GetLocalPoint(node, aPoint);
 
     normal = GetGlobalVector(transform, solid.SurfaceNormal(localPoint));
     return normal.unit();
@@ -712,7 +787,7 @@ G4ThreeVector G4MultiUnion::SurfaceNormal(const G4ThreeVector& aPoint) const
     G4VSolid& solid = *fSolids[node];
 
     const G4Transform3D& transform = fTransformObjs[node];
-    localPoint = GetLocalPoint(transform, aPoint);
+    localPoint = GetLocalPoint(node, aPoint);
 
     // evaluate normal for point at this found solid
     // and transform multi-union coordinates
@@ -736,7 +811,7 @@ G4double G4MultiUnion::DistanceToOut(const G4ThreeVector& point) const
 
   // In general, the value return by DistanceToIn(p) will not be the exact
   // but only an undervalue (cf. overlaps)
-  fVoxels.GetCandidatesVoxelArray(point, candidates);
+  GetCandidates(point, candidates);
 
   G4int limit = candidates.size();
   for (G4int i = 0; i < limit; ++i)
@@ -745,8 +820,7 @@ G4double G4MultiUnion::DistanceToOut(const G4ThreeVector& point) const
 
     // The coordinates of the point are modified so as to fit the intrinsic
     // solid local frame:
-    const G4Transform3D& transform = fTransformObjs[candidate];
-    localPoint = GetLocalPoint(transform, point);
+    localPoint = GetLocalPoint(candidate, point);
     G4VSolid& solid = *fSolids[candidate];
     if (solid.Inside(localPoint) == EInside::kInside)
     {
@@ -766,6 +840,32 @@ G4double G4MultiUnion::DistanceToIn(const G4ThreeVector& point) const
   // any of its surfaces. The algorithm may be accurate or should provide a fast
   // underestimate.
 
+  if (!fBVH.IsEmpty())
+  {
+    if (!fAccurate)  { return fBVH.DistanceToBoundingBox(point); }
+
+    // Nodes are visited from the closest bounding box; those whose bounding
+    // sphere is further than the current safety are not computed
+    //
+    G4double safetyMin = kInfinity;
+    auto visitor = [&](const G4int* candidates, G4int count, G4double)
+    {
+      for (G4int i = 0; i < count; ++i)
+      {
+        G4int candidate = candidates[i];
+        if (SphereDistance(candidate, point) >= safetyMin) continue;
+        G4VSolid& solid = *fSolids[candidate];
+        G4double safety = solid.DistanceToIn(GetLocalPoint(candidate, point));
+        if (safetyMin > safety) safetyMin = safety;
+        if (safety <= 0) return -1.;
+          // it was detected, that the point is not located outside
+      }
+      return safetyMin;
+    };
+    fBVH.TraverseNearest(point, kInfinity, visitor);
+    return safetyMin;
+  }
+
   if (!fAccurate)  { return fVoxels.DistanceToBoundingBox(point); }
 
   const std::vector<G4VoxelBox>& boxes = fVoxels.GetBoxes();
@@ -775,6 +875,9 @@ G4double G4MultiUnion::DistanceToIn(const G4ThreeVector& point) const
   G4int numNodes = fSolids.size();
   for (G4int j = 0; j < numNodes; ++j)
   {
+    // the bounding sphere gives a cheap lower bound of the distance
+    if (SphereDistance(j, point) >= safetyMin) continue;
+
     G4ThreeVector dxyz;
     if (j > 0)
     {
@@ -798,8 +901,7 @@ G4double G4MultiUnion::DistanceToIn(const G4ThreeVector& point) const
         continue;
       }
     }
-    const G4Transform3D& transform = fTransformObjs[j];
-    localPoint = GetLocalPoint(transform, point);
+    localPoint = GetLocalPoint(j, point);
     G4VSolid& solid = *fSolids[j];
 
     G4double safety = solid.DistanceToIn(localPoint);
@@ -823,7 +925,32 @@ G4double G4MultiUnion::GetSurfaceArea()
 //______________________________________________________________________________
 void G4MultiUnion::Voxelize()
 {
-  fVoxels.Voxelize(fSolids, fTransformObjs);
+  if (!fUseBVH)
+  {
+    fBVH.Clear();
+    fVoxels.Voxelize(fSolids, fTransformObjs);
+    return;
+  }
+
+  // Bounding boxes of the nodes in the global frame, enlarged by the
+  // tolerance (relative for large solids, as for G4Orb)
+  //
+  G4double tolerance = G4GeometryTolerance::GetInstance()
+                       ->GetSurfaceTolerance();
+  G4int numNodes = fSolids.size();
+  std::vector<G4ThreeVector> bmin(numNodes), bmax(numNodes);
+  for (G4int i = 0; i < numNodes; ++i)
+  {
+    G4ThreeVector min, max;
+    fSolids[i]->BoundingLimits(min, max);
+    G4double tol = std::max(tolerance, 1.e-9*(max - min).mag());
+    min -= G4ThreeVector(tol, tol, tol);
+    max += G4ThreeVector(tol, tol, tol);
+    TransformLimits(min, max, fTransformObjs[i]);
+    bmin[i] = min;
+    bmax[i] = max;
+  }
+  fBVH.Build(bmin, bmax);
 }
 
 //______________________________________________________________________________
@@ -834,14 +961,38 @@ G4int G4MultiUnion::SafetyFromOutsideNumberNode(const G4ThreeVector& aPoint,
   // G4MultiUnion.
   // This is used to compute the normal in the case no candidate has been found.
 
-  const std::vector<G4VoxelBox>& boxes = fVoxels.GetBoxes();
   safetyMin = kInfinity;
   G4int safetyNode = 0;
   G4ThreeVector localPoint;
 
+  if (!fBVH.IsEmpty())
+  {
+    auto visitor = [&](const G4int* candidates, G4int count, G4double)
+    {
+      for (G4int i = 0; i < count; ++i)
+      {
+        G4int candidate = candidates[i];
+        if (SphereDistance(candidate, aPoint) >= safetyMin) continue;
+        G4VSolid& solid = *fSolids[candidate];
+        G4double safety = solid.DistanceToIn(GetLocalPoint(candidate, aPoint));
+        if (safetyMin > safety)
+        {
+          safetyMin = safety;
+          safetyNode = candidate;
+        }
+      }
+      return safetyMin;
+    };
+    fBVH.TraverseNearest(aPoint, kInfinity, visitor);
+    return safetyNode;
+  }
+
+  const std::vector<G4VoxelBox>& boxes = fVoxels.GetBoxes();
   G4int numNodes = fSolids.size();
   for (G4int i = 0; i < numNodes; ++i)
   {
+    if (SphereDistance(i, aPoint) >= safetyMin) continue;
+
     G4double d2xyz = 0.;
     G4double dxyz0 = std::abs(aPoint.x() - boxes[i].pos.x()) - boxes[i].hlen.x();
     if (dxyz0 > safetyMin) continue;
@@ -856,8 +1007,7 @@ G4int G4MultiUnion::SafetyFromOutsideNumberNode(const G4ThreeVector& aPoint,
     if (d2xyz >= safetyMin * safetyMin) continue;
 
     G4VSolid& solid = *fSolids[i];
-    const G4Transform3D& transform = fTransformObjs[i];
-    localPoint = GetLocalPoint(transform, aPoint);
+    localPoint = GetLocalPoint(i, aPoint);
     fAccurate = true;
     G4double safety = solid.DistanceToIn(localPoint);
     fAccurate = false;
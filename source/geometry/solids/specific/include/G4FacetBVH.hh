@@ -0,0 +1,146 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// $Id:$
+//
+// --------------------------------------------------------------------
+// GEANT 4 class header file
+//
+// G4FacetBVH
+//
+// Class description:
+//
+// Bounding volume hierarchy over the facets of a tessellated solid,
+// alternative to G4Voxelizer for meshes with a large number of facets.
+// The hierarchy is built top-down with a binned surface area heuristic;
+// each leaf holds at most kMaxLeafSize facets.
+// The bounding boxes of the facets are stored in leaf order, as separate
+// arrays of coordinates, so that the boxes of a whole leaf are tested
+// against a ray or a point in a single loop without branches.
+// Traversals hand the facets surviving the box tests to a visitor, which
+// performs the exact facet computations and returns the distance beyond
+// which further facets are not needed.
+// The hierarchy can also be built directly over a set of bounding boxes,
+// e.g. those of the nodes of a G4MultiUnion.
+
+// History:
+// - Created. 19/Oct/2018
+// --------------------------------------------------------------------
+
+#ifndef G4FacetBVH_HH
+#define G4FacetBVH_HH
+
+#include <vector>
+
+#include "G4Types.hh"
+#include "G4ThreeVector.hh"
+
+class G4VFacet;
+
+class G4FacetBVH
+{
+  public:
+
+    G4FacetBVH();
+   ~G4FacetBVH();
+
+    void Build(const std::vector<G4VFacet*>& facets);
+      // Build the hierarchy for the given facets, replacing any former one.
+    void Build(const std::vector<G4ThreeVector>& bmin,
+               const std::vector<G4ThreeVector>& bmax);
+      // Build the hierarchy for the given bounding boxes; the indices
+      // handed to the visitors are the indices of the boxes.
+    void Clear();
+      // Release the hierarchy.
+
+    inline G4bool IsEmpty() const;
+    inline G4int GetNumberOfNodes() const;
+    G4int AllocatedMemory() const;
+
+    G4double DistanceToBoundingBox(const G4ThreeVector& p) const;
+      // Distance from the bounding box of all facets, zero if inside.
+
+    G4bool IsExtreme(G4VFacet& facet,
+                     const std::vector<G4VFacet*>& facets) const;
+      // Return true if all vertices of the facets lie on or behind the
+      // plane of the given facet, as G4VFacet::IsInside().
+
+    template <class Visitor>
+    inline void TraverseRay(const G4ThreeVector& p, const G4ThreeVector& v,
+                            G4double limit, Visitor& visitor) const;
+      // Visit, ordered from the closest along the direction v, the leaves
+      // whose facet boxes are crossed by the ray from p at a distance not
+      // larger than limit. The visitor is called as
+      //   G4double visitor(const G4int* facets, G4int n, G4double limit)
+      // with the indices of the facets crossed in the leaf, and returns
+      // the new limit.
+
+    template <class Visitor>
+    inline void TraverseNearest(const G4ThreeVector& p, G4double limit,
+                                Visitor& visitor) const;
+      // Visit, ordered from the closest, the leaves whose facet boxes are
+      // within limit from p. The visitor is called as for TraverseRay().
+
+    static const G4int kMaxLeafSize = 8;
+    static const G4int kMaxDepth = 64;
+      // Maximum number of facets in a leaf and maximum depth of the tree.
+
+  private:
+
+    struct Node
+    {
+      G4ThreeVector bmin, bmax;
+      G4int first;  // First facet (leaf) or first of two children
+      G4int count;  // Number of facets, 0 for internal nodes
+    };
+
+    G4FacetBVH(const G4FacetBVH&);
+    G4FacetBVH& operator=(const G4FacetBVH&);
+
+    inline G4int LeafRay(const Node& node, const G4ThreeVector& p,
+                         const G4ThreeVector& inv, G4double limit,
+                         G4int* hits) const;
+    inline G4int LeafNearest(const Node& node, const G4ThreeVector& p,
+                             G4double limit2, G4int* hits) const;
+    static inline G4bool RayBox(const Node& node, const G4ThreeVector& p,
+                                const G4ThreeVector& inv, G4double limit,
+                                G4double& tnear);
+    static inline G4double BoxDistance2(const Node& node,
+                                        const G4ThreeVector& p);
+    static inline G4ThreeVector Inverse(const G4ThreeVector& v);
+
+  private:
+
+    std::vector<Node> fNodes;
+
+    // Facet boxes and facet indices, in leaf order
+    //
+    std::vector<G4double> fMinX, fMinY, fMinZ, fMaxX, fMaxY, fMaxZ;
+    std::vector<G4int> fFacet;
+};
+
+#include "G4FacetBVH.icc"
+
+#endif
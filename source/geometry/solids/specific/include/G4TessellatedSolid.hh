@@ -116,6 +116,7 @@
 #include "G4VSolid.hh"
 #include "G4Types.hh"
 #include "G4Voxelizer.hh"
+#include "G4FacetBVH.hh"
 
 struct G4VertexInfo
 {
@@ -191,6 +192,13 @@ class G4TessellatedSolid : public G4VSolid
 
     inline G4Voxelizer &GetVoxels();
 
+    void SetUseBVH(G4bool flag);
+    inline G4bool GetUseBVH() const;
+      // Use a bounding volume hierarchy of the facets in place of the
+      // voxelization; recommended for meshes of very many facets.
+      // If the solid is already closed, the hierarchy (or voxelization)
+      // is rebuilt.
+
     virtual G4bool CalculateExtent(const EAxis pAxis,
                                    const G4VoxelLimits& pVoxelLimit,
                                    const G4AffineTransform& pTransform,
@@ -223,10 +231,12 @@ class G4TessellatedSolid : public G4VSolid
                                          G4ThreeVector &aNormalVector,
                                          G4bool        &aConvex,
                                          G4double aPstep = kInfinity) const;
-    G4double DistanceToInCandidates(const std::vector<G4int> &candidates,
+    G4double DistanceToInCandidates(const G4int *candidates,
+                                          G4int candidatesCount,
                                     const G4ThreeVector &aPoint,
                                     const G4ThreeVector &aDirection) const;
-    void DistanceToOutCandidates(const std::vector<G4int> &candidates,
+    void DistanceToOutCandidates(const G4int *candidates,
+                                       G4int candidatesCount,
                                  const G4ThreeVector &aPoint,
                                  const G4ThreeVector &direction,
                                        G4double &minDist,
@@ -239,6 +249,7 @@ class G4TessellatedSolid : public G4VSolid
 
     EInside InsideNoVoxels (const G4ThreeVector &p) const;
     EInside InsideVoxels(const G4ThreeVector &aPoint) const;
+    EInside InsideBVH(const G4ThreeVector &aPoint) const;
 
     void Voxelize();
 
@@ -254,6 +265,11 @@ class G4TessellatedSolid : public G4VSolid
                                      G4ThreeVector &aNormalVector,
                                      G4bool        &aConvex,
                                      G4double aPstep = kInfinity) const;
+    G4double DistanceToInBVH(const G4ThreeVector &p,
+                             const G4ThreeVector &v) const;
+    G4double DistanceToOutBVH(const G4ThreeVector &p, const G4ThreeVector &v,
+                                    G4ThreeVector &aNormalVector,
+                                    G4bool        &aConvex) const;
 
     G4int SetAllUsingStack(const std::vector<G4int> &voxel,
                            const std::vector<G4int> &max,
@@ -267,6 +283,8 @@ class G4TessellatedSolid : public G4VSolid
 
     G4double MinDistanceFacet(const G4ThreeVector &p, G4bool simple,
                                     G4VFacet * &facet) const;
+    G4double MinDistanceFacetBVH(const G4ThreeVector &p, G4bool simple,
+                                       G4VFacet * &facet) const;
 
     inline G4bool OutsideOfExtent(const G4ThreeVector &p,
                                         G4double tolerance=0) const;
@@ -303,6 +321,9 @@ class G4TessellatedSolid : public G4VSolid
     G4Voxelizer fVoxels;  // Pointer to the voxelized solid
 
     G4SurfBits fInsides;
+
+    G4FacetBVH fBVH;  // Hierarchy of the facets, alternative to fVoxels
+    G4bool fUseBVH;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -324,6 +345,11 @@ inline G4Voxelizer &G4TessellatedSolid::GetVoxels()
   return fVoxels;
 }
 
+inline G4bool G4TessellatedSolid::GetUseBVH() const
+{
+  return fUseBVH;
+}
+
 inline G4bool G4TessellatedSolid::OutsideOfExtent(const G4ThreeVector &p,
                                                   G4double tolerance) const
 {
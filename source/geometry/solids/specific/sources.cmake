@@ -47,6 +47,8 @@ GEANT4_DEFINE_MODULE(NAME G4specsolids
         G4EnclosingCylinder.hh
         G4ExtrudedSolid.hh
         G4ExtrudedSolid.icc
+        G4FacetBVH.hh
+        G4FacetBVH.icc
         G4GenericPolycone.hh
         G4GenericPolycone.icc
         G4GenericTrap.hh
@@ -112,6 +114,7 @@ GEANT4_DEFINE_MODULE(NAME G4specsolids
         G4EllipticalTube.cc
         G4EnclosingCylinder.cc
         G4ExtrudedSolid.cc
+        G4FacetBVH.cc
         G4GenericPolycone.cc
         G4GenericTrap.cc
         G4Hype.cc
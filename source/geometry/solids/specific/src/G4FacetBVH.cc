@@ -0,0 +1,351 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// $Id:$
+//
+// --------------------------------------------------------------------
+// GEANT 4 class source file
+//
+// G4FacetBVH implementation
+//
+// History:
+// - Created. 19/Oct/2018
+// --------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "G4FacetBVH.hh"
+#include "G4VFacet.hh"
+#include "G4GeometryTolerance.hh"
+
+namespace
+{
+  const G4int kNumberOfBins = 16;
+
+  struct BuildTask
+  {
+    G4int node, first, count, depth;
+  };
+
+  inline G4double HalfArea(const G4ThreeVector& bmin,
+                           const G4ThreeVector& bmax)
+  {
+    G4ThreeVector d = bmax - bmin;
+    return d.x()*d.y() + d.y()*d.z() + d.z()*d.x();
+  }
+
+  inline void Enlarge(G4ThreeVector& bmin, G4ThreeVector& bmax,
+                      const G4ThreeVector& pmin, const G4ThreeVector& pmax)
+  {
+    bmin.set(std::min(bmin.x(),pmin.x()), std::min(bmin.y(),pmin.y()),
+             std::min(bmin.z(),pmin.z()));
+    bmax.set(std::max(bmax.x(),pmax.x()), std::max(bmax.y(),pmax.y()),
+             std::max(bmax.z(),pmax.z()));
+  }
+}
+
+//______________________________________________________________________________
+G4FacetBVH::G4FacetBVH()
+{
+}
+
+//______________________________________________________________________________
+G4FacetBVH::~G4FacetBVH()
+{
+}
+
+//______________________________________________________________________________
+void G4FacetBVH::Clear()
+{
+  std::vector<Node>().swap(fNodes);
+  std::vector<G4double>().swap(fMinX); std::vector<G4double>().swap(fMaxX);
+  std::vector<G4double>().swap(fMinY); std::vector<G4double>().swap(fMaxY);
+  std::vector<G4double>().swap(fMinZ); std::vector<G4double>().swap(fMaxZ);
+  std::vector<G4int>().swap(fFacet);
+}
+
+//______________________________________________________________________________
+G4int G4FacetBVH::AllocatedMemory() const
+{
+  G4int size = sizeof(*this);
+  size += fNodes.capacity()*sizeof(Node);
+  size += 6*fMinX.capacity()*sizeof(G4double);
+  size += fFacet.capacity()*sizeof(G4int);
+  return size;
+}
+
+//______________________________________________________________________________
+void G4FacetBVH::Build(const std::vector<G4VFacet*>& facets)
+{
+  Clear();
+  G4int nfacets = facets.size();
+  if (nfacets == 0)  { return; }
+
+  // Bounding boxes of the facets, enlarged by the surface tolerance so
+  // that flat facets do not give empty boxes
+  //
+  G4double tolerance =
+    G4GeometryTolerance::GetInstance()->GetSurfaceTolerance();
+  G4ThreeVector tol(tolerance, tolerance, tolerance);
+  std::vector<G4ThreeVector> bmin(nfacets), bmax(nfacets);
+  for (G4int i=0; i<nfacets; ++i)
+  {
+    const G4VFacet& facet = *facets[i];
+    G4ThreeVector pmin = facet.GetVertex(0), pmax = pmin;
+    G4int nv = facet.GetNumberOfVertices();
+    for (G4int k=1; k<nv; ++k)
+    {
+      G4ThreeVector vertex = facet.GetVertex(k);
+      Enlarge(pmin, pmax, vertex, vertex);
+    }
+    bmin[i] = pmin - tol;
+    bmax[i] = pmax + tol;
+  }
+  Build(bmin, bmax);
+}
+
+//______________________________________________________________________________
+void G4FacetBVH::Build(const std::vector<G4ThreeVector>& bmin,
+                       const std::vector<G4ThreeVector>& bmax)
+{
+  Clear();
+  G4int nfacets = bmin.size();
+  if (nfacets == 0)  { return; }
+
+  std::vector<G4ThreeVector> centre(nfacets);
+  std::vector<G4int> order(nfacets);
+  for (G4int i=0; i<nfacets; ++i)
+  {
+    centre[i] = 0.5*(bmin[i] + bmax[i]);
+    order[i] = i;
+  }
+
+  fNodes.reserve(2*(nfacets/kMaxLeafSize + 1));
+  fNodes.push_back(Node());
+
+  std::vector<BuildTask> tasks;
+  BuildTask root = { 0, 0, nfacets, 0 };
+  tasks.push_back(root);
+
+  while (!tasks.empty())
+  {
+    BuildTask task = tasks.back();
+    tasks.pop_back();
+
+    // Bounds of the facet boxes and of their centroids
+    //
+    G4ThreeVector nmin = bmin[order[task.first]], nmax = bmax[order[task.first]];
+    G4ThreeVector cmin = centre[order[task.first]], cmax = cmin;
+    for (G4int i=task.first+1; i<task.first+task.count; ++i)
+    {
+      Enlarge(nmin, nmax, bmin[order[i]], bmax[order[i]]);
+      Enlarge(cmin, cmax, centre[order[i]], centre[order[i]]);
+    }
+    fNodes[task.node].bmin = nmin;
+    fNodes[task.node].bmax = nmax;
+
+    if (task.count <= kMaxLeafSize)
+    {
+      fNodes[task.node].first = task.first;
+      fNodes[task.node].count = task.count;
+      continue;
+    }
+
+    // Split along the axis of largest extent of the centroids
+    //
+    G4ThreeVector extent = cmax - cmin;
+    G4int axis = (extent.x() > extent.y()) ? 0 : 1;
+    if (extent.z() > extent[axis])  { axis = 2; }
+
+    G4int* begin = &order[task.first];
+    G4int* end = begin + task.count;
+    G4int* middle = 0;
+
+    // Binned surface area heuristic; past half of the maximum depth
+    // only median splits are done, which bounds the depth of the tree
+    //
+    if (extent[axis] > 0. && task.depth < kMaxDepth/2)
+    {
+      G4int binCount[kNumberOfBins] = { 0 };
+      G4ThreeVector binMin[kNumberOfBins], binMax[kNumberOfBins];
+      G4double scale = kNumberOfBins/extent[axis];
+      for (G4int* it=begin; it!=end; ++it)
+      {
+        G4int b = std::min(kNumberOfBins-1,
+                           G4int((centre[*it][axis]-cmin[axis])*scale));
+        if (binCount[b]++ == 0)
+        {
+          binMin[b] = bmin[*it]; binMax[b] = bmax[*it];
+        }
+        else
+        {
+          Enlarge(binMin[b], binMax[b], bmin[*it], bmax[*it]);
+        }
+      }
+
+      // Sweep from the right, then from the left, evaluating the cost of
+      // the split after each bin
+      //
+      G4double rightArea[kNumberOfBins];
+      G4int rightCount[kNumberOfBins];
+      G4ThreeVector amin, amax;
+      G4int n = 0;
+      for (G4int b=kNumberOfBins-1; b>0; --b)
+      {
+        if (binCount[b] > 0)
+        {
+          if (n == 0) { amin = binMin[b]; amax = binMax[b]; }
+          else        { Enlarge(amin, amax, binMin[b], binMax[b]); }
+          n += binCount[b];
+        }
+        rightArea[b] = (n > 0) ? HalfArea(amin, amax) : 0.;
+        rightCount[b] = n;
+      }
+      G4double bestCost = kInfinity;
+      G4int bestBin = -1;
+      n = 0;
+      for (G4int b=0; b<kNumberOfBins-1; ++b)
+      {
+        if (binCount[b] > 0)
+        {
+          if (n == 0) { amin = binMin[b]; amax = binMax[b]; }
+          else        { Enlarge(amin, amax, binMin[b], binMax[b]); }
+          n += binCount[b];
+        }
+        if (n == 0 || rightCount[b+1] == 0)  { continue; }
+        G4double cost = n*HalfArea(amin, amax)
+                      + rightCount[b+1]*rightArea[b+1];
+        if (cost < bestCost)  { bestCost = cost; bestBin = b; }
+      }
+      if (bestBin >= 0)
+      {
+        G4int ax = axis;
+        middle = std::partition(begin, end, [&](G4int i)
+        {
+          return std::min(kNumberOfBins-1,
+                          G4int((centre[i][ax]-cmin[ax])*scale)) <= bestBin;
+        });
+        if (middle == begin || middle == end)  { middle = 0; }
+      }
+    }
+    if (middle == 0)
+    {
+      middle = begin + task.count/2;
+      G4int ax = axis;
+      std::nth_element(begin, middle, end, [&](G4int i, G4int j)
+      {
+        return centre[i][ax] < centre[j][ax];
+      });
+    }
+
+    G4int left = fNodes.size();
+    fNodes.push_back(Node());
+    fNodes.push_back(Node());
+    fNodes[task.node].first = left;
+    fNodes[task.node].count = 0;
+
+    G4int nleft = middle - begin;
+    BuildTask rightTask = { left+1, task.first+nleft, task.count-nleft,
+                            task.depth+1 };
+    BuildTask leftTask = { left, task.first, nleft, task.depth+1 };
+    tasks.push_back(rightTask);
+    tasks.push_back(leftTask);
+  }
+
+  // Facet boxes in leaf order
+  //
+  fMinX.resize(nfacets); fMinY.resize(nfacets); fMinZ.resize(nfacets);
+  fMaxX.resize(nfacets); fMaxY.resize(nfacets); fMaxZ.resize(nfacets);
+  fFacet.resize(nfacets);
+  for (G4int i=0; i<nfacets; ++i)
+  {
+    G4int k = order[i];
+    fMinX[i] = bmin[k].x(); fMinY[i] = bmin[k].y(); fMinZ[i] = bmin[k].z();
+    fMaxX[i] = bmax[k].x(); fMaxY[i] = bmax[k].y(); fMaxZ[i] = bmax[k].z();
+    fFacet[i] = k;
+  }
+}
+
+//______________________________________________________________________________
+G4double G4FacetBVH::DistanceToBoundingBox(const G4ThreeVector& p) const
+{
+  if (fNodes.empty())  { return kInfinity; }
+  return std::sqrt(BoxDistance2(fNodes[0], p));
+}
+
+//______________________________________________________________________________
+G4bool G4FacetBVH::IsExtreme(G4VFacet& facet,
+                             const std::vector<G4VFacet*>& facets) const
+{
+  // Nodes whose box lies entirely behind the plane of the facet cannot
+  // contain a vertex in front of it and are skipped
+  //
+  if (fNodes.empty())  { return false; }
+
+  G4ThreeVector p0 = facet.GetVertex(0);
+  G4ThreeVector n = facet.GetSurfaceNormal();
+
+  G4int stack[2*kMaxDepth];
+  G4int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+  {
+    const Node& node = fNodes[stack[--top]];
+    if (node.count > 0)
+    {
+      for (G4int k=node.first; k<node.first+node.count; ++k)
+      {
+        const G4VFacet& other = *facets[fFacet[k]];
+        G4int nv = other.GetNumberOfVertices();
+        for (G4int j=0; j<nv; ++j)
+        {
+          if (!facet.IsInside(other.GetVertex(j)))  { return false; }
+        }
+      }
+      continue;
+    }
+    G4double support[2];
+    for (G4int c=0; c<2; ++c)
+    {
+      const Node& child = fNodes[node.first+c];
+      support[c] = 0.;
+      for (G4int i=0; i<3; ++i)
+      {
+        support[c] += std::max(n[i]*(child.bmin[i]-p0[i]),
+                               n[i]*(child.bmax[i]-p0[i]));
+      }
+    }
+    G4bool left = (support[0] > 0.), right = (support[1] > 0.);
+    if (left && right)
+    {
+      G4bool leftFirst = (support[0] >= support[1]);
+      stack[top++] = leftFirst ? node.first+1 : node.first;
+      stack[top++] = leftFirst ? node.first : node.first+1;
+    }
+    else if (left)  { stack[top++] = node.first; }
+    else if (right) { stack[top++] = node.first+1; }
+  }
+  return true;
+}
@@ -190,6 +190,7 @@ void G4TessellatedSolid::Initialize()
 
   fGeometryType = "G4TessellatedSolid";
   fSolidClosed  = false;
+  fUseBVH       = false;
 
   fMinExtent.set(kInfinity,kInfinity,kInfinity);
   fMaxExtent.set(-kInfinity,-kInfinity,-kInfinity);
@@ -205,6 +206,7 @@ void G4TessellatedSolid::DeleteObjects ()
   for (G4int i = 0; i < size; ++i)  { delete fFacets[i]; }
   fFacets.clear();
   delete fpPolyhedron; fpPolyhedron = 0;
+  fBVH.Clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -218,6 +220,8 @@ void G4TessellatedSolid::CopyObjects (const G4TessellatedSolid &ts)
   else
     fVoxels.SetMaxVoxels(fmaxVoxels);
 
+  fUseBVH = ts.GetUseBVH();
+
   G4int n = ts.GetNumberOfFacets();
   for (G4int i = 0; i < n; ++i)
   {
@@ -427,6 +431,17 @@ void G4TessellatedSolid::Voxelize ()
 void G4TessellatedSolid::SetExtremeFacets()
 {
   G4int size = fFacets.size();
+  if (!fBVH.IsEmpty())
+  {
+    // The hierarchy skips the facets lying behind the plane of the facet
+    //
+    for (G4int j = 0; j < size; ++j)
+    {
+      G4VFacet &facet = *fFacets[j];
+      if (fBVH.IsExtreme(facet, fFacets)) fExtremeFacets.insert(&facet);
+    }
+    return;
+  }
   for (G4int j = 0; j < size; ++j)
   {
     G4VFacet &facet = *fFacets[j];
@@ -602,15 +617,26 @@ void G4TessellatedSolid::SetSolidClosed (const G4bool t)
 #endif
     CreateVertexList();
 
+    if (fUseBVH)
+    {
+#ifdef G4SPECSDEBUG    
+      G4cout << "Building bounding volume hierarchy..." << G4endl;
+#endif
+      fBVH.Build(fFacets);
+    }
+
 #ifdef G4SPECSDEBUG    
     G4cout << "Setting extreme facets..." << G4endl;
 #endif
     SetExtremeFacets();
     
+    if (!fUseBVH)
+    {
 #ifdef G4SPECSDEBUG    
-    G4cout << "Voxelizing..." << G4endl;
+      G4cout << "Voxelizing..." << G4endl;
 #endif
-    Voxelize();
+      Voxelize();
+    }
 
 #ifdef G4SPECSDEBUG
     DisplayAllocatedMemory();
@@ -620,6 +646,32 @@ void G4TessellatedSolid::SetSolidClosed (const G4bool t)
   fSolidClosed = t;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// SetUseBVH
+//
+// Select the bounding volume hierarchy or the voxelization of the facets
+// for the navigation queries. If the solid is already closed, the selected
+// structure is built if not yet available; a voxelization built before is
+// kept, but not used while the hierarchy is present.
+//
+void G4TessellatedSolid::SetUseBVH (G4bool flag)
+{
+  if (flag == fUseBVH) return;
+  fUseBVH = flag;
+  if (!fSolidClosed) return;
+
+  if (fUseBVH)
+  {
+    fBVH.Build(fFacets);
+  }
+  else
+  {
+    fBVH.Clear();
+    if (fVoxels.GetCountOfVoxels() == 0) Voxelize();
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 // GetSolidClosed
@@ -850,6 +902,130 @@ EInside G4TessellatedSolid::InsideVoxels(const G4ThreeVector &p) const
   return location;
 }
  
+///////////////////////////////////////////////////////////////////////////////
+//
+EInside G4TessellatedSolid::InsideBVH(const G4ThreeVector &p) const
+{
+  //
+  // First the simple test - check if we're outside of the X-Y-Z extremes
+  // of the tessellated solid.
+  //
+  if (OutsideOfExtent(p, kCarTolerance))
+    return kOutside;
+
+  const G4double dirTolerance = 1.0E-14;
+
+  //
+  // Check if we are close to a surface; only the facets whose boxes are
+  // within tolerance from the point are tested
+  //
+  G4bool onSurface = false;
+  G4double minDist = kInfinity;
+  auto nearest = [&](const G4int* candidates, G4int count, G4double limit)
+  {
+    for (G4int i = 0; i < count; ++i)
+    {
+      G4double dist = fFacets[candidates[i]]->Distance(p,minDist);
+      if (dist < minDist) minDist = dist;
+      if (dist <= kCarToleranceHalf)
+      {
+        onSurface = true;
+        return -1.;
+      }
+    }
+    return limit;
+  };
+  fBVH.TraverseNearest(p, kCarToleranceHalf, nearest);
+  if (onSurface) return kSurface;
+
+  //
+  // Same ray casting as in InsideVoxels(), the facets crossed by the ray
+  // being visited from the closest; facets further than the closest
+  // crossing found, plus tolerance, cannot change the result.
+  //
+  G4double distOut          = kInfinity;
+  G4double distIn           = kInfinity;
+  G4double distO            = 0.0;
+  G4double distI            = 0.0;
+  G4double distFromSurfaceO = 0.0;
+  G4double distFromSurfaceI = 0.0;
+  G4ThreeVector normalO, normalI;
+  G4bool crossingO          = false;
+  G4bool crossingI          = false;
+  EInside location          = kOutside;
+  G4int sm                  = 0;
+
+  G4bool nearParallel = false;
+  do
+  {
+    distOut = distIn = kInfinity;
+    nearParallel = false;
+    const G4ThreeVector &v = fRandir[sm];
+    sm++;
+
+    auto crossing = [&](const G4int* candidates, G4int count, G4double)
+    {
+      for (G4int i = 0; i < count; ++i)
+      {
+        G4VFacet &facet = *fFacets[candidates[i]];
+
+        crossingO = facet.Intersect(p,v,true,distO,distFromSurfaceO,normalO);
+        crossingI = facet.Intersect(p,v,false,distI,distFromSurfaceI,normalI);
+
+        if (crossingO || crossingI)
+        {
+          nearParallel = (crossingO
+                   && std::fabs(normalO.dot(v))<dirTolerance)
+                   || (crossingI && std::fabs(normalI.dot(v))<dirTolerance);
+          if (nearParallel) return -1.;
+
+          if (crossingO && distO > 0.0 && distO < distOut) 
+            distOut = distO;
+          if (crossingI && distI > 0.0 && distI < distIn)  
+            distIn  = distI;
+        }
+      }
+      return std::min(distIn, distOut) + kCarTolerance;
+    };
+    fBVH.TraverseRay(p, v, kInfinity, crossing);
+  }
+  while (nearParallel && sm!=fMaxTries);
+
+#ifdef G4VERBOSE
+  if (sm == fMaxTries)
+  {
+    //
+    // We've run out of random vector directions. If nTries is set sufficiently
+    // low (nTries <= 0.5*maxTries) then this would indicate that there is
+    // something wrong with geometry.
+    //
+    std::ostringstream message;
+    G4int oldprc = message.precision(16);
+    message << "Cannot determine whether point is inside or outside volume!"
+      << G4endl
+      << "Solid name       = " << GetName()  << G4endl
+      << "Geometry Type    = " << fGeometryType  << G4endl
+      << "Number of facets = " << fFacets.size() << G4endl
+      << "Position:"  << G4endl << G4endl
+      << "p.x() = "   << p.x()/mm << " mm" << G4endl
+      << "p.y() = "   << p.y()/mm << " mm" << G4endl
+      << "p.z() = "   << p.z()/mm << " mm";
+    message.precision(oldprc);
+    G4Exception("G4TessellatedSolid::Inside()",
+                "GeomSolids1002", JustWarning, message);
+  }
+#endif
+
+  if (distIn == kInfinity && distOut == kInfinity)
+    location = kOutside;
+  else if (distIn <= distOut - kCarToleranceHalf)
+    location = kOutside;
+  else if (distOut <= distIn - kCarToleranceHalf)
+    location = kInside;
+
+  return location;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 EInside G4TessellatedSolid::InsideNoVoxels (const G4ThreeVector &p) const
@@ -1004,7 +1180,11 @@ G4bool G4TessellatedSolid::Normal (const G4ThreeVector &p,
   G4double minDist;
   G4VFacet *facet = 0;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (!fBVH.IsEmpty())
+  {
+    minDist = MinDistanceFacetBVH(p, true, facet);
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     vector<G4int> curVoxel(3);
     fVoxels.GetVoxel(curVoxel, p);
@@ -1214,13 +1394,13 @@ G4TessellatedSolid::DistanceToOutNoVoxels (const G4ThreeVector &p,
 ///////////////////////////////////////////////////////////////////////////////
 //
 void G4TessellatedSolid::
-DistanceToOutCandidates(const std::vector<G4int> &candidates,
+DistanceToOutCandidates(const G4int *candidates,
+                              G4int candidatesCount,
                         const G4ThreeVector &aPoint,
                         const G4ThreeVector &direction,
                               G4double &minDist, G4ThreeVector &minNormal,
                               G4int &minCandidate ) const
 {
-  G4int candidatesCount = candidates.size();
   G4double dist            = 0.0;
   G4double distFromSurface = 0.0;
   G4ThreeVector normal;
@@ -1262,7 +1442,11 @@ G4TessellatedSolid::DistanceToOutCore(const G4ThreeVector &aPoint,
 {
   G4double minDistance;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (!fBVH.IsEmpty())
+  {
+    minDistance = DistanceToOutBVH(aPoint, aDirection, aNormalVector, aConvex);
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     minDistance = kInfinity;
 
@@ -1286,8 +1470,9 @@ G4TessellatedSolid::DistanceToOutCore(const G4ThreeVector &aPoint,
         old++;
       if (old != &candidates && candidates.size())
       {
-        DistanceToOutCandidates(candidates, aPoint, direction, minDistance,
-                                aNormalVector, minCandidate); 
+        DistanceToOutCandidates(&candidates[0], candidates.size(), aPoint,
+                                direction, minDistance, aNormalVector,
+                                minCandidate);
         if (minDistance <= totalShift) break; 
       }
 
@@ -1327,11 +1512,11 @@ G4TessellatedSolid::DistanceToOutCore(const G4ThreeVector &aPoint,
 ///////////////////////////////////////////////////////////////////////////////
 //
 G4double G4TessellatedSolid::
-DistanceToInCandidates(const std::vector<G4int> &candidates,
+DistanceToInCandidates(const G4int *candidates,
+                             G4int candidatesCount,
                        const G4ThreeVector &aPoint,
                        const G4ThreeVector &direction) const
 {
-  G4int candidatesCount = candidates.size();
   G4double dist            = 0.0;
   G4double distFromSurface = 0.0;
   G4ThreeVector normal;
@@ -1381,7 +1566,11 @@ G4TessellatedSolid::DistanceToInCore(const G4ThreeVector &aPoint,
 {
   G4double minDistance;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (!fBVH.IsEmpty())
+  {
+    minDistance = DistanceToInBVH(aPoint, aDirection);
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     minDistance = kInfinity;
     G4ThreeVector currentPoint = aPoint;
@@ -1403,7 +1592,8 @@ G4TessellatedSolid::DistanceToInCore(const G4ThreeVector &aPoint,
       const vector<G4int> &candidates = fVoxels.GetCandidates(curVoxel);
       if (candidates.size())
       {
-        G4double distance=DistanceToInCandidates(candidates, aPoint, direction);
+        G4double distance = DistanceToInCandidates(&candidates[0],
+                               candidates.size(), aPoint, direction);
         if (minDistance > distance) minDistance = distance;
         if (distance < totalShift) break;
       }
@@ -1426,6 +1616,68 @@ G4TessellatedSolid::DistanceToInCore(const G4ThreeVector &aPoint,
   return minDistance;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// Distances along a direction using the hierarchy of the facets: the
+// leaves are visited from the closest along the direction, and the
+// traversal stops beyond the closest intersection found.
+//
+G4double
+G4TessellatedSolid::DistanceToInBVH(const G4ThreeVector &aPoint,
+                                    const G4ThreeVector &aDirection) const
+{
+  G4double minDistance = kInfinity;
+  G4ThreeVector direction = aDirection.unit();
+
+  auto visitor = [&](const G4int* candidates, G4int count, G4double)
+  {
+    G4double distance = DistanceToInCandidates(candidates, count,
+                                               aPoint, direction);
+    if (minDistance > distance) minDistance = distance;
+    return (minDistance == 0.0) ? -1. : minDistance;
+  };
+  fBVH.TraverseRay(aPoint, direction, kInfinity, visitor);
+
+  return minDistance;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+G4double
+G4TessellatedSolid::DistanceToOutBVH(const G4ThreeVector &aPoint,
+                                     const G4ThreeVector &aDirection,
+                                           G4ThreeVector &aNormalVector,
+                                           G4bool &aConvex) const
+{
+  if (OutsideOfExtent(aPoint, kCarTolerance)) return 0;
+
+  G4double minDistance = kInfinity;
+  G4ThreeVector direction = aDirection.unit();
+  G4int minCandidate = -1;
+
+  auto visitor = [&](const G4int* candidates, G4int count, G4double)
+  {
+    DistanceToOutCandidates(candidates, count, aPoint, direction,
+                            minDistance, aNormalVector, minCandidate);
+    return (minCandidate >= 0 && minDistance == 0.0) ? -1. : minDistance;
+  };
+  fBVH.TraverseRay(aPoint, direction, kInfinity, visitor);
+
+  if (minCandidate < 0)
+  {
+    // No intersection found
+    minDistance = 0;
+    aConvex = false;
+    Normal(aPoint, aNormalVector);
+  }
+  else
+  {
+    aConvex = (fExtremeFacets.find(fFacets[minCandidate])
+            != fExtremeFacets.end());
+  }
+  return minDistance;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 G4bool
@@ -1487,6 +1739,35 @@ G4TessellatedSolid::MinDistanceFacet(const G4ThreeVector &p,
   return minDist;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+G4double
+G4TessellatedSolid::MinDistanceFacetBVH(const G4ThreeVector &p,
+                                              G4bool simple,
+                                              G4VFacet * &minFacet) const
+{
+  G4double minDist = kInfinity;
+
+  auto visitor = [&](const G4int* candidates, G4int count, G4double)
+  {
+    for (G4int i = 0; i < count; ++i)
+    {
+      G4VFacet &facet = *fFacets[candidates[i]];
+      G4double dist = simple ? facet.Distance(p,minDist)
+                             : facet.Distance(p,minDist,false);
+      if (dist < minDist)
+      {
+        minDist  = dist;
+        minFacet = &facet;
+      }
+    }
+    return minDist;
+  };
+  fBVH.TraverseNearest(p, kInfinity, visitor);
+
+  return minDist;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 G4double G4TessellatedSolid::SafetyFromOutside (const G4ThreeVector &p,
@@ -1511,7 +1792,15 @@ G4double G4TessellatedSolid::SafetyFromOutside (const G4ThreeVector &p,
 
   G4double minDist;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (!fBVH.IsEmpty())
+  {
+    if (!aAccurate)
+      return fBVH.DistanceToBoundingBox(p);
+
+    G4VFacet *facet;
+    minDist = MinDistanceFacetBVH(p, true, facet);
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     if (!aAccurate)
       return fVoxels.DistanceToBoundingBox(p);
@@ -1571,7 +1860,12 @@ G4TessellatedSolid::SafetyFromInside (const G4ThreeVector &p, G4bool) const
 
   if (OutsideOfExtent(p, kCarTolerance)) return 0.0;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (!fBVH.IsEmpty())
+  {
+    G4VFacet *facet;
+    minDist = MinDistanceFacetBVH(p, true, facet);
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     G4VFacet *facet;
     minDist = MinDistanceFacet(p, true, facet);
@@ -1646,7 +1940,11 @@ EInside G4TessellatedSolid::Inside (const G4ThreeVector &aPoint) const
 {
   EInside location;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (!fBVH.IsEmpty())
+  {
+    location = InsideBVH(aPoint);
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     location = InsideVoxels(aPoint);
   }
@@ -2097,7 +2395,8 @@ G4int G4TessellatedSolid::AllocatedMemory()
   G4int size = AllocatedMemoryWithoutVoxels();
   G4int sizeInsides = fInsides.GetNbytes();
   G4int sizeVoxels = fVoxels.AllocatedMemory();
-  size += sizeInsides + sizeVoxels;
+  G4int sizeBVH = fBVH.AllocatedMemory();
+  size += sizeInsides + sizeVoxels + sizeBVH;
   return size;
 }
 
@@ -40,7 +40,9 @@
 // Version:     1.0
 // Created:     1996-02-08
 // Author:      Juliet Armstrong
-// Updated:     2005-05-12 add SetGROUPVEL() by P. Gumplinger
+// Updated:     2018-10-19 flat index arrays for the built-in properties
+//                         and precomputed optical bundle
+//              2005-05-12 add SetGROUPVEL() by P. Gumplinger
 //              2002-11-05 add named material constants by P. Gumplinger
 //              1999-11-05 Migration from G4RWTPtrHashDictionary to STL
 //                         by John Allison
@@ -68,6 +70,35 @@
 // Class Definition
 /////////////////////
 
+struct G4MaterialOpticalBundle
+{
+  // Pointers to the properties used by the optical processes on every
+  // step, refreshed whenever the owning table is modified, so that a
+  // process can fetch all of them with a single call per step
+
+  G4MaterialPropertyVector* fRindex = nullptr;
+  G4MaterialPropertyVector* fGroupVel = nullptr;
+  G4MaterialPropertyVector* fAbsLength = nullptr;
+  G4MaterialPropertyVector* fRayleigh = nullptr;
+  G4MaterialPropertyVector* fMieHG = nullptr;
+  G4MaterialPropertyVector* fWLSAbsLength = nullptr;
+  G4MaterialPropertyVector* fReflectivity = nullptr;
+  G4MaterialPropertyVector* fRealRindex = nullptr;
+  G4MaterialPropertyVector* fImaginaryRindex = nullptr;
+  G4MaterialPropertyVector* fEfficiency = nullptr;
+  G4MaterialPropertyVector* fTransmittance = nullptr;
+  G4MaterialPropertyVector* fSpecularLobe = nullptr;
+  G4MaterialPropertyVector* fSpecularSpike = nullptr;
+  G4MaterialPropertyVector* fBackScatter = nullptr;
+
+  G4bool   fHasSurfaceRoughness = false;
+  G4double fSurfaceRoughness = 0.;
+  G4bool   fHasIsothermalCompressibility = false;
+  G4double fIsothermalCompressibility = 0.;
+  G4bool   fHasRSScaleFactor = false;
+  G4double fRSScaleFactor = 1.;
+};
+
 class G4MaterialPropertiesTable
 {
   public: // Without description
@@ -107,6 +138,9 @@ class G4MaterialPropertiesTable
     G4bool ConstPropertyExists(const char *key) const;
     // Return true if a const property 'key' exists.
 
+    G4bool ConstPropertyExists(const G4int index) const;
+    // Return true if a const property with key-index exists.
+
     G4MaterialPropertyVector* GetProperty(const char *key,
                                           G4bool warning=false);
     // Get the property from the table corresponding to the key-name.
@@ -126,6 +160,9 @@ class G4MaterialPropertiesTable
     G4int GetPropertyIndex(const G4String& key, G4bool warning=false) const;
     // Get the property index by the key-name.
 
+    inline const G4MaterialOpticalBundle& GetOpticalBundle() const;
+    // Get the precomputed set of properties used by the optical processes.
+
     std::vector<G4String> GetMaterialPropertyNames() const;
     std::vector<G4String> GetMaterialConstPropertyNames() const;
 
@@ -152,6 +189,12 @@ class G4MaterialPropertiesTable
     G4MaterialPropertyVector* SetGROUPVEL();
     // Dummy method: will be obsolete from the next (version 11) release
 
+    void SetPropertyEntry(G4int index, G4MaterialPropertyVector* mpv);
+    void SetConstPropertyEntry(G4int index, G4double value, G4bool exists);
+    // Mirror an update of MP/MCP into the flat arrays and optical bundle
+
+    void UpdateOpticalBundle();
+
   private:
 
     std::map<G4String, G4MaterialPropertyVector*, std::less<G4String> > MPT;
@@ -173,6 +216,14 @@ class G4MaterialPropertiesTable
                       std::less<G4int> >::const_iterator MCPiterator;
     //material property map and constant property map by index types
 
+    G4MaterialPropertyVector* fPropertyArray[kNumberOfPropertyIndex];
+    G4double fConstPropertyArray[kNumberOfConstPropertyIndex];
+    G4bool   fConstPropertySet[kNumberOfConstPropertyIndex];
+    // flat copies of MP and MCP for the built-in indices, avoiding a
+    // map lookup per step in the tracking
+
+    G4MaterialOpticalBundle fOpticalBundle;
+
     std::vector<G4String> G4MaterialPropertyName;
     std::vector<G4String> G4MaterialConstPropertyName;
     // vectors of strings of property names
@@ -35,7 +35,9 @@
 // Version:     1.0
 // Created:     1996-02-08
 // Author:      Juliet Armstrong
-// Updated:     2005-05-12 add SetGROUPVEL(), courtesy of
+// Updated:     2018-10-19 flat index arrays for the built-in properties
+//                         and precomputed optical bundle
+//              2005-05-12 add SetGROUPVEL(), courtesy of
 //              Horton-Smith (bug report #741), by P. Gumplinger
 //              2002-11-05 add named material constants by P. Gumplinger
 //              1999-11-05 Migration from G4RWTPtrHashDictionary to STL
@@ -59,6 +61,13 @@
 
 G4MaterialPropertiesTable::G4MaterialPropertiesTable()
 {
+  std::fill(fPropertyArray, fPropertyArray + kNumberOfPropertyIndex,
+            (G4MaterialPropertyVector*)nullptr);
+  std::fill(fConstPropertyArray,
+            fConstPropertyArray + kNumberOfConstPropertyIndex, 0.);
+  std::fill(fConstPropertySet,
+            fConstPropertySet + kNumberOfConstPropertyIndex, false);
+
   // elements of these 2 vectors must be in same order as
   // the corresponding enums in G4MaterialPropertiesIndex.hh
   G4MaterialPropertyName.push_back(G4String("RINDEX"));
@@ -142,6 +151,11 @@ G4MaterialPropertiesTable::~G4MaterialPropertiesTable()
   MP.clear();
   MCP.clear();
 
+  std::fill(fPropertyArray, fPropertyArray + kNumberOfPropertyIndex,
+            (G4MaterialPropertyVector*)nullptr);
+  std::fill(fConstPropertySet,
+            fConstPropertySet + kNumberOfConstPropertyIndex, false);
+
   G4MaterialPropertyName.clear();
   G4MaterialConstPropertyName.clear();
 }
@@ -190,9 +204,16 @@ G4double G4MaterialPropertiesTable::GetConstProperty(const G4int index) const
   // Returns the constant material property corresponding to an index
   // fatal exception if property not found
 
-  MCPiterator j;
-  j = MCP.find(index);
-  if ( j != MCP.end() ) return j->second;
+  if (index >= 0 && index < kNumberOfConstPropertyIndex)
+  {
+    if (fConstPropertySet[index]) return fConstPropertyArray[index];
+  }
+  else
+  {
+    MCPiterator j;
+    j = MCP.find(index);
+    if ( j != MCP.end() ) return j->second;
+  }
   G4ExceptionDescription ed;
   ed << "Constant Material Property Index " << index << " not found.";
   G4Exception("G4MaterialPropertiesTable::GetConstProperty()","mat202",
@@ -213,11 +234,17 @@ G4bool G4MaterialPropertiesTable::ConstPropertyExists(const char *key) const
 {
   // Returns true if a const property 'key' exists
   const G4int index = GetConstPropertyIndex(G4String(key));
+  return ConstPropertyExists(index);
+}
 
-  MCPiterator j;
-  j = MCP.find(index);
-  if ( j != MCP.end() ) return true;
-  return false;
+G4bool G4MaterialPropertiesTable::ConstPropertyExists(const G4int index) const
+{
+  // Returns true if a const property with the given index exists
+  if (index >= 0 && index < kNumberOfConstPropertyIndex)
+  {
+    return fConstPropertySet[index];
+  }
+  return (index >= 0 && MCP.find(index) != MCP.end());
 }
 
 G4MaterialPropertyVector*
@@ -232,9 +259,16 @@ G4MaterialPropertyVector*
 G4MaterialPropertiesTable::GetProperty(const G4int index, G4bool warning)
 {
   // Returns a Material Property Vector corresponding to an index
-  MPiterator i;
-  i = MP.find(index);
-  if ( i != MP.end() ) return i->second;
+  if (index >= 0 && index < kNumberOfPropertyIndex)
+  {
+    if (fPropertyArray[index] != nullptr) return fPropertyArray[index];
+  }
+  else
+  {
+    MPiterator i;
+    i = MP.find(index);
+    if ( i != MP.end() ) return i->second;
+  }
   if (warning) {
     G4ExceptionDescription ed;
     ed << "Material Property for index " << index << " not found.";
@@ -264,6 +298,7 @@ G4MaterialPropertyVector* G4MaterialPropertiesTable::AddProperty(
   G4MaterialPropertyVector *mpv = new G4MaterialPropertyVector(PhotonEnergies, 
                                                    PropertyValues, NumEntries);
   MP[index] = mpv;
+  SetPropertyEntry(index, mpv);
 
   // if key is RINDEX, we calculate GROUPVEL - 
   // contribution from Tao Lin (IHEP, the JUNO experiment) 
@@ -288,6 +323,7 @@ AddProperty(const char *key, G4MaterialPropertyVector *mpv)
   }
   G4int index = GetPropertyIndex(k);
   MP[ index ] = mpv;
+  SetPropertyEntry(index, mpv);
 
   // if key is RINDEX, we calculate GROUPVEL -
   // contribution from Tao Lin (IHEP, the JUNO experiment) 
@@ -322,6 +358,56 @@ void G4MaterialPropertiesTable::AddEntry(const char *key,
   }
 }
 
+void G4MaterialPropertiesTable::SetPropertyEntry(G4int index,
+                                                 G4MaterialPropertyVector* mpv)
+{
+  // Built-in indices are mirrored in the flat array, user defined
+  // properties are only kept in the map
+  if (index < 0 || index >= kNumberOfPropertyIndex) return;
+  fPropertyArray[index] = mpv;
+  UpdateOpticalBundle();
+}
+
+void G4MaterialPropertiesTable::SetConstPropertyEntry(G4int index,
+                                                      G4double value,
+                                                      G4bool exists)
+{
+  if (index < 0 || index >= kNumberOfConstPropertyIndex) return;
+  fConstPropertyArray[index] = exists ? value : 0.;
+  fConstPropertySet[index] = exists;
+  UpdateOpticalBundle();
+}
+
+void G4MaterialPropertiesTable::UpdateOpticalBundle()
+{
+  G4MaterialOpticalBundle& b = fOpticalBundle;
+
+  b.fRindex          = fPropertyArray[kRINDEX];
+  b.fGroupVel        = fPropertyArray[kGROUPVEL];
+  b.fAbsLength       = fPropertyArray[kABSLENGTH];
+  b.fRayleigh        = fPropertyArray[kRAYLEIGH];
+  b.fMieHG           = fPropertyArray[kMIEHG];
+  b.fWLSAbsLength    = fPropertyArray[kWLSABSLENGTH];
+  b.fReflectivity    = fPropertyArray[kREFLECTIVITY];
+  b.fRealRindex      = fPropertyArray[kREALRINDEX];
+  b.fImaginaryRindex = fPropertyArray[kIMAGINARYRINDEX];
+  b.fEfficiency      = fPropertyArray[kEFFICIENCY];
+  b.fTransmittance   = fPropertyArray[kTRANSMITTANCE];
+  b.fSpecularLobe    = fPropertyArray[kSPECULARLOBECONSTANT];
+  b.fSpecularSpike   = fPropertyArray[kSPECULARSPIKECONSTANT];
+  b.fBackScatter     = fPropertyArray[kBACKSCATTERCONSTANT];
+
+  b.fHasSurfaceRoughness = fConstPropertySet[kSURFACEROUGHNESS];
+  b.fSurfaceRoughness    = fConstPropertyArray[kSURFACEROUGHNESS];
+  b.fHasIsothermalCompressibility =
+    fConstPropertySet[kISOTHERMAL_COMPRESSIBILITY];
+  b.fIsothermalCompressibility =
+    fConstPropertyArray[kISOTHERMAL_COMPRESSIBILITY];
+  b.fHasRSScaleFactor = fConstPropertySet[kRS_SCALE_FACTOR];
+  b.fRSScaleFactor    = b.fHasRSScaleFactor ?
+                        fConstPropertyArray[kRS_SCALE_FACTOR] : 1.;
+}
+
 void G4MaterialPropertiesTable::DumpTable()
 {
   // material properties
@@ -41,6 +41,7 @@
 #define _G4GDMLEVALUATOR_INCLUDED_
 
 #include <vector>
+#include <map>
 
 #include "G4Evaluator.hh"
 
@@ -65,10 +66,17 @@ class G4GDMLEvaluator
    G4String ConvertToString(G4int ival);
    G4String ConvertToString(G4double dval);
 
+ private:
+
+   G4bool IsNumber(const G4String&, G4double&) const;
+
  private:
 
    G4Evaluator eval;
    std::vector<G4String> variableList;
+   std::map<G4String,G4double> cachedValues;
+     // Values of the expressions evaluated so far; invalidated whenever
+     // a variable changes value
 };
 
 #endif
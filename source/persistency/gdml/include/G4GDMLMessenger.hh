@@ -50,6 +50,7 @@ class G4UIcmdWithAString;
 class G4UIcmdWithADoubleAndUnit;
 class G4UIcmdWithoutParameter;
 class G4UIcmdWithABool;
+class G4UIcmdWithAnInteger;
 
 class G4GDMLMessenger : public G4UImessenger
 {
@@ -76,6 +77,8 @@ class G4GDMLMessenger : public G4UImessenger
     G4UIcmdWithABool*          SDCmd;    
     G4UIcmdWithABool*          StripCmd;    
     G4UIcmdWithABool*          AppendCmd;
+    G4UIcmdWithAnInteger*      ThreadsCmd;
+    G4UIcmdWithABool*          TimingCmd;
 
     G4bool pFlag;  // Append pointers to names flag   
 };
@@ -124,6 +124,8 @@ class G4GDMLParser
    inline void StripNamePointers() const;
    inline void SetStripFlag(G4bool);
    inline void SetOverlapCheck(G4bool);
+   inline void SetNumberOfThreads(G4int);
+   inline void SetTimingReport(G4bool);
    inline void SetRegionExport(G4bool);
    inline void SetEnergyCutsExport(G4bool);
    inline void SetSDExport(G4bool);
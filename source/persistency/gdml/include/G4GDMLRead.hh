@@ -133,6 +133,17 @@ class G4GDMLRead
      //
      // Activate/de-activate surface check for overlaps (default is off)
 
+   void SetNumberOfThreads(G4int);
+     //
+     // Set the number of threads completing concurrently the construction
+     // of tessellated solids (vertex lists and voxels); 0 uses all the
+     // cores. Effective only in multi-threaded mode (default is 1)
+
+   void TimingReport(G4bool);
+     //
+     // Activate/de-activate the report of the time spent parsing the
+     // file and reading each of its sections (default is off)
+
    const G4GDMLAuxListType* GetAuxList() const;
 
   
@@ -156,6 +167,8 @@ class G4GDMLRead
    G4bool validate;
    G4bool check;
    G4bool dostrip;
+   G4int nThreads;
+   G4bool timing;
 
  private:
 
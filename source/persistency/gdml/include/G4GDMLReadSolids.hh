@@ -40,6 +40,8 @@
 #ifndef _G4GDMLREADSOLIDS_INCLUDED_
 #define _G4GDMLREADSOLIDS_INCLUDED_
 
+#include <vector>
+
 #include "G4Types.hh"
 #include "G4GDMLReadMaterials.hh"
 #include "G4ExtrudedSolid.hh"
@@ -48,6 +50,7 @@
 class G4VSolid;
 class G4QuadrangularFacet;
 class G4TriangularFacet;
+class G4TessellatedSolid;
 class G4SurfaceProperty;
 class G4OpticalSurface;
 
@@ -109,6 +112,13 @@ class G4GDMLReadSolids : public G4GDMLReadMaterials
    rzPointType RZPointRead(const xercesc::DOMElement* const);
    void OpticalSurfaceRead(const xercesc::DOMElement* const);
    void PropertyRead(const xercesc::DOMElement* const,G4OpticalSurface*);
+   void CloseTessellatedSolids();
+
+ private:
+
+   std::vector<G4TessellatedSolid*> openTessellated;
+     // Tessellated solids read, to be closed at the end of the section
+   G4int solidsLevel;
   
 };
 
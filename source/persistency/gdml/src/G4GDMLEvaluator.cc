@@ -34,6 +34,7 @@
 // --------------------------------------------------------------------
 
 #include <sstream>
+#include <cstdlib>
 
 #include "G4GDMLEvaluator.hh"
 #include "G4SystemOfUnits.hh"
@@ -52,6 +53,7 @@ void G4GDMLEvaluator::Clear()
   eval.setSystemOfUnits(meter,kilogram,second,ampere,kelvin,mole,candela);
 
   variableList.clear();
+  cachedValues.clear();
 }
 
 void G4GDMLEvaluator::DefineConstant(const G4String& name, G4double value)
@@ -141,6 +143,7 @@ void G4GDMLEvaluator::SetVariable(const G4String& name, G4double value)
                  FatalException, error_msg);
    }
    eval.setVariable(name.c_str(),value);
+   cachedValues.clear();
 }
 
 G4bool G4GDMLEvaluator::IsVariable(const G4String& name) const
@@ -218,6 +221,15 @@ G4double G4GDMLEvaluator::Evaluate(const G4String& in)
 
    if (!expression.empty())
    {
+      // Plain numbers, the bulk of the attributes of large geometries,
+      // and expressions already met are not handed to the evaluator
+      //
+      if (IsNumber(expression, value))  { return value; }
+
+      std::map<G4String,G4double>::const_iterator pos
+        = cachedValues.find(expression);
+      if (pos != cachedValues.end())  { return pos->second; }
+
       value = eval.evaluate(expression.c_str());
 
       if (eval.status() != G4Evaluator::OK)
@@ -226,11 +238,40 @@ G4double G4GDMLEvaluator::Evaluate(const G4String& in)
          G4String error_msg = "Error in expression: " + expression;
          G4Exception("G4GDMLEvaluator::Evaluate()", "InvalidExpression",
                      FatalException, error_msg);
+         return value;
       }
+      cachedValues.insert(std::make_pair(expression, value));
    }
    return value;
 }
 
+G4bool G4GDMLEvaluator::IsNumber(const G4String& expression,
+                                       G4double& value) const
+{
+   // Accepts only decimal literals, possibly signed and with exponent,
+   // surrounded by blanks; anything else is left to the evaluator
+
+   const char* const str = expression.c_str();
+   const char* first = str;
+   while (*first==' ' || *first=='\t')  { ++first; }
+   for (const char* c = first; *c != 0; ++c)
+   {
+     if (!((*c>='0' && *c<='9') || *c=='.' || *c=='+' || *c=='-'
+         || *c=='e' || *c=='E' || *c==' ' || *c=='\t'))  { return false; }
+   }
+   if (*first=='+' || *first=='-')  { ++first; }
+   if (!((*first>='0' && *first<='9') || *first=='.'))  { return false; }
+
+   char* last = 0;
+   const G4double number = std::strtod(str, &last);
+   if (last == str)  { return false; }
+   while (*last==' ' || *last=='\t')  { ++last; }
+   if (*last != 0)  { return false; }
+
+   value = number;
+   return true;
+}
+
 G4int G4GDMLEvaluator::EvaluateInteger(const G4String& expression)
 {
    // This function is for evaluating integer expressions,
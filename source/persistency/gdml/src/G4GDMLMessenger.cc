@@ -39,6 +39,7 @@
 #include "G4UIdirectory.hh"
 #include "G4UIcmdWithAString.hh"
 #include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAnInteger.hh"
 #include "G4UIcmdWithoutParameter.hh"
 #include "G4GeometryManager.hh"
 #include "G4LogicalVolumeStore.hh"
@@ -106,6 +107,23 @@ G4GDMLMessenger::G4GDMLMessenger(G4GDMLParser* myPars)
   SDCmd->SetDefaultValue(false);
   SDCmd->AvailableForStates(G4State_Idle);
 
+  ThreadsCmd = new G4UIcmdWithAnInteger("/persistency/gdml/read_threads",this);
+  ThreadsCmd->SetGuidance("Set the number of threads completing concurrently");
+  ThreadsCmd->SetGuidance("the construction of tessellated solids when reading");
+  ThreadsCmd->SetGuidance("a GDML file. 0 uses all the cores.");
+  ThreadsCmd->SetGuidance("NOTE: effective only in multi-threaded mode!");
+  ThreadsCmd->SetParameterName("nThreads",true);
+  ThreadsCmd->SetDefaultValue(1);
+  ThreadsCmd->SetRange("nThreads >=0");
+  ThreadsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  TimingCmd = new G4UIcmdWithABool("/persistency/gdml/timing",this);
+  TimingCmd->SetGuidance("Enable/disable report of the time spent parsing");
+  TimingCmd->SetGuidance("and reading each section of a GDML file.");
+  TimingCmd->SetParameterName("timing",true);
+  TimingCmd->SetDefaultValue(true);
+  TimingCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
   ClearCmd = new G4UIcmdWithoutParameter("/persistency/gdml/clear",this);
   ClearCmd->SetGuidance("Clear geometry (before reading a new one from GDML).");
   ClearCmd->AvailableForStates(G4State_Idle);
@@ -124,6 +142,8 @@ G4GDMLMessenger::~G4GDMLMessenger()
   delete gdmlDir;
   delete StripCmd;
   delete AppendCmd;
+  delete ThreadsCmd;
+  delete TimingCmd;
 }
 
 void G4GDMLMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
@@ -140,6 +160,16 @@ void G4GDMLMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
     myParser->SetAddPointerToName(pFlag);
   }
 
+  if( command == ThreadsCmd )
+  {
+    myParser->SetNumberOfThreads(ThreadsCmd->GetNewIntValue(newValue));
+  }
+
+  if( command == TimingCmd )
+  {
+    myParser->SetTimingReport(TimingCmd->GetNewBoolValue(newValue));
+  }
+
   if( command == ReaderCmd )
   { 
     G4GeometryManager::GetInstance()->OpenGeometry();
@@ -36,6 +36,7 @@
 #include "G4GDMLRead.hh"
 
 #include "G4UnitsTable.hh"
+#include "G4Timer.hh"
 #include "G4Element.hh"
 #include "G4Material.hh"
 #include "G4SolidStore.hh"
@@ -43,7 +44,8 @@
 #include "G4PhysicalVolumeStore.hh"
 
 G4GDMLRead::G4GDMLRead()
-  : validate(true), check(false), dostrip(true), inLoop(0), loopCount(0)
+  : validate(true), check(false), dostrip(true), nThreads(1), timing(false),
+    inLoop(0), loopCount(0)
 {
    G4UnitDefinition::BuildUnitsTable();
 }
@@ -65,6 +67,16 @@ void G4GDMLRead::OverlapCheck(G4bool flag)
    check = flag;
 }
 
+void G4GDMLRead::SetNumberOfThreads(G4int n)
+{
+   nThreads = n;
+}
+
+void G4GDMLRead::TimingReport(G4bool flag)
+{
+   timing = flag;
+}
+
 G4String G4GDMLRead::GenerateName(const G4String& nameIn, G4bool strip)
 {
    G4String nameOut(nameIn);
@@ -393,12 +405,22 @@ void G4GDMLRead::Read(const G4String& fileName,
    parser->setDoSchema(validate);
    parser->setErrorHandler(handler);
 
+   G4Timer timer, allTimer;
+   if (timing)  { allTimer.Start(); timer.Start(); }
+
    try { parser->parse(fileName.c_str()); }
    catch (const xercesc::XMLException &e)
      { G4cout << "G4GDML: " << Transcode(e.getMessage()) << G4endl; }
    catch (const xercesc::DOMException &e)
      { G4cout << "G4GDML: " << Transcode(e.getMessage()) << G4endl; }
 
+   if (timing)
+   {
+      timer.Stop();
+      G4cout << "G4GDML: Parsing '" << fileName << "' took "
+             << timer.GetRealElapsed() << " s" << G4endl;
+   }
+
    xercesc::DOMDocument* doc = parser->getDocument();
 
    if (!doc)
@@ -440,6 +462,8 @@ void G4GDMLRead::Read(const G4String& fileName,
       }
       const G4String tag = Transcode(child->getTagName());
 
+      if (timing)  { timer.Start(); }
+
       if (tag=="define")    { DefineRead(child);    } else
       if (tag=="materials") { MaterialsRead(child); } else
       if (tag=="solids")    { SolidsRead(child);    } else
@@ -453,11 +477,26 @@ void G4GDMLRead::Read(const G4String& fileName,
         G4Exception("G4GDMLRead::Read()", "InvalidRead",
                     FatalException, error_msg);
       }
+
+      if (timing)
+      {
+         timer.Stop();
+         G4cout << "G4GDML: Reading " << tag << " took "
+                << timer.GetRealElapsed() << " s (user "
+                << timer.GetUserElapsed() << " s)" << G4endl;
+      }
    }
 
    delete parser;
    delete handler;
 
+   if (timing)
+   {
+      allTimer.Stop();
+      G4cout << "G4GDML: Reading '" << fileName << "' took "
+             << allTimer.GetRealElapsed() << " s in total" << G4endl;
+   }
+
    if (isModule)
    {
 #ifdef G4VERBOSE
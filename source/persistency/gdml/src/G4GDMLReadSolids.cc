@@ -31,6 +31,9 @@
 //
 // --------------------------------------------------------------------
 
+#include <algorithm>
+#include <atomic>
+
 #include "G4GDMLReadSolids.hh"
 #include "G4Box.hh"
 #include "G4Cons.hh"
@@ -65,13 +68,16 @@
 #include "G4TwistedTrap.hh"
 #include "G4TwistedTrd.hh"
 #include "G4TwistedTubs.hh"
+#include "G4Voxelizer.hh"
+#include "G4Threading.hh"
 #include "G4UnionSolid.hh"
 #include "G4OpticalSurface.hh"
 #include "G4UnitsTable.hh"
 #include "G4SurfaceProperty.hh"
 #include "G4MaterialPropertiesTable.hh"
 
-G4GDMLReadSolids::G4GDMLReadSolids() : G4GDMLReadMaterials()
+G4GDMLReadSolids::G4GDMLReadSolids()
+  : G4GDMLReadMaterials(), solidsLevel(0)
 {
 }
 
@@ -700,6 +706,7 @@ MultiUnionRead(const xercesc::DOMElement* const unionElement)
                     FatalException, error_msg);
       }
    }
+   CloseTessellatedSolids();
    multiUnion->Voxelize();
 }
 
@@ -1571,7 +1578,14 @@ TessellatedRead(const xercesc::DOMElement* const tessellatedElement)
         { tessellated->AddFacet(QuadrangularRead(child)); }
    }
 
-   tessellated->SetSolidClosed(true);
+   if (nThreads == 1)
+   {
+     tessellated->SetSolidClosed(true);
+   }
+   else
+   {
+     openTessellated.push_back(tessellated);
+   }
 }
 
 void G4GDMLReadSolids::TetRead(const xercesc::DOMElement* const tetElement)
@@ -2692,6 +2706,7 @@ void G4GDMLReadSolids::SolidsRead(const xercesc::DOMElement* const solidsElement
 #ifdef G4VERBOSE
    G4cout << "G4GDML: Reading solids..." << G4endl;
 #endif
+   ++solidsLevel;
    for (xercesc::DOMNode* iter = solidsElement->getFirstChild();
         iter != 0; iter = iter->getNextSibling())
    {
@@ -2749,6 +2764,59 @@ void G4GDMLReadSolids::SolidsRead(const xercesc::DOMElement* const solidsElement
                     FatalException, error_msg);
       }
    }
+   if (--solidsLevel == 0)  { CloseTessellatedSolids(); }
+}
+
+void G4GDMLReadSolids::CloseTessellatedSolids()
+{
+   // Closing a tessellated solid builds its vertex list and voxels, the
+   // costly part of its construction, which involves only the solid
+   // itself: solids are closed concurrently, largest first
+
+   const size_t nSolids = openTessellated.size();
+   if (nSolids == 0)  { return; }
+
+#ifdef G4MULTITHREADED
+   G4int nUsed = (nThreads > 0) ? nThreads
+                                : G4Threading::G4GetNumberOfCores();
+   if (size_t(nUsed) > nSolids)  { nUsed = G4int(nSolids); }
+   if (nUsed > 1)
+   {
+     std::sort(openTessellated.begin(), openTessellated.end(),
+               [](const G4TessellatedSolid* a, const G4TessellatedSolid* b)
+               { return a->GetNumberOfFacets() > b->GetNumberOfFacets(); });
+
+     const G4int voxelsCount = G4Voxelizer::GetDefaultVoxelsCount();
+     std::atomic<size_t> next(0);
+     auto closeSolids = [&]()
+     {
+       G4Voxelizer::SetDefaultVoxelsCount(voxelsCount);
+       for (size_t i=next++; i<nSolids; i=next++)
+       {
+         openTessellated[i]->SetSolidClosed(true);
+       }
+     };
+
+     std::vector<G4Thread> helpers;
+     for (G4int t=1; t<nUsed; ++t)
+     {
+       helpers.push_back(G4Thread(closeSolids));
+     }
+     closeSolids();
+     for (size_t t=0; t<helpers.size(); ++t)
+     {
+       G4THREADJOIN(helpers[t]);
+     }
+     openTessellated.clear();
+     return;
+   }
+#endif
+
+   for (size_t i=0; i<nSolids; ++i)
+   {
+     openTessellated[i]->SetSolidClosed(true);
+   }
+   openTessellated.clear();
 }
 
 G4VSolid* G4GDMLReadSolids::GetSolid(const G4String& ref) const
@@ -260,6 +260,8 @@ FileRead(const xercesc::DOMElement* const fileElement)
 
    const G4bool isModule = true;
    G4GDMLReadStructure structure;
+   structure.SetNumberOfThreads(nThreads);
+   structure.TimingReport(timing);
    structure.Read(name,validate,isModule);
 
    // Register existing auxiliar information defined in child module
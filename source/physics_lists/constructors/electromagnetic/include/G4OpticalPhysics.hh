@@ -100,6 +100,10 @@ class G4OpticalPhysics : public G4VPhysicsConstructor
     void SetScintillationStackPhotons(G4bool );
 
     void SetInvokeSD(G4bool );
+    void SetBoundaryTables(G4bool );
+
+    void SetFastPhotonTransport(G4bool );
+    void SetDeferredPhotonGeneration(G4bool );
 
   private:
 
@@ -149,11 +153,23 @@ class G4OpticalPhysics : public G4VPhysicsConstructor
     /// to call/not call InvokeSD method
     G4bool                      fInvokeSD;
 
+    /// option for G4OpBoundaryProcess to use the shared facet angle
+    /// tables and to reuse surface property values
+    G4bool                      fBoundaryTables;
+
     /// option to allow stacking of secondary Cerenkov photons
     G4bool                      fCerenkovStackPhotons;
     /// option to allow stacking of secondary Scintillation photons
     G4bool                      fScintillationStackPhotons;
 
+    /// option to propagate Cerenkov and Scintillation photons through
+    /// the bulk of the volume with G4OpticalPhotonTransport
+    G4bool                      fFastPhotonTransport;
+
+    /// option to keep records of the steps producing Cerenkov and
+    /// Scintillation light and to sample the photons later
+    G4bool                      fDeferredPhotonGeneration;
+
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
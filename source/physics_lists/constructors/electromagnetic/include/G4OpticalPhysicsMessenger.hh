@@ -63,6 +63,8 @@ class G4UIcommand;
 // - /process/optical/processActivation proc_name flag
 // - /process/optical/verbose level
 // - /process/optical/setTrackSecondariesFirst proc_name flag
+// - /process/optical/setFastPhotonTransport flag
+// - /process/optical/setDeferredPhotonGeneration flag
 // - /process/optical/defaults/cerenkov/setMaxPhotons val
 // - /process/optical/defaults/cerenkov/setMaxBetaChange val
 // - /process/optical/defaults/cerenkov/setStackPhotons flag
@@ -72,6 +74,7 @@ class G4UIcommand;
 // - /process/optical/defaults/scintillation/setStackPhotons flag
 // - /process/optical/defaults/wls/setTimeProfile val
 // - /process/optical/defaults/boundary/setInvokeSD flag
+// - /process/optical/defaults/boundary/setUseTables flag
 
 class G4OpticalPhysicsMessenger: public G4UImessenger
 {
@@ -147,6 +150,15 @@ private:
   /// setInvokeSD command
   G4UIcmdWithABool*      fSetInvokeSDCmd;
 
+  /// setUseTables command
+  G4UIcmdWithABool*      fSetBoundaryTablesCmd;
+
+  /// setFastPhotonTransport command
+  G4UIcmdWithABool*      fSetFastPhotonTransportCmd;
+
+  /// setDeferredPhotonGeneration command
+  G4UIcmdWithABool*      fSetDeferredPhotonGenerationCmd;
+
 };
 
 #endif // G4OpticalPhysicsMessenger_h
@@ -73,8 +73,11 @@ G4OpticalPhysics::G4OpticalPhysics(G4int verbose, const G4String& name)
     fScintillationByParticleType(false),
     fScintillationTrackInfo(false),
     fInvokeSD(true),
+    fBoundaryTables(false),
     fCerenkovStackPhotons(true),
-    fScintillationStackPhotons(true)
+    fScintillationStackPhotons(true),
+    fFastPhotonTransport(false),
+    fDeferredPhotonGeneration(false)
 {
   verboseLevel = verbose;
   fMessenger = new G4OpticalPhysicsMessenger(this);
@@ -294,6 +297,7 @@ void G4OpticalPhysics::ConstructProcess()
   G4OpBoundaryProcess* OpBoundaryProcess = new G4OpBoundaryProcess();
   UIhelpers::buildCommands(OpBoundaryProcess,DIR_CMDS"/boundary/",GUIDANCE" for boundary process");
   OpBoundaryProcess->SetInvokeSD(fInvokeSD);
+  OpBoundaryProcess->SetUseBoundaryTables(fBoundaryTables);
   OpProcesses[kBoundary] = OpBoundaryProcess;
 
   G4OpWLS* OpWLSProcess = new G4OpWLS();
@@ -326,6 +330,8 @@ void G4OpticalPhysics::ConstructProcess()
   ScintillationProcess->SetScintillationTrackInfo(fScintillationTrackInfo);
   ScintillationProcess->SetTrackSecondariesFirst(fProcessTrackSecondariesFirst[kScintillation]);
   ScintillationProcess->SetStackPhotons(fScintillationStackPhotons);
+  ScintillationProcess->SetFastPhotonTransport(fFastPhotonTransport);
+  ScintillationProcess->SetDeferredGeneration(fDeferredPhotonGeneration);
   G4EmSaturation* emSaturation = G4LossTableManager::Instance()->EmSaturation();
   ScintillationProcess->AddSaturation(emSaturation);
   UIhelpers::buildCommands(ScintillationProcess);
@@ -336,6 +342,8 @@ void G4OpticalPhysics::ConstructProcess()
   CerenkovProcess->SetMaxBetaChangePerStep(fMaxBetaChange);
   CerenkovProcess->SetTrackSecondariesFirst(fProcessTrackSecondariesFirst[kCerenkov]);
   CerenkovProcess->SetStackPhotons(fCerenkovStackPhotons);
+  CerenkovProcess->SetFastPhotonTransport(fFastPhotonTransport);
+  CerenkovProcess->SetDeferredGeneration(fDeferredPhotonGeneration);
   UIhelpers::buildCommands(CerenkovProcess);
   OpProcesses[kCerenkov] = CerenkovProcess;
 
@@ -462,6 +470,21 @@ void G4OpticalPhysics::SetInvokeSD(G4bool invokeSD)
   fInvokeSD = invokeSD;
 }
 
+void G4OpticalPhysics::SetBoundaryTables(G4bool val)
+{
+  fBoundaryTables = val;
+}
+
+void G4OpticalPhysics::SetFastPhotonTransport(G4bool val)
+{
+  fFastPhotonTransport = val;
+}
+
+void G4OpticalPhysics::SetDeferredPhotonGeneration(G4bool val)
+{
+  fDeferredPhotonGeneration = val;
+}
+
 void G4OpticalPhysics::SetCerenkovStackPhotons(G4bool stackingFlag)
 {
   fCerenkovStackPhotons = stackingFlag;
@@ -74,7 +74,10 @@ G4OpticalPhysicsMessenger::G4OpticalPhysicsMessenger(
     fSetWLSTimeProfileCmd(0),
     fSetTrackSecondariesFirstCmd(0),
     fSetFiniteRiseTimeCmd(0),
-    fSetInvokeSDCmd(0)
+    fSetInvokeSDCmd(0),
+    fSetBoundaryTablesCmd(0),
+    fSetFastPhotonTransportCmd(0),
+    fSetDeferredPhotonGenerationCmd(0)
 {
     G4bool toBeBroadcasted = false;
     fDir = new G4UIdirectory("/process/optical/defaults/",toBeBroadcasted);
@@ -188,6 +191,25 @@ G4OpticalPhysicsMessenger::G4OpticalPhysicsMessenger(
     fSetInvokeSDCmd->SetGuidance("Set option for calling InvokeSD in G4OpBoundaryProcess");
     fSetInvokeSDCmd->SetParameterName("InvokeSD", false);
     fSetInvokeSDCmd->AvailableForStates(G4State_PreInit);
+
+    fSetBoundaryTablesCmd = new G4UIcmdWithABool("/process/optical/defaults/boundary/setUseTables", this);
+    fSetBoundaryTablesCmd->SetGuidance("Sample the facet angle of the unified model from shared tables");
+    fSetBoundaryTablesCmd->SetGuidance("and reuse surface property values for repeated hits in G4OpBoundaryProcess");
+    fSetBoundaryTablesCmd->SetParameterName("UseTables", false);
+    fSetBoundaryTablesCmd->AvailableForStates(G4State_PreInit);
+
+    fSetFastPhotonTransportCmd = new G4UIcmdWithABool("/process/optical/setFastPhotonTransport", this);
+    fSetFastPhotonTransportCmd->SetGuidance("Propagate Cerenkov and scintillation photons through the bulk");
+    fSetFastPhotonTransportCmd->SetGuidance("of the volume before they are stacked; boundaries are left");
+    fSetFastPhotonTransportCmd->SetGuidance("to full tracking, bulk steps are not seen by user actions");
+    fSetFastPhotonTransportCmd->SetParameterName("FastPhotonTransport", false);
+    fSetFastPhotonTransportCmd->AvailableForStates(G4State_PreInit);
+
+    fSetDeferredPhotonGenerationCmd = new G4UIcmdWithABool("/process/optical/setDeferredPhotonGeneration", this);
+    fSetDeferredPhotonGenerationCmd->SetGuidance("Keep records of steps producing Cerenkov and scintillation light");
+    fSetDeferredPhotonGenerationCmd->SetGuidance("and sample the photons when the urgent stack is empty");
+    fSetDeferredPhotonGenerationCmd->SetParameterName("DeferredPhotonGeneration", false);
+    fSetDeferredPhotonGenerationCmd->AvailableForStates(G4State_PreInit);
 }
 
 G4OpticalPhysicsMessenger::~G4OpticalPhysicsMessenger()
@@ -209,6 +231,9 @@ G4OpticalPhysicsMessenger::~G4OpticalPhysicsMessenger()
   delete fSetTrackSecondariesFirstCmd;
   delete fSetFiniteRiseTimeCmd;
   delete fSetInvokeSDCmd;
+  delete fSetBoundaryTablesCmd;
+  delete fSetFastPhotonTransportCmd;
+  delete fSetDeferredPhotonGenerationCmd;
 }
 
 #include <iostream>
@@ -321,4 +346,16 @@ void G4OpticalPhysicsMessenger::SetNewValue(G4UIcommand* command,
     fOpticalPhysics
       ->SetInvokeSD(fSetInvokeSDCmd->GetNewBoolValue(newValue));
   }
+  else if (command == fSetBoundaryTablesCmd) {
+    fOpticalPhysics
+      ->SetBoundaryTables(fSetBoundaryTablesCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fSetFastPhotonTransportCmd) {
+    fOpticalPhysics->SetFastPhotonTransport(
+      fSetFastPhotonTransportCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fSetDeferredPhotonGenerationCmd) {
+    fOpticalPhysics->SetDeferredPhotonGeneration(
+      fSetDeferredPhotonGenerationCmd->GetNewBoolValue(newValue));
+  }
 }
@@ -36,7 +36,9 @@
 // Version:     2.0
 // Created:     1996-02-21
 // Author:      Juliet Armstrong
-// Updated:     2007-09-30 change inheritance to G4VDiscreteProcess
+// Updated:     2018-10-19 optional fast transport of photons in the bulk
+//                         and deferred generation of photons
+//              2007-09-30 change inheritance to G4VDiscreteProcess
 //              2005-07-28 add G4ProcessType to constructor
 //              1999-10-29 add method and class descriptors
 //              1997-04-09 by Peter Gumplinger
@@ -69,6 +71,9 @@
 #include "G4MaterialPropertiesTable.hh"
 #include "G4PhysicsOrderedFreeVector.hh"
 
+class G4OpticalPhotonBank;
+struct G4OpticalPhotonGenStep;
+
 // Class Description:
 // Discrete Process -- Generation of Cerenkov Photons.
 // Class inherits publicly from G4VDiscreteProcess.
@@ -184,6 +189,30 @@ public:
   G4int GetNumPhotons() const;
   // Returns the current number of scint. photons (after PostStepDoIt)
 
+  void SetFastPhotonTransport(const G4bool state);
+  // If set, the photons are kept in a G4OpticalPhotonBank and
+  // propagated through the bulk of the volume by
+  // G4OpticalPhotonTransport; only the photons which survive are
+  // added as secondaries, at their last position before a boundary
+
+  G4bool GetFastPhotonTransport() const;
+  // Returns the boolean flag for the fast photon transport
+
+  void SetDeferredGeneration(const G4bool state);
+  // If set, no photons are created in PostStepDoIt; a
+  // G4OpticalPhotonGenStep record of the step is passed to
+  // G4OpticalPhotonGenerator, which samples the photons when
+  // the urgent stack is empty
+
+  G4bool GetDeferredGeneration() const;
+  // Returns the boolean flag for the deferred generation
+
+  void SamplePhoton(const G4OpticalPhotonGenStep& genStep,
+                    G4ThreeVector& position, G4ThreeVector& direction,
+                    G4ThreeVector& polarization,
+                    G4double& energy, G4double& time) const;
+  // Samples one photon of the record
+
   G4PhysicsTable* GetPhysicsTable() const;
   // Returns the address of the physics table.
 
@@ -223,6 +252,10 @@ private:
   G4bool fStackingFlag;
 
   G4int fNumPhotons;
+
+  G4bool fFastPhotonTransport;
+  G4bool fDeferredGeneration;
+  G4OpticalPhotonBank* fPhotonBank;
 };
 
   ////////////////////
@@ -265,6 +298,30 @@ G4int G4Cerenkov::GetNumPhotons() const
         return fNumPhotons;
 }
 
+inline
+void G4Cerenkov::SetFastPhotonTransport(const G4bool state)
+{
+        fFastPhotonTransport = state;
+}
+
+inline
+G4bool G4Cerenkov::GetFastPhotonTransport() const
+{
+        return fFastPhotonTransport;
+}
+
+inline
+void G4Cerenkov::SetDeferredGeneration(const G4bool state)
+{
+        fDeferredGeneration = state;
+}
+
+inline
+G4bool G4Cerenkov::GetDeferredGeneration() const
+{
+        return fDeferredGeneration;
+}
+
 inline
 G4PhysicsTable* G4Cerenkov::GetPhysicsTable() const
 {
@@ -0,0 +1,93 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+////////////////////////////////////////////////////////////////////////
+// Optical Photon Generation Record
+////////////////////////////////////////////////////////////////////////
+//
+// File:        G4OpticalPhotonGenStep.hh
+// Description: Compact record of one step of a charged particle which
+//              produced Cerenkov or scintillation light. It contains all
+//              what is needed to sample the photons later with
+//              G4Cerenkov::SamplePhoton or G4Scintillation::SamplePhoton:
+//              the step end points, the number of photons, the material
+//              and the emission spectrum, the scintillation time
+//              constants of one component or the Cerenkov cone data.
+// Created:     2018-10-19
+//
+////////////////////////////////////////////////////////////////////////
+
+#ifndef G4OpticalPhotonGenStep_h
+#define G4OpticalPhotonGenStep_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4TouchableHandle.hh"
+#include "G4PhysicsOrderedFreeVector.hh"
+
+class G4VProcess;
+class G4Material;
+
+struct G4OpticalPhotonGenStep
+{
+  const G4VProcess*  fCreator = nullptr;  // G4Cerenkov or G4Scintillation
+  G4int              fCreatorSubType = 0; // fCerenkov or fScintillation
+  G4int              fParentID = 0;
+  G4double           fWeight = 1.0;       // weight of the photons
+  G4TouchableHandle  fTouchable;          // pre-step point of the parent
+  const G4Material*  fMaterial = nullptr;
+  G4int              fNumPhotons = 0;     // photons left to generate
+  G4double           fMeanNumberOfPhotons = 0.0;
+  G4double           fSurvivalProbability = 1.0; // set by biasing
+
+  // step of the parent
+  G4ThreeVector      fPosition;           // pre-step position
+  G4ThreeVector      fDeltaPosition;
+  G4ThreeVector      fDirection;          // unit vector along the step
+  G4double           fStepLength = 0.0;
+  G4double           fTime = 0.0;         // pre-step global time
+  G4double           fPreVelocity = 0.0;
+  G4double           fPostVelocity = 0.0;
+  G4bool             fAlongStep = true;   // false: photons at the end
+
+  // emission spectrum: scintillation integral or RINDEX
+  G4PhysicsOrderedFreeVector* fSpectrum = nullptr;
+  G4double           fSpectrumMax = 0.0;  // max of the integral
+  G4double           fEnergyMin = 0.0;
+  G4double           fEnergyRange = 0.0;
+
+  // scintillation component
+  G4int              fScintillationType = 0;
+  G4double           fDecayTime = 0.0;
+  G4double           fRiseTime = 0.0;
+
+  // Cerenkov cone
+  G4double           fBetaInverse = 0.0;
+  G4double           fMaxSin2 = 0.0;
+  G4double           fMeanNumberOfPhotons1 = 0.0;
+  G4double           fMeanNumberOfPhotons2 = 0.0;
+};
+
+#endif
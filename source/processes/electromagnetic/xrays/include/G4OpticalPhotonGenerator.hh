@@ -0,0 +1,169 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+////////////////////////////////////////////////////////////////////////
+// Deferred Optical Photon Generator
+////////////////////////////////////////////////////////////////////////
+//
+// File:        G4OpticalPhotonGenerator.hh
+// Description: Thread local store of G4OpticalPhotonGenStep records 
+//              filled by G4Cerenkov and G4Scintillation in deferred 
+//              mode. G4EventManager asks for tracks when the urgent
+//              and waiting stacks are empty; photons are then sampled
+//              in chunks of limited size, so an event with millions
+//              of photons never holds all of them as G4Tracks at the
+//              same time.
+//
+//              An optional G4VOpticalGenStepBiasing gives for each 
+//              record the probability to keep its photons: 0 rejects
+//              the record before any photon is sampled, otherwise
+//              photons are kept with this probability and their
+//              weight is divided by it.
+//
+//              If the creator process has fast photon transport 
+//              enabled, the photons of a chunk are propagated with
+//              G4OpticalPhotonTransport before tracks are made.
+//              The energy of the photons absorbed there cannot be 
+//              deposited in the step of the parent, which is gone, so
+//              stepping actions and scorers do not see it as they do
+//              in eager mode; it is summed per event and available to
+//              user actions, and a warning is issued once when fast
+//              transport is combined with deferred generation.
+// Created:     2018-10-19
+//
+////////////////////////////////////////////////////////////////////////
+
+#ifndef G4OpticalPhotonGenerator_h
+#define G4OpticalPhotonGenerator_h 1
+
+#include "globals.hh"
+#include "G4VDeferredTrackGenerator.hh"
+#include "G4OpticalPhotonGenStep.hh"
+#include "G4OpticalPhotonBank.hh"
+#include "G4ThreadLocalSingleton.hh"
+#include <vector>
+
+class G4VOpticalGenStepBiasing
+{
+public:
+
+  G4VOpticalGenStepBiasing() {};
+  virtual ~G4VOpticalGenStepBiasing() {};
+
+  virtual G4double GetSurvivalProbability(const G4OpticalPhotonGenStep&) = 0;
+  // Returns probability in [0,1] to keep photons of the record
+};
+
+class G4OpticalPhotonGenerator : public G4VDeferredTrackGenerator
+{
+
+friend class G4ThreadLocalSingleton<G4OpticalPhotonGenerator>;
+
+public:
+
+  static G4OpticalPhotonGenerator* GetInstance();
+
+  virtual ~G4OpticalPhotonGenerator();
+
+  void AddGenStep(const G4OpticalPhotonGenStep& genStep);
+  // Stores a copy of the record unless it is rejected by biasing
+
+  virtual G4bool HasTracks() const override;
+
+  virtual void GenerateTracks(G4TrackVector& tracks) override;
+
+  virtual void Clear() override;
+
+  inline std::size_t GetNumberOfGenSteps() const;
+  inline const G4OpticalPhotonGenStep& GetGenStep(std::size_t i) const;
+  // Pending records, e.g. for inspection in a stacking action
+
+  inline void SetBiasing(G4VOpticalGenStepBiasing* ptr);
+  // Not owned by the generator
+
+  inline void SetMaxPhotonsPerChunk(G4int val);
+  inline G4int GetMaxPhotonsPerChunk() const;
+
+  inline G4double GetAbsorbedEnergy() const;
+  // Energy of photons absorbed by fast transport since the last Clear(),
+  // i.e. since the start of the event
+
+private:
+
+  G4OpticalPhotonGenerator();
+
+  void SamplePhoton(const G4OpticalPhotonGenStep& genStep,
+                    G4ThreeVector& position, G4ThreeVector& direction,
+                    G4ThreeVector& polarization,
+                    G4double& energy, G4double& time) const;
+
+  G4Track* MakeTrack(const G4OpticalPhotonGenStep& genStep, 
+                     std::size_t i) const;
+
+  G4OpticalPhotonGenerator(const G4OpticalPhotonGenerator&) = delete;
+  G4OpticalPhotonGenerator& operator=
+  (const G4OpticalPhotonGenerator&) = delete;
+
+  static G4ThreadLocal G4OpticalPhotonGenerator* fInstance;
+
+  std::vector<G4OpticalPhotonGenStep> fGenSteps;
+  G4OpticalPhotonBank fBank;
+  G4VOpticalGenStepBiasing* fBiasing;
+  G4int fMaxPhotonsPerChunk;
+  G4double fAbsorbedEnergy;
+};
+
+inline std::size_t G4OpticalPhotonGenerator::GetNumberOfGenSteps() const
+{
+  return fGenSteps.size();
+}
+
+inline const G4OpticalPhotonGenStep& 
+G4OpticalPhotonGenerator::GetGenStep(std::size_t i) const
+{
+  return fGenSteps[i];
+}
+
+inline void G4OpticalPhotonGenerator::SetBiasing(G4VOpticalGenStepBiasing* ptr)
+{
+  fBiasing = ptr;
+}
+
+inline void G4OpticalPhotonGenerator::SetMaxPhotonsPerChunk(G4int val)
+{
+  fMaxPhotonsPerChunk = std::max(val, 1);
+}
+
+inline G4int G4OpticalPhotonGenerator::GetMaxPhotonsPerChunk() const
+{
+  return fMaxPhotonsPerChunk;
+}
+
+inline G4double G4OpticalPhotonGenerator::GetAbsorbedEnergy() const
+{
+  return fAbsorbedEnergy;
+}
+
+#endif
@@ -36,7 +36,9 @@
 // Version:     1.0
 // Created:     1998-11-07
 // Author:      Peter Gumplinger
-// Updated:     2010-10-20 Allow the scintillation yield to be a function
+// Updated:     2018-10-19 optional fast transport of photons in the bulk
+//                         and deferred generation of photons
+//              2010-10-20 Allow the scintillation yield to be a function
 //                         of energy deposited by particle type
 //                         Thanks to Zach Hartwig (Department of Nuclear
 //                         Science and Engineeering - MIT)
@@ -76,6 +78,9 @@
 
 #include "G4EmSaturation.hh"
 
+class G4OpticalPhotonBank;
+struct G4OpticalPhotonGenStep;
+
 // Class Description:
 // RestDiscrete Process - Generation of Scintillation Photons.
 // Class inherits publicly from G4VRestDiscreteProcess.
@@ -225,6 +230,30 @@ public:
         G4int GetNumPhotons() const;
         // Returns the current number of scint. photons (after PostStepDoIt)
 
+        void SetFastPhotonTransport(const G4bool state);
+        // If set, the photons are kept in a G4OpticalPhotonBank and
+        // propagated through the bulk of the volume by
+        // G4OpticalPhotonTransport; only the photons which survive are
+        // added as secondaries, at their last position before a boundary
+
+        G4bool GetFastPhotonTransport() const;
+        // Returns the boolean flag for the fast photon transport
+
+        void SetDeferredGeneration(const G4bool state);
+        // If set, no photons are created in PostStepDoIt; a
+        // G4OpticalPhotonGenStep record per scintillation component is
+        // passed to G4OpticalPhotonGenerator, which samples the photons
+        // when the urgent stack is empty
+
+        G4bool GetDeferredGeneration() const;
+        // Returns the boolean flag for the deferred generation
+
+        void SamplePhoton(const G4OpticalPhotonGenStep& genStep,
+                          G4ThreeVector& position, G4ThreeVector& direction,
+                          G4ThreeVector& polarization,
+                          G4double& energy, G4double& time) const;
+        // Samples one photon of the record
+
         void DumpPhysicsTable() const;
         // Prints the fast and slow scintillation integral tables.
 
@@ -258,15 +287,19 @@ private:
 
         G4int fNumPhotons;
 
+        G4bool fFastPhotonTransport;
+        G4bool fDeferredGeneration;
+        G4OpticalPhotonBank* fPhotonBank;
+
 #ifdef G4DEBUG_SCINTILLATION
         G4double ScintTrackEDep, ScintTrackYield;
 #endif
 
-        G4double single_exp(G4double t, G4double tau2);
-        G4double bi_exp(G4double t, G4double tau1, G4double tau2);
+        G4double single_exp(G4double t, G4double tau2) const;
+        G4double bi_exp(G4double t, G4double tau1, G4double tau2) const;
 
         // emission time distribution when there is a finite rise time
-        G4double sample_time(G4double tau1, G4double tau2);
+        G4double sample_time(G4double tau1, G4double tau2) const;
 
         G4EmSaturation* fEmSaturation;
 
@@ -390,15 +423,39 @@ G4int G4Scintillation::GetNumPhotons() const
         return fNumPhotons;
 }
 
+inline
+void G4Scintillation::SetFastPhotonTransport(const G4bool state)
+{
+        fFastPhotonTransport = state;
+}
+
+inline
+G4bool G4Scintillation::GetFastPhotonTransport() const
+{
+        return fFastPhotonTransport;
+}
+
+inline
+void G4Scintillation::SetDeferredGeneration(const G4bool state)
+{
+        fDeferredGeneration = state;
+}
+
+inline
+G4bool G4Scintillation::GetDeferredGeneration() const
+{
+        return fDeferredGeneration;
+}
+
 
 inline
-G4double G4Scintillation::single_exp(G4double t, G4double tau2)
+G4double G4Scintillation::single_exp(G4double t, G4double tau2) const
 {
          return std::exp(-1.0*t/tau2)/tau2;
 }
 
 inline
-G4double G4Scintillation::bi_exp(G4double t, G4double tau1, G4double tau2)
+G4double G4Scintillation::bi_exp(G4double t, G4double tau1, G4double tau2) const
 {
          return std::exp(-1.0*t/tau2)*(1-std::exp(-1.0*t/tau1))/tau2/tau2*(tau1+tau2);
 }
@@ -38,6 +38,7 @@ include_directories(${CMAKE_SOURCE_DIR}/source/processes/cuts/include)
 include_directories(${CMAKE_SOURCE_DIR}/source/processes/electromagnetic/standard/include)
 include_directories(${CMAKE_SOURCE_DIR}/source/processes/electromagnetic/utils/include)
 include_directories(${CMAKE_SOURCE_DIR}/source/processes/management/include)
+include_directories(${CMAKE_SOURCE_DIR}/source/processes/optical/include)
 include_directories(${CMAKE_SOURCE_DIR}/source/track/include)
 
 #
@@ -49,6 +50,8 @@ GEANT4_DEFINE_MODULE(NAME G4xrays
         G4Cerenkov.hh
         G4ForwardXrayTR.hh
         G4GammaXTRadiator.hh
+        G4OpticalPhotonGenStep.hh
+        G4OpticalPhotonGenerator.hh
         G4RegularXTRadiator.hh
         G4Scintillation.hh
         G4ScintillationTrackInformation.hh
@@ -67,6 +70,7 @@ GEANT4_DEFINE_MODULE(NAME G4xrays
         G4Cerenkov.cc
         G4ForwardXrayTR.cc
         G4GammaXTRadiator.cc
+        G4OpticalPhotonGenerator.cc
         G4RegularXTRadiator.cc
         G4Scintillation.cc
         G4ScintillationTrackInformation.cc
@@ -94,6 +98,7 @@ GEANT4_DEFINE_MODULE(NAME G4xrays
         G4materials
         G4mesons
         G4navigation
+        G4optical
         G4partman
         G4procman
         G4track
@@ -35,7 +35,11 @@
 // Version:     2.1
 // Created:     1996-02-21
 // Author:      Juliet Armstrong
-// Updated:     2007-09-30 by Peter Gumplinger
+// Updated:     2018-10-19
+//              > optional fast transport of the photons in the bulk
+//              > optional deferred generation of the photons from
+//                G4OpticalPhotonGenStep records
+//              2007-09-30 by Peter Gumplinger
 //              > change inheritance to G4VDiscreteProcess
 //              GetContinuousStepLimit -> GetMeanFreePath (StronglyForced)
 //              AlongStepDoIt -> PostStepDoIt
@@ -70,6 +74,9 @@
 #include "G4LossTableManager.hh"
 #include "G4MaterialCutsCouple.hh"
 #include "G4ParticleDefinition.hh"
+#include "G4OpticalPhotonBank.hh"
+#include "G4OpticalPhotonTransport.hh"
+#include "G4OpticalPhotonGenerator.hh"
 
 #include "G4Cerenkov.hh"
 
@@ -99,7 +106,10 @@ G4Cerenkov::G4Cerenkov(const G4String& processName, G4ProcessType type)
              fMaxBetaChange(0.0),
              fMaxPhotons(0),
              fStackingFlag(true),
-             fNumPhotons(0)
+             fNumPhotons(0),
+             fFastPhotonTransport(false),
+             fDeferredGeneration(false),
+             fPhotonBank(nullptr)
 {
   SetProcessSubType(fCerenkov);
 
@@ -124,6 +134,7 @@ G4Cerenkov::~G4Cerenkov()
      thePhysicsTable->clearAndDestroy();
      delete thePhysicsTable;
   }
+  delete fPhotonBank;
 }
 
   ////////////
@@ -197,7 +208,7 @@ G4Cerenkov::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
   if (!aMaterialPropertiesTable) return pParticleChange;
 
   G4MaterialPropertyVector* Rindex = 
-                aMaterialPropertiesTable->GetProperty(kRINDEX); 
+                aMaterialPropertiesTable->GetOpticalBundle().fRindex;
   if (!Rindex) return pParticleChange;
 
   // particle charge
@@ -239,19 +250,8 @@ G4Cerenkov::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 
   ////////////////////////////////////////////////////////////////
 
-  aParticleChange.SetNumberOfSecondaries(fNumPhotons);
-
-  if (fTrackSecondariesFirst) {
-     if (aTrack.GetTrackStatus() == fAlive )
-                           aParticleChange.ProposeTrackStatus(fSuspend);
-  }
-
   ////////////////////////////////////////////////////////////////
 
-  G4double Pmin = Rindex->GetMinLowEdgeEnergy();
-  G4double Pmax = Rindex->GetMaxLowEdgeEnergy();
-  G4double dp = Pmax - Pmin;
-
   G4double nMax = Rindex->GetMaxValue();
 
   G4double BetaInverse = 1./beta;
@@ -262,74 +262,76 @@ G4Cerenkov::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
   G4double beta1 = pPreStepPoint ->GetBeta();
   G4double beta2 = pPostStepPoint->GetBeta();
 
-  G4double MeanNumberOfPhotons1 =
+  // Record of the step; photons are sampled from it here or later
+  // by G4OpticalPhotonGenerator
+
+  G4OpticalPhotonGenStep genStep;
+  genStep.fCreator = this;
+  genStep.fCreatorSubType = fCerenkov;
+  genStep.fParentID = aTrack.GetTrackID();
+  genStep.fWeight = aTrack.GetWeight();
+  genStep.fTouchable = pPreStepPoint->GetTouchableHandle();
+  genStep.fMaterial = aMaterial;
+  genStep.fNumPhotons = fNumPhotons;
+  genStep.fMeanNumberOfPhotons = MeanNumberOfPhotons;
+  genStep.fPosition = x0;
+  genStep.fDeltaPosition = aStep.GetDeltaPosition();
+  genStep.fDirection = p0;
+  genStep.fStepLength = step_length;
+  genStep.fTime = t0;
+  genStep.fPreVelocity = pPreStepPoint->GetVelocity();
+  genStep.fPostVelocity = pPostStepPoint->GetVelocity();
+  genStep.fSpectrum = Rindex;
+  genStep.fEnergyMin = Rindex->GetMinLowEdgeEnergy();
+  genStep.fEnergyRange = Rindex->GetMaxLowEdgeEnergy() - genStep.fEnergyMin;
+  genStep.fBetaInverse = BetaInverse;
+  genStep.fMaxSin2 = maxSin2;
+  genStep.fMeanNumberOfPhotons1 =
                      GetAverageNumberOfPhotons(charge,beta1,aMaterial,Rindex);
-  G4double MeanNumberOfPhotons2 =
+  genStep.fMeanNumberOfPhotons2 =
                      GetAverageNumberOfPhotons(charge,beta2,aMaterial,Rindex);
 
-  for (G4int i = 0; i < fNumPhotons; i++) {
-
-      // Determine photon energy
-
-      G4double rand;
-      G4double sampledEnergy, sampledRI; 
-      G4double cosTheta, sin2Theta;
-
-      // sample an energy
-
-      do {
-         rand = G4UniformRand();	
-         sampledEnergy = Pmin + rand * dp; 
-         sampledRI = Rindex->Value(sampledEnergy);
-         cosTheta = BetaInverse / sampledRI;  
-
-         sin2Theta = (1.0 - cosTheta)*(1.0 + cosTheta);
-         rand = G4UniformRand();	
-
-        // Loop checking, 07-Aug-2015, Vladimir Ivanchenko
-      } while (rand*maxSin2 > sin2Theta);
-
-      // Generate random position of photon on cone surface 
-      // defined by Theta 
-
-      rand = G4UniformRand();
+  if (fDeferredGeneration) {
 
-      G4double phi = twopi*rand;
-      G4double sinPhi = std::sin(phi);
-      G4double cosPhi = std::cos(phi);
+     // no secondaries at this step, the record is kept until
+     // the urgent stack is empty
 
-      // calculate x,y, and z components of photon energy
-      // (in coord system with primary particle direction 
-      //  aligned with the z axis)
+     G4OpticalPhotonGenerator::GetInstance()->AddGenStep(genStep);
 
-      G4double sinTheta = std::sqrt(sin2Theta); 
-      G4double px = sinTheta*cosPhi;
-      G4double py = sinTheta*sinPhi;
-      G4double pz = cosTheta;
+     aParticleChange.SetNumberOfSecondaries(0);
 
-      // Create photon momentum direction vector 
-      // The momentum direction is still with respect
-      // to the coordinate system where the primary
-      // particle direction is aligned with the z axis  
+     return pParticleChange;
+  }
 
-      G4ParticleMomentum photonMomentum(px, py, pz);
+  aParticleChange.SetNumberOfSecondaries(fNumPhotons);
 
-      // Rotate momentum direction back to global reference
-      // system 
+  if (fTrackSecondariesFirst) {
+     if (aTrack.GetTrackStatus() == fAlive )
+                           aParticleChange.ProposeTrackStatus(fSuspend);
+  }
 
-      photonMomentum.rotateUz(p0);
+  ////////////////////////////////////////////////////////////////
 
-      // Determine polarization of new photon 
+  if (fFastPhotonTransport) {
+     if (!fPhotonBank) fPhotonBank = new G4OpticalPhotonBank();
+     fPhotonBank->Clear();
+     fPhotonBank->Reserve(fNumPhotons);
+  }
 
-      G4double sx = cosTheta*cosPhi;
-      G4double sy = cosTheta*sinPhi; 
-      G4double sz = -sinTheta;
+  G4double sampledEnergy, aSecondaryTime;
+  G4ThreeVector aSecondaryPosition, photonMomentum, photonPolarization;
 
-      G4ThreeVector photonPolarization(sx, sy, sz);
+  for (G4int i = 0; i < fNumPhotons; i++) {
 
-      // Rotate back to original coord system 
+      SamplePhoton(genStep, aSecondaryPosition, photonMomentum,
+                   photonPolarization, sampledEnergy, aSecondaryTime);
 
-      photonPolarization.rotateUz(p0);
+      if (fFastPhotonTransport) {
+         fPhotonBank->AddPhoton(aSecondaryPosition, photonMomentum,
+                                photonPolarization, sampledEnergy,
+                                aSecondaryTime);
+         continue;
+      }
 
       // Generate a new photon:
 
@@ -344,27 +346,6 @@ G4Cerenkov::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 
       // Generate new G4Track object:
 
-      G4double NumberOfPhotons, N;
-
-      do {
-         rand = G4UniformRand();
-         NumberOfPhotons = MeanNumberOfPhotons1 - rand *
-                                (MeanNumberOfPhotons1-MeanNumberOfPhotons2);
-         N = G4UniformRand() *
-                        std::max(MeanNumberOfPhotons1,MeanNumberOfPhotons2);
-        // Loop checking, 07-Aug-2015, Vladimir Ivanchenko
-      } while (N > NumberOfPhotons);
-
-      G4double delta = rand * aStep.GetStepLength();
-
-      G4double deltaTime = delta / (pPreStepPoint->GetVelocity()+
-                                      rand*(pPostStepPoint->GetVelocity()-
-                                            pPreStepPoint->GetVelocity())*0.5);
-
-      G4double aSecondaryTime = t0 + deltaTime;
-
-      G4ThreeVector aSecondaryPosition = x0 + rand * aStep.GetDeltaPosition();
-
       G4Track* aSecondaryTrack = 
                new G4Track(aCerenkovPhoton,aSecondaryTime,aSecondaryPosition);
 
@@ -376,6 +357,30 @@ G4Cerenkov::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
       aParticleChange.AddSecondary(aSecondaryTrack);
   }
 
+  if (fFastPhotonTransport) {
+
+     // propagate the photons through the bulk of the volume and
+     // hand over the survivors to the stepping manager; the energy
+     // of the absorbed photons is deposited in this step
+
+     aParticleChange.ProposeLocalEnergyDeposit(
+           G4OpticalPhotonTransport::GetInstance()->
+                                 Transport(*fPhotonBank, pPreStepPoint));
+
+     size_t nPhotons = fPhotonBank->Size();
+     for (size_t i = 0; i < nPhotons; ++i) {
+         G4Track* aSecondaryTrack = fPhotonBank->MakeTrack(i);
+
+         aSecondaryTrack->SetTouchableHandle(
+                                  pPreStepPoint->GetTouchableHandle());
+
+         aSecondaryTrack->SetParentID(aTrack.GetTrackID());
+
+         aParticleChange.AddSecondary(aSecondaryTrack);
+     }
+     fPhotonBank->Clear();
+  }
+
   if (verboseLevel>0) {
      G4cout <<"\n Exiting from G4Cerenkov::DoIt -- NumberOfSecondaries = "
 	    << aParticleChange.GetNumberOfSecondaries() << G4endl;
@@ -384,6 +389,90 @@ G4Cerenkov::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
   return pParticleChange;
 }
 
+// SamplePhoton
+// ------------
+//
+void G4Cerenkov::SamplePhoton(const G4OpticalPhotonGenStep& genStep,
+                              G4ThreeVector& position,
+                              G4ThreeVector& direction,
+                              G4ThreeVector& polarization,
+                              G4double& energy, G4double& time) const
+{
+  // Determine photon energy
+
+  G4double rand;
+  G4double sampledRI; 
+  G4double cosTheta, sin2Theta;
+
+  // sample an energy
+
+  do {
+     rand = G4UniformRand();	
+     energy = genStep.fEnergyMin + rand * genStep.fEnergyRange; 
+     sampledRI = genStep.fSpectrum->Value(energy);
+     cosTheta = genStep.fBetaInverse / sampledRI;  
+
+     sin2Theta = (1.0 - cosTheta)*(1.0 + cosTheta);
+     rand = G4UniformRand();	
+
+    // Loop checking, 07-Aug-2015, Vladimir Ivanchenko
+  } while (rand*genStep.fMaxSin2 > sin2Theta);
+
+  // Generate random position of photon on cone surface 
+  // defined by Theta 
+
+  rand = G4UniformRand();
+
+  G4double phi = twopi*rand;
+  G4double sinPhi = std::sin(phi);
+  G4double cosPhi = std::cos(phi);
+
+  // calculate x,y, and z components of photon energy
+  // (in coord system with primary particle direction 
+  //  aligned with the z axis)
+
+  G4double sinTheta = std::sqrt(sin2Theta); 
+  direction.set(sinTheta*cosPhi, sinTheta*sinPhi, cosTheta);
+
+  // Rotate momentum direction back to global reference
+  // system 
+
+  direction.rotateUz(genStep.fDirection);
+
+  // Determine polarization of new photon 
+
+  polarization.set(cosTheta*cosPhi, cosTheta*sinPhi, -sinTheta);
+
+  // Rotate back to original coord system 
+
+  polarization.rotateUz(genStep.fDirection);
+
+  // Sample the position along the step
+
+  G4double NumberOfPhotons, N;
+  G4double MeanNumberOfPhotons1 = genStep.fMeanNumberOfPhotons1;
+  G4double MeanNumberOfPhotons2 = genStep.fMeanNumberOfPhotons2;
+
+  do {
+     rand = G4UniformRand();
+     NumberOfPhotons = MeanNumberOfPhotons1 - rand *
+                            (MeanNumberOfPhotons1-MeanNumberOfPhotons2);
+     N = G4UniformRand() *
+                    std::max(MeanNumberOfPhotons1,MeanNumberOfPhotons2);
+    // Loop checking, 07-Aug-2015, Vladimir Ivanchenko
+  } while (N > NumberOfPhotons);
+
+  G4double delta = rand * genStep.fStepLength;
+
+  G4double deltaTime = delta / (genStep.fPreVelocity +
+                                rand*(genStep.fPostVelocity-
+                                      genStep.fPreVelocity)*0.5);
+
+  time = genStep.fTime + deltaTime;
+
+  position = genStep.fPosition + rand * genStep.fDeltaPosition;
+}
+
 // BuildThePhysicsTable for the Cerenkov process
 // ---------------------------------------------
 //
@@ -524,7 +613,7 @@ G4double G4Cerenkov::PostStepGetPhysicalInteractionLength(
   G4MaterialPropertyVector* Rindex = NULL;
 
   if (aMaterialPropertiesTable)
-                     Rindex = aMaterialPropertiesTable->GetProperty(kRINDEX);
+             Rindex = aMaterialPropertiesTable->GetOpticalBundle().fRindex;
 
   G4double nMax;
   if (Rindex) {
@@ -0,0 +1,183 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+////////////////////////////////////////////////////////////////////////
+// Deferred Optical Photon Generator Class Implementation
+////////////////////////////////////////////////////////////////////////
+//
+// File:        G4OpticalPhotonGenerator.cc
+// Created:     2018-10-19
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "G4OpticalPhotonGenerator.hh"
+#include "G4OpticalPhotonTransport.hh"
+#include "G4Cerenkov.hh"
+#include "G4Scintillation.hh"
+#include "G4ScintillationTrackInformation.hh"
+#include "G4EmProcessSubType.hh"
+#include "G4Track.hh"
+#include "Randomize.hh"
+#include <atomic>
+
+G4ThreadLocal G4OpticalPhotonGenerator* 
+G4OpticalPhotonGenerator::fInstance = nullptr;
+
+G4OpticalPhotonGenerator* G4OpticalPhotonGenerator::GetInstance()
+{
+  if(!fInstance) {
+    static G4ThreadLocalSingleton<G4OpticalPhotonGenerator> inst;
+    fInstance = inst.Instance();
+  }
+  return fInstance;
+}
+
+G4OpticalPhotonGenerator::G4OpticalPhotonGenerator()
+  : fBiasing(nullptr), fMaxPhotonsPerChunk(10000), fAbsorbedEnergy(0.0)
+{}
+
+G4OpticalPhotonGenerator::~G4OpticalPhotonGenerator()
+{}
+
+void G4OpticalPhotonGenerator::AddGenStep(const G4OpticalPhotonGenStep& gs)
+{
+  if(gs.fNumPhotons <= 0) { return; }
+  G4double p = 1.0;
+  if(fBiasing) {
+    p = std::min(fBiasing->GetSurvivalProbability(gs), 1.0);
+    // early rejection, no photon of the record is sampled
+    if(p <= 0.0) { return; }
+  }
+  fGenSteps.push_back(gs);
+  if(p < 1.0) {
+    G4OpticalPhotonGenStep& genStep = fGenSteps.back();
+    genStep.fSurvivalProbability = p;
+    genStep.fWeight /= p;
+  }
+}
+
+G4bool G4OpticalPhotonGenerator::HasTracks() const
+{
+  return !fGenSteps.empty();
+}
+
+void G4OpticalPhotonGenerator::Clear()
+{
+  fGenSteps.clear();
+  fBank.Clear();
+  fAbsorbedEnergy = 0.0;
+}
+
+void G4OpticalPhotonGenerator::GenerateTracks(G4TrackVector& tracks)
+{
+  G4int nLeft = fMaxPhotonsPerChunk;
+  G4ThreeVector position, direction, polarization;
+  G4double energy, time;
+
+  // records are consumed from the last one, as a stack;
+  // a record may be split between several chunks
+  while(nLeft > 0 && !fGenSteps.empty()) {
+    G4OpticalPhotonGenStep& genStep = fGenSteps.back();
+    G4int n = std::min(nLeft, genStep.fNumPhotons);
+    genStep.fNumPhotons -= n;
+    nLeft -= n;
+
+    G4double p = genStep.fSurvivalProbability;
+    fBank.Clear();
+    fBank.Reserve(n);
+    for(G4int i=0; i<n; ++i) {
+      if(p < 1.0 && G4UniformRand() >= p) { continue; }
+      SamplePhoton(genStep, position, direction, polarization, energy, time);
+      fBank.AddPhoton(position, direction, polarization, energy, time,
+                      genStep.fWeight, genStep.fScintillationType);
+    }
+
+    G4bool fastTransport = (fCerenkov == genStep.fCreatorSubType)
+      ? static_cast<const G4Cerenkov*>(genStep.fCreator)
+        ->GetFastPhotonTransport()
+      : static_cast<const G4Scintillation*>(genStep.fCreator)
+        ->GetFastPhotonTransport();
+    if(fastTransport) {
+      // the parent step is gone, so unlike eager generation the energy 
+      // of absorbed photons does not reach stepping actions and scorers
+      static std::atomic<G4bool> isWarned(false);
+      if(!isWarned.exchange(true)) {
+        G4ExceptionDescription ed;
+        ed << "Fast photon transport is combined with deferred generation"
+           << " for " << genStep.fCreator->GetProcessName() << ".\n"
+           << "The energy of absorbed photons is not deposited in the step"
+           << " of the parent and is not seen by user stepping actions"
+           << " and scorers;\nit is only available via"
+           << " G4OpticalPhotonGenerator::GetAbsorbedEnergy().";
+        G4Exception("G4OpticalPhotonGenerator::GenerateTracks()", "OpGen01",
+                    JustWarning, ed);
+      }
+      fAbsorbedEnergy += G4OpticalPhotonTransport::GetInstance()
+        ->Transport(fBank, genStep.fTouchable(), genStep.fMaterial);
+    }
+
+    std::size_t nPhotons = fBank.Size();
+    for(std::size_t i=0; i<nPhotons; ++i) {
+      tracks.push_back(MakeTrack(genStep, i));
+    }
+    if(0 == genStep.fNumPhotons) { fGenSteps.pop_back(); }
+  }
+  fBank.Clear();
+}
+
+void 
+G4OpticalPhotonGenerator::SamplePhoton(const G4OpticalPhotonGenStep& gs,
+                                       G4ThreeVector& position,
+                                       G4ThreeVector& direction,
+                                       G4ThreeVector& polarization,
+                                       G4double& energy, 
+                                       G4double& time) const
+{
+  if(fCerenkov == gs.fCreatorSubType) {
+    static_cast<const G4Cerenkov*>(gs.fCreator)
+      ->SamplePhoton(gs, position, direction, polarization, energy, time);
+  } else {
+    static_cast<const G4Scintillation*>(gs.fCreator)
+      ->SamplePhoton(gs, position, direction, polarization, energy, time);
+  }
+}
+
+G4Track* 
+G4OpticalPhotonGenerator::MakeTrack(const G4OpticalPhotonGenStep& gs,
+                                    std::size_t i) const
+{
+  G4Track* track = fBank.MakeTrack(i);
+  track->SetTouchableHandle(gs.fTouchable);
+  track->SetParentID(gs.fParentID);
+  track->SetCreatorProcess(gs.fCreator);
+
+  if(fScintillation == gs.fCreatorSubType &&
+     static_cast<const G4Scintillation*>(gs.fCreator)
+     ->GetScintillationTrackInfo()) {
+    track->SetUserInformation(new G4ScintillationTrackInformation(
+                              G4ScintillationType(fBank.GetTag(i))));
+  }
+  return track;
+}
@@ -34,7 +34,11 @@
 // Version:     1.0
 // Created:     1998-11-07
 // Author:      Peter Gumplinger
-// Updated:     2010-10-20 Allow the scintillation yield to be a function
+// Updated:     2018-10-19
+//              > optional fast transport of the photons in the bulk
+//              > optional deferred generation of the photons from
+//                G4OpticalPhotonGenStep records
+//              2010-10-20 Allow the scintillation yield to be a function
 //              of energy deposited by particle type
 //              Thanks to Zach Hartwig (Department of Nuclear
 //              Science and Engineeering - MIT)
@@ -74,6 +78,9 @@
 #include "G4ParticleTypes.hh"
 #include "G4EmProcessSubType.hh"
 #include "G4ScintillationTrackInformation.hh"
+#include "G4OpticalPhotonBank.hh"
+#include "G4OpticalPhotonTransport.hh"
+#include "G4OpticalPhotonGenerator.hh"
 
 #include "G4Scintillation.hh"
 
@@ -118,6 +125,9 @@ G4Scintillation::G4Scintillation(const G4String& processName,
     fScintillationTrackInfo(false),
     fStackingFlag(true),
     fNumPhotons(0),
+    fFastPhotonTransport(false),
+    fDeferredGeneration(false),
+    fPhotonBank(nullptr),
     fEmSaturation(nullptr)
 {
         SetProcessSubType(fScintillation);
@@ -149,6 +159,7 @@ G4Scintillation::~G4Scintillation()
            fSlowIntegralTable->clearAndDestroy();
            delete fSlowIntegralTable;
         }
+        delete fPhotonBank;
 }
 
         ////////////
@@ -295,11 +306,15 @@ G4Scintillation::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 
         ////////////////////////////////////////////////////////////////
 
-        aParticleChange.SetNumberOfSecondaries(fNumPhotons);
+        if (fDeferredGeneration) {
+           aParticleChange.SetNumberOfSecondaries(0);
+        } else {
+           aParticleChange.SetNumberOfSecondaries(fNumPhotons);
 
-        if (fTrackSecondariesFirst) {
-           if (aTrack.GetTrackStatus() == fAlive )
-                  aParticleChange.ProposeTrackStatus(fSuspend);
+           if (fTrackSecondariesFirst) {
+              if (aTrack.GetTrackStatus() == fAlive )
+                     aParticleChange.ProposeTrackStatus(fSuspend);
+           }
         }
 
         ////////////////////////////////////////////////////////////////
@@ -311,6 +326,33 @@ G4Scintillation::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 
         G4int Num = fNumPhotons;
 
+        // Record of the step; photons of each component are sampled
+        // from it here or later by G4OpticalPhotonGenerator
+
+        G4OpticalPhotonGenStep genStep;
+        genStep.fCreator = this;
+        genStep.fCreatorSubType = fScintillation;
+        genStep.fParentID = aTrack.GetTrackID();
+        genStep.fWeight = aTrack.GetWeight();
+        genStep.fTouchable = pPreStepPoint->GetTouchableHandle();
+        genStep.fMaterial = aMaterial;
+        genStep.fMeanNumberOfPhotons = MeanNumberOfPhotons;
+        genStep.fPosition = x0;
+        genStep.fDeltaPosition = aStep.GetDeltaPosition();
+        genStep.fDirection = p0;
+        genStep.fStepLength = aStep.GetStepLength();
+        genStep.fTime = t0;
+        genStep.fPreVelocity = pPreStepPoint->GetVelocity();
+        genStep.fPostVelocity = pPostStepPoint->GetVelocity();
+        genStep.fAlongStep = 
+                 (aParticle->GetDefinition()->GetPDGCharge() != 0);
+
+        if (fFastPhotonTransport && !fDeferredGeneration) {
+           if (!fPhotonBank) fPhotonBank = new G4OpticalPhotonBank();
+           fPhotonBank->Clear();
+           fPhotonBank->Reserve(fNumPhotons);
+        }
+
         for (G4int scnt = 1; scnt <= nscnt; scnt++) {
 
             G4double ScintillationTime = 0.*ns;
@@ -382,58 +424,37 @@ G4Scintillation::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 
             if (!ScintillationIntegral) continue;
 
-            // Max Scintillation Integral
- 
-            G4double CIImax = ScintillationIntegral->GetMaxValue();
+            genStep.fNumPhotons = Num;
+            genStep.fSpectrum = ScintillationIntegral;
+            genStep.fSpectrumMax = ScintillationIntegral->GetMaxValue();
+            genStep.fScintillationType = ScintillationType;
+            genStep.fDecayTime = ScintillationTime;
+            genStep.fRiseTime = ScintillationRiseTime;
+
+            if (fDeferredGeneration) {
+               if (Num > 0) G4OpticalPhotonGenerator::GetInstance()->
+                                                     AddGenStep(genStep);
+               continue;
+            }
+
+            G4double sampledEnergy, aSecondaryTime;
+            G4ThreeVector aSecondaryPosition;
+            G4ThreeVector photonMomentum, photonPolarization;
 
             for (G4int i = 0; i < Num; i++) {
 
-                // Determine photon energy
-
-                G4double CIIvalue = G4UniformRand()*CIImax;
-                G4double sampledEnergy =
-                              ScintillationIntegral->GetEnergy(CIIvalue);
+                SamplePhoton(genStep, aSecondaryPosition, photonMomentum,
+                             photonPolarization, sampledEnergy,
+                             aSecondaryTime);
 
-                if (verboseLevel>1) {
-                   G4cout << "sampledEnergy = " << sampledEnergy << G4endl;
-                   G4cout << "CIIvalue =        " << CIIvalue << G4endl;
+                if (fFastPhotonTransport) {
+                   fPhotonBank->AddPhoton(aSecondaryPosition, photonMomentum,
+                                          photonPolarization, sampledEnergy,
+                                          aSecondaryTime, 1.0,
+                                          ScintillationType);
+                   continue;
                 }
 
-                // Generate random photon direction
-
-                G4double cost = 1. - 2.*G4UniformRand();
-                G4double sint = std::sqrt((1.-cost)*(1.+cost));
-
-                G4double phi = twopi*G4UniformRand();
-                G4double sinp = std::sin(phi);
-                G4double cosp = std::cos(phi);
-
-                G4double px = sint*cosp;
-                G4double py = sint*sinp;
-                G4double pz = cost;
-
-                // Create photon momentum direction vector
-
-                G4ParticleMomentum photonMomentum(px, py, pz);
-
-                // Determine polarization of new photon
-
-                G4double sx = cost*cosp;
-                G4double sy = cost*sinp;
-                G4double sz = -sint;
-
-                G4ThreeVector photonPolarization(sx, sy, sz);
-
-                G4ThreeVector perp = photonMomentum.cross(photonPolarization);
-
-                phi = twopi*G4UniformRand();
-                sinp = std::sin(phi);
-                cosp = std::cos(phi);
-
-                photonPolarization = cosp * photonPolarization + sinp * perp;
-
-                photonPolarization = photonPolarization.unit();
-
                 // Generate a new photon:
 
                 G4DynamicParticle* aScintillationPhoton =
@@ -448,33 +469,6 @@ G4Scintillation::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 
                 // Generate new G4Track object:
 
-                G4double rand;
-
-                if (aParticle->GetDefinition()->GetPDGCharge() != 0) {
-                   rand = G4UniformRand();
-                } else {
-                   rand = 1.0;
-                }
-
-                G4double delta = rand * aStep.GetStepLength();
-                G4double deltaTime = delta / (pPreStepPoint->GetVelocity()+
-                                      rand*(pPostStepPoint->GetVelocity()-
-                                            pPreStepPoint->GetVelocity())/2.);
-
-                // emission time distribution
-                if (ScintillationRiseTime==0.0) {
-                   deltaTime = deltaTime -
-                          ScintillationTime * std::log( G4UniformRand() );
-                } else {
-                   deltaTime = deltaTime +
-                          sample_time(ScintillationRiseTime, ScintillationTime);
-                }
-
-                G4double aSecondaryTime = t0 + deltaTime;
-
-                G4ThreeVector aSecondaryPosition =
-                                    x0 + rand * aStep.GetDeltaPosition();
-
                 G4Track* aSecondaryTrack = new G4Track(aScintillationPhoton,
                                                        aSecondaryTime,
                                                        aSecondaryPosition);
@@ -493,6 +487,34 @@ G4Scintillation::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
             }
         }
 
+        if (fFastPhotonTransport && !fDeferredGeneration) {
+
+           // propagate the photons through the bulk of the volume and
+           // hand over the survivors to the stepping manager; the energy
+           // of the absorbed photons is deposited in this step
+
+           aParticleChange.ProposeLocalEnergyDeposit(
+                 G4OpticalPhotonTransport::GetInstance()->
+                                   Transport(*fPhotonBank, pPreStepPoint));
+
+           size_t nPhotons = fPhotonBank->Size();
+           for (size_t i = 0; i < nPhotons; ++i) {
+               G4Track* aSecondaryTrack = fPhotonBank->MakeTrack(i);
+
+               aSecondaryTrack->SetTouchableHandle(
+                                 pPreStepPoint->GetTouchableHandle());
+
+               aSecondaryTrack->SetParentID(aTrack.GetTrackID());
+
+               if (fScintillationTrackInfo) aSecondaryTrack->
+                  SetUserInformation(new G4ScintillationTrackInformation(
+                         G4ScintillationType(fPhotonBank->GetTag(i))));
+
+               aParticleChange.AddSecondary(aSecondaryTrack);
+           }
+           fPhotonBank->Clear();
+        }
+
         if (verboseLevel>0) {
         G4cout << "\n Exiting from G4Scintillation::DoIt -- NumberOfSecondaries = "
                << aParticleChange.GetNumberOfSecondaries() << G4endl;
@@ -501,6 +523,73 @@ G4Scintillation::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
         return G4VRestDiscreteProcess::PostStepDoIt(aTrack, aStep);
 }
 
+// SamplePhoton
+// ------------
+//
+void G4Scintillation::SamplePhoton(const G4OpticalPhotonGenStep& genStep,
+                                   G4ThreeVector& position,
+                                   G4ThreeVector& direction,
+                                   G4ThreeVector& polarization,
+                                   G4double& energy, G4double& time) const
+{
+        // Determine photon energy
+
+        G4double CIIvalue = G4UniformRand()*genStep.fSpectrumMax;
+        energy = genStep.fSpectrum->GetEnergy(CIIvalue);
+
+        if (verboseLevel>1) {
+           G4cout << "sampledEnergy = " << energy << G4endl;
+           G4cout << "CIIvalue =        " << CIIvalue << G4endl;
+        }
+
+        // Generate random photon direction
+
+        G4double cost = 1. - 2.*G4UniformRand();
+        G4double sint = std::sqrt((1.-cost)*(1.+cost));
+
+        G4double phi = twopi*G4UniformRand();
+        G4double sinp = std::sin(phi);
+        G4double cosp = std::cos(phi);
+
+        direction.set(sint*cosp, sint*sinp, cost);
+
+        // Determine polarization of new photon
+
+        polarization.set(cost*cosp, cost*sinp, -sint);
+
+        G4ThreeVector perp = direction.cross(polarization);
+
+        phi = twopi*G4UniformRand();
+        sinp = std::sin(phi);
+        cosp = std::cos(phi);
+
+        polarization = cosp * polarization + sinp * perp;
+
+        polarization = polarization.unit();
+
+        // Sample the position and time
+
+        G4double rand = (genStep.fAlongStep) ? G4UniformRand() : 1.0;
+
+        G4double delta = rand * genStep.fStepLength;
+        G4double deltaTime = delta / (genStep.fPreVelocity +
+                                      rand*(genStep.fPostVelocity-
+                                            genStep.fPreVelocity)/2.);
+
+        // emission time distribution
+        if (genStep.fRiseTime==0.0) {
+           deltaTime = deltaTime -
+                  genStep.fDecayTime * std::log( G4UniformRand() );
+        } else {
+           deltaTime = deltaTime +
+                  sample_time(genStep.fRiseTime, genStep.fDecayTime);
+        }
+
+        time = genStep.fTime + deltaTime;
+
+        position = genStep.fPosition + rand * genStep.fDeltaPosition;
+}
+
 // BuildThePhysicsTable for the scintillation process
 // --------------------------------------------------
 //
@@ -695,7 +784,7 @@ G4double G4Scintillation::GetMeanLifeTime(const G4Track&,
 
 }
 
-G4double G4Scintillation::sample_time(G4double tau1, G4double tau2)
+G4double G4Scintillation::sample_time(G4double tau1, G4double tau2) const
 {
 // tau1: rise time and tau2: decay time
 
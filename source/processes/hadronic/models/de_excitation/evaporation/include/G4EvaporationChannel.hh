@@ -43,6 +43,7 @@
 #include "G4VCoulombBarrier.hh"
 
 class G4PairingCorrection;
+class G4EmissionWidthTable;
 
 class G4EvaporationChannel : public G4VEvaporationChannel
 {
@@ -62,6 +63,13 @@ public:
   virtual G4Fragment* EmittedFragment(G4Fragment* theNucleus);
 
 private: 
+
+  // Computes kinematic limits of emission; returns false if the 
+  // channel is closed
+  G4bool ComputeLimits(const G4Fragment* fragment);
+
+  // Emission probability taken from the table of widths 
+  G4double TabulatedProbability(const G4Fragment* fragment);
   
   G4EvaporationChannel(const G4EvaporationChannel & right) = delete;
   const G4EvaporationChannel & operator=
@@ -88,6 +96,9 @@ private:
 
   // For pairing correction calculation
   G4PairingCorrection* pairingCorrection;
+
+  // Optional table of total widths 
+  G4EmissionWidthTable* fWidthTable;
    
   //---------------------------------------------------
 
@@ -108,6 +119,9 @@ private:
   G4double MinKinEnergy;
   G4double MaxKinEnergy;
 
+  // Probability was interpolated, integration is needed before sampling
+  G4bool isTabulated;
+
 };
 
 
@@ -37,10 +37,13 @@
 // 17-11-2010 V.Ivanchenko in constructor replace G4VEmissionProbability by 
 //            G4EvaporationProbability and do not new and delete probability
 //            object at each call; use G4Pow
+// 19-10-2018 Optional use of tabulated emission widths
 
 #include "G4EvaporationChannel.hh"
 #include "G4PairingCorrection.hh"
 #include "G4NuclearLevelData.hh"
+#include "G4DeexPrecoParameters.hh"
+#include "G4EmissionWidthTable.hh"
 #include "G4NucleiProperties.hh"
 #include "G4Pow.hh"
 #include "G4Log.hh"
@@ -59,7 +62,9 @@ G4EvaporationChannel::G4EvaporationChannel(G4int anA, G4int aZ,
     theA(anA),
     theZ(aZ),
     theProbability(aprob),
-    theCoulombBarrier(barrier)
+    theCoulombBarrier(barrier),
+    fWidthTable(nullptr),
+    isTabulated(false)
 { 
   ResA = ResZ = 0;
   Mass = CoulombBarrier = MinKinEnergy = MaxKinEnergy = EmissionProbability = 0.0; 
@@ -68,15 +73,79 @@ G4EvaporationChannel::G4EvaporationChannel(G4int anA, G4int aZ,
 }
 
 G4EvaporationChannel::~G4EvaporationChannel()
-{}
+{
+  delete fWidthTable;
+}
 
 void G4EvaporationChannel::Initialise()
 {
   theProbability->Initialise();
   G4VEvaporationChannel::Initialise();  
+  G4DeexPrecoParameters* param = 
+    G4NuclearLevelData::GetInstance()->GetParameters();
+  if(param->UseWidthTable()) {
+    if(nullptr == fWidthTable) {
+      fWidthTable = new G4EmissionWidthTable(param->GetWidthTableStep(),
+					     param->GetWidthTableMaxEnergy());
+    }
+  } else {
+    delete fWidthTable;
+    fWidthTable = nullptr;
+  }
 }
 
 G4double G4EvaporationChannel::GetEmissionProbability(G4Fragment* fragment)
+{
+  EmissionProbability = 0.0;
+  isTabulated = false;
+
+  // nodes of the table are computed before the limits for the 
+  // given fragment, because computation of nodes modifies them
+  G4double prob = (nullptr != fWidthTable) 
+    ? TabulatedProbability(fragment) : -1.0;
+
+  if(ComputeLimits(fragment)) {
+    if(prob > 0.0) {
+      EmissionProbability = prob;
+      isTabulated = true;
+    } else {
+      EmissionProbability = theProbability->
+	TotalProbability(*fragment, MinKinEnergy, MaxKinEnergy, CoulombBarrier);
+    }
+  }
+  //G4cout << "G4EvaporationChannel:: probability= " 
+  //    << EmissionProbability << G4endl;   
+  return EmissionProbability;
+}
+
+G4double 
+G4EvaporationChannel::TabulatedProbability(const G4Fragment* fragment)
+{
+  G4int FragA = fragment->GetA_asInt();
+  G4int FragZ = fragment->GetZ_asInt();
+  size_t idx;
+  G4double x;
+  G4double* nodes = fWidthTable->GetNodes(1000*FragZ + FragA, 
+					  fragment->GetExcitationEnergy(),
+					  idx, x);
+  if(nullptr == nodes) { return -1.0; }
+
+  for(size_t i=idx; i<=idx+1; ++i) {
+    if(nodes[i] < 0.0) {
+      nodes[i] = 0.0;
+      G4double mass = fragment->GetGroundStateMass() 
+	+ fWidthTable->GetEnergy(i);
+      G4Fragment frag(FragA, FragZ, G4LorentzVector(0.0, 0.0, 0.0, mass));
+      if(ComputeLimits(&frag)) {
+	nodes[i] = theProbability->
+	  TotalProbability(frag, MinKinEnergy, MaxKinEnergy, CoulombBarrier);
+      }
+    }
+  }
+  return fWidthTable->Interpolate(nodes, idx, x);
+}
+
+G4bool G4EvaporationChannel::ComputeLimits(const G4Fragment* fragment)
 {
   G4int FragA = fragment->GetA_asInt();
   G4int FragZ = fragment->GetZ_asInt();
@@ -88,7 +157,6 @@ G4double G4EvaporationChannel::GetEmissionProbability(G4Fragment* fragment)
   Mass = FragmentMass + ExEnergy;
   //G4cout << "G4EvaporationChannel::Initialize Z= " << theZ << " A= " << theA 
   //	 << " FragZ= " << FragZ << " FragA= " << FragA << G4endl;
-  EmissionProbability = 0.0;
 
   // Only channels which are physically allowed are taken into account 
   if (ResA >= ResZ && ResZ > 0 && ResA >= theA) {
@@ -121,13 +189,10 @@ G4double G4EvaporationChannel::GetEmissionProbability(G4Fragment* fragment)
       MaxKinEnergy = std::max(0.5*(xm2 - ResMass*ResMass)/Mass, 0.0);
       //G4cout << "Emin= " << MinKinEnergy << " Emax= " << MaxKinEnergy 
       //     << "  xm= " << xm  << G4endl;
-      EmissionProbability = theProbability->
-	TotalProbability(*fragment, MinKinEnergy, MaxKinEnergy, CoulombBarrier);
+      return true;
     }
   }
-  //G4cout << "G4EvaporationChannel:: probability= " 
-  //    << EmissionProbability << G4endl;   
-  return EmissionProbability;
+  return false;
 }
 
 G4Fragment* G4EvaporationChannel::EmittedFragment(G4Fragment* theNucleus)
@@ -141,6 +206,12 @@ G4Fragment* G4EvaporationChannel::EmittedFragment(G4Fragment* theNucleus)
     G4double mres = G4NucleiProperties::GetNuclearMass(ResA, ResZ);
     ekin = 0.5*(Mass*Mass - mres*mres + EvapMass*EvapMass)/Mass - EvapMass;
   } else {
+    // the spectrum is integrated only for the selected channel
+    if(isTabulated) {
+      theProbability->TotalProbability(*theNucleus, MinKinEnergy, 
+				       MaxKinEnergy, CoulombBarrier);
+      isTabulated = false;
+    }
     ekin = theProbability->SampleKineticEnergy(MinKinEnergy, MaxKinEnergy,
 					       CoulombBarrier);
   }
@@ -138,9 +138,10 @@ void G4ExcitationHandler::Initialise()
   if(fVerbose > 0) {
     G4cout << "G4ExcitationHandler::Initialise() started " << this << G4endl;
   }
-  G4DeexPrecoParameters* param = 
-    G4NuclearLevelData::GetInstance()->GetParameters();
+  G4NuclearLevelData* ndata = G4NuclearLevelData::GetInstance();
+  G4DeexPrecoParameters* param = ndata->GetParameters();
   isInitialised = true;
+  ndata->Initialise();
   SetParameters();
   if(isActive) {
     theFermiModel->Initialise();
@@ -83,9 +83,15 @@ private:
   G4UIcmdWithABool*          readCmd;
   G4UIcmdWithABool*          icCmd;
   G4UIcmdWithABool*          corgCmd;
+  G4UIcmdWithABool*          wtabCmd;
 
   G4UIcmdWithAnInteger*      maxjCmd;
 
+  G4UIcmdWithADoubleAndUnit* wstepCmd;
+  G4UIcmdWithADoubleAndUnit* wmaxCmd;
+
+  G4UIcmdWithAString*        cacheCmd;
+
 };
 
 #endif
@@ -84,6 +84,10 @@ public:
 
   inline G4double GetMinExPerNucleounForMF() const;
 
+  inline G4double GetWidthTableStep() const;
+
+  inline G4double GetWidthTableMaxEnergy() const;
+
   inline G4int GetInternalConversionID() const;
 
   inline G4int GetMinZForPreco() const;
@@ -116,8 +120,12 @@ public:
 
   inline G4bool StoreICLevelData() const;
 
+  inline G4bool UseWidthTable() const;
+
   inline G4DeexChannelType GetDeexChannelsType() const;
 
+  inline const G4String& GetLevelDataCache() const;
+
   // Set methods 
 
   void SetLevelDensity(G4double);
@@ -140,6 +148,10 @@ public:
 
   void SetMinEForMultiFrag(G4double);
 
+  void SetWidthTableStep(G4double);
+
+  void SetWidthTableMaxEnergy(G4double);
+
   void SetMinZForPreco(G4int);
 
   void SetMinAForPreco(G4int);
@@ -168,6 +180,8 @@ public:
 
   void SetStoreICLevelData(G4bool);
 
+  void SetUseWidthTable(G4bool);
+
   // obsolete method (use previous)
   void SetStoreAllLevels(G4bool);
 
@@ -175,6 +189,10 @@ public:
 
   void SetDeexChannelsType(G4DeexChannelType);
 
+  // name of the file with binary cache of nuclear level data,
+  // if empty level data are read from G4LEVELGAMMADATA files 
+  void SetLevelDataCache(const G4String&);
+
   // obsolete method (has no effect)
   inline void SetUseFilesNEW(G4bool) {};
 
@@ -216,6 +234,10 @@ private:
   // Multi-fragmentation model
   G4double fMinExPerNucleounForMF;
 
+  // Tables of emission widths
+  G4double fWidthTableStep;
+  G4double fWidthTableMaxEnergy;
+
   // Cross section type
   G4int fPrecoType;
   G4int fDeexType;
@@ -236,6 +258,7 @@ private:
   G4bool fUseHETC;
   G4bool fUseAngularGen;
   G4bool fPrecoDummy;
+  G4bool fUseWidthTable;
 
   // Deex flags
   G4bool fCorrelatedGamma;
@@ -245,6 +268,9 @@ private:
   // type of a set of e-exitation channels
   G4DeexChannelType fDeexChannelType;   
 
+  // binary cache of level data
+  G4String fLevelDataCache;
+
 #ifdef G4MULTITHREADED
   static G4Mutex deexPrecoMutex;
 #endif
@@ -295,6 +321,16 @@ inline G4double G4DeexPrecoParameters::GetMinExPerNucleounForMF() const
   return fMinExPerNucleounForMF;
 }
 
+inline G4double G4DeexPrecoParameters::GetWidthTableStep() const
+{
+  return fWidthTableStep;
+}
+
+inline G4double G4DeexPrecoParameters::GetWidthTableMaxEnergy() const
+{
+  return fWidthTableMaxEnergy;
+}
+
 inline G4int G4DeexPrecoParameters::GetInternalConversionID() const
 {
   return fInternalConversionID;
@@ -370,6 +406,11 @@ inline G4bool G4DeexPrecoParameters::StoreICLevelData() const
   return fStoreAllLevels;
 }
 
+inline G4bool G4DeexPrecoParameters::UseWidthTable() const
+{
+  return fUseWidthTable;
+}
+
 inline G4bool G4DeexPrecoParameters::GetInternalConversionFlag() const
 {
   return fInternalConversion;
@@ -380,4 +421,9 @@ inline G4DeexChannelType G4DeexPrecoParameters::GetDeexChannelsType() const
   return fDeexChannelType;
 }
 
+inline const G4String& G4DeexPrecoParameters::GetLevelDataCache() const
+{
+  return fLevelDataCache;
+}
+
 #endif
@@ -0,0 +1,137 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// -------------------------------------------------------------------
+//
+//      GEANT4 header file 
+//
+//      File name:     G4EmissionWidthTable
+//
+//      Creation date: 19 October 2018
+//
+//      Modifications:
+//      
+// -------------------------------------------------------------------
+//
+// Lazily filled table of total emission widths of one de-excitation
+// channel as a function of excitation energy. Each row of the table
+// corresponds to one configuration of the decaying nucleus identified
+// by an integer key (Z, A and, if needed, exciton numbers); nodes are 
+// equidistant in excitation energy and are computed by the owner of 
+// the table on first use. Between nodes widths are interpolated in
+// logarithmic scale. The table is not shared between threads.
+// 
+
+#ifndef G4EmissionWidthTable_h
+#define G4EmissionWidthTable_h 1
+
+#include "globals.hh"
+#include "G4Log.hh"
+#include "G4Exp.hh"
+#include <vector>
+#include <map>
+
+class G4EmissionWidthTable 
+{
+public:
+
+  explicit G4EmissionWidthTable(G4double step, G4double emax);
+
+  ~G4EmissionWidthTable();
+
+  // Returns pointer to the row of nodes for the key or nullptr if 
+  // the excitation energy is outside the grid; idx is the index of 
+  // the lower node, x is the relative position inside the bin
+  inline G4double* GetNodes(G4long key, G4double U, size_t& idx, 
+                            G4double& x);
+
+  // Excitation energy of the node
+  inline G4double GetEnergy(size_t idx) const;
+
+  // Interpolated width or negative value if interpolation is not 
+  // reliable (closed channel at one of nodes)
+  inline G4double Interpolate(const G4double* nodes, size_t idx, 
+                              G4double x) const;
+
+  inline size_t GetNumberOfRows() const;
+
+  void Clear();
+
+private:
+
+  G4EmissionWidthTable(const G4EmissionWidthTable &right) = delete;
+  const G4EmissionWidthTable & operator=
+  (const G4EmissionWidthTable &right) = delete;
+
+  G4double fStep;
+  G4double fInvStep;
+  size_t   fNodes;
+
+  // last used row is cached, because the same nucleus is usually
+  // requested several times in a row
+  G4long    fLastKey;
+  G4double* fLastRow;
+
+  std::map<G4long, std::vector<G4double>* > fTable;
+};
+
+inline G4double* 
+G4EmissionWidthTable::GetNodes(G4long key, G4double U, size_t& idx, 
+                               G4double& x)
+{
+  if(U < 0.0) { return nullptr; }
+  G4double y = U*fInvStep;
+  idx = (size_t)y;
+  if(idx + 1 >= fNodes) { return nullptr; }
+  x = y - (G4double)idx;
+  if(key != fLastKey || nullptr == fLastRow) {
+    std::vector<G4double>*& row = fTable[key];
+    if(nullptr == row) { row = new std::vector<G4double>(fNodes, -1.0); }
+    fLastKey = key;
+    fLastRow = row->data();
+  }
+  return fLastRow;
+}
+
+inline G4double G4EmissionWidthTable::GetEnergy(size_t idx) const
+{
+  return idx*fStep;
+}
+
+inline G4double 
+G4EmissionWidthTable::Interpolate(const G4double* nodes, size_t idx, 
+                                  G4double x) const
+{
+  G4double y1 = nodes[idx];
+  G4double y2 = nodes[idx+1];
+  return (y1 > 0.0 && y2 > 0.0) ? y1*G4Exp(x*G4Log(y2/y1)) : -1.0;
+}
+
+inline size_t G4EmissionWidthTable::GetNumberOfRows() const
+{
+  return fTable.size();
+}
+
+#endif
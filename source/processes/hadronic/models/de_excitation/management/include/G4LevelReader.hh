@@ -36,6 +36,7 @@
 //      Creation date: 4 January 2012
 //
 //      Modifications:
+//      19.10.2018 Added binary streaming of level managers
 //      
 // -------------------------------------------------------------------
 //
@@ -66,6 +67,17 @@ public:
   const G4LevelManager* MakeLevelManager(G4int Z, G4int A,
 					 const G4String& filename);
 
+  // check if G4LEVELGAMMADATA file for Z and A exists
+  G4bool HasLevelFile(G4int Z, G4int A) const;
+
+  inline const G4String& GetDataDirectory() const;
+
+  // binary image of a level manager used for the cache of level data
+  void StreamBinary(std::ostream& out, const G4LevelManager*) const;
+
+  // create level manager from the binary image
+  const G4LevelManager* MakeLevelManager(const char* data, size_t length);
+
   inline void SetVerbose(G4int val);
   
 private:
@@ -140,6 +152,11 @@ private:
   std::vector<const std::vector<G4float>*> vShellProbability;
 };
 
+inline const G4String& G4LevelReader::GetDataDirectory() const
+{
+  return fDirectory;
+}
+
 inline void G4LevelReader::SetVerbose(G4int val)
 {
   fVerbose = val;
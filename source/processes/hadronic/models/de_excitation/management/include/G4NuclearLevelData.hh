@@ -36,11 +36,19 @@
 //      Creation date: 9 February 2014
 //
 //      Modifications:
+//      19.10.2018 Added optional binary cache of level data
 //      
 // -------------------------------------------------------------------
 //
 // Nuclear level data uploaded at initialisation of Geant4 from 
 // data files of the G4LEVELGAMMADATA
+//
+// If the name of a cache file is defined via G4DeexPrecoParameters, 
+// the level data are read from a compact binary image of all level 
+// managers, which is created once from G4LEVELGAMMADATA if the file 
+// does not exist or is not compatible. The image is uploaded in one
+// block by the master thread at initialisation and is not modified 
+// later; level managers are created from it on first request. 
 // 
 
 #ifndef G4NUCLEARLEVELDATA_HH
@@ -51,6 +59,7 @@
 #include "G4Threading.hh"
 #include <vector>
 #include <iostream>
+#include <atomic>
 
 class G4LevelReader;
 class G4LevelManager;
@@ -74,6 +83,10 @@ public:
   // run time call to access or to create level manager
   const G4LevelManager* GetLevelManager(G4int Z, G4int A);
 
+  // upload or create the binary cache of level data, if defined;
+  // acts only on the master thread, to be called at initialisation
+  void Initialise();
+
   // add private data to isotope from master thread
   G4bool AddPrivateData(G4int Z, G4int A, const G4String& filename);
 
@@ -111,6 +124,15 @@ private:
 
   void InitialiseForIsotope(G4int Z, G4int A);
 
+  // binary cache of level data
+  void InitialiseCache(G4bool create);
+
+  G4bool ReadCache(const G4String& fname);
+
+  void WriteCache(const G4String& fname);
+
+  inline G4int CacheIndex(G4int Z, G4int A) const;
+
   G4DeexPrecoParameters* fDeexPrecoParameters;
   G4LevelReader*         fLevelReader;
   G4PairingCorrection*   fPairingCorrection;
@@ -122,11 +144,21 @@ private:
   static const G4int LEVELIDX[ZMAX];
 
   std::vector<const G4LevelManager*> fLevelManagers[ZMAX];
-  std::vector<G4bool> fLevelManagerFlags[ZMAX];
+  std::vector<std::atomic<G4bool> > fLevelManagerFlags[ZMAX];
+
+  G4bool fCacheInitialised;
+  std::vector<char> fCache;
+  std::vector<size_t> fCacheOffset;
+  std::vector<size_t> fCacheSize;
 
 #ifdef G4MULTITHREADED
   static G4Mutex nuclearLevelDataMutex;
 #endif
 };
 
+inline G4int G4NuclearLevelData::CacheIndex(G4int Z, G4int A) const
+{
+  return LEVELIDX[Z] + A - AMIN[Z];
+}
+
 #endif
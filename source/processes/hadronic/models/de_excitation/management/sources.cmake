@@ -45,6 +45,7 @@ GEANT4_DEFINE_MODULE(NAME G4hadronic_deex_management
     HEADERS
         G4DeexParametersMessenger.hh
         G4DeexPrecoParameters.hh
+        G4EmissionWidthTable.hh
         G4LevelManager.hh
         G4LevelReader.hh
         G4NuclearLevelData.hh
@@ -55,6 +56,7 @@ GEANT4_DEFINE_MODULE(NAME G4hadronic_deex_management
     SOURCES
         G4DeexParametersMessenger.cc
         G4DeexPrecoParameters.cc
+        G4EmissionWidthTable.cc
         G4LevelManager.cc
         G4LevelReader.cc
         G4NuclearLevelData.cc
@@ -88,6 +88,34 @@ G4DeexParametersMessenger::G4DeexParametersMessenger(G4DeexPrecoParameters* ptr)
   maxjCmd->SetParameterName("max2J",true);
   maxjCmd->SetDefaultValue(10);
   maxjCmd->AvailableForStates(G4State_PreInit);
+
+  wtabCmd = new G4UIcmdWithABool("/process/deex/useWidthTable",this);
+  wtabCmd->SetGuidance("Enable/disable tables of emission widths.");
+  wtabCmd->SetParameterName("wtab",true);
+  wtabCmd->SetDefaultValue(false);
+  wtabCmd->AvailableForStates(G4State_PreInit);
+
+  wstepCmd = new G4UIcmdWithADoubleAndUnit("/process/deex/widthTableStep",this);
+  wstepCmd->SetGuidance("Set excitation energy step of tables of emission widths.");
+  wstepCmd->SetParameterName("wstep",true);
+  wstepCmd->SetUnitCategory("Energy");
+  wstepCmd->SetDefaultValue(0.5);
+  wstepCmd->SetDefaultUnit("MeV");
+  wstepCmd->AvailableForStates(G4State_PreInit);
+
+  wmaxCmd = new G4UIcmdWithADoubleAndUnit("/process/deex/widthTableMaxEnergy",this);
+  wmaxCmd->SetGuidance("Set max excitation energy of tables of emission widths.");
+  wmaxCmd->SetParameterName("wmax",true);
+  wmaxCmd->SetUnitCategory("Energy");
+  wmaxCmd->SetDefaultValue(200.);
+  wmaxCmd->SetDefaultUnit("MeV");
+  wmaxCmd->AvailableForStates(G4State_PreInit);
+
+  cacheCmd = new G4UIcmdWithAString("/process/deex/levelDataCache",this);
+  cacheCmd->SetGuidance("Set file name of binary cache of nuclear level data.");
+  cacheCmd->SetGuidance("The file is created if it does not exist.");
+  cacheCmd->SetParameterName("fname",false);
+  cacheCmd->AvailableForStates(G4State_PreInit);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
@@ -100,6 +128,10 @@ G4DeexParametersMessenger::~G4DeexParametersMessenger()
   delete icCmd;
   delete corgCmd;
   delete maxjCmd;
+  delete wtabCmd;
+  delete wstepCmd;
+  delete wmaxCmd;
+  delete cacheCmd;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
@@ -115,6 +147,14 @@ void G4DeexParametersMessenger::SetNewValue(G4UIcommand* command,
     theParameters->SetCorrelatedGamma(corgCmd->GetNewBoolValue(newValue));
   } else if (command == maxjCmd) { 
     theParameters->SetTwoJMAX(maxjCmd->GetNewIntValue(newValue));
+  } else if (command == wtabCmd) {
+    theParameters->SetUseWidthTable(wtabCmd->GetNewBoolValue(newValue));
+  } else if (command == wstepCmd) { 
+    theParameters->SetWidthTableStep(wstepCmd->GetNewDoubleValue(newValue));
+  } else if (command == wmaxCmd) { 
+    theParameters->SetWidthTableMaxEnergy(wmaxCmd->GetNewDoubleValue(newValue));
+  } else if (command == cacheCmd) { 
+    theParameters->SetLevelDataCache(newValue);
   }
 }
 
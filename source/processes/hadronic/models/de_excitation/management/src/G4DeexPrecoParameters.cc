@@ -69,6 +69,8 @@ void G4DeexPrecoParameters::SetDefaults()
   fMinExcitation = 10*CLHEP::eV;
   fMaxLifeTime = 1000*CLHEP::second;
   fMinExPerNucleounForMF = 100*CLHEP::GeV;
+  fWidthTableStep = 0.5*CLHEP::MeV;
+  fWidthTableMaxEnergy = 200*CLHEP::MeV;
   fMinZForPreco = 3;
   fMinAForPreco = 5;
   fPrecoType = 3;
@@ -81,10 +83,12 @@ void G4DeexPrecoParameters::SetDefaults()
   fUseHETC = false;
   fUseAngularGen = true;
   fPrecoDummy = false;
+  fUseWidthTable = false;
   fCorrelatedGamma = false;
   fStoreAllLevels = false;
   fInternalConversion = true;
   fDeexChannelType = fEvaporation;
+  fLevelDataCache = "";
   fInternalConversionID = 
     G4PhysicsModelCatalog::Register("e-InternalConvertion");
 #ifdef G4MULTITHREADED
@@ -146,6 +150,18 @@ void G4DeexPrecoParameters::SetMinExPerNucleounForMF(G4double val)
   fMinExPerNucleounForMF = val;
 }
 
+void G4DeexPrecoParameters::SetWidthTableStep(G4double val)
+{
+  if(IsLocked() || val <= 0.0) { return; }
+  fWidthTableStep = val;
+}
+
+void G4DeexPrecoParameters::SetWidthTableMaxEnergy(G4double val)
+{
+  if(IsLocked() || val <= 0.0) { return; }
+  fWidthTableMaxEnergy = val;
+}
+
 void G4DeexPrecoParameters::SetMinZForPreco(G4int n)
 {
   if(IsLocked() || n < 2) { return; }
@@ -231,6 +247,12 @@ void G4DeexPrecoParameters::SetStoreICLevelData(G4bool val)
   fStoreAllLevels = val;
 }
 
+void G4DeexPrecoParameters::SetUseWidthTable(G4bool val)
+{
+  if(IsLocked()) { return; }
+  fUseWidthTable = val;
+}
+
 void G4DeexPrecoParameters::SetStoreAllLevels(G4bool val)
 {
   SetStoreICLevelData(val);
@@ -248,6 +270,12 @@ void G4DeexPrecoParameters::SetDeexChannelsType(G4DeexChannelType val)
   fDeexChannelType = val;
 }
 
+void G4DeexPrecoParameters::SetLevelDataCache(const G4String& fname)
+{
+  if(IsLocked()) { return; }
+  fLevelDataCache = fname;
+}
+
 std::ostream& G4DeexPrecoParameters::StreamInfo(std::ostream& os) const
 {
   static const G4String namm[4] = {"Evaporation","GEM","Evaporation+GEM","Dummy"};
@@ -271,6 +299,14 @@ std::ostream& G4DeexPrecoParameters::StreamInfo(std::ostream& os) const
      << fMinExPerNucleounForMF/CLHEP::MeV << "\n";
   os << "Level density (1/MeV)                               " 
      << fLevelDensity*CLHEP::MeV << "\n";
+  os << "Use tables of emission widths                       " 
+     << fUseWidthTable << "\n";
+  if(fUseWidthTable) {
+    os << "Step of tables of emission widths (MeV)             " 
+       << fWidthTableStep/CLHEP::MeV << "\n";
+    os << "Max excitation for tables of emission widths (MeV)  " 
+       << fWidthTableMaxEnergy/CLHEP::MeV << "\n";
+  }
   os << "Time limit for long lived isomeres (ns)             " 
      << fMaxLifeTime/CLHEP::ns << "\n";
   os << "Internal e- conversion flag                         " 
@@ -278,6 +314,9 @@ std::ostream& G4DeexPrecoParameters::StreamInfo(std::ostream& os) const
   os << "Store e- internal conversion data                   " << fStoreAllLevels << "\n";
   os << "Electron internal conversion ID                     " 
      << fInternalConversionID << "\n";
+  if(!fLevelDataCache.empty()) {
+    os << "Binary cache of level data                          " << fLevelDataCache << "\n";
+  }
   os << "Correlated gamma emission flag                      " << fCorrelatedGamma << "\n";
   os << "Max 2J for sampling of angular correlations         " << fTwoJMAX << "\n";
   os << "=======================================================================" << "\n";
@@ -0,0 +1,58 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// -------------------------------------------------------------------
+//
+//      GEANT4 source file 
+//
+//      File name:     G4EmissionWidthTable
+//
+//      Creation date: 19 October 2018
+//
+//      Modifications:
+//      
+// -------------------------------------------------------------------
+
+#include "G4EmissionWidthTable.hh"
+
+G4EmissionWidthTable::G4EmissionWidthTable(G4double step, G4double emax)
+  : fStep(step), fLastKey(-1), fLastRow(nullptr)
+{
+  fInvStep = 1.0/fStep;
+  fNodes = (size_t)(emax*fInvStep) + 2;
+}
+
+G4EmissionWidthTable::~G4EmissionWidthTable()
+{
+  Clear();
+}
+
+void G4EmissionWidthTable::Clear()
+{
+  for(auto & row : fTable) { delete row.second; }
+  fTable.clear();
+  fLastKey = -1;
+  fLastRow = nullptr;
+}
@@ -36,6 +36,7 @@
 //      Creation date: 4 January 2012
 //
 //      Modifications:
+//      19.10.2018 Added binary streaming of level managers
 //
 // -------------------------------------------------------------------
 
@@ -49,6 +50,25 @@
 #include <vector>
 #include <fstream>
 #include <sstream>
+#include <cstring>
+
+namespace
+{
+  template <typename T> 
+  inline void WriteItem(std::ostream& out, T x)
+  {
+    out.write(reinterpret_cast<const char*>(&x), sizeof(T));
+  }
+
+  template <typename T> 
+  inline G4bool ReadItem(const char*& ptr, const char* end, T& x)
+  {
+    if(ptr + sizeof(T) > end) { return false; }
+    std::memcpy(&x, ptr, sizeof(T));
+    ptr += sizeof(T);
+    return true;
+  }
+}
 
 G4String G4LevelReader::fFloatingLevels[] = {
   "-", "+X", "+Y", "+Z", "+U", "+V", "+W", "+R", "+S", "+T", "+A", "+B", "+C"};
@@ -458,3 +478,106 @@ G4LevelReader::LevelManager(G4int Z, G4int A, G4int nlev,
 
   return lman;
 }
+
+G4bool G4LevelReader::HasLevelFile(G4int Z, G4int A) const
+{
+  std::ostringstream ss;
+  ss << fDirectory << "/z" << Z << ".a" << A;
+  std::ifstream infile(ss.str().c_str(), std::ios::in);
+  return infile.is_open();
+}
+
+void 
+G4LevelReader::StreamBinary(std::ostream& out, const G4LevelManager* man) const
+{
+  // record: number of levels, then for each level energy, spin code 
+  // and, if exists, the list of transitions
+  G4int nlev = (man) ? (G4int)man->NumberOfTransitions() + 1 : 0;
+  WriteItem(out, nlev);
+  for(G4int i=0; i<nlev; ++i) {
+    WriteItem(out, man->LevelEnergy(i));
+    G4int spin = man->FloatingLevel(i)*100000 + 100 
+      + man->Parity(i)*man->SpinTwo(i);
+    WriteItem(out, spin);
+    const G4NucLevel* level = man->GetLevel(i);
+    G4int ntr = (level) ? (G4int)level->NumberOfTransitions() : -1;
+    WriteItem(out, ntr);
+    if(!level) { continue; }
+    WriteItem(out, level->GetTimeGamma());
+    for(G4int j=0; j<ntr; ++j) {
+      WriteItem(out, (G4int)(level->FinalExcitationIndex(j)*10000 
+			     + level->TransitionType(j)));
+      WriteItem(out, level->GammaCumProbability(j));
+      WriteItem(out, level->GammaProbability(j));
+      WriteItem(out, level->MultipolarityRatio(j));
+      const std::vector<G4float>* shell = level->ShellProbabilty(j);
+      G4int nsh = (shell) ? (G4int)shell->size() : 0;
+      WriteItem(out, nsh);
+      for(G4int k=0; k<nsh; ++k) { WriteItem(out, (*shell)[k]); }
+    }
+  }
+}
+
+const G4LevelManager* 
+G4LevelReader::MakeLevelManager(const char* data, size_t length)
+{
+  const char* ptr = data;
+  const char* end = data + length;
+  G4int nlev(0);
+  if(!ReadItem(ptr, end, nlev) || nlev <= 0) { return nullptr; }
+
+  if(nlev > fLevelMax) {
+    fLevelMax = nlev;
+    vEnergy.resize(fLevelMax,0.0);
+    vSpin.resize(fLevelMax,0);
+    vLevel.resize(fLevelMax,nullptr);
+  }
+  G4bool ok = true;
+  G4int i = 0;
+  for(; i<nlev; ++i) {
+    G4int ntr(0);
+    vLevel[i] = nullptr;
+    if(!(ReadItem(ptr, end, vEnergy[i]) && ReadItem(ptr, end, vSpin[i]) &&
+	 ReadItem(ptr, end, ntr))) { ok = false; break; }
+    if(ntr < 0) { continue; }
+    if(!ReadItem(ptr, end, fTime)) { ok = false; break; }
+    if(ntr > fTransMax) {
+      fTransMax = ntr;
+      vTrans.resize(fTransMax);
+      vRatio.resize(fTransMax);
+      vGammaCumProbability.resize(fTransMax);
+      vGammaProbability.resize(fTransMax);
+      vShellProbability.resize(fTransMax);
+    }
+    for(G4int j=0; j<ntr; ++j) { vShellProbability[j] = nullptr; }
+    for(G4int j=0; j<ntr && ok; ++j) {
+      G4int nsh(0);
+      if(!(ReadItem(ptr, end, vTrans[j]) && 
+	   ReadItem(ptr, end, vGammaCumProbability[j]) &&
+	   ReadItem(ptr, end, vGammaProbability[j]) &&
+	   ReadItem(ptr, end, vRatio[j]) &&
+	   ReadItem(ptr, end, nsh))) { ok = false; break; }
+      if(0 < nsh) {
+	std::vector<G4float>* vec = new std::vector<G4float>(nsh, 0.0f);
+	for(G4int k=0; k<nsh; ++k) { 
+	  if(!ReadItem(ptr, end, (*vec)[k])) { ok = false; break; }
+	}
+	vShellProbability[j] = vec;
+      }
+    }
+    vLevel[i] = new G4NucLevel((size_t)ntr, fTime,
+			       vTrans,
+			       vGammaCumProbability,
+			       vGammaProbability,
+			       vRatio,
+			       vShellProbability);
+    if(!ok) { ++i; break; }
+  }
+  if(!ok) {
+    for(G4int j=0; j<i; ++j) { delete vLevel[j]; }
+    G4Exception("G4LevelReader::MakeLevelManager(..)","had014",
+		JustWarning, "Corrupted binary level data, ignored");
+    return nullptr;
+  }
+  return new G4LevelManager((size_t)nlev,vEnergy,vSpin,vLevel);
+}
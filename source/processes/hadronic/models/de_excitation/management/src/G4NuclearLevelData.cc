@@ -36,6 +36,7 @@
 //      Creation date: 10 February 2015
 //
 //      Modifications:
+//      19.10.2018 Added optional binary cache of level data
 //      
 // -------------------------------------------------------------------
 
@@ -48,6 +49,16 @@
 #include "G4PairingCorrection.hh"
 #include "G4ShellCorrection.hh"
 #include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cstdio>
+#include <cstdint>
+#if defined(WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
 
 G4NuclearLevelData* G4NuclearLevelData::theInstance = nullptr;
 
@@ -434,13 +445,21 @@ G4NuclearLevelData* G4NuclearLevelData::GetInstance()
   return theInstance;
 }   
 
-G4NuclearLevelData::G4NuclearLevelData()
+namespace
+{
+  const char fCacheTag[8] = {'G','4','L','E','V','E','L','\0'};
+  const G4int fCacheVersion = 1;
+}
+
+G4NuclearLevelData::G4NuclearLevelData() : fCacheInitialised(false)
 {
   fDeexPrecoParameters = new G4DeexPrecoParameters();
   fLevelReader = new G4LevelReader(this);
   for(G4int Z=0; Z<ZMAX; ++Z) {
-    (fLevelManagers[Z]).resize(AMAX[Z]-AMIN[Z]+1,nullptr);
-    (fLevelManagerFlags[Z]).resize(AMAX[Z]-AMIN[Z]+1,false);
+    size_t nn = AMAX[Z]-AMIN[Z]+1;
+    (fLevelManagers[Z]).resize(nn,nullptr);
+    fLevelManagerFlags[Z] = std::vector<std::atomic<G4bool> >(nn);
+    for(size_t j=0; j<nn; ++j) { (fLevelManagerFlags[Z])[j] = false; }
   }
   fShellCorrection = new G4ShellCorrection();
   fPairingCorrection = new G4PairingCorrection();
@@ -468,10 +487,11 @@ G4NuclearLevelData::GetLevelManager(G4int Z, G4int A)
   const G4LevelManager* man = nullptr;
   //G4cout << "G4NuclearLevelData: Z= " << Z << " A= " << A << G4endl;  
   if(0 < Z && Z < ZMAX && A >= AMIN[Z] && A <= AMAX[Z]) {
-    if(!(fLevelManagerFlags[Z])[A - AMIN[Z]]) {
+    G4int idx = A - AMIN[Z];
+    if(!(fLevelManagerFlags[Z])[idx].load(std::memory_order_acquire)) {
       InitialiseForIsotope(Z, A);
     }
-    man = (fLevelManagers[Z])[A - AMIN[Z]];
+    man = (fLevelManagers[Z])[idx];
   }
   //G4cout << man << G4endl;
   return man;
@@ -490,7 +510,8 @@ G4NuclearLevelData::AddPrivateData(G4int Z, G4int A, const G4String& filename)
     if(newman) { 
       delete (fLevelManagers[Z])[A - AMIN[Z]]; 
       (fLevelManagers[Z])[A - AMIN[Z]] = newman;
-      (fLevelManagerFlags[Z])[A - AMIN[Z]] = true;
+      (fLevelManagerFlags[Z])[A - AMIN[Z]].store(true, 
+                                                 std::memory_order_release);
       res = true;
     }
   } else {
@@ -522,16 +543,176 @@ void G4NuclearLevelData::InitialiseForIsotope(G4int Z, G4int A)
 #ifdef G4MULTITHREADED
   G4MUTEXLOCK(&nuclearLevelDataMutex);
 #endif
-  if(!(fLevelManagerFlags[Z])[A - AMIN[Z]]) {
-    (fLevelManagers[Z])[A - AMIN[Z]] = 
-      fLevelReader->CreateLevelManager(Z, A);
-    (fLevelManagerFlags[Z])[A - AMIN[Z]] = true;
+  // the cache is normally uploaded by the master at initialisation,
+  // a thread may only read an existing cache here
+  if(!fCacheInitialised) { InitialiseCache(false); }
+  G4int idx = A - AMIN[Z];
+  if(!(fLevelManagerFlags[Z])[idx].load(std::memory_order_relaxed)) {
+    const G4LevelManager* man = nullptr;
+    if(!fCache.empty()) {
+      G4int i = CacheIndex(Z, A);
+      if(0 < fCacheSize[i]) { 
+	man = fLevelReader->MakeLevelManager(&fCache[fCacheOffset[i]], 
+					     fCacheSize[i]);
+      }
+    } else {
+      man = fLevelReader->CreateLevelManager(Z, A);
+    }
+    (fLevelManagers[Z])[idx] = man;
+    (fLevelManagerFlags[Z])[idx].store(true, std::memory_order_release);
   }
 #ifdef G4MULTITHREADED
   G4MUTEXUNLOCK(&nuclearLevelDataMutex);
 #endif
 }
 
+void G4NuclearLevelData::Initialise()
+{
+  if(!G4Threading::IsMasterThread()) { return; }
+#ifdef G4MULTITHREADED
+  G4MUTEXLOCK(&nuclearLevelDataMutex);
+#endif
+  if(!fCacheInitialised) { InitialiseCache(true); }
+#ifdef G4MULTITHREADED
+  G4MUTEXUNLOCK(&nuclearLevelDataMutex);
+#endif
+}
+
+void G4NuclearLevelData::InitialiseCache(G4bool create)
+{
+  // called under the mutex
+  fCacheInitialised = true;
+  const G4String& fname = fDeexPrecoParameters->GetLevelDataCache();
+  if(fname.empty()) { return; }
+  if(ReadCache(fname) || !create) { return; }
+
+  WriteCache(fname);
+  if(!ReadCache(fname)) {
+    G4ExceptionDescription ed;
+    ed << "Binary cache of nuclear level data <" << fname 
+       << "> cannot be used, level data are read from G4LEVELGAMMADATA";
+    G4Exception("G4NuclearLevelData::InitialiseCache()","had0434",
+		JustWarning,ed,"");
+  }
+}
+
+G4bool G4NuclearLevelData::ReadCache(const G4String& fname)
+{
+  fCache.clear();
+  std::ifstream in(fname.c_str(), std::ios::in | std::ios::binary);
+  if(!in.is_open()) { return false; }
+
+  // the whole file is uploaded in one block
+  in.seekg(0, std::ios::end);
+  size_t length = (size_t)in.tellg();
+  in.seekg(0, std::ios::beg);
+  fCache.resize(length);
+  if(0 < length) { in.read(&fCache[0], length); }
+  if(in.fail() || 0 == length) { fCache.clear(); return false; }
+
+  const char* ptr = &fCache[0];
+  const char* end = ptr + length;
+  const G4String& dir = fLevelReader->GetDataDirectory();
+  G4int nslots = CacheIndex(ZMAX-1, AMAX[ZMAX-1]) + 1;
+  G4int version(0), ic(0), nn(0), ndir(0);
+
+  // header: tag, version, IC flag, number of isotopes, data directory
+  size_t hsize = sizeof(fCacheTag) + 4*sizeof(G4int);
+  G4bool ok = (length >= hsize && 
+	       0 == std::memcmp(ptr, fCacheTag, sizeof(fCacheTag)));
+  if(ok) {
+    ptr += sizeof(fCacheTag);
+    std::memcpy(&version, ptr, sizeof(G4int)); ptr += sizeof(G4int);
+    std::memcpy(&ic, ptr, sizeof(G4int));      ptr += sizeof(G4int);
+    std::memcpy(&nn, ptr, sizeof(G4int));      ptr += sizeof(G4int);
+    std::memcpy(&ndir, ptr, sizeof(G4int));    ptr += sizeof(G4int);
+    ok = (version == fCacheVersion && nn == nslots && 
+	  ic == (G4int)fDeexPrecoParameters->StoreICLevelData() &&
+	  ndir == (G4int)dir.size() && ptr + ndir <= end &&
+	  dir == G4String(ptr, ndir));
+    ptr += ndir;
+  }
+  size_t isize = 2*sizeof(std::uint64_t)*nslots;
+  if(ok && ptr + isize <= end) {
+    size_t data = (size_t)(ptr - &fCache[0]) + isize;
+    fCacheOffset.resize(nslots, 0);
+    fCacheSize.resize(nslots, 0);
+    std::uint64_t x;
+    for(G4int i=0; i<nslots; ++i) {
+      std::memcpy(&x, ptr, sizeof(x)); ptr += sizeof(x);
+      fCacheOffset[i] = data + (size_t)x;
+      std::memcpy(&x, ptr, sizeof(x)); ptr += sizeof(x);
+      fCacheSize[i] = (size_t)x;
+      if(fCacheOffset[i] + fCacheSize[i] > length) { ok = false; break; }
+    }
+  } else {
+    ok = false;
+  }
+  if(!ok) { 
+    fCache.clear(); 
+    G4cout << "### G4NuclearLevelData: binary cache of level data <" 
+	   << fname << "> is not compatible with the level data" << G4endl;
+  }
+  return ok;
+}
+
+void G4NuclearLevelData::WriteCache(const G4String& fname)
+{
+  G4cout << "### G4NuclearLevelData: creating binary cache of level data <" 
+	 << fname << ">" << G4endl;
+  G4int nslots = CacheIndex(ZMAX-1, AMAX[ZMAX-1]) + 1;
+  std::vector<std::uint64_t> offset(nslots, 0);
+  std::vector<std::uint64_t> size(nslots, 0);
+  std::ostringstream data(std::ios::out | std::ios::binary);
+
+  for(G4int Z=1; Z<ZMAX; ++Z) {
+    if(0 == AMAX[Z]) { continue; }
+    for(G4int A=AMIN[Z]; A<=AMAX[Z]; ++A) {
+      if(!fLevelReader->HasLevelFile(Z, A)) { continue; }
+      const G4LevelManager* man = fLevelReader->CreateLevelManager(Z, A);
+      if(!man) { continue; }
+      G4int i = CacheIndex(Z, A);
+      offset[i] = (std::uint64_t)data.tellp();
+      fLevelReader->StreamBinary(data, man);
+      size[i] = (std::uint64_t)data.tellp() - offset[i];
+      delete man;
+    }
+  }
+
+  // the file is written under a temporary name private to this process
+  // and renamed into place, so a concurrent job never reads a partially
+  // written cache
+  std::ostringstream tmp;
+#if defined(WIN32)
+  tmp << fname << "." << _getpid() << ".tmp";
+#else
+  tmp << fname << "." << getpid() << ".tmp";
+#endif
+  G4String tmpName = tmp.str();
+  std::ofstream out(tmpName.c_str(), std::ios::out | std::ios::binary);
+  if(!out.is_open()) { return; }
+  const G4String& dir = fLevelReader->GetDataDirectory();
+  G4int version = fCacheVersion;
+  G4int ic = (G4int)fDeexPrecoParameters->StoreICLevelData();
+  G4int ndir = (G4int)dir.size();
+  out.write(fCacheTag, sizeof(fCacheTag));
+  out.write(reinterpret_cast<const char*>(&version), sizeof(G4int));
+  out.write(reinterpret_cast<const char*>(&ic), sizeof(G4int));
+  out.write(reinterpret_cast<const char*>(&nslots), sizeof(G4int));
+  out.write(reinterpret_cast<const char*>(&ndir), sizeof(G4int));
+  out.write(dir.c_str(), ndir);
+  for(G4int i=0; i<nslots; ++i) {
+    out.write(reinterpret_cast<const char*>(&offset[i]), sizeof(std::uint64_t));
+    out.write(reinterpret_cast<const char*>(&size[i]), sizeof(std::uint64_t));
+  }
+  const std::string& buf = data.str();
+  out.write(buf.data(), buf.size());
+  out.close();
+  if(out.fail() || 0 != std::rename(tmpName.c_str(), fname.c_str())) {
+    std::remove(tmpName.c_str());
+  }
+}
+
 G4double G4NuclearLevelData::GetMaxLevelEnergy(G4int Z, G4int A) const
 {
   return (0 < Z && Z < ZMAX && A >= AMIN[Z] && A <= AMAX[Z]) ?
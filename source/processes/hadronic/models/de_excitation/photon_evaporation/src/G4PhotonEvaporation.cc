@@ -97,6 +97,7 @@ void G4PhotonEvaporation::Initialise()
   if(fVerbose > 0) {
     G4cout << "### G4PhotonEvaporation is initialized " << this << G4endl;   
   }
+  fNuclearLevelData->Initialise();
   G4DeexPrecoParameters* param = fNuclearLevelData->GetParameters();
   LevelDensity = param->GetLevelDensity();
   Tolerance = param->GetMinExcitation();
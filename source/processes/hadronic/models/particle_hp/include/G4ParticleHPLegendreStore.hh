@@ -26,13 +26,19 @@
 //
 // P. Arce, June-2014 Conversion neutron_hp to particle_hp
 //
+// 19.10.2018 Optional inverse-CDF tables of the angular distribution at each
+//            tabulated energy, built lazily on first use and shared between
+//            threads together with the store
+//
 #ifndef G4ParticleHPLegendreStore_h
 #define G4ParticleHPLegendreStore_h 1
 
 #include "G4ParticleHPLegendreTable.hh"
 #include "G4InterpolationManager.hh"
 #include "G4ios.hh"
+#include "G4Threading.hh"
 #include <fstream>
+#include <atomic>
 
 class G4ParticleHPLegendreStore
 {
@@ -42,12 +48,26 @@ class G4ParticleHPLegendreStore
   {
     theCoeff = new G4ParticleHPLegendreTable[n];
     nEnergy = n;
+    nTables = n;
+    useTables = false;
+    theTables = 0;
   }
   
   ~G4ParticleHPLegendreStore()
   {
     delete [] theCoeff;
+    if(theTables != 0)
+    {
+      for(G4int i=0; i<nTables; i++) delete [] theTables[i].load();
+      delete [] theTables;
+    }
   }
+
+  // Sample the Legendre-represented distributions by inversion of tabulated
+  // cumulative distributions instead of by rejection.  Only worth enabling
+  // for stores kept for the whole run.
+  void SetUseTables(G4bool val);
+  inline G4bool GetUseTables() const { return useTables; }
   
   inline void Init(G4int i, G4double e, G4int n)
   {
@@ -75,6 +95,7 @@ class G4ParticleHPLegendreStore
   G4double Sample (G4double energy);
   G4double SampleMax (G4double energy);
   G4double Integrate(G4int k, G4double costh);
+  G4double SampleFromTables(G4double anEnergy);
   
   void InitInterpolation(std::istream & aDataFile)
   {
@@ -87,9 +108,22 @@ class G4ParticleHPLegendreStore
   }
 
   private:
+
+  const G4double* GetTable(G4int i);
+  G4double SampleTable(const G4double* aTable);
   
   G4int nEnergy;
   G4ParticleHPLegendreTable * theCoeff;
   G4InterpolationManager theManager; // interpolate between different Tables
+
+  // Probability density and normalised cumulative distribution on a uniform
+  // grid of nTableBins bins in cos(theta), one table per energy
+  static const G4int nTableBins = 600;
+  G4int nTables;
+  G4bool useTables;
+  std::atomic<const G4double*>* theTables;
+#ifdef G4MULTITHREADED
+  static G4Mutex tableMutex;
+#endif
 };
 #endif
@@ -31,6 +31,10 @@
 //
 // P. Arce, June-2014 Conversion neutron_hp to particle_hp
 //
+// 19.10.2018 The data points are reference counted and shared between vectors
+//            assigned from one another, and copied only when one of them is
+//            modified. GetXsec bisects the data instead of using a hash.
+//
 #ifndef G4ParticleHPVector_h
 #define G4ParticleHPVector_h 1
 
@@ -45,9 +49,9 @@
 #include "G4Log.hh"
 #include "G4Pow.hh"
 #include "G4ParticleHPInterpolator.hh"
-#include "G4ParticleHPHash.hh"
 #include <cmath>
 #include <vector>
+#include <atomic>
 
 #if defined WIN32-VC
    #include <float.h>
@@ -63,6 +67,9 @@ class G4ParticleHPVector
   G4ParticleHPVector();
 
   G4ParticleHPVector(G4int n);
+
+  // The copy shares the data points of right until either is modified
+  G4ParticleHPVector(const G4ParticleHPVector & right);
   
   ~G4ParticleHPVector();
   
@@ -75,6 +82,7 @@ class G4ParticleHPVector
   
   inline void Times(G4double factor)
   {
+    MakeWritable();
     G4int i;
     for(i=0; i<nEntries; i++)
     {
@@ -82,7 +90,7 @@ class G4ParticleHPVector
     }
     if(theIntegral!=0)
     {
-      theIntegral[i] *= factor;
+      for(i=0; i<nEntries; i++) theIntegral[i] *= factor;
     }
   }
   
@@ -132,26 +140,10 @@ class G4ParticleHPVector
   }
   inline const G4ParticleHPDataPoint & GetPoint(G4int i) const { return theData[i]; }
   
-  void Hash() 
-  {
-    G4int i;
-    G4double x, y;
-    for(i=0 ; i<nEntries; i++)
-    {
-      if(0 == (i+1)%10)
-      {
-        x = GetX(i);
-	y = GetY(i);
-	theHash.SetData(i, x, y);
-      }
-    }
-  }
-  
-  void ReHash()
-  {
-    theHash.Clear();
-    Hash();
-  }
+  // The search in GetXsec is a bisection of the contiguous data, which
+  // needs no index; these are kept for existing callers.
+  inline void Hash() {}
+  inline void ReHash() {}
   
   G4double GetXsec(G4double e);
   G4double GetXsec(G4double e, G4int min)
@@ -227,10 +219,6 @@ class G4ParticleHPVector
       x*=ux;
       y*=uy;
       SetData(i,x,y);
-      if(0 == nEntries%10)
-      {
-        theHash.SetData(nEntries-1, x, y);
-      }
     }
   }
   
@@ -238,9 +226,8 @@ class G4ParticleHPVector
   {
     G4int total;
     aDataFile >> total;
-    if(theData!=0) delete [] theData;
-    theData = new G4ParticleHPDataPoint[total]; 
-    nPoints=total;
+    ReleaseData();
+    AllocateData(total);
     nEntries=0;    
     theManager.Init(aDataFile);
     Init(aDataFile, total, ux, uy);
@@ -263,7 +250,6 @@ class G4ParticleHPVector
     nEntries=0;   
     theManager.CleanUp();
     maxValue = -DBL_MAX;
-    theHash.Clear();
 //080811 TK DB 
     delete[] theIntegral;
     theIntegral = NULL;
@@ -547,6 +533,15 @@ class G4ParticleHPVector
   private:
   
   void Check(G4int i);
+
+  // Management of the (possibly shared) data points
+  void AllocateData(G4int n);
+  void ReleaseData();
+  inline void MakeWritable()
+  {
+    if(theDataUsers->load(std::memory_order_acquire) > 1) CopyData();
+  }
+  void CopyData();
   
   G4bool IsBlocked(G4double aX);
   
@@ -559,6 +554,7 @@ class G4ParticleHPVector
   G4double totalIntegral;
   
   G4ParticleHPDataPoint * theData; // the data
+  std::atomic<G4int> * theDataUsers; // number of vectors sharing theData
   G4InterpolationManager theManager; // knows how to interpolate the data.
   G4double * theIntegral;
   G4int nEntries;
@@ -570,7 +566,6 @@ class G4ParticleHPVector
   // debug only
   G4int isFreed;
   
-  G4ParticleHPHash theHash;
   G4double maxValue;
   
   std::vector<G4double> theBlocked;
@@ -35,6 +35,7 @@
 // P. Arce, June-2014 Conversion neutron_hp to particle_hp
 //
 #include "G4ParticleHPAngular.hh"
+#include "G4ParticleHPManager.hh"
 #include "G4PhysicalConstants.hh"
 #include "G4SystemOfUnits.hh"
 
@@ -70,6 +71,7 @@ void G4ParticleHPAngular::Init(std::istream & aDataFile)
         theCoefficients->SetCoeff(i, ii+1, coeff);
       }
     }
+    theCoefficients->SetUseTables(G4ParticleHPManager::GetInstance()->GetUseLegendreTables());
   }
   else if (theAngularDistributionType==2)
   {
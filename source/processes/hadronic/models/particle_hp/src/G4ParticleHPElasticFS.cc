@@ -95,6 +95,7 @@ void G4ParticleHPElasticFS::Init (G4double A, G4double Z, G4int M, G4String & di
           theCoefficients->SetCoeff(i, ii+1, coeff); // @@@HPW@@@
         }
       }
+      theCoefficients->SetUseTables( G4ParticleHPManager::GetInstance()->GetUseLegendreTables() );
     }
     else if (repFlag==2)
     {
@@ -151,6 +152,7 @@ void G4ParticleHPElasticFS::Init (G4double A, G4double Z, G4int M, G4String & di
              theCoefficients->SetCoeff(i, ii+1, coeff); // @@@HPW@@@
           }
        } 
+       theCoefficients->SetUseTables( G4ParticleHPManager::GetInstance()->GetUseLegendreTables() );
 
        tE_of_repFlag3 = energy; 
 
@@ -31,13 +31,161 @@
 //
 // P. Arce, June-2014 Conversion neutron_hp to particle_hp
 //
+// 19.10.2018 SampleFromTables: sampling by inversion of tabulated cumulative
+//            distributions, with stochastic interpolation in energy
+//
 #include "G4ParticleHPLegendreStore.hh"
 #include "G4ParticleHPVector.hh"
 #include "G4ParticleHPInterpolator.hh"
 #include "G4ParticleHPFastLegendre.hh"
+#include "G4AutoLock.hh"
 #include "Randomize.hh"
 #include <iostream>
 
+#ifdef G4MULTITHREADED
+G4Mutex G4ParticleHPLegendreStore::tableMutex = G4MUTEX_INITIALIZER;
+#endif
+
+void G4ParticleHPLegendreStore::SetUseTables(G4bool val)
+{
+  useTables = val;
+  if(useTables && theTables == 0)
+  {
+    theTables = new std::atomic<const G4double*>[nTables];
+    for(G4int i=0; i<nTables; i++) theTables[i].store(0);
+  }
+}
+
+const G4double* G4ParticleHPLegendreStore::GetTable(G4int i)
+{
+  const G4double* table = theTables[i].load(std::memory_order_acquire);
+  if(table != 0) return table;
+
+#ifdef G4MULTITHREADED
+  G4AutoLock l(&tableMutex);
+#endif
+  table = theTables[i].load(std::memory_order_relaxed);
+  if(table != 0) return table;
+
+  // pdf(mu) = sum_l (2l+1)/2 a_l P_l(mu), negative values set to zero as in
+  // SampleMax; the cumulative distribution is integrated with the
+  // trapezoidal rule, i.e. the pdf is taken as linear within each bin
+  G4double* newTable = new G4double[2*(nTableBins+1)];
+  G4double* pdf = newTable;
+  G4double* cdf = newTable + nTableBins + 1;
+  G4ParticleHPFastLegendre theLeg;
+  G4int nPoly = theCoeff[i].GetNumberOfPoly();
+  G4double dmu = 2./nTableBins;
+  for(G4int k=0; k<=nTableBins; k++)
+  {
+    G4double mu = std::min(-1. + k*dmu, 1.);
+    G4double v = 0;
+    for(G4int j=0; j<nPoly; j++)
+    {
+      v += (2.*j+1)/2.*theCoeff[i].GetCoeff(j)*theLeg.Evaluate(j, mu);
+    }
+    pdf[k] = std::max(0., v);
+  }
+  cdf[0] = 0;
+  for(G4int k=1; k<=nTableBins; k++)
+  {
+    cdf[k] = cdf[k-1] + 0.5*(pdf[k-1]+pdf[k])*dmu;
+  }
+  G4double norm = cdf[nTableBins];
+  if(norm > 0)
+  {
+    for(G4int k=0; k<=nTableBins; k++)
+    {
+      pdf[k] /= norm;
+      cdf[k] /= norm;
+    }
+  }
+  theTables[i].store(newTable, std::memory_order_release);
+  return newTable;
+}
+
+G4double G4ParticleHPLegendreStore::SampleTable(const G4double* aTable)
+{
+  const G4double* pdf = aTable;
+  const G4double* cdf = aTable + nTableBins + 1;
+  G4double dmu = 2./nTableBins;
+  G4double rand = G4UniformRand();
+
+  G4int lo = 0;
+  G4int hi = nTableBins;
+  while(hi - lo > 1)
+  {
+    G4int mid = (lo + hi)/2;
+    if(cdf[mid] > rand) hi = mid;
+    else lo = mid;
+  }
+
+  // invert the quadratic cumulative distribution of the linear pdf in bin lo
+  G4double area = rand - cdf[lo];
+  G4double p0 = pdf[lo];
+  G4double slope = (pdf[lo+1] - p0)/dmu;
+  G4double t;
+  if(std::abs(slope*area) < 1.e-6*p0*p0)
+  {
+    t = (p0 > 0) ? area/p0 : 0.5*dmu;
+  }
+  else
+  {
+    t = (std::sqrt(std::max(0., p0*p0 + 2.*slope*area)) - p0)/slope;
+  }
+  t = std::min(std::max(t, 0.), dmu);
+  return std::min(-1. + lo*dmu + t, 1.);
+}
+
+G4double G4ParticleHPLegendreStore::SampleFromTables(G4double anEnergy)
+{
+  // Returns -DBL_MAX if the tables cannot reproduce the distribution; the
+  // caller then samples by rejection
+  G4int low(0), high(0);
+  if(nEnergy > 0)
+  {
+    // first tabulated energy above anEnergy, as in the sampling loops below
+    G4int lo = 0;
+    G4int hi = nEnergy - 1;
+    if(theCoeff[hi].GetEnergy() <= anEnergy)
+    {
+      high = hi;
+    }
+    else
+    {
+      while(hi - lo > 0)
+      {
+        G4int mid = (lo + hi)/2;
+        if(theCoeff[mid].GetEnergy() > anEnergy) hi = mid;
+        else lo = mid + 1;
+      }
+      high = hi;
+    }
+  }
+  low = std::max(0, high-1);
+
+  // The series are interpolated linearly in the value of the distribution
+  // for the lin-lin, histogram and lin-log schemes, so that the interpolated
+  // distribution is a mixture of the two tabulated ones: pick one of them
+  // with the interpolation weight and sample it
+  G4int scheme = theManager.GetScheme(high) % CSTART_;
+  if(scheme != HISTO && scheme != LINLIN && scheme != LINLOG) return -DBL_MAX;
+
+  G4int index = high;
+  if(low != high)
+  {
+    G4ParticleHPInterpolator theInt;
+    G4double w = theInt.Interpolate(theManager.GetScheme(high), anEnergy,
+                                    theCoeff[low].GetEnergy(),
+                                    theCoeff[high].GetEnergy(), 0., 1.);
+    w = std::min(std::max(w, 0.), 1.);
+    if(G4UniformRand() >= w) index = low;
+  }
+  const G4double* table = GetTable(index);
+  if(table[2*nTableBins+1] <= 0) return -DBL_MAX;
+  return SampleTable(table);
+}
+
 
 
 //080612TK contribution from Benoit Pirard and Laurent Desorgher (Univ. Bern) #3 
@@ -126,6 +274,11 @@ G4double G4ParticleHPLegendreStore::SampleDiscreteTwoBody (G4double anEnergy)
 G4double G4ParticleHPLegendreStore::SampleMax (G4double anEnergy)
 {
   G4double result;
+  if(useTables)
+  {
+    result = SampleFromTables(anEnergy);
+    if(result > -DBL_MAX) return result;
+  }
   
   G4int i0;
   G4int low(0), high(0);
@@ -202,6 +355,11 @@ G4double G4ParticleHPLegendreStore::SampleMax (G4double anEnergy)
 G4double G4ParticleHPLegendreStore::SampleElastic (G4double anEnergy)
 {
   G4double result;
+  if(useTables)
+  {
+    result = SampleFromTables(anEnergy);
+    if(result > -DBL_MAX) return result;
+  }
   
   G4int i0;
   G4int low(0), high(0);
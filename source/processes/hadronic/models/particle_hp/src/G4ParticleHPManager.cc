@@ -46,6 +46,7 @@ G4ParticleHPManager::G4ParticleHPManager()
 ,DO_NOT_ADJUST_FINAL_STATE(false)
 ,PRODUCE_FISSION_FRAGMENTS(false)
 ,USE_NRESP71_MODEL(false)
+,USE_LEGENDRE_TABLES(false)
 ,theElasticCrossSections(NULL)
 ,theCaptureCrossSections(NULL)
 //,theInelasticCrossSections(NULL)
@@ -68,6 +69,7 @@ G4ParticleHPManager::G4ParticleHPManager()
    if ( getenv( "G4NEUTRONHP_SKIP_MISSING_ISOTOPES" ) ) SKIP_MISSING_ISOTOPES = true;
    if ( getenv( "G4NEUTRONHP_PRODUCE_FISSION_FRAGMENTS" ) ) PRODUCE_FISSION_FRAGMENTS = true;
    if ( getenv( "G4PHP_USE_NRESP71_MODEL" ) ) USE_NRESP71_MODEL = true;
+   if ( getenv( "G4PHP_USE_LEGENDRE_TABLES" ) ) USE_LEGENDRE_TABLES = true;
 }
 G4ParticleHPManager::~G4ParticleHPManager()
 {
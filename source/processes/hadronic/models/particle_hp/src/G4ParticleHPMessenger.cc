@@ -74,6 +74,15 @@ G4ParticleHPMessenger::G4ParticleHPMessenger( G4ParticleHPManager* man )
    NRESP71Cmd->SetCandidates("true false");
    NRESP71Cmd->AvailableForStates(G4State_PreInit,G4State_Idle);
 
+   LegendreTablesCmd = new G4UIcmdWithAString("/process/had/particle_hp/use_Legendre_tables",this);
+   LegendreTablesCmd->SetGuidance("Sample Legendre-represented angular distributions of elastic scattering");
+   LegendreTablesCmd->SetGuidance("and two-body final states from tabulated cumulative distributions.");
+   LegendreTablesCmd->SetGuidance("Tables are built on first use and shared by all threads.");
+   LegendreTablesCmd->SetGuidance("Must be set before the final state data are read.");
+   LegendreTablesCmd->SetParameterName("choice",false);
+   LegendreTablesCmd->SetCandidates("true false");
+   LegendreTablesCmd->AvailableForStates(G4State_PreInit);
+
    VerboseCmd = new G4UIcmdWithAnInteger("/process/had/particle_hp/verbose",this);
    VerboseCmd->SetGuidance("Set Verbose level of ParticleHP package");
    VerboseCmd->SetParameterName("verbose_level",true);
@@ -90,6 +99,8 @@ G4ParticleHPMessenger::~G4ParticleHPMessenger()
    delete NeglectDopplerCmd;
    delete DoNotAdjustFSCmd;
    delete ProduceFissionFragementCmd;
+   delete NRESP71Cmd;
+   delete LegendreTablesCmd;
    delete VerboseCmd;
 }
 
@@ -116,6 +127,9 @@ void G4ParticleHPMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
    if ( command == NRESP71Cmd ) { 
       manager->SetUseNRESP71Model( bValue ); 
    }
+   if ( command == LegendreTablesCmd ) { 
+      manager->SetUseLegendreTables( bValue ); 
+   }
    if ( command == VerboseCmd ) {
       manager->SetVerboseLevel( VerboseCmd->ConvertToInt( newValue ) ); 
    }
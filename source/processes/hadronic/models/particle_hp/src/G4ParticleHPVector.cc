@@ -82,8 +82,7 @@
 
   G4ParticleHPVector::G4ParticleHPVector()
   {
-    theData = new G4ParticleHPDataPoint[20]; 
-    nPoints=20;
+    AllocateData(20);
     nEntries=0;
     Verbose=0;
     theIntegral=0;
@@ -97,8 +96,7 @@
   
   G4ParticleHPVector::G4ParticleHPVector(G4int n)
   {
-    nPoints=std::max(n, 20);
-    theData = new G4ParticleHPDataPoint[nPoints]; 
+    AllocateData(std::max(n, 20));
     nEntries=0;
     Verbose=0;
     theIntegral=0;
@@ -110,14 +108,23 @@
     label = -DBL_MAX;
   }
 
+  G4ParticleHPVector::G4ParticleHPVector(const G4ParticleHPVector & right)
+  {
+    theData = 0;
+    theDataUsers = 0;
+    theIntegral = 0;
+    isFreed = 0;
+    maxValue = -DBL_MAX;
+    *this = right;
+  }
+
   G4ParticleHPVector::~G4ParticleHPVector()
   {
 //    if(Verbose==1)G4cout <<"G4ParticleHPVector::~G4ParticleHPVector"<<G4endl;
-      delete [] theData;
+      ReleaseData();
 //    if(Verbose==1)G4cout <<"Vector: delete theData"<<G4endl;
       delete [] theIntegral;
 //    if(Verbose==1)G4cout <<"Vector: delete theIntegral"<<G4endl;
-    theHash.Clear();
     isFreed = 1;
   }
   
@@ -126,14 +133,23 @@
   {
     if(&right == this) return *this;
     
-    G4int i;
-    
+    // share the data points of right; they are copied by the first
+    // modification of either vector (see MakeWritable)
+    right.theDataUsers->fetch_add(1, std::memory_order_relaxed);
+    ReleaseData();
+    theData = right.theData;
+    theDataUsers = right.theDataUsers;
+    nEntries = right.nEntries;
+    nPoints = right.nPoints;
+    maxValue = right.maxValue;
+
     totalIntegral = right.totalIntegral;
-    if(right.theIntegral!=0) theIntegral = new G4double[right.nEntries];
-    for(i=0; i<right.nEntries; i++)
+    delete [] theIntegral;
+    theIntegral = 0;
+    if(right.theIntegral!=0)
     {
-      SetPoint(i, right.GetPoint(i)); // copy theData
-      if(right.theIntegral!=0) theIntegral[i] = right.theIntegral[i];
+      theIntegral = new G4double[right.nEntries];
+      for(G4int i=0; i<right.nEntries; i++) theIntegral[i] = right.theIntegral[i];
     }
     theManager = right.theManager; 
     label = right.label;
@@ -141,28 +157,55 @@
     Verbose = right.Verbose;
     the15percentBorderCash = right.the15percentBorderCash;
     the50percentBorderCash = right.the50percentBorderCash;
-    theHash = right.theHash;
+    theBlocked = right.theBlocked;
+    theBuffered = right.theBuffered;
    return *this;
   }
 
+  void G4ParticleHPVector::AllocateData(G4int n)
+  {
+    nPoints = n;
+    theData = new G4ParticleHPDataPoint[nPoints];
+    theDataUsers = new std::atomic<G4int>(1);
+  }
+
+  void G4ParticleHPVector::ReleaseData()
+  {
+    if(theDataUsers == 0) return;
+    if(theDataUsers->fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      delete [] theData;
+      delete theDataUsers;
+    }
+    theData = 0;
+    theDataUsers = 0;
+  }
+
+  void G4ParticleHPVector::CopyData()
+  {
+    G4ParticleHPDataPoint * shared = theData;
+    std::atomic<G4int> * sharedUsers = theDataUsers;
+    AllocateData(nPoints);
+    for(G4int j=0; j<nEntries; j++) theData[j] = shared[j];
+    if(sharedUsers->fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      delete [] shared;
+      delete sharedUsers;
+    }
+  }
+
   
   G4double G4ParticleHPVector::GetXsec(G4double e) 
   {
     if(nEntries == 0) return 0;
-    //if(!theHash.Prepared()) Hash();
-    if ( !theHash.Prepared() ) {
-       if ( G4Threading::IsWorkerThread() ) {
-          ;
-       } else {
-          Hash();
-       }
-    }
-    G4int min = theHash.GetMinIndex(e);
-    G4int i;
-    for(i=min ; i<nEntries; i++)
+    // first point with x >= e, by bisection
+    G4int i = 0;
+    G4int upper = nEntries;
+    while(i < upper)
     {
-      //if(theData[i].GetX()>e) break;
-      if(theData[i].GetX() >= e) break;
+      G4int mid = (i + upper)/2;
+      if(theData[mid].GetX() < e) i = mid + 1;
+      else upper = mid;
     }
     G4int low = i-1;
     G4int high = i;
@@ -217,6 +260,7 @@
   
   void G4ParticleHPVector::Check(G4int i)
   {
+    MakeWritable();
     if(i>nEntries) throw G4HadronicException(__FILE__, __LINE__, "Skipped some index numbers in G4ParticleHPVector");
     if(i==nPoints)
     {
@@ -286,18 +330,13 @@
       }
       p++;
     }
-    // Rebuild the Hash;
-    if(theHash.Prepared()) 
-    {
-      ReHash();
-    }
   }
     
   void G4ParticleHPVector::ThinOut(G4double precision)
   {
     // anything in there?
     if(GetVectorLength()==0) return;
-    // make the new vector
+    // make the new vector; the old points may be shared with other vectors
     G4ParticleHPDataPoint * aBuff = new G4ParticleHPDataPoint[nPoints];
     G4double x, x1, x2, y, y1, y2;
     G4int count = 0, current = 2, start = 1;
@@ -341,15 +380,12 @@
     }
     // The last one also always goes, and is never tested.
     aBuff[++count] = theData[GetVectorLength()-1];
-    delete [] theData;
+    G4int n = nPoints;
+    ReleaseData();
+    nPoints = n;
     theData = aBuff;
+    theDataUsers = new std::atomic<G4int>(1);
     nEntries = count+1;
-    
-    // Rebuild the Hash;
-    if(theHash.Prepared()) 
-    {
-      ReHash();
-    }
   }
 
   G4bool G4ParticleHPVector::IsBlocked(G4double aX)
@@ -67,6 +67,8 @@ public:
 
   inline void UseSICB(G4bool);
 
+  inline void Initialise();
+
 private:
 
   void AngularDistribution(G4VPreCompoundFragment * theFragment,
@@ -114,4 +116,9 @@ inline void G4PreCompoundEmission::UseSICB(G4bool use)
   theFragmentsVector->UseSICB(use);
 }
 
+inline void G4PreCompoundEmission::Initialise()
+{
+  theFragmentsVector->Initialise();
+}
+
 #endif
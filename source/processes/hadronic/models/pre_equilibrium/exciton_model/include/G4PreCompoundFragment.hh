@@ -35,12 +35,15 @@
 //     superimposed Coulomb barrier (if useSICB=true, default false) 
 // 20.08.2010 V.Ivanchenko added int Z and A and cleanup; added 
 //                        G4ParticleDefinition to constructor
+// 19.10.2018 Optional use of tabulated emission widths
 
 #ifndef G4PreCompoundFragment_h
 #define G4PreCompoundFragment_h 1
 
 #include "G4VPreCompoundFragment.hh"
 
+class G4EmissionWidthTable;
+
 class G4PreCompoundFragment : public G4VPreCompoundFragment
 {
 public:  
@@ -49,6 +52,9 @@ public:
 			G4VCoulombBarrier * aCoulombBarrier);
   
   virtual ~G4PreCompoundFragment();
+
+  // Optional table of widths is created or deleted according to parameters
+  virtual void Initialise();
       
   // ================================================
   // Methods for calculating the emission probability
@@ -80,6 +86,9 @@ private:
 
   G4double GetOpt0(G4double ekin) const;
 
+  // Emission probability taken from the table of widths
+  G4double TabulatedProbability(const G4Fragment & aFragment);
+
   // operators
   G4PreCompoundFragment(const G4PreCompoundFragment &right) = delete;
   const G4PreCompoundFragment& 
@@ -91,6 +100,12 @@ private:
 
   G4double muu;
   G4double probmax;
+
+  // Optional table of total widths
+  G4EmissionWidthTable* fWidthTable;
+
+  // Probability was interpolated, integration is needed before sampling
+  G4bool isTabulated;
 };
 
 #endif
@@ -63,6 +63,8 @@ public:
 
   void UseSICB(G4bool);
 
+  void Initialise();
+
   G4double CalculateProbabilities(const G4Fragment & aFragment);
 	
   G4VPreCompoundFragment * ChooseFragment();
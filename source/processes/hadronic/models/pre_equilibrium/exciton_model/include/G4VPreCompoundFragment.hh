@@ -71,6 +71,9 @@ public:
   
   // Initialization method
   void Initialize(const G4Fragment & aFragment);
+
+  // Run-time parameters are read at model initialisation
+  virtual void Initialise();
     
   // Methods for calculating the emission probability
   // ------------------------------------------------
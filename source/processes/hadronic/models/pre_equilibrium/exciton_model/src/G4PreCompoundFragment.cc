@@ -32,16 +32,19 @@
 // 06.09.2008 JMQ Also external choice has been added for:
 //               - superimposed Coulomb barrier (if useSICB=true) 
 // 20.08.2010 V.Ivanchenko cleanup
+// 19.10.2018 Optional use of tabulated emission widths
 //
 
 #include "G4PreCompoundFragment.hh"
 #include "G4KalbachCrossSection.hh"
 #include "G4ChatterjeeCrossSection.hh"
+#include "G4EmissionWidthTable.hh"
 #include "Randomize.hh"
 
 G4PreCompoundFragment::G4PreCompoundFragment(const G4ParticleDefinition* p,
 					     G4VCoulombBarrier* aCoulBarrier)
-  : G4VPreCompoundFragment(p, aCoulBarrier)
+  : G4VPreCompoundFragment(p, aCoulBarrier), 
+    fWidthTable(nullptr), isTabulated(false)
 {
   muu = probmax = 0.0;
   if(0 == theZ)      { index = 0; }
@@ -50,7 +53,23 @@ G4PreCompoundFragment::G4PreCompoundFragment(const G4ParticleDefinition* p,
 }
 
 G4PreCompoundFragment::~G4PreCompoundFragment()
-{}
+{
+  delete fWidthTable;
+}
+
+void G4PreCompoundFragment::Initialise()
+{
+  if(theParameters->UseWidthTable()) {
+    if(nullptr == fWidthTable) {
+      fWidthTable = 
+	new G4EmissionWidthTable(theParameters->GetWidthTableStep(),
+				 theParameters->GetWidthTableMaxEnergy());
+    }
+  } else {
+    delete fWidthTable;
+    fWidthTable = nullptr;
+  }
+}
 
 G4double G4PreCompoundFragment::
 CalcEmissionProbability(const G4Fragment & aFragment)
@@ -60,9 +79,19 @@ CalcEmissionProbability(const G4Fragment & aFragment)
   // Coulomb barrier is the lower limit of integration over kinetic energy
 
   theEmissionProbability = 0.0;
+  isTabulated = false;
 
   if (theMaxKinEnergy <= theMinKinEnergy) { return 0.0; }    
 
+  if(nullptr != fWidthTable) {
+    G4double prob = TabulatedProbability(aFragment);
+    if(prob > 0.0) {
+      theEmissionProbability = prob;
+      isTabulated = true;
+      return theEmissionProbability;
+    }
+  }
+
   // compute power once
   if(0 < index) { 
     muu = G4KalbachCrossSection::ComputePowerParameter(theResA, index);
@@ -82,6 +111,49 @@ CalcEmissionProbability(const G4Fragment & aFragment)
   return theEmissionProbability;
 }
 
+G4double 
+G4PreCompoundFragment::TabulatedProbability(const G4Fragment & aFragment)
+{
+  // a row of the table is defined by the nucleus and exciton numbers
+  G4int P  = aFragment.GetNumberOfParticles();
+  G4int H  = aFragment.GetNumberOfHoles();
+  G4int Pz = aFragment.GetNumberOfCharged();
+  G4int Hz = aFragment.GetNumberOfChargedHoles();
+  if(P >= 32 || H >= 32) { return -1.0; }
+  G4long key = ((((G4long)(1000*theFragZ + theFragA)*32 + P)*32 + H)*32 + Pz);
+
+  size_t idx;
+  G4double x;
+  G4double* nodes = 
+    fWidthTable->GetNodes(key, aFragment.GetExcitationEnergy(), idx, x);
+  if(nullptr == nodes) { return -1.0; }
+
+  G4bool changed = false;
+  for(size_t i=idx; i<=idx+1; ++i) {
+    if(nodes[i] < 0.0) {
+      nodes[i] = 0.0;
+      G4double mass = aFragment.GetGroundStateMass() 
+	+ fWidthTable->GetEnergy(i);
+      G4Fragment frag(theFragA, theFragZ, 
+		      G4LorentzVector(0.0, 0.0, 0.0, mass));
+      frag.SetNumberOfExcitedParticle(P, Pz);
+      frag.SetNumberOfHoles(H, Hz);
+      Initialize(frag);
+      if(IsItPossible(frag) && theMaxKinEnergy > theMinKinEnergy) {
+	if(0 < index) { 
+	  muu = G4KalbachCrossSection::ComputePowerParameter(theResA, index);
+	}
+	nodes[i] = 
+	  IntegrateEmissionProbability(theMinKinEnergy,theMaxKinEnergy,frag);
+      }
+      changed = true;
+    }
+  }
+  // restore kinematics of the fragment
+  if(changed) { Initialize(aFragment); }
+  return fWidthTable->Interpolate(nodes, idx, x);
+}
+
 G4double G4PreCompoundFragment::
 IntegrateEmissionProbability(G4double low, G4double up,
 			     const G4Fragment & aFragment)
@@ -138,6 +210,14 @@ G4double G4PreCompoundFragment::GetOpt0(G4double ekin) const
 
 G4double G4PreCompoundFragment::SampleKineticEnergy(const G4Fragment& fragment) 
 {
+  // the spectrum is integrated only for the selected channel
+  if(isTabulated) {
+    if(0 < index) { 
+      muu = G4KalbachCrossSection::ComputePowerParameter(theResA, index);
+    }
+    IntegrateEmissionProbability(theMinKinEnergy,theMaxKinEnergy,fragment);
+    isTabulated = false;
+  }
   G4double delta = theMaxKinEnergy - theMinKinEnergy;
   static const G4double toler = 1.25;
   probmax *= toler;
@@ -72,6 +72,13 @@ void G4PreCompoundFragmentVector::UseSICB(G4bool use)
   }
 }
 
+void G4PreCompoundFragmentVector::Initialise()
+{    
+  for (G4int i=0; i< nChannels; ++i) { 
+    (*theChannels)[i]->Initialise();
+  }
+}
+
 G4double G4PreCompoundFragmentVector::CalculateProbabilities(
          const G4Fragment & aFragment)
 {
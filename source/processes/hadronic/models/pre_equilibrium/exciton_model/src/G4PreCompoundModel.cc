@@ -121,6 +121,7 @@ void G4PreCompoundModel::InitialiseModel()
   if(param->UseHETC()) { theEmission->SetHETCModel(); }
   //else { theEmission->SetDefaultModel(); }
   theEmission->SetOPTxs(param->GetPrecoModelType());
+  theEmission->Initialise();
 
   if(param->UseGNASH()) { theTransition = new G4GNASHTransitions; }
   else { theTransition = new G4PreCompoundTransitions(); }
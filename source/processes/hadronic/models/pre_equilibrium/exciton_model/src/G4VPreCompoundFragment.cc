@@ -58,6 +58,9 @@ G4VPreCompoundFragment::G4VPreCompoundFragment(
 G4VPreCompoundFragment::~G4VPreCompoundFragment()
 {}
 
+void G4VPreCompoundFragment::Initialise()
+{}
+
 std::ostream& 
 operator << (std::ostream &out, const G4VPreCompoundFragment &theFragment)
 {
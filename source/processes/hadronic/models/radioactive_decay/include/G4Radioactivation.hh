@@ -77,14 +77,14 @@ class G4Radioactivation : public G4RadioactiveDecayBase
 
     void CalculateChainsFromParent(const G4ParticleDefinition&);
     // Calculates the coefficient and decay time table for all the descendents
-    // of the specified isotope.  Adds the calculated table to the private data
-    // member "theParentChainTable".
+    // of the specified isotope.  Adds the calculated table to the chain map
+    // shared by all threads, unless another thread has already done so.
     // used in VR decay mode only 
 
     void GetChainsFromParent(const G4ParticleDefinition&);
     // Used to retrieve the coefficient and decay time table for all the
-    // descendants of the specified isotope from "theParentChainTable"
-    // and place it in "chainsFromParent".
+    // descendants of the specified isotope from the shared chain map
+    // and make it the current one ("theCurrentChains").
     // used in VR decay mode only 
 
     void SetDecayRate(G4int,G4int,G4double, G4int, std::vector<G4double>,
@@ -122,6 +122,9 @@ class G4Radioactivation : public G4RadioactiveDecayBase
   protected:
 
     G4double ConvolveSourceTimeProfile(const G4double, const G4double);
+    void ConvolveSourceTimeProfile(const G4double, const std::vector<G4double>&,
+                                   std::vector<G4double>&);
+    // Batched version: convolves all the mean lives of a chain at once
     G4double GetDecayTime();
     G4int GetDecayTimeBin(const G4double aDecayTime);
 
@@ -152,7 +155,19 @@ class G4Radioactivation : public G4RadioactiveDecayBase
     G4RadioactiveDecayRatesToDaughter ratesToDaughter;
     G4RadioactiveDecayRates theDecayRateVector;
     G4RadioactiveDecayChainsFromParent chainsFromParent;
-    G4RadioactiveDecayParentChainTable theParentChainTable;
+
+    // Chains are computed once per parent nuclide and shared by all threads;
+    // each thread keeps its own index into the shared map to avoid locking
+    typedef std::map<G4String, const G4RadioactiveDecayChainsFromParent*>
+            ChainsFromParentMap;
+    ChainsFromParentMap theChainsMap;
+    const G4RadioactiveDecayChainsFromParent* theCurrentChains;
+    static ChainsFromParentMap* master_chainmap;
+    static G4Mutex chainMutex;
+
+    // Work space for the batched Bateman evaluation
+    std::vector<G4double> theConvolvedTimes;
+    std::vector<G4double> theDecayRates;
 
     // for the radioactivity tables
     std::vector<G4RadioactivityTable*> theRadioactivityTables;
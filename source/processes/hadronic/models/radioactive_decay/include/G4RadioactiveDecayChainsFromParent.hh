@@ -47,6 +47,11 @@
 // 13 April 2000, F Lei, DERA UK
 // 0.b.4 release. No change to this file     
 //
+// 19 October 2018
+// Added a compact flattened copy of the Bateman coefficients, indexed on the
+// distinct lifetimes of the chain, and a batched evaluation of the decay
+// rates of all descendants.
+//
 ////////////////////////////////////////////////////////////////////////////////
 //                                                                            //
 //  This class contains the decay times and coefficients for calculating      //
@@ -85,14 +90,35 @@ class G4RadioactiveDecayChainsFromParent
     // Retrieve the coefficients and decays of all descendants along the
     // decay chains
     inline G4RadioactiveDecayRates GetItsRates() const {return itsRates;}
+    inline const G4RadioactiveDecayRates& GetRates() const {return itsRates;}
+
+    // Fill in the coefficients and decay times in the chains; the compact
+    // form used by GetDecayRates() is rebuilt from them
+    void SetItsRates(const G4RadioactiveDecayRates& arate);
+
+    // Distinct mean lives appearing anywhere in the chains
+    inline const std::vector<G4double>& GetUniqueTaos() const
+      {return theUniqueTaos;}
 
-    // Fill in the coefficients and decay times in the chains
-    inline void SetItsRates(G4RadioactiveDecayRates arate) {itsRates = arate;}
+    // Given the source-convolved time of each of the distinct mean lives,
+    // fill rates[i] with the (non-negative) activity of descendant i
+    void GetDecayRates(const std::vector<G4double>& convolvedTimes,
+                       std::vector<G4double>& rates) const;
 
 protected:
+    void Compact();
+
     G4String ionName;
     G4RadioactiveDecayRates itsRates;
 
+    // Compact form: coefficients of descendant i are in
+    // theCoefficients[theOffsets[i] .. theOffsets[i+1]), their mean lives
+    // in theUniqueTaos[theTaoIndex[k]]
+    std::vector<G4double> theUniqueTaos;
+    std::vector<G4double> theCoefficients;
+    std::vector<G4int> theTaoIndex;
+    std::vector<size_t> theOffsets;
+
 };
 #endif
 
@@ -79,6 +79,8 @@
 #include "G4VAtomDeexcitation.hh"
 #include "G4UAtomicDeexcitation.hh"
 #include "G4PhotonEvaporation.hh"
+#include "G4AutoLock.hh"
+#include "G4Threading.hh"
 
 #include <vector>
 #include <sstream>
@@ -87,8 +89,11 @@
 
 using namespace CLHEP;
 
+G4Radioactivation::ChainsFromParentMap* G4Radioactivation::master_chainmap = 0;
+G4Mutex G4Radioactivation::chainMutex = G4MUTEX_INITIALIZER;
+
 G4Radioactivation::G4Radioactivation(const G4String& processName)
- : G4RadioactiveDecayBase(processName)
+ : G4RadioactiveDecayBase(processName), theCurrentChains(0)
 {
 #ifdef G4VERBOSE
   if (GetVerboseLevel() > 1) {
@@ -135,6 +140,20 @@ void G4Radioactivation::ProcessDescription(std::ostream& outFile) const
 G4Radioactivation::~G4Radioactivation()
 {
   delete theRadioactivationMessenger;
+
+  // The shared chains are owned by the master, whose process is deleted
+  // after those of the workers
+  if (G4Threading::IsMasterThread()) {
+    G4AutoLock lk(&G4Radioactivation::chainMutex);
+    if (master_chainmap) {
+      for (ChainsFromParentMap::iterator i = master_chainmap->begin();
+           i != master_chainmap->end(); ++i) {
+        delete i->second;
+      }
+      delete master_chainmap;
+      master_chainmap = 0;
+    }
+  }
 }
 
 
@@ -142,12 +161,16 @@ G4bool
 G4Radioactivation::IsRateTableReady(const G4ParticleDefinition& aParticle)
 {
   // Check whether the radioactive decay rates table for the ion has already
-  // been calculated.
-  G4String aParticleName = aParticle.GetParticleName();
-  for (size_t i = 0; i < theParentChainTable.size(); i++) {
-    if (theParentChainTable[i].GetIonName() == aParticleName) return true;
-  }
-  return false;
+  // been calculated, by this thread or by any other one.
+  const G4String& aParticleName = aParticle.GetParticleName();
+  if (theChainsMap.find(aParticleName) != theChainsMap.end()) return true;
+
+  G4AutoLock lk(&G4Radioactivation::chainMutex);
+  if (!master_chainmap) return false;
+  ChainsFromParentMap::const_iterator it = master_chainmap->find(aParticleName);
+  if (it == master_chainmap->end()) return false;
+  theChainsMap[aParticleName] = it->second;
+  return true;
 }
 
 
@@ -155,13 +178,10 @@ void
 G4Radioactivation::GetChainsFromParent(const G4ParticleDefinition& aParticle)
 {
   // Retrieve the decay rate table for the specified aParticle
-  G4String aParticleName = aParticle.GetParticleName();
+  const G4String& aParticleName = aParticle.GetParticleName();
 
-  for (size_t i = 0; i < theParentChainTable.size(); i++) {
-    if (theParentChainTable[i].GetIonName() == aParticleName) {
-      theDecayRateVector = theParentChainTable[i].GetItsRates();
-    }
-  }
+  ChainsFromParentMap::const_iterator it = theChainsMap.find(aParticleName);
+  theCurrentChains = (it != theChainsMap.end()) ? it->second : 0;
 #ifdef G4VERBOSE
   if (GetVerboseLevel() > 0) {
     G4cout << "The DecayRate Table for " << aParticleName << " is selected."
@@ -233,6 +253,55 @@ G4Radioactivation::ConvolveSourceTimeProfile(const G4double t, const G4double ta
 }
 
 
+// Batched form of the above for all the mean lives of a decay chain.  The
+// source bin containing t is located once, and the exponentials of each
+// source bin are evaluated for all lifetimes in a single pass.
+
+void
+G4Radioactivation::ConvolveSourceTimeProfile(const G4double t,
+                                             const std::vector<G4double>& taus,
+                                             std::vector<G4double>& convolved)
+{
+  size_t ntau = taus.size();
+  convolved.assign(ntau, 0.0);
+
+  G4int nbin;
+  if ( t > SBin[NSourceBin]) {
+    nbin  = NSourceBin;
+  } else {
+    nbin = 0;
+    while (nbin < NSourceBin && t > SBin[nbin]) ++nbin;
+    nbin--;
+    if (nbin < 0) nbin = 0;
+  }
+
+  G4double* res = convolved.data();
+  const G4double* tau = taus.data();
+  G4double earg;
+  for (G4int i = 0; i < nbin; i++) {
+    if (SProfile[i] == 0.0) continue;
+    for (size_t k = 0; k < ntau; ++k) {
+      earg = (SBin[i+1] - SBin[i])/tau[k];
+      if (earg < 100.) {
+        res[k] += SProfile[i] * std::exp((SBin[i] - t)/tau[k]) *
+                  std::expm1(earg);
+      } else {
+        res[k] += SProfile[i] *
+          (std::exp(-(t-SBin[i+1])/tau[k])-std::exp(-(t-SBin[i])/tau[k]));
+      }
+    }
+  }
+  for (size_t k = 0; k < ntau; ++k) {
+    res[k] -= SProfile[nbin] * std::expm1((SBin[nbin] - t)/tau[k]);
+    if (res[k] < 0.) {
+      G4cout << " Convolved time =: " << res[k] << " reset to zero! " << G4endl;
+      G4cout << " t = " << t << " tau = " << tau[k] << G4endl;
+      res[k] = 0.;
+    }
+  }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                                                            //
 //  GetDecayTime                                                              //
@@ -613,8 +682,21 @@ CalculateChainsFromParent(const G4ParticleDefinition& theParentNucleus)
   // now fill the decay table with the newly completed decay rate vector
   chainsFromParent.SetItsRates(theDecayRateVector);
 
-  // finally add the decayratetable to the tablevector
-  theParentChainTable.push_back(chainsFromParent);
+  // finally add the decayratetable to the shared map.  The calculation is
+  // done outside the lock; if another thread got there first, its copy is
+  // kept and ours dropped.
+  G4AutoLock lk(&G4Radioactivation::chainMutex);
+  if (!master_chainmap) master_chainmap = new ChainsFromParentMap;
+  const G4String& parentName = theParentNucleus.GetParticleName();
+  ChainsFromParentMap::const_iterator it = master_chainmap->find(parentName);
+  if (it == master_chainmap->end()) {
+    const G4RadioactiveDecayChainsFromParent* chains =
+      new G4RadioactiveDecayChainsFromParent(chainsFromParent);
+    (*master_chainmap)[parentName] = chains;
+    theChainsMap[parentName] = chains;
+  } else {
+    theChainsMap[parentName] = it->second;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -826,13 +908,9 @@ G4Radioactivation::DecayIt(const G4Track& theTrack, const G4Step&)
     G4int PA;
     G4double PE;
     G4String keyName;
-    std::vector<G4double> PT;
-    std::vector<G4double> PR;
-    G4double taotime;
-    long double decayRate;
+    G4double decayRate;
 
     size_t i;
-    size_t j;
     G4int numberOfSecondaries;
     G4int totalNumberOfSecondaries = 0;
     G4double currentTime = 0.;
@@ -866,20 +944,27 @@ G4Radioactivation::DecayIt(const G4Track& theTrack, const G4Step&)
       // it should be calculated in seconds
       weight1 /= s ;
 	    
+      // Evaluate the activities of all the descendants at theDecayTime at
+      // once: each distinct mean life of the chains is convolved with the
+      // source time profile only once (Eq. 4.13 of the TN), then combined
+      // with the Bateman coefficients of every descendant (Eq. 4.23).
+      ConvolveSourceTimeProfile(theDecayTime, theCurrentChains->GetUniqueTaos(),
+                                theConvolvedTimes);
+      theCurrentChains->GetDecayRates(theConvolvedTimes, theDecayRates);
+
       // loop over all the possible secondaries of the nucleus
       // the first one is itself.
-      for (i = 0; i < theDecayRateVector.size(); i++) {
-        PZ = theDecayRateVector[i].GetZ();
-        PA = theDecayRateVector[i].GetA();
-        PE = theDecayRateVector[i].GetE();
-        PT = theDecayRateVector[i].GetTaos();
-        PR = theDecayRateVector[i].GetDecayRateC();
-
-        // The array of arrays theDecayRateVector contains all possible decay
+      const G4RadioactiveDecayRates& theRates = theCurrentChains->GetRates();
+      for (i = 0; i < theRates.size(); i++) {
+        PZ = theRates[i].GetZ();
+        PA = theRates[i].GetA();
+        PE = theRates[i].GetE();
+
+        // The array of arrays theRates contains all possible decay
         // chains of a given parent nucleus (ZP,AP,EP) to a given descendant
         // nuclide (Z,A,E).
         //
-        // theDecayRateVector[0] contains the decay parameters of the parent
+        // theRates[0] contains the decay parameters of the parent
         // nucleus
         //           PZ = ZP
         //           PA = AP
@@ -887,7 +972,7 @@ G4Radioactivation::DecayIt(const G4Track& theTrack, const G4Step&)
         //           PT[] = {TP}
         //           PR[] = {RP}
         //
-        // theDecayRateVector[1] contains the decay of the parent to the first
+        // theRates[1] contains the decay of the parent to the first
         // generation daughter (Z1,A1,E1).
         //           PZ = Z1
         //           PA = A1
@@ -895,7 +980,7 @@ G4Radioactivation::DecayIt(const G4Track& theTrack, const G4Step&)
         //           PT[] = {TP, T1}
         //           PR[] = {RP, R1}
         //
-        // theDecayRateVector[2] contains the decay of the parent to the first
+        // theRates[2] contains the decay of the parent to the first
         // generation daughter (Z1,A1,E1) and the decay of the first
         // generation daughter to the second generation daughter (Z2,A2,E2).
         //           PZ = Z2
@@ -904,7 +989,7 @@ G4Radioactivation::DecayIt(const G4Track& theTrack, const G4Step&)
         //           PT[] = {TP, T1, T2}
         //           PR[] = {RP, R1, R2}
         //
-        // theDecayRateVector[3] may contain a branch chain
+        // theRates[3] may contain a branch chain
         //           PZ = Z2a
         //           PA = A2a
         //           PE = E2a
@@ -913,50 +998,11 @@ G4Radioactivation::DecayIt(const G4Track& theTrack, const G4Step&)
         //
         // and so on.
 
-        // Calculate the decay rate of the isotope.  decayRate is the
-        // radioactivity of isotope (PZ,PA,PE) at 'theDecayTime'
-        // it will be used to calculate the statistical weight of the 
-        // decay products of this isotope
-
-        // For each nuclide, calculate all the decay chains which can reach
-        // the parent nuclide
-        decayRate = 0.L;
-        for (j = 0; j < PT.size(); j++) {
-          // G4cout <<  " RDM::DecayIt: tau input to Convolve: " <<  PT[j] << G4endl; 
-          taotime = ConvolveSourceTimeProfile(theDecayTime,PT[j]);
-          // taotime = GetTaoTime(theDecayTime,PT[j]);
-          decayRate -= PR[j] * (long double)taotime;  // PRs are Acoeffs, taotime is inverse time
-          // Eq.4.23 of of the TN
-          // note the negative here is required as the rate in the
-          // equation is defined to be negative, 
-          // i.e. decay away, but we need positive value here.
-
-          // G4cout << j << "\t"<< PT[j]/s << "\t" << PR[j] << "\t" << decayRate << G4endl;		
-        }
-
-        // At this point any negative decay rates are probably small enough
-        // (order 10**-30) that negative values are likely due to cancellation
-        // errors.  Set them to zero.
-        if (decayRate < 0.0) decayRate = 0.0;
-/*
-        if (decayRate < 0.0) {
-          if (-decayRate > 1.0e-30) {
-            G4ExceptionDescription ed;
-            ed << "    Negative decay probability (magnitude > 1e-30) \n"
-               << "    in variance reduction branch " << G4endl;
-            G4Exception("G4RadioactiveDecay::DecayIt()",
-                        "HAD_RDM_200", JustWarning, ed);
-          } else {
-            // Decay probability is small enough that negative value is likely
-            // due to cancellation errors.  Set it to zero.
-            decayRate = 0.0;
-          }
-        }
-
-        if (decayRate < 0.0) G4cout << " NEGATIVE decay rate = " << decayRate << G4endl;
-*/
-        //  G4cout <<theDecayTime/s <<"\t"<<nbin<<G4endl;
-        //  G4cout << theTrack.GetWeight() <<"\t"<<weight1<<"\t"<<decayRate<< G4endl;
+        // decayRate is the radioactivity of isotope (PZ,PA,PE) at
+        // 'theDecayTime'; it is used to calculate the statistical weight of
+        // the decay products of this isotope.  Negative values from
+        // cancellation errors have already been set to zero.
+        decayRate = theDecayRates[i];
 
         // Add isotope to the radioactivity tables
         // One table for each observation time window specifed in
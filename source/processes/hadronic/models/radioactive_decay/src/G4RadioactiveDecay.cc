@@ -711,6 +711,7 @@ void G4RadioactiveDecay::BuildPhysicsTable(const G4ParticleDefinition&)
 {
   if (!isInitialised) {
     isInitialised = true;
+    G4NuclearLevelData::GetInstance()->Initialise();
     if(G4Threading::IsMasterThread()) { StreamInfo(G4cout, "\n"); }
   }
 }
@@ -25,6 +25,8 @@
 //
 
 #include "G4RadioactiveDecayChainsFromParent.hh"
+#include <algorithm>
+#include <map>
 
 
 G4RadioactiveDecayChainsFromParent::G4RadioactiveDecayChainsFromParent()
@@ -36,6 +38,10 @@ G4RadioactiveDecayChainsFromParent(const G4RadioactiveDecayChainsFromParent& rig
 {
   ionName = right.ionName;
   itsRates = right.itsRates;
+  theUniqueTaos = right.theUniqueTaos;
+  theCoefficients = right.theCoefficients;
+  theTaoIndex = right.theTaoIndex;
+  theOffsets = right.theOffsets;
 }
 
 
@@ -45,6 +51,10 @@ G4RadioactiveDecayChainsFromParent::operator=(const G4RadioactiveDecayChainsFrom
   if (this != &right) { 
     ionName = right.ionName;
     itsRates = right.itsRates;
+    theUniqueTaos = right.theUniqueTaos;
+    theCoefficients = right.theCoefficients;
+    theTaoIndex = right.theTaoIndex;
+    theOffsets = right.theOffsets;
   }
   return *this;
 }
@@ -54,3 +64,68 @@ G4RadioactiveDecayChainsFromParent::~G4RadioactiveDecayChainsFromParent()
 {} 
 
 
+
+
+void
+G4RadioactiveDecayChainsFromParent::SetItsRates(const G4RadioactiveDecayRates& arate)
+{
+  itsRates = arate;
+  Compact();
+}
+
+
+void G4RadioactiveDecayChainsFromParent::Compact()
+{
+  // Every descendant carries the mean lives of all its ancestors, so the
+  // same few values are repeated many times over the chains.  Store each
+  // once so that the source-time convolution is done once per lifetime.
+  theUniqueTaos.clear();
+  theCoefficients.clear();
+  theTaoIndex.clear();
+  theOffsets.clear();
+
+  std::map<G4double, G4int> taoIndex;
+  size_t nrates = itsRates.size();
+  theOffsets.reserve(nrates + 1);
+  theOffsets.push_back(0);
+
+  for (size_t i = 0; i < nrates; ++i) {
+    std::vector<G4double> taos = itsRates[i].GetTaos();
+    std::vector<G4double> coeffs = itsRates[i].GetDecayRateC();
+    size_t n = std::min(taos.size(), coeffs.size());
+    for (size_t j = 0; j < n; ++j) {
+      std::map<G4double, G4int>::const_iterator it = taoIndex.find(taos[j]);
+      G4int idx;
+      if (it == taoIndex.end()) {
+        idx = theUniqueTaos.size();
+        taoIndex[taos[j]] = idx;
+        theUniqueTaos.push_back(taos[j]);
+      } else {
+        idx = it->second;
+      }
+      theTaoIndex.push_back(idx);
+      theCoefficients.push_back(coeffs[j]);
+    }
+    theOffsets.push_back(theCoefficients.size());
+  }
+}
+
+
+void G4RadioactiveDecayChainsFromParent::
+GetDecayRates(const std::vector<G4double>& convolvedTimes,
+              std::vector<G4double>& rates) const
+{
+  // Eq. 4.23 of the DERA technical note.  The coefficients are defined for
+  // a decaying population, hence the minus sign.  Small negative results
+  // come from cancellation and are set to zero.
+  size_t nrates = theOffsets.size() - 1;
+  rates.resize(nrates);
+  const G4double* conv = convolvedTimes.data();
+  for (size_t i = 0; i < nrates; ++i) {
+    long double decayRate = 0.L;
+    for (size_t k = theOffsets[i]; k < theOffsets[i+1]; ++k) {
+      decayRate -= theCoefficients[k] * (long double)conv[theTaoIndex[k]];
+    }
+    rates[i] = (decayRate > 0.L) ? G4double(decayRate) : 0.0;
+  }
+}
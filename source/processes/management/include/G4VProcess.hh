@@ -400,6 +400,11 @@ public:
     // to get pointer of master process from worker thread
     // By default this method makes a forward call
     // to PreparePhysicsTable
+
+    virtual const G4VProcess* GetCreatorProcess() const;
+    // Returns the process recorded by G4SteppingManager as the creator
+    // of the secondaries of the last DoIt: this process by default, the
+    // process actually invoked by a process which delegates to others
 };
 
 // -----------------------------------------
@@ -543,6 +548,12 @@ const G4VProcess* G4VProcess::GetMasterProcess() const
     return masterProcessShadow;
 }
 
+inline
+const G4VProcess* G4VProcess::GetCreatorProcess() const
+{
+  return this;
+}
+
 inline
 void G4VProcess::SubtractNumberOfInteractionLengthLeft(
                                   G4double previousStepSize )
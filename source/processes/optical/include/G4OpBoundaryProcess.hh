@@ -56,6 +56,10 @@
 //                           of a dichronic filter
 //              2017-02-24 - add capability of simulating surface reflections
 //                           with Look-Up-Tables (LUT) developed in DAVIS
+//              2018-10-19 - optional boundary tables: tabulated facet angle
+//                           distribution of the unified model (shared
+//                           between threads) and reuse of the surface
+//                           property values for repeated hits
 //
 // Author:      Peter Gumplinger
 //              adopted from work by Werner Keil - April 2/96
@@ -170,6 +174,9 @@ public:
         // every step. However, only at a boundary will any action be
         // taken.
 
+        void StartTracking(G4Track* aTrack);
+        // Resets the per-photon cache of surface property values.
+
         G4VParticleChange* PostStepDoIt(const G4Track& aTrack,
                                         const G4Step&  aStep);
         // This is the method implementing boundary processes.
@@ -180,6 +187,13 @@ public:
         void SetInvokeSD(G4bool );
         // Set flag for call to InvokeSD method.
 
+        void SetUseBoundaryTables(G4bool );
+        G4bool GetUseBoundaryTables() const;
+        // If true, the facet angle alpha of the unified model is sampled
+        // from a shared table (see G4OpBoundaryTables) and the surface
+        // property values are reused when a photon hits the same surface
+        // again with the same energy.
+
 private:
 
         G4bool G4BooleanRand(const G4double prob) const;
@@ -187,6 +201,8 @@ private:
         G4ThreeVector GetFacetNormal(const G4ThreeVector& Momentum,
                                      const G4ThreeVector&  Normal) const;
 
+        void UpdateFacetAngleTable();
+
         void DielectricMetal();
         void DielectricDielectric();
 
@@ -265,6 +281,16 @@ private:
         G4Physics2DVector* DichroicVector;
 
         G4bool fInvokeSD;
+
+        G4bool fUseBoundaryTables;
+
+        const G4PhysicsOrderedFreeVector* fFacetAngleTable;
+        G4double fFacetSigmaAlpha;
+
+        const G4OpticalSurface* fCachedSurface;
+        G4double fCachedPhotonMomentum;
+        G4double fCachedSurfaceValues[6];
+        // reflectivity, efficiency, transmittance, prob_sl, prob_ss, prob_bs
 };
 
 ////////////////////
@@ -298,6 +324,21 @@ void G4OpBoundaryProcess::SetInvokeSD(G4bool flag)
   fInvokeSD = flag;
 }
 
+inline
+void G4OpBoundaryProcess::SetUseBoundaryTables(G4bool flag)
+{
+  fUseBoundaryTables = flag;
+  fFacetAngleTable = NULL;
+  fFacetSigmaAlpha = 0.;
+  fCachedSurface = NULL;
+}
+
+inline
+G4bool G4OpBoundaryProcess::GetUseBoundaryTables() const
+{
+  return fUseBoundaryTables;
+}
+
 inline
 void G4OpBoundaryProcess::ChooseReflection()
 {
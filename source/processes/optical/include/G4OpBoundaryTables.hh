@@ -0,0 +1,94 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// -------------------------------------------------------------------
+//
+// GEANT4 Class file
+//
+//
+// File name:     G4OpBoundaryTables.hh
+//
+// Creation date: 2018-10-19
+//
+// Modifications: 
+//
+// Class Description: 
+//
+// Shared tables used by G4OpBoundaryProcess when the boundary tables
+// are enabled. For each value of sigma_alpha of the unified model the
+// inverse cumulative distribution of the facet angle alpha is tabulated,
+// so that GetFacetNormal samples alpha with a single random number
+// instead of the Gauss * sin(alpha) rejection loop. The density which is
+// tabulated is exactly the one produced by the rejection loop, including
+// the min(1,4*sigma_alpha) envelope. Tables are built on the first
+// request for a given sigma_alpha, under a mutex, and are read only
+// afterwards, so that they are shared by all worker threads.
+
+// -------------------------------------------------------------------
+//
+
+#ifndef G4OpBoundaryTables_h
+#define G4OpBoundaryTables_h 1
+
+#include "globals.hh"
+#include <map>
+
+class G4PhysicsOrderedFreeVector;
+
+class G4OpBoundaryTables 
+{
+public:
+
+  static G4OpBoundaryTables* Instance();
+
+  ~G4OpBoundaryTables();
+
+  const G4PhysicsOrderedFreeVector* GetFacetAngleTable(G4double sigmaAlpha);
+  // Inverse cumulative distribution of alpha: the abscissa is the
+  // cumulative probability in [0,1], the value is alpha
+
+  void SetNumberOfBins(G4int val);
+  // Number of alpha bins of tables built after this call
+
+  void Clear();
+
+private:
+
+  G4OpBoundaryTables();
+
+  G4PhysicsOrderedFreeVector* BuildFacetAngleTable(G4double sigmaAlpha) const;
+
+  // hide assignment operator
+  G4OpBoundaryTables & operator=(const G4OpBoundaryTables &right) = delete;
+  G4OpBoundaryTables(const G4OpBoundaryTables&) = delete;
+
+  static G4OpBoundaryTables* fInstance;
+
+  std::map<G4double, G4PhysicsOrderedFreeVector*> fFacetAngleTables;
+
+  G4int fNumberOfBins;
+};
+
+#endif
@@ -0,0 +1,238 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// -------------------------------------------------------------------
+//
+// GEANT4 Class file
+//
+//
+// File name:     G4OpticalPhotonBank.hh
+//
+// Creation date: 2018-10-19
+//
+// Modifications: 
+//
+// Class Description: 
+//
+// Compact store of optical photons kept as a structure of arrays
+// (position, direction, polarization, energy, time, weight and an
+// integer tag free for the creator process). Photons in the bank are
+// not G4Tracks; they are filled by the light emitting processes, moved
+// by G4OpticalPhotonTransport and converted into G4Tracks with
+// MakeTrack() only when they have to be handed to the stepping manager.
+// The bank is not shared between threads.
+
+// -------------------------------------------------------------------
+//
+
+#ifndef G4OpticalPhotonBank_h
+#define G4OpticalPhotonBank_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include <vector>
+
+class G4Track;
+
+class G4OpticalPhotonBank 
+{
+
+public:
+
+  G4OpticalPhotonBank();
+
+  ~G4OpticalPhotonBank();
+
+  void Reserve(std::size_t n);
+
+  void Clear();
+  // Removes all photons, capacity is kept
+
+  inline std::size_t Size() const;
+
+  inline std::size_t AddPhoton(const G4ThreeVector& position,
+                               const G4ThreeVector& direction,
+                               const G4ThreeVector& polarization,
+                               G4double energy, G4double time,
+                               G4double weight = 1.0, G4int tag = 0);
+  // Returns index of the new photon
+
+  inline G4ThreeVector GetPosition(std::size_t i) const;
+  inline G4ThreeVector GetMomentumDirection(std::size_t i) const;
+  inline G4ThreeVector GetPolarization(std::size_t i) const;
+  inline G4double GetEnergy(std::size_t i) const;
+  inline G4double GetTime(std::size_t i) const;
+  inline G4double GetWeight(std::size_t i) const;
+  inline G4int GetTag(std::size_t i) const;
+  inline G4bool IsAlive(std::size_t i) const;
+
+  inline void SetPosition(std::size_t i, const G4ThreeVector& v);
+  inline void SetMomentumDirection(std::size_t i, const G4ThreeVector& v);
+  inline void SetPolarization(std::size_t i, const G4ThreeVector& v);
+  inline void SetTime(std::size_t i, G4double t);
+  inline void SetWeight(std::size_t i, G4double w);
+
+  inline void Kill(std::size_t i);
+  // Marks photon as absorbed; it is removed by Compact()
+
+  std::size_t Compact();
+  // Removes killed photons keeping the order of survivors,
+  // returns the number of photons left
+
+  G4Track* MakeTrack(std::size_t i) const;
+  // New track for the photon; touchable, parent ID and user 
+  // information have to be set by the caller
+
+private:
+
+  G4OpticalPhotonBank(const G4OpticalPhotonBank&) = delete;
+  G4OpticalPhotonBank& operator=(const G4OpticalPhotonBank&) = delete;
+
+  std::vector<G4double> fX, fY, fZ;
+  std::vector<G4double> fDx, fDy, fDz;
+  std::vector<G4double> fPx, fPy, fPz;
+  std::vector<G4double> fEnergy;
+  std::vector<G4double> fTime;
+  std::vector<G4double> fWeight;
+  std::vector<G4int>    fTag;
+  std::vector<G4bool>   fAlive;
+  std::size_t           fNKilled;
+};
+
+inline std::size_t G4OpticalPhotonBank::Size() const
+{
+  return fEnergy.size();
+}
+
+inline std::size_t 
+G4OpticalPhotonBank::AddPhoton(const G4ThreeVector& position,
+                               const G4ThreeVector& direction,
+                               const G4ThreeVector& polarization,
+                               G4double energy, G4double time,
+                               G4double weight, G4int tag)
+{
+  fX.push_back(position.x());
+  fY.push_back(position.y());
+  fZ.push_back(position.z());
+  fDx.push_back(direction.x());
+  fDy.push_back(direction.y());
+  fDz.push_back(direction.z());
+  fPx.push_back(polarization.x());
+  fPy.push_back(polarization.y());
+  fPz.push_back(polarization.z());
+  fEnergy.push_back(energy);
+  fTime.push_back(time);
+  fWeight.push_back(weight);
+  fTag.push_back(tag);
+  fAlive.push_back(true);
+  return fEnergy.size() - 1;
+}
+
+inline G4ThreeVector G4OpticalPhotonBank::GetPosition(std::size_t i) const
+{
+  return G4ThreeVector(fX[i], fY[i], fZ[i]);
+}
+
+inline G4ThreeVector 
+G4OpticalPhotonBank::GetMomentumDirection(std::size_t i) const
+{
+  return G4ThreeVector(fDx[i], fDy[i], fDz[i]);
+}
+
+inline G4ThreeVector 
+G4OpticalPhotonBank::GetPolarization(std::size_t i) const
+{
+  return G4ThreeVector(fPx[i], fPy[i], fPz[i]);
+}
+
+inline G4double G4OpticalPhotonBank::GetEnergy(std::size_t i) const
+{
+  return fEnergy[i];
+}
+
+inline G4double G4OpticalPhotonBank::GetTime(std::size_t i) const
+{
+  return fTime[i];
+}
+
+inline G4double G4OpticalPhotonBank::GetWeight(std::size_t i) const
+{
+  return fWeight[i];
+}
+
+inline G4int G4OpticalPhotonBank::GetTag(std::size_t i) const
+{
+  return fTag[i];
+}
+
+inline G4bool G4OpticalPhotonBank::IsAlive(std::size_t i) const
+{
+  return fAlive[i];
+}
+
+inline void 
+G4OpticalPhotonBank::SetPosition(std::size_t i, const G4ThreeVector& v)
+{
+  fX[i] = v.x(); 
+  fY[i] = v.y(); 
+  fZ[i] = v.z();
+}
+
+inline void 
+G4OpticalPhotonBank::SetMomentumDirection(std::size_t i, 
+                                          const G4ThreeVector& v)
+{
+  fDx[i] = v.x(); 
+  fDy[i] = v.y(); 
+  fDz[i] = v.z();
+}
+
+inline void 
+G4OpticalPhotonBank::SetPolarization(std::size_t i, const G4ThreeVector& v)
+{
+  fPx[i] = v.x(); 
+  fPy[i] = v.y(); 
+  fPz[i] = v.z();
+}
+
+inline void G4OpticalPhotonBank::SetTime(std::size_t i, G4double t)
+{
+  fTime[i] = t;
+}
+
+inline void G4OpticalPhotonBank::SetWeight(std::size_t i, G4double w)
+{
+  fWeight[i] = w;
+}
+
+inline void G4OpticalPhotonBank::Kill(std::size_t i)
+{
+  if(fAlive[i]) {
+    fAlive[i] = false;
+    ++fNKilled;
+  }
+}
+
+#endif
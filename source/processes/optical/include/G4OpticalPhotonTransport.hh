@@ -0,0 +1,145 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// -------------------------------------------------------------------
+//
+// GEANT4 Class file
+//
+//
+// File name:     G4OpticalPhotonTransport.hh
+//
+// Creation date: 2018-10-19
+//
+// Modifications: 
+//  2018-10-19 Transport() for a touchable, used for photons generated
+//             from G4OpticalPhotonGenStep records
+//
+// Class Description: 
+//
+// Thread local engine which propagates a batch of optical photons kept 
+// in a G4OpticalPhotonBank through the bulk of the volume where they
+// were created, without G4Tracks and without the stepping manager.
+// Bulk absorption (ABSLENGTH) and Rayleigh scattering are sampled with
+// the same physics as G4OpAbsorption and G4OpRayleigh; the navigator
+// is called only when the sampled flight length exceeds the isotropic
+// safety. Absorbed photons are removed from the bank and their energy is
+// returned to the caller, to be deposited locally as G4OpAbsorption
+// does in full tracking. A photon which would
+// reach a volume boundary is left at its last interaction point with
+// its current direction, polarization and time, so the boundary and
+// everything after it are done by full tracking once the photon is
+// converted into a G4Track.
+//
+// The batch is left untouched (all photons go to full tracking) if
+// the volume is sensitive, if the material has WLS or Mie scattering
+// properties with the corresponding process registered, or if optical
+// photons have processes unknown to the engine.
+
+// -------------------------------------------------------------------
+//
+
+#ifndef G4OpticalPhotonTransport_h
+#define G4OpticalPhotonTransport_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4ThreadLocalSingleton.hh"
+
+class G4OpticalPhotonBank;
+class G4StepPoint;
+class G4VTouchable;
+class G4Material;
+class G4Navigator;
+class G4VProcess;
+class G4ProcessManager;
+class G4OpRayleigh;
+
+class G4OpticalPhotonTransport 
+{
+
+friend class G4ThreadLocalSingleton<G4OpticalPhotonTransport>;
+
+public:
+
+  static G4OpticalPhotonTransport* GetInstance();
+
+  ~G4OpticalPhotonTransport();
+
+  G4double Transport(G4OpticalPhotonBank& bank, const G4StepPoint* point);
+  // Propagates photons of the bank created inside the volume of 
+  // the step point (normally the pre-step point of the parent);
+  // returns the total energy of the photons absorbed in the bulk
+
+  G4double Transport(G4OpticalPhotonBank& bank, 
+                     const G4VTouchable* touchable,
+                     const G4Material* material);
+  // Same for photons created inside the volume of the touchable
+
+  inline void SetMaxInteractions(G4int val);
+  // Maximal number of Rayleigh scatterings per photon done by 
+  // the engine, afterwards the photon goes to full tracking
+
+  inline void SetVerboseLevel(G4int val);
+
+private:
+
+  G4OpticalPhotonTransport();
+
+  void Initialise();
+
+  G4bool IsActive(const G4VProcess* p) const;
+
+  G4ThreeVector RayleighScatter(const G4ThreeVector& dir,
+                                G4ThreeVector& pol) const;
+
+  G4OpticalPhotonTransport(const G4OpticalPhotonTransport&) = delete;
+  G4OpticalPhotonTransport& operator=
+  (const G4OpticalPhotonTransport&) = delete;
+
+  static G4ThreadLocal G4OpticalPhotonTransport* fInstance;
+
+  G4Navigator*      fNavigator;
+  G4ProcessManager* fManager;
+  G4VProcess*       fAbsorption;
+  G4OpRayleigh*     fRayleigh;
+  G4VProcess*       fWLS;
+  G4VProcess*       fMieHG;
+  G4int             fMaxInteractions;
+  G4int             verboseLevel;
+  G4bool            isInitialised;
+  G4bool            isApplicable;
+};
+
+inline void G4OpticalPhotonTransport::SetMaxInteractions(G4int val)
+{
+  fMaxInteractions = val;
+}
+
+inline void G4OpticalPhotonTransport::SetVerboseLevel(G4int val)
+{
+  verboseLevel = val;
+}
+
+#endif
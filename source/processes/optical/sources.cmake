@@ -43,19 +43,25 @@ GEANT4_DEFINE_MODULE(NAME G4optical
     HEADERS
         G4OpAbsorption.hh
         G4OpBoundaryProcess.hh
+        G4OpBoundaryTables.hh
         G4OpMieHG.hh
         G4OpProcessSubType.hh
         G4OpRayleigh.hh
         G4OpWLS.hh
+        G4OpticalPhotonBank.hh
+        G4OpticalPhotonTransport.hh
         G4VWLSTimeGeneratorProfile.hh
         G4WLSTimeGeneratorProfileDelta.hh
         G4WLSTimeGeneratorProfileExponential.hh
     SOURCES
         G4OpAbsorption.cc
         G4OpBoundaryProcess.cc
+        G4OpBoundaryTables.cc
         G4OpMieHG.cc
         G4OpRayleigh.cc
         G4OpWLS.cc
+        G4OpticalPhotonBank.cc
+        G4OpticalPhotonTransport.cc
         G4VWLSTimeGeneratorProfile.cc
         G4WLSTimeGeneratorProfileDelta.cc
         G4WLSTimeGeneratorProfileExponential.cc
@@ -136,8 +136,8 @@ G4double G4OpAbsorption::GetMeanFreePath(const G4Track& aTrack,
 	aMaterialPropertyTable = aMaterial->GetMaterialPropertiesTable();
 
 	if ( aMaterialPropertyTable ) {
-	   AttenuationLengthVector = aMaterialPropertyTable->
-                                                GetProperty(kABSLENGTH);
+	   AttenuationLengthVector =
+                       aMaterialPropertyTable->GetOpticalBundle().fAbsLength;
            if ( AttenuationLengthVector ){
              AttenuationLength = AttenuationLengthVector->
                                          Value(thePhotonMomentum);
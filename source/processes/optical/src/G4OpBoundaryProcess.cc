@@ -79,6 +79,7 @@
 #include "G4OpProcessSubType.hh"
 
 #include "G4OpBoundaryProcess.hh"
+#include "G4OpBoundaryTables.hh"
 #include "G4GeometryTolerance.hh"
 
 #include "G4VSensitiveDetector.hh"
@@ -146,6 +147,13 @@ G4OpBoundaryProcess::G4OpBoundaryProcess(const G4String& processName,
         DichroicVector = NULL;
 
         fInvokeSD = true;
+
+        fUseBoundaryTables = false;
+        fFacetAngleTable = NULL;
+        fFacetSigmaAlpha = 0.;
+        fCachedSurface = NULL;
+        fCachedPhotonMomentum = -1.;
+        for (G4int i = 0; i < 6; ++i) fCachedSurfaceValues[i] = 0.;
 }
 
 // G4OpBoundaryProcess::G4OpBoundaryProcess(const G4OpBoundaryProcess &right)
@@ -162,6 +170,19 @@ G4OpBoundaryProcess::~G4OpBoundaryProcess(){}
         // Methods
         ////////////
 
+// StartTracking
+// -------------
+//
+
+void G4OpBoundaryProcess::StartTracking(G4Track* aTrack)
+{
+        G4VDiscreteProcess::StartTracking(aTrack);
+
+        // surface values are only reused along one photon history
+        fCachedSurface = NULL;
+        fCachedPhotonMomentum = -1.;
+}
+
 // PostStepDoIt
 // ------------
 //
@@ -280,7 +301,7 @@ G4OpBoundaryProcess::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 
 	aMaterialPropertiesTable = Material1->GetMaterialPropertiesTable();
         if (aMaterialPropertiesTable) {
-		Rindex = aMaterialPropertiesTable->GetProperty(kRINDEX);
+		Rindex = aMaterialPropertiesTable->GetOpticalBundle().fRindex;
 	}
 	else {
                 theStatus = NoRINDEX;
@@ -352,9 +373,13 @@ G4OpBoundaryProcess::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 
            if (aMaterialPropertiesTable) {
 
+              // all surface properties are fetched at once
+              const G4MaterialOpticalBundle& surfaceProperties =
+                               aMaterialPropertiesTable->GetOpticalBundle();
+
               if (theFinish == polishedbackpainted ||
                   theFinish == groundbackpainted ) {
-                  Rindex = aMaterialPropertiesTable->GetProperty(kRINDEX);
+                  Rindex = surfaceProperties.fRindex;
 	          if (Rindex) {
                      Rindex2 = Rindex->Value(thePhotonMomentum);
                   }
@@ -367,74 +392,96 @@ G4OpBoundaryProcess::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
                   }
               }
 
-              PropertyPointer =
-                      aMaterialPropertiesTable->GetProperty(kREFLECTIVITY);
-              PropertyPointer1 =
-                      aMaterialPropertiesTable->GetProperty(kREALRINDEX);
-              PropertyPointer2 =
-                      aMaterialPropertiesTable->GetProperty(kIMAGINARYRINDEX);
+              PropertyPointer  = surfaceProperties.fReflectivity;
+              PropertyPointer1 = surfaceProperties.fRealRindex;
+              PropertyPointer2 = surfaceProperties.fImaginaryRindex;
 
               iTE = 1;
               iTM = 1;
 
-              if (PropertyPointer) {
-
-                 theReflectivity =
-                          PropertyPointer->Value(thePhotonMomentum);
-
-              } else if (PropertyPointer1 && PropertyPointer2) {
-
-                 CalculateReflectivity();
-
-              }
+              if (fUseBoundaryTables && OpticalSurface == fCachedSurface &&
+                  thePhotonMomentum == fCachedPhotonMomentum) {
 
-              PropertyPointer =
-              aMaterialPropertiesTable->GetProperty(kEFFICIENCY);
-              if (PropertyPointer) {
-                      theEfficiency =
-                      PropertyPointer->Value(thePhotonMomentum);
-              }
+                 // same surface and photon energy as at the previous hit,
+                 // e.g. a photon bouncing in a light guide
 
-              PropertyPointer =
-              aMaterialPropertiesTable->GetProperty(kTRANSMITTANCE);
-              if (PropertyPointer) {
-                      theTransmittance =
-                      PropertyPointer->Value(thePhotonMomentum);
-              }
+                 theReflectivity  = fCachedSurfaceValues[0];
+                 theEfficiency    = fCachedSurfaceValues[1];
+                 theTransmittance = fCachedSurfaceValues[2];
+                 if ( theModel == unified ) {
+                    prob_sl = fCachedSurfaceValues[3];
+                    prob_ss = fCachedSurfaceValues[4];
+                    prob_bs = fCachedSurfaceValues[5];
+                 }
 
-              if (aMaterialPropertiesTable->
-                                     ConstPropertyExists("SURFACEROUGHNESS"))
-                 theSurfaceRoughness = aMaterialPropertiesTable->
-                                         GetConstProperty(kSURFACEROUGHNESS);
+              } else {
 
-	      if ( theModel == unified ) {
-                 PropertyPointer =
-                 aMaterialPropertiesTable->GetProperty(kSPECULARLOBECONSTANT);
                  if (PropertyPointer) {
-                         prob_sl =
+                         theReflectivity =
                          PropertyPointer->Value(thePhotonMomentum);
-                 } else {
-                         prob_sl = 0.0;
                  }
 
-                 PropertyPointer =
-                 aMaterialPropertiesTable->GetProperty(kSPECULARSPIKECONSTANT);
-	         if (PropertyPointer) {
-                         prob_ss =
+                 PropertyPointer = surfaceProperties.fEfficiency;
+                 if (PropertyPointer) {
+                         theEfficiency =
                          PropertyPointer->Value(thePhotonMomentum);
-                 } else {
-                         prob_ss = 0.0;
                  }
 
-                 PropertyPointer =
-                 aMaterialPropertiesTable->GetProperty(kBACKSCATTERCONSTANT);
+                 PropertyPointer = surfaceProperties.fTransmittance;
                  if (PropertyPointer) {
-                         prob_bs =
+                         theTransmittance =
                          PropertyPointer->Value(thePhotonMomentum);
-                 } else {
-                         prob_bs = 0.0;
+                 }
+
+	         if ( theModel == unified ) {
+                    PropertyPointer = surfaceProperties.fSpecularLobe;
+                    if (PropertyPointer) {
+                            prob_sl =
+                            PropertyPointer->Value(thePhotonMomentum);
+                    } else {
+                            prob_sl = 0.0;
+                    }
+
+                    PropertyPointer = surfaceProperties.fSpecularSpike;
+	            if (PropertyPointer) {
+                            prob_ss =
+                            PropertyPointer->Value(thePhotonMomentum);
+                    } else {
+                            prob_ss = 0.0;
+                    }
+
+                    PropertyPointer = surfaceProperties.fBackScatter;
+                    if (PropertyPointer) {
+                            prob_bs =
+                            PropertyPointer->Value(thePhotonMomentum);
+                    } else {
+                            prob_bs = 0.0;
+                    }
+                 }
+
+                 if (fUseBoundaryTables) {
+                    fCachedSurface = OpticalSurface;
+                    fCachedPhotonMomentum = thePhotonMomentum;
+                    fCachedSurfaceValues[0] = theReflectivity;
+                    fCachedSurfaceValues[1] = theEfficiency;
+                    fCachedSurfaceValues[2] = theTransmittance;
+                    fCachedSurfaceValues[3] = prob_sl;
+                    fCachedSurfaceValues[4] = prob_ss;
+                    fCachedSurfaceValues[5] = prob_bs;
                  }
               }
+
+              if (!surfaceProperties.fReflectivity &&
+                  PropertyPointer1 && PropertyPointer2) {
+
+                 CalculateReflectivity();
+
+              }
+
+              if (surfaceProperties.fHasSurfaceRoughness)
+                 theSurfaceRoughness = surfaceProperties.fSurfaceRoughness;
+
+              if (fUseBoundaryTables) UpdateFacetAngleTable();
            }
            else if (theFinish == polishedbackpainted ||
                     theFinish == groundbackpainted ) {
@@ -455,7 +502,7 @@ G4OpBoundaryProcess::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
               aMaterialPropertiesTable =
                      Material2->GetMaterialPropertiesTable();
               if (aMaterialPropertiesTable)
-                 Rindex = aMaterialPropertiesTable->GetProperty(kRINDEX);
+                 Rindex = aMaterialPropertiesTable->GetOpticalBundle().fRindex;
               if (Rindex) {
                  Rindex2 = Rindex->Value(thePhotonMomentum);
               }
@@ -541,7 +588,7 @@ G4OpBoundaryProcess::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 
         if ( theStatus == FresnelRefraction || theStatus == Transmission ) {
            G4MaterialPropertyVector* groupvel =
-           Material2->GetMaterialPropertiesTable()->GetProperty(kGROUPVEL);
+           Material2->GetMaterialPropertiesTable()->GetOpticalBundle().fGroupVel;
            G4double finalVelocity = groupvel->Value(thePhotonMomentum);
            aParticleChange.ProposeVelocity(finalVelocity);
         }
@@ -658,14 +705,24 @@ G4OpBoundaryProcess::GetFacetNormal(const G4ThreeVector& Momentum,
 
            G4double f_max = std::min(1.0,4.*sigma_alpha);
 
+           // alpha is sampled from the tabulated distribution if available
+           const G4PhysicsOrderedFreeVector* alphaTable =
+             (fUseBoundaryTables && sigma_alpha == fFacetSigmaAlpha) ?
+             fFacetAngleTable : NULL;
+
            G4double phi, SinAlpha, CosAlpha, SinPhi, CosPhi, unit_x, unit_y, unit_z;
            G4ThreeVector tmpNormal;
 
            do {
-              do {
-                 alpha = G4RandGauss::shoot(0.0,sigma_alpha);
-                 // Loop checking, 13-Aug-2015, Peter Gumplinger
-              } while (G4UniformRand()*f_max > std::sin(alpha) || alpha >= halfpi );
+              if (alphaTable) {
+                 alpha = alphaTable->Value(G4UniformRand());
+              }
+              else {
+                do {
+                   alpha = G4RandGauss::shoot(0.0,sigma_alpha);
+                   // Loop checking, 13-Aug-2015, Peter Gumplinger
+                } while (G4UniformRand()*f_max > std::sin(alpha) || alpha >= halfpi );
+              }
 
               phi = G4UniformRand()*twopi;
 
@@ -715,6 +772,21 @@ G4OpBoundaryProcess::GetFacetNormal(const G4ThreeVector& Momentum,
         return FacetNormal;
 }
 
+void G4OpBoundaryProcess::UpdateFacetAngleTable()
+{
+        // Fetch the shared facet angle table for the current surface;
+        // the table is kept until sigma_alpha changes
+
+        G4double sigma_alpha = 0.0;
+        if (OpticalSurface) sigma_alpha = OpticalSurface->GetSigmaAlpha();
+
+        if (sigma_alpha == fFacetSigmaAlpha && fFacetAngleTable) return;
+
+        fFacetSigmaAlpha = sigma_alpha;
+        fFacetAngleTable =
+          G4OpBoundaryTables::Instance()->GetFacetAngleTable(sigma_alpha);
+}
+
 void G4OpBoundaryProcess::DielectricMetal()
 {
         G4int n = 0;
@@ -1338,12 +1410,12 @@ G4double G4OpBoundaryProcess::GetReflectivity(G4double E1_perp,
   G4complex denominatorTE, denominatorTM;
   G4complex rTM, rTE;
 
-  G4MaterialPropertiesTable* aMaterialPropertiesTable =
-                                    Material1->GetMaterialPropertiesTable();
+  const G4MaterialOpticalBundle& material1Properties =
+                Material1->GetMaterialPropertiesTable()->GetOpticalBundle();
   G4MaterialPropertyVector* aPropertyPointerR =
-                      aMaterialPropertiesTable->GetProperty(kREALRINDEX);
+                                         material1Properties.fRealRindex;
   G4MaterialPropertyVector* aPropertyPointerI =
-                      aMaterialPropertiesTable->GetProperty(kIMAGINARYRINDEX);
+                                         material1Properties.fImaginaryRindex;
   if (aPropertyPointerR && aPropertyPointerI) {
      G4double RRindex = aPropertyPointerR->Value(thePhotonMomentum);
      G4double IRindex = aPropertyPointerI->Value(thePhotonMomentum);
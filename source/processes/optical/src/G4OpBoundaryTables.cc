@@ -0,0 +1,154 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// -------------------------------------------------------------------
+//
+// GEANT4 Class file
+//
+//
+// File name:     G4OpBoundaryTables.cc
+//
+// Creation date: 2018-10-19
+//
+// Modifications: 
+//
+// -------------------------------------------------------------------
+//
+
+#include "G4OpBoundaryTables.hh"
+#include "G4PhysicsOrderedFreeVector.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4Exp.hh"
+#include "G4AutoLock.hh"
+
+#include <vector>
+
+namespace
+{
+  G4Mutex opBoundaryTablesMutex = G4MUTEX_INITIALIZER;
+}
+
+G4OpBoundaryTables* G4OpBoundaryTables::fInstance = nullptr;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+G4OpBoundaryTables* G4OpBoundaryTables::Instance()
+{
+  if(nullptr == fInstance) {
+    G4AutoLock l(&opBoundaryTablesMutex);
+    if(nullptr == fInstance) {
+      static G4OpBoundaryTables manager;
+      fInstance = &manager;
+    }
+  }
+  return fInstance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+G4OpBoundaryTables::G4OpBoundaryTables() : fNumberOfBins(1000)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+G4OpBoundaryTables::~G4OpBoundaryTables()
+{
+  Clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4OpBoundaryTables::Clear()
+{
+  G4AutoLock l(&opBoundaryTablesMutex);
+  for(auto& table : fFacetAngleTables) { delete table.second; }
+  fFacetAngleTables.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4OpBoundaryTables::SetNumberOfBins(G4int val)
+{
+  if(val > 1) { fNumberOfBins = val; }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+const G4PhysicsOrderedFreeVector* 
+G4OpBoundaryTables::GetFacetAngleTable(G4double sigmaAlpha)
+{
+  if(sigmaAlpha <= 0.0) { return nullptr; }
+
+  G4AutoLock l(&opBoundaryTablesMutex);
+  auto itr = fFacetAngleTables.find(sigmaAlpha);
+  if(itr != fFacetAngleTables.end()) { return itr->second; }
+
+  G4PhysicsOrderedFreeVector* table = BuildFacetAngleTable(sigmaAlpha);
+  fFacetAngleTables[sigmaAlpha] = table;
+  return table;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+G4PhysicsOrderedFreeVector* 
+G4OpBoundaryTables::BuildFacetAngleTable(G4double sigmaAlpha) const
+{
+  // G4OpBoundaryProcess::GetFacetNormal accepts alpha = |gauss(0,sigma)|
+  // with probability sin(alpha)/f_max (capped at 1) for alpha < pi/2;
+  // beyond 10 sigma the gaussian factor is negligible
+  const G4double fMax = std::min(1.0, 4.*sigmaAlpha);
+  const G4double alphaMax = std::min(halfpi, 10.*sigmaAlpha);
+  const G4double invSig2 = 0.5/(sigmaAlpha*sigmaAlpha);
+  const G4int nBins = fNumberOfBins;
+  const G4double dAlpha = alphaMax/nBins;
+
+  std::vector<G4double> alpha, cdf;
+  alpha.reserve(nBins+1);
+  cdf.reserve(nBins+1);
+  alpha.push_back(0.0);
+  cdf.push_back(0.0);
+
+  G4double sum = 0.0;
+  G4double f0 = 0.0;
+  for(G4int i=1; i<=nBins; ++i) {
+    G4double a = i*dAlpha;
+    G4double f1 = G4Exp(-a*a*invSig2)*std::min(std::sin(a), fMax)/fMax;
+    sum += 0.5*(f0 + f1)*dAlpha;
+    f0 = f1;
+    // keep the abscissa strictly increasing for the interpolation
+    if(sum > cdf.back()) {
+      alpha.push_back(a);
+      cdf.push_back(sum);
+    }
+  }
+
+  const std::size_t n = cdf.size();
+  for(std::size_t i=1; i<n; ++i) { cdf[i] /= sum; }
+  cdf[n-1] = 1.0;
+
+  return new G4PhysicsOrderedFreeVector(&cdf[0], &alpha[0], n);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
@@ -234,7 +234,7 @@ void G4OpRayleigh::BuildPhysicsTable(const G4ParticleDefinition&)
                                        material->GetMaterialPropertiesTable();
       G4PhysicsOrderedFreeVector* rayleigh = NULL;
       if ( materialProperties != NULL ) {
-         rayleigh = materialProperties->GetProperty( kRAYLEIGH );
+         rayleigh = materialProperties->GetOpticalBundle().fRayleigh;
          if ( rayleigh == NULL ) rayleigh = 
                                    CalculateRayleighMeanFreePaths( material );
       }
@@ -268,8 +268,8 @@ G4double G4OpRayleigh::GetMeanFreePath(const G4Track& aTrack,
 G4PhysicsOrderedFreeVector* 
 G4OpRayleigh::CalculateRayleighMeanFreePaths( const G4Material* material ) const
 {
-  G4MaterialPropertiesTable* materialProperties = 
-                                       material->GetMaterialPropertiesTable();
+  const G4MaterialOpticalBundle& materialProperties =
+                   material->GetMaterialPropertiesTable()->GetOpticalBundle();
 
   // Retrieve the beta_T or isothermal compressibility value. For backwards
   // compatibility use a constant if the material is "Water". If the material
@@ -277,19 +277,19 @@ G4OpRayleigh::CalculateRayleighMeanFreePaths( const G4Material* material ) const
   G4double betat;
   if ( material->GetName() == "Water" )
     betat = 7.658e-23*m3/MeV;
-  else if(materialProperties->ConstPropertyExists("ISOTHERMAL_COMPRESSIBILITY"))
-    betat = materialProperties->GetConstProperty(kISOTHERMAL_COMPRESSIBILITY);
+  else if(materialProperties.fHasIsothermalCompressibility)
+    betat = materialProperties.fIsothermalCompressibility;
   else
     return NULL;
 
   // If the material doesn't have a RINDEX property vector then return
-  G4MaterialPropertyVector* rIndex = materialProperties->GetProperty(kRINDEX);
+  G4MaterialPropertyVector* rIndex = materialProperties.fRindex;
   if ( rIndex == NULL ) return NULL;
 
   // Retrieve the optional scale factor, (this just scales the scattering length
   G4double scaleFactor = 1.0;
-  if( materialProperties->ConstPropertyExists( "RS_SCALE_FACTOR" ) )
-    scaleFactor= materialProperties->GetConstProperty(kRS_SCALE_FACTOR );
+  if( materialProperties.fHasRSScaleFactor )
+    scaleFactor = materialProperties.fRSScaleFactor;
 
   // Retrieve the material temperature. For backwards compatibility use a 
   // constant if the material is "Water"
@@ -0,0 +1,143 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// -------------------------------------------------------------------
+//
+// GEANT4 Class file
+//
+//
+// File name:     G4OpticalPhotonBank.cc
+//
+// Creation date: 2018-10-19
+//
+// Modifications: 
+//
+// -------------------------------------------------------------------
+//
+
+#include "G4OpticalPhotonBank.hh"
+#include "G4Track.hh"
+#include "G4DynamicParticle.hh"
+#include "G4OpticalPhoton.hh"
+
+G4OpticalPhotonBank::G4OpticalPhotonBank() : fNKilled(0)
+{}
+
+G4OpticalPhotonBank::~G4OpticalPhotonBank()
+{}
+
+void G4OpticalPhotonBank::Reserve(std::size_t n)
+{
+  fX.reserve(n);
+  fY.reserve(n);
+  fZ.reserve(n);
+  fDx.reserve(n);
+  fDy.reserve(n);
+  fDz.reserve(n);
+  fPx.reserve(n);
+  fPy.reserve(n);
+  fPz.reserve(n);
+  fEnergy.reserve(n);
+  fTime.reserve(n);
+  fWeight.reserve(n);
+  fTag.reserve(n);
+  fAlive.reserve(n);
+}
+
+void G4OpticalPhotonBank::Clear()
+{
+  fX.clear();
+  fY.clear();
+  fZ.clear();
+  fDx.clear();
+  fDy.clear();
+  fDz.clear();
+  fPx.clear();
+  fPy.clear();
+  fPz.clear();
+  fEnergy.clear();
+  fTime.clear();
+  fWeight.clear();
+  fTag.clear();
+  fAlive.clear();
+  fNKilled = 0;
+}
+
+std::size_t G4OpticalPhotonBank::Compact()
+{
+  std::size_t n = Size();
+  if(0 == fNKilled) { return n; }
+
+  std::size_t j = 0;
+  for(std::size_t i=0; i<n; ++i) {
+    if(!fAlive[i]) { continue; }
+    if(i != j) {
+      fX[j] = fX[i];
+      fY[j] = fY[i];
+      fZ[j] = fZ[i];
+      fDx[j] = fDx[i];
+      fDy[j] = fDy[i];
+      fDz[j] = fDz[i];
+      fPx[j] = fPx[i];
+      fPy[j] = fPy[i];
+      fPz[j] = fPz[i];
+      fEnergy[j] = fEnergy[i];
+      fTime[j] = fTime[i];
+      fWeight[j] = fWeight[i];
+      fTag[j] = fTag[i];
+      fAlive[j] = true;
+    }
+    ++j;
+  }
+  fX.resize(j);
+  fY.resize(j);
+  fZ.resize(j);
+  fDx.resize(j);
+  fDy.resize(j);
+  fDz.resize(j);
+  fPx.resize(j);
+  fPy.resize(j);
+  fPz.resize(j);
+  fEnergy.resize(j);
+  fTime.resize(j);
+  fWeight.resize(j);
+  fTag.resize(j);
+  fAlive.resize(j);
+  fNKilled = 0;
+  return j;
+}
+
+G4Track* G4OpticalPhotonBank::MakeTrack(std::size_t i) const
+{
+  G4DynamicParticle* photon = 
+    new G4DynamicParticle(G4OpticalPhoton::OpticalPhoton(), 
+                          GetMomentumDirection(i));
+  photon->SetPolarization(fPx[i], fPy[i], fPz[i]);
+  photon->SetKineticEnergy(fEnergy[i]);
+
+  G4Track* track = new G4Track(photon, fTime[i], GetPosition(i));
+  track->SetWeight(fWeight[i]);
+  return track;
+}
@@ -0,0 +1,287 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// -------------------------------------------------------------------
+//
+// GEANT4 Class file
+//
+//
+// File name:     G4OpticalPhotonTransport.cc
+//
+// Creation date: 2018-10-19
+//
+// Modifications: 
+//
+// -------------------------------------------------------------------
+//
+
+#include "G4OpticalPhotonTransport.hh"
+#include "G4OpticalPhotonBank.hh"
+#include "G4OpProcessSubType.hh"
+#include "G4OpRayleigh.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4StepPoint.hh"
+#include "G4VTouchable.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4PhysicsTable.hh"
+#include "G4Navigator.hh"
+#include "G4TransportationManager.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4Log.hh"
+#include "Randomize.hh"
+
+G4ThreadLocal G4OpticalPhotonTransport* 
+G4OpticalPhotonTransport::fInstance = nullptr;
+
+G4OpticalPhotonTransport* G4OpticalPhotonTransport::GetInstance()
+{
+  if(!fInstance) {
+    static G4ThreadLocalSingleton<G4OpticalPhotonTransport> inst;
+    fInstance = inst.Instance();
+  }
+  return fInstance;
+}
+
+G4OpticalPhotonTransport::G4OpticalPhotonTransport()
+  : fNavigator(new G4Navigator()), fManager(nullptr),
+    fAbsorption(nullptr), fRayleigh(nullptr), fWLS(nullptr), 
+    fMieHG(nullptr), fMaxInteractions(100), verboseLevel(0),
+    isInitialised(false), isApplicable(false)
+{}
+
+G4OpticalPhotonTransport::~G4OpticalPhotonTransport()
+{
+  delete fNavigator;
+}
+
+void G4OpticalPhotonTransport::Initialise()
+{
+  isInitialised = true;
+  isApplicable = true;
+  fManager = G4OpticalPhoton::OpticalPhoton()->GetProcessManager();
+  if(!fManager) {
+    isApplicable = false;
+    return;
+  }
+  G4ProcessVector* plist = fManager->GetProcessList();
+  G4int n = plist->size();
+  for(G4int i=0; i<n; ++i) {
+    G4VProcess* p = (*plist)[i];
+    G4ProcessType type = p->GetProcessType();
+    if(fTransportation == type) { continue; }
+    G4int subtype = p->GetProcessSubType();
+    if(fOptical == type && fOpAbsorption == subtype) {
+      fAbsorption = p;
+    } else if(fOptical == type && fOpRayleigh == subtype) {
+      fRayleigh = dynamic_cast<G4OpRayleigh*>(p);
+      if(!fRayleigh) { isApplicable = false; }
+    } else if(fOptical == type && fOpWLS == subtype) {
+      fWLS = p;
+    } else if(fOptical == type && fOpMieHG == subtype) {
+      fMieHG = p;
+    } else if(fOptical != type || fOpBoundary != subtype) {
+      // physics unknown to the engine would be skipped in the bulk
+      isApplicable = false;
+    }
+  }
+  if(!isApplicable) {
+    G4ExceptionDescription ed;
+    ed << "Optical photons have processes which cannot be handled by"
+       << " the fast transport;\n"
+       << " all photons are passed to full tracking.";
+    G4Exception("G4OpticalPhotonTransport::Initialise()","Optical001",
+                JustWarning, ed);
+  }
+}
+
+G4bool G4OpticalPhotonTransport::IsActive(const G4VProcess* p) const
+{
+  return (p && fManager->GetProcessActivation(const_cast<G4VProcess*>(p)));
+}
+
+G4double G4OpticalPhotonTransport::Transport(G4OpticalPhotonBank& bank,
+                                             const G4StepPoint* point)
+{
+  return (point) 
+    ? Transport(bank, point->GetTouchable(), point->GetMaterial()) : 0.0;
+}
+
+G4double G4OpticalPhotonTransport::Transport(G4OpticalPhotonBank& bank,
+                                             const G4VTouchable* touchable,
+                                             const G4Material* material)
+{
+  if(!isInitialised) { Initialise(); }
+  std::size_t n = bank.Size();
+  if(!isApplicable || 0 == n || !touchable || !material) { return 0.0; }
+
+  // the whole batch is left to full tracking if the volume 
+  // is sensitive or the material needs other bulk processes
+  const G4VPhysicalVolume* volume = touchable->GetVolume();
+  if(!volume || volume->GetLogicalVolume()->GetSensitiveDetector()) { 
+    return 0.0; 
+  }
+
+  G4MaterialPropertiesTable* mpt = material->GetMaterialPropertiesTable();
+  if(!mpt) { return 0.0; }
+  const G4MaterialOpticalBundle& properties = mpt->GetOpticalBundle();
+  if(IsActive(fWLS) && properties.fWLSAbsLength) { return 0.0; }
+  if(IsActive(fMieHG) && properties.fMieHG) { return 0.0; }
+
+  G4MaterialPropertyVector* absVector = 
+    IsActive(fAbsorption) ? properties.fAbsLength : nullptr;
+  G4PhysicsVector* rayVector = nullptr;
+  if(IsActive(fRayleigh)) {
+    const G4PhysicsTable* table = fRayleigh->GetPhysicsTable();
+    std::size_t idx = material->GetIndex();
+    if(table && idx < table->size()) { rayVector = (*table)(idx); }
+  }
+  if(!absVector && !rayVector) { return 0.0; }
+  G4MaterialPropertyVector* groupVel = properties.fGroupVel;
+
+  G4VPhysicalVolume* world = G4TransportationManager::
+    GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume();
+  if(fNavigator->GetWorldVolume() != world) {
+    fNavigator->SetWorldVolume(world);
+  }
+
+  std::size_t nAbsorbed = 0;
+  std::size_t nScattered = 0;
+  G4double absorbed = 0.0;
+  G4bool relative = false;
+
+  for(std::size_t i=0; i<n; ++i) {
+    G4ThreeVector pos = bank.GetPosition(i);
+    G4ThreeVector dir = bank.GetMomentumDirection(i);
+
+    // photons starting on a boundary of the volume are skipped 
+    if(fNavigator->LocateGlobalPointAndSetup(pos, &dir, relative, false)
+       != volume) { 
+      relative = false;
+      continue; 
+    }
+    relative = true;
+
+    G4double energy = bank.GetEnergy(i);
+    G4double absLength = (absVector) ? absVector->Value(energy) : DBL_MAX;
+    G4double rayLength = (rayVector) ? rayVector->Value(energy) : DBL_MAX;
+    if(absLength == DBL_MAX && rayLength == DBL_MAX) { continue; }
+
+    G4double velocity = (groupVel) ? groupVel->Value(energy) : c_light;
+    G4ThreeVector pol = bank.GetPolarization(i);
+    G4double time = bank.GetTime(i);
+    G4double safety = 0.0;
+    G4bool located = true;
+    G4int nscat = 0;
+
+    // Loop checking: limited by the number of interactions
+    while(nscat < fMaxInteractions) {
+      G4double sAbs = (absLength < DBL_MAX) 
+        ? -absLength*G4Log(G4UniformRand()) : DBL_MAX;
+      G4double sRay = (rayLength < DBL_MAX) 
+        ? -rayLength*G4Log(G4UniformRand()) : DBL_MAX;
+      G4double s = std::min(sAbs, sRay);
+
+      // the navigator is called only outside the safety sphere;
+      // if a boundary comes first the photon stays where it is
+      if(s >= safety) {
+        if(!located) { 
+          fNavigator->LocateGlobalPointWithinVolume(pos); 
+          located = true;
+        }
+        G4double step = fNavigator->ComputeStep(pos, dir, s, safety);
+        if(step < s) { break; }
+      }
+      pos += s*dir;
+      time += s/velocity;
+      safety -= s;
+      located = false;
+
+      if(sAbs <= sRay) {
+        // the energy is deposited as in G4OpAbsorption::PostStepDoIt
+        bank.Kill(i);
+        absorbed += energy;
+        ++nAbsorbed;
+        break;
+      }
+      dir = RayleighScatter(dir, pol);
+      ++nScattered;
+      ++nscat;
+    }
+    if(bank.IsAlive(i)) {
+      bank.SetPosition(i, pos);
+      bank.SetMomentumDirection(i, dir);
+      bank.SetPolarization(i, pol);
+      bank.SetTime(i, time);
+    }
+  }
+  bank.Compact();
+
+  if(verboseLevel > 1) {
+    G4cout << "G4OpticalPhotonTransport: " << n << " photons in "
+           << volume->GetName() << " absorbed: " << nAbsorbed
+           << " Rayleigh scatterings: " << nScattered << G4endl;
+  }
+  return absorbed;
+}
+
+G4ThreeVector 
+G4OpticalPhotonTransport::RayleighScatter(const G4ThreeVector& dir,
+                                          G4ThreeVector& pol) const
+{
+  // sampling is the same as in G4OpRayleigh::PostStepDoIt
+  G4ThreeVector newDir, newPol;
+  G4double cosTheta, sinTheta, phi, cost;
+
+  // Loop checking, same as in G4OpRayleigh
+  do {
+    cosTheta = G4UniformRand();
+    sinTheta = std::sqrt(1. - cosTheta*cosTheta);
+    if(G4UniformRand() < 0.5) { cosTheta = -cosTheta; }
+
+    phi = twopi*G4UniformRand();
+    newDir.set(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+    newDir.rotateUz(dir);
+    newDir = newDir.unit();
+
+    newPol = pol - newDir.dot(pol)*newDir;
+    newPol = newPol.unit();
+
+    if(newPol.mag() == 0.) {
+      phi = twopi*G4UniformRand();
+      newPol.set(std::cos(phi), std::sin(phi), 0.);
+      newPol.rotateUz(newDir);
+    } else if(G4UniformRand() < 0.5) { 
+      newPol = -newPol; 
+    }
+    cost = newPol.dot(pol);
+  } while (cost*cost < G4UniformRand());
+
+  pol = newPol;
+  return newDir;
+}
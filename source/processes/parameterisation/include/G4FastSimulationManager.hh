@@ -162,6 +162,11 @@ public:  // without description
 					       const G4Navigator* a = 0);
   G4VParticleChange*  InvokeAtRestDoIt();
 
+  // Creator process of the secondaries of the last DoIt, null if they
+  // are made by the fast simulation itself
+  const G4VProcess* GetSecondaryCreatorProcess() const
+  {return fFastStep.GetSecondaryCreatorProcess();}
+
   // For management
   G4bool operator == ( const G4FastSimulationManager&) const;
 
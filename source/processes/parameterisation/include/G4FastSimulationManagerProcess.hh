@@ -140,6 +140,10 @@ public:
 					      G4ForceCondition*);
   
   G4VParticleChange* AtRestDoIt(const G4Track&, const G4Step&);
+
+  // -- Creator of the secondaries: the process invoked by the model
+  // -- at the last DoIt, if any, otherwise this process:
+  const G4VProcess* GetCreatorProcess() const;
   
   
 
@@ -68,6 +68,7 @@
 #include "G4ThreeVector.hh"
 #include "G4ParticleMomentum.hh"
 class G4DynamicParticle;
+class G4VProcess;
 #include "G4VParticleChange.hh"
 #include "G4FastTrack.hh"
 
@@ -238,6 +239,12 @@ public: // with Description
   G4Track* GetSecondaryTrack(G4int);
   // Returns a pointer on the i-th secondary track created.
 
+  void SetSecondaryCreatorProcess(const G4VProcess*);
+  const G4VProcess* GetSecondaryCreatorProcess() const;
+  // Process recorded as the creator of the secondaries of this step,
+  // for a model which invokes a physics process. By default (null)
+  // the fast simulation process is recorded.
+
   //------------------------------------------------
   //
   //   Total energy deposit in the "fast Step"
@@ -368,6 +375,9 @@ private:
   // weight for event biasing mechanism:
   G4double theWeightChange;
 
+  // creator process of the secondaries, if not the fast simulation
+  const G4VProcess* fSecondaryCreatorProcess;
+
 
 public:
   // for Debug 
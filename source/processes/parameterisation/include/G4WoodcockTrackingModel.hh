@@ -0,0 +1,170 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//---------------------------------------------------------------
+//
+//  G4WoodcockTrackingModel.hh
+//
+//  Description:
+//    Fast simulation model transporting neutral particles through
+//    an envelope with Woodcock (delta) tracking.
+//
+//    Instead of stopping at every volume boundary of the envelope
+//    (e.g. the voxels of a CT phantom), flight distances are sampled
+//    with a majorant macroscopic cross section, the maximum over the
+//    materials of the envelope region of the total cross section of
+//    the discrete processes registered to the particle. At each
+//    tentative collision point the material is located and the
+//    collision is accepted as real with probability
+//    Sigma(material)/Sigma(majorant); otherwise it is virtual and
+//    the flight continues. At a real collision a process is chosen
+//    in proportion to its cross section and its PostStepDoIt() is
+//    invoked; the final state is returned through the G4FastStep.
+//    A particle reaching the envelope boundary is handed back to
+//    the standard transport.
+//
+//    Cross sections are obtained from the discrete electromagnetic
+//    (G4VEmProcess) and hadronic (G4HadronicProcess) processes
+//    through their cross section interfaces, and computed from the
+//    lifetime for decay, so that the interaction length state of the
+//    processes is not touched by the scans; other processes are
+//    ignored. Only the process invoked at a real collision is asked
+//    for its interaction length, and all processes are reset for the
+//    particle at the end of DoIt(). The majorant is tabulated lazily
+//    on a logarithmic energy grid; if a cross section larger than the
+//    majorant is met, the table is raised, the flight is rejected and
+//    sampled again from its start, and a warning is issued.
+//
+//    Usage, for the region of the phantom:
+//      new G4WoodcockTrackingModel("woodcock", phantomRegion);
+//    with fast simulation activated for gamma and/or neutron
+//    (G4FastSimulationPhysics or G4FastSimulationHelper).
+//    At a real collision the process acts in a step of null length
+//    whose points are located in the volume of the collision, and
+//    which is handed to the sensitive detector of that volume, if
+//    any, to score the local energy deposit. The step of the fast
+//    simulation process, which starts where the flight started and
+//    does not invoke hits, also carries the deposit for the energy
+//    balance seen by user stepping actions. Secondaries are recorded
+//    as created by the invoked process.
+//
+//  History:
+//      Oct 2018: First implementation.
+//
+//---------------------------------------------------------------
+
+#ifndef G4WoodcockTrackingModel_h
+#define G4WoodcockTrackingModel_h 1
+
+#include "G4VFastSimulationModel.hh"
+#include "G4Step.hh"
+
+#include <map>
+#include <vector>
+
+class G4Navigator;
+class G4VProcess;
+class G4VEmProcess;
+class G4HadronicProcess;
+class G4Material;
+class G4MaterialCutsCouple;
+class G4Region;
+
+class G4WoodcockTrackingModel : public G4VFastSimulationModel
+{
+public: // With description
+
+  G4WoodcockTrackingModel(const G4String& name);
+  G4WoodcockTrackingModel(const G4String& name, G4Region* envelope);
+  virtual ~G4WoodcockTrackingModel();
+
+  virtual G4bool IsApplicable(const G4ParticleDefinition&);
+  // Neutral particles, except optical photons and geantinos.
+
+  virtual G4bool ModelTrigger(const G4FastTrack&);
+  virtual void DoIt(const G4FastTrack&, G4FastStep&);
+
+  void SetMajorantFactor(G4double factor);
+  // Safety factor applied to the tabulated majorant (default 1.05).
+
+  void SetEnergyGrid(G4double emin, G4double emax, G4int binsPerDecade);
+  // Energy grid of the majorant tables (default 1 meV to 100 GeV,
+  // 20 bins per decade). Resets the tables.
+
+  inline G4long GetNumberOfRealCollisions() const
+  { return fNReal; }
+  inline G4long GetNumberOfVirtualCollisions() const
+  { return fNVirtual; }
+
+private:
+
+  struct MajorantTable
+  {
+    std::vector<G4VProcess*> processes;
+    std::vector<G4VEmProcess*> emProcesses;         // null if not EM
+    std::vector<G4HadronicProcess*> hadProcesses;   // null if not hadronic
+    std::vector<G4double> majorant;   // per energy bin, <0 if not computed
+  };
+
+  MajorantTable& GetMajorantTable(const G4ParticleDefinition*,
+                                  const G4Region*);
+  G4double GetMajorant(MajorantTable&, const G4Region*, G4double ekin);
+  G4double ComputeMajorant(MajorantTable&, const G4Region*, G4double ekin);
+  G4double TotalCrossSection(MajorantTable&, const G4Material*,
+                             const G4MaterialCutsCouple*);
+  G4double CrossSection(const MajorantTable&, std::size_t i,
+                        const G4Material*, const G4MaterialCutsCouple*);
+  G4VProcess* SelectProcess(MajorantTable&, G4double sigma);
+  G4double RaiseMajorant(MajorantTable&, G4double ekin, G4double sigma);
+  void SetScratchMaterial(const G4Material*, const G4MaterialCutsCouple*);
+  const G4MaterialCutsCouple* GetCouple(const G4Material*,
+                                        const G4Region*) const;
+
+  G4double fMajorantFactor;
+  G4double fLogEmin, fLogEmax, fInvLogBin;
+  G4int fNBins;
+
+  std::map<std::pair<const G4ParticleDefinition*,const G4Region*>,
+           MajorantTable> fTables;
+
+  // Scratch track and step used to query and invoke the processes
+  G4Track* fTrack;
+  G4Step fStep;
+  std::vector<G4double> fPartialSigma;
+
+  // Per-flight cache of total cross sections by material index
+  std::vector<G4double> fSigmaCache;
+  std::vector<G4long> fSigmaStamp;
+  G4long fFlight;
+
+  G4Navigator* fNavigator;
+  G4bool fNavigatorReady;
+
+  G4long fNReal, fNVirtual;
+  G4bool fWarned;
+};
+
+#endif
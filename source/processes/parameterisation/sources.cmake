@@ -19,6 +19,8 @@
 include_directories(${CLHEP_INCLUDE_DIRS})
 
 # List internal includes needed.
+include_directories(${CMAKE_SOURCE_DIR}/source/digits_hits/detector/include)
+include_directories(${CMAKE_SOURCE_DIR}/source/digits_hits/hits/include)
 include_directories(${CMAKE_SOURCE_DIR}/source/geometry/magneticfield/include)
 include_directories(${CMAKE_SOURCE_DIR}/source/geometry/management/include)
 include_directories(${CMAKE_SOURCE_DIR}/source/geometry/navigation/include)
@@ -29,6 +31,7 @@ include_directories(${CMAKE_SOURCE_DIR}/source/global/management/include)
 include_directories(${CMAKE_SOURCE_DIR}/source/intercoms/include)
 include_directories(${CMAKE_SOURCE_DIR}/source/materials/include)
 include_directories(${CMAKE_SOURCE_DIR}/source/particles/management/include)
+include_directories(${CMAKE_SOURCE_DIR}/source/processes/cuts/include)
 include_directories(${CMAKE_SOURCE_DIR}/source/processes/management/include)
 include_directories(${CMAKE_SOURCE_DIR}/source/track/include)
 
@@ -50,6 +53,7 @@ GEANT4_DEFINE_MODULE(NAME G4parameterisation
         G4FastTrack.hh
         G4GlobalFastSimulationManager.hh
         G4VFastSimulationModel.hh
+        G4WoodcockTrackingModel.hh
     SOURCES
         G4FastSimulationHelper.cc
         G4FastSimulationManager.cc
@@ -59,9 +63,16 @@ GEANT4_DEFINE_MODULE(NAME G4parameterisation
         G4FastTrack.cc
         G4GlobalFastSimulationManager.cc
         G4VFastSimulationModel.cc
+        G4WoodcockTrackingModel.cc
     GRANULAR_DEPENDENCIES
+        G4cuts
+        G4detector
+        G4emutils
         G4geometrymng
         G4globman
+        G4hadronic_mgt
+        G4hadronic_xsect
+        G4hits
         G4intercoms
         G4magneticfield
         G4materials
@@ -71,6 +82,7 @@ GEANT4_DEFINE_MODULE(NAME G4parameterisation
         G4track
         G4volumes
     GLOBAL_DEPENDENCIES
+        G4digits_hits
         G4geometry
         G4global
         G4intercoms
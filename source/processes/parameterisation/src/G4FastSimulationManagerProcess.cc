@@ -408,6 +408,14 @@ G4VParticleChange* G4FastSimulationManagerProcess::AtRestDoIt(const G4Track&, co
 }
 
 
+const G4VProcess* G4FastSimulationManagerProcess::GetCreatorProcess() const
+{
+  const G4VProcess* creator = fFastSimulationManager ?
+    fFastSimulationManager->GetSecondaryCreatorProcess() : nullptr;
+  return creator ? creator : this;
+}
+
+
 void G4FastSimulationManagerProcess::Verbose() const
 {
   /*  G4cout << "     >>>>> Trigger Status : ";
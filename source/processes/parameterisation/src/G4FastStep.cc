@@ -78,6 +78,9 @@ void G4FastStep::Initialize(const G4FastTrack& fastTrack)
 
   // event biasing weigth:
   theWeightChange        = currentTrack.GetWeight();
+
+  // secondaries are made by the fast simulation by default:
+  fSecondaryCreatorProcess = nullptr;
 }  
 
 //----------------------------------------
@@ -301,7 +304,8 @@ G4FastStep::G4FastStep()
     theTimeChange      ( 0.0     ),
     theProperTimeChange( 0.0     ),
     fFastTrack         ( nullptr ),
-    theWeightChange    ( 0.0     )
+    theWeightChange    ( 0.0     ),
+    fSecondaryCreatorProcess( nullptr )
 {
   if (verboseLevel>2)
   {
@@ -345,6 +349,7 @@ G4FastStep & G4FastStep::operator=(const G4FastStep &right)
      theSteppingControlFlag        = right.theSteppingControlFlag;
      theWeightChange               = right.theWeightChange;
      fFastTrack                    = right.fFastTrack;
+     fSecondaryCreatorProcess      = right.fSecondaryCreatorProcess;
    }
    return *this;
 }
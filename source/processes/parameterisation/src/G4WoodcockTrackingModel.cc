@@ -0,0 +1,519 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//---------------------------------------------------------------
+//
+//  G4WoodcockTrackingModel.cc
+//
+//  Description:
+//    Woodcock (delta) tracking of neutral particles in an envelope.
+//
+//  History:
+//      Oct 2018: First implementation.
+//
+//---------------------------------------------------------------
+
+#include "G4WoodcockTrackingModel.hh"
+
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4TouchableHistory.hh"
+#include "G4VSensitiveDetector.hh"
+#include "G4Navigator.hh"
+#include "G4TransportationManager.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4MaterialCutsCouple.hh"
+#include "G4Material.hh"
+#include "G4Region.hh"
+#include "G4VSolid.hh"
+#include "G4VProcess.hh"
+#include "G4VEmProcess.hh"
+#include "G4HadronicProcess.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4VParticleChange.hh"
+#include "G4DynamicParticle.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Log.hh"
+#include "G4Exp.hh"
+#include "Randomize.hh"
+
+namespace
+{
+  // Number of sub-intervals sampled in each bin of a majorant table
+  const G4int kMajorantSampling = 4;
+}
+
+G4WoodcockTrackingModel::G4WoodcockTrackingModel(const G4String& name)
+  : G4VFastSimulationModel(name),
+    fMajorantFactor(1.05), fLogEmin(0.), fLogEmax(0.), fInvLogBin(0.),
+    fNBins(0), fTrack(0), fFlight(0), fNavigator(new G4Navigator()),
+    fNavigatorReady(false), fNReal(0), fNVirtual(0), fWarned(false)
+{
+  SetEnergyGrid(1.e-3*CLHEP::eV, 100.*CLHEP::GeV, 20);
+}
+
+G4WoodcockTrackingModel::G4WoodcockTrackingModel(const G4String& name,
+                                                 G4Region* envelope)
+  : G4VFastSimulationModel(name, envelope),
+    fMajorantFactor(1.05), fLogEmin(0.), fLogEmax(0.), fInvLogBin(0.),
+    fNBins(0), fTrack(0), fFlight(0), fNavigator(new G4Navigator()),
+    fNavigatorReady(false), fNReal(0), fNVirtual(0), fWarned(false)
+{
+  SetEnergyGrid(1.e-3*CLHEP::eV, 100.*CLHEP::GeV, 20);
+}
+
+G4WoodcockTrackingModel::~G4WoodcockTrackingModel()
+{
+  delete fNavigator;
+}
+
+G4bool
+G4WoodcockTrackingModel::IsApplicable(const G4ParticleDefinition& particle)
+{
+  return particle.GetPDGCharge() == 0.
+      && particle.GetParticleName() != "opticalphoton"
+      && particle.GetParticleType() != "geantino";
+}
+
+G4bool G4WoodcockTrackingModel::ModelTrigger(const G4FastTrack& fastTrack)
+{
+  // Leaving particles are given back to the standard transport
+  return !fastTrack.OnTheBoundaryButExiting();
+}
+
+void G4WoodcockTrackingModel::SetMajorantFactor(G4double factor)
+{
+  fMajorantFactor = factor;
+  fTables.clear();
+}
+
+void G4WoodcockTrackingModel::SetEnergyGrid(G4double emin, G4double emax,
+                                            G4int binsPerDecade)
+{
+  fLogEmin = G4Log(emin);
+  fLogEmax = G4Log(emax);
+  fNBins = G4int(std::ceil(std::log10(emax/emin)*binsPerDecade));
+  if(fNBins < 1) { fNBins = 1; }
+  fInvLogBin = fNBins/(fLogEmax - fLogEmin);
+  fTables.clear();
+}
+
+void G4WoodcockTrackingModel::DoIt(const G4FastTrack& fastTrack,
+                                   G4FastStep& fastStep)
+{
+  const G4Track* primary = fastTrack.GetPrimaryTrack();
+  const G4Region* region = fastTrack.GetEnvelope();
+
+  G4VPhysicalVolume* world = G4TransportationManager::
+    GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume();
+  if(fNavigator->GetWorldVolume() != world)
+  {
+    fNavigator->SetWorldVolume(world);
+    fNavigatorReady = false;
+  }
+
+  // Scratch copy of the primary, through which processes are queried
+  fTrack = new G4Track(new G4DynamicParticle(*primary->GetDynamicParticle()),
+                       primary->GetGlobalTime(), primary->GetPosition());
+  fTrack->SetTrackID(primary->GetTrackID());
+  fTrack->SetParentID(primary->GetParentID());
+  fTrack->SetWeight(primary->GetWeight());
+  fTrack->SetTouchableHandle(primary->GetTouchableHandle());
+  fTrack->SetStep(&fStep);
+  fStep.InitializeStep(fTrack);
+
+  MajorantTable& table =
+    GetMajorantTable(primary->GetDefinition(), region);
+  const G4double ekin = primary->GetKineticEnergy();
+  G4double sigmaMax = GetMajorant(table, region, ekin);
+
+  const G4double distOut = fastTrack.GetEnvelopeSolid()->
+    DistanceToOut(fastTrack.GetPrimaryTrackLocalPosition(),
+                  fastTrack.GetPrimaryTrackLocalDirection());
+  const G4ThreeVector& x0 = primary->GetPosition();
+  const G4ThreeVector& dir = primary->GetMomentumDirection();
+
+  // Flight from collision to collision with the majorant, until a real
+  // collision or the envelope boundary. The flight length strictly
+  // increases, and a flight is restarted only when the majorant is
+  // raised above the cross section of one more material, so the loop
+  // ends.
+  ++fFlight;
+  G4double length = 0.;
+  G4ThreeVector x = x0;
+  G4VProcess* process = 0;
+  while(sigmaMax > 0.)
+  {
+    length -= G4Log(G4UniformRand())/sigmaMax;
+    if(length >= distOut) { break; }
+
+    x = x0 + length*dir;
+    G4VPhysicalVolume* volume =
+      fNavigator->LocateGlobalPointAndSetup(x, &dir, fNavigatorReady, false);
+    fNavigatorReady = true;
+    if(!volume) { break; }
+
+    G4Material* material = volume->GetLogicalVolume()->GetMaterial();
+    const std::size_t idx = material->GetIndex();
+    if(fSigmaStamp[idx] != fFlight)
+    {
+      fSigmaCache[idx] = TotalCrossSection(table, material,
+                                           GetCouple(material, region));
+      fSigmaStamp[idx] = fFlight;
+    }
+    const G4double sigma = fSigmaCache[idx];
+
+    if(sigma > sigmaMax)
+    {
+      // The flight so far was sampled with a too small majorant: it is
+      // rejected and sampled again from its start with the raised one
+      sigmaMax = RaiseMajorant(table, ekin, sigma);
+      length = 0.;
+      x = x0;
+      continue;
+    }
+    if(G4UniformRand()*sigmaMax < sigma)
+    {
+      // Partial cross sections of this material for the process choice
+      TotalCrossSection(table, material, GetCouple(material, region));
+      process = SelectProcess(table, sigma);
+      break;
+    }
+    ++fNVirtual;
+  }
+  if(!process) { length = distOut; x = x0 + length*dir; }
+
+  const G4double dt = length/primary->GetVelocity();
+  const G4double mass = primary->GetDynamicParticle()->GetMass();
+  fastStep.ProposePrimaryTrackPathLength(length);
+  fastStep.ProposePrimaryTrackFinalPosition(x, false);
+  fastStep.ProposePrimaryTrackFinalTime(primary->GetGlobalTime() + dt);
+  fastStep.ProposePrimaryTrackFinalProperTime(primary->GetProperTime()
+    + dt*mass/primary->GetTotalEnergy());
+
+  if(process)
+  {
+    ++fNReal;
+
+    // Invoke the selected process in a step of null length at the
+    // collision point, located in the volume (e.g. the voxel) where
+    // the navigator found the collision
+    const G4double time = primary->GetGlobalTime() + dt;
+    G4TouchableHandle touchable = fNavigator->CreateTouchableHistory();
+    G4VSensitiveDetector* sensitive =
+      touchable->GetVolume()->GetLogicalVolume()->GetSensitiveDetector();
+    fTrack->SetPosition(x);
+    fTrack->SetGlobalTime(time);
+    fTrack->SetTouchableHandle(touchable);
+    fTrack->SetNextTouchableHandle(touchable);
+    G4StepPoint* points[2] = { fStep.GetPreStepPoint(),
+                               fStep.GetPostStepPoint() };
+    for(G4int k=0; k<2; ++k)
+    {
+      points[k]->SetPosition(x);
+      points[k]->SetGlobalTime(time);
+      points[k]->SetTouchableHandle(touchable);
+      points[k]->SetSensitiveDetector(sensitive);
+    }
+    fStep.GetPostStepPoint()->SetProcessDefinedStep(process);
+    fStep.SetStepLength(0.);
+
+    G4ForceCondition condition = NotForced;
+    process->PostStepGetPhysicalInteractionLength(*fTrack, 0., &condition);
+    G4VParticleChange* change = process->PostStepDoIt(*fTrack, fStep);
+    change->UpdateStepForPostStep(&fStep);
+
+    const G4StepPoint* post = fStep.GetPostStepPoint();
+    if(change->GetTrackStatus() == fStopAndKill)
+    {
+      fastStep.KillPrimaryTrack();
+    }
+    else
+    {
+      fastStep.ProposePrimaryTrackFinalKineticEnergyAndDirection(
+        post->GetKineticEnergy(), post->GetMomentumDirection(), false);
+      fastStep.ProposePrimaryTrackFinalPolarization(post->GetPolarization(),
+                                                    false);
+    }
+    // The fast step, which does not invoke hits, keeps the energy
+    // balance; hits are made from the step at the collision point
+    fastStep.ProposeTotalEnergyDeposited(change->GetLocalEnergyDeposit());
+    if(sensitive && fStep.GetTotalEnergyDeposit() > 0.)
+    {
+      sensitive->Hit(&fStep);
+    }
+
+    const G4int nSecondaries = change->GetNumberOfSecondaries();
+    fastStep.SetNumberOfSecondaryTracks(nSecondaries);
+    fastStep.SetSecondaryCreatorProcess(process);
+    for(G4int i=0; i<nSecondaries; ++i)
+    {
+      G4Track* secondary = change->GetSecondary(i);
+      G4Track* track =
+        fastStep.CreateSecondaryTrack(*secondary->GetDynamicParticle(),
+                                      secondary->GetPosition(),
+                                      secondary->GetGlobalTime(), false);
+      track->SetWeight(secondary->GetWeight());
+      track->SetCreatorModelIndex(secondary->GetCreatorModelID());
+      track->SetTouchableHandle(touchable);
+      delete secondary;
+    }
+    change->Clear();
+  }
+
+  // The invoked process was asked for its interaction length at the
+  // collision point; the processes start afresh for the particle
+  for(std::size_t i=0; i<table.processes.size(); ++i)
+  {
+    table.processes[i]->StartTracking(fTrack);
+  }
+
+  delete fTrack;
+  fTrack = 0;
+}
+
+G4WoodcockTrackingModel::MajorantTable&
+G4WoodcockTrackingModel::GetMajorantTable(const G4ParticleDefinition* particle,
+                                          const G4Region* region)
+{
+  const std::size_t nMaterials = G4Material::GetNumberOfMaterials();
+  if(fSigmaCache.size() < nMaterials)
+  {
+    fSigmaCache.resize(nMaterials, 0.);
+    fSigmaStamp.resize(nMaterials, -1);
+  }
+
+  std::pair<const G4ParticleDefinition*,const G4Region*> key(particle,region);
+  std::map<std::pair<const G4ParticleDefinition*,const G4Region*>,
+           MajorantTable>::iterator pos = fTables.find(key);
+  if(pos != fTables.end()) { return pos->second; }
+
+  MajorantTable& table = fTables[key];
+  table.majorant.assign(fNBins, -1.);
+
+  // Discrete processes with a physical interaction length
+  G4ProcessVector* pVector = particle->GetProcessManager()
+    ->GetPostStepProcessVector(typeGPIL);
+  for(G4int i=0; i<pVector->entries(); ++i)
+  {
+    G4VProcess* proc = (*pVector)[i];
+    if(!proc) { continue; }
+    const G4ProcessType type = proc->GetProcessType();
+    G4VEmProcess* em = 0;
+    G4HadronicProcess* had = 0;
+    if(type == fElectromagnetic)
+    {
+      em = dynamic_cast<G4VEmProcess*>(proc);
+      if(!em) { continue; }
+    }
+    else if(type == fHadronic || type == fPhotolepton_hadron)
+    {
+      had = dynamic_cast<G4HadronicProcess*>(proc);
+      if(!had) { continue; }
+    }
+    else if(type != fDecay) { continue; }
+    table.processes.push_back(proc);
+    table.emProcesses.push_back(em);
+    table.hadProcesses.push_back(had);
+  }
+  return table;
+}
+
+G4double G4WoodcockTrackingModel::GetMajorant(MajorantTable& table,
+                                              const G4Region* region,
+                                              G4double ekin)
+{
+  G4double majorant;
+  const G4double x = (G4Log(ekin) - fLogEmin)*fInvLogBin;
+  if(x < 0. || x >= fNBins)
+  {
+    majorant = fMajorantFactor*ComputeMajorant(table, region, ekin);
+  }
+  else
+  {
+    const G4int bin = G4int(x);
+    if(table.majorant[bin] < 0.)
+    {
+      G4double sigma = 0.;
+      for(G4int k=0; k<=kMajorantSampling; ++k)
+      {
+        const G4double e =
+          G4Exp(fLogEmin + (bin + G4double(k)/kMajorantSampling)/fInvLogBin);
+        sigma = std::max(sigma, ComputeMajorant(table, region, e));
+      }
+      table.majorant[bin] = fMajorantFactor*sigma;
+    }
+    majorant = table.majorant[bin];
+  }
+  fTrack->SetKineticEnergy(ekin);
+  return majorant;
+}
+
+G4double G4WoodcockTrackingModel::ComputeMajorant(MajorantTable& table,
+                                                  const G4Region* region,
+                                                  G4double ekin)
+{
+  fTrack->SetKineticEnergy(ekin);
+  G4double sigmaMax = 0.;
+  std::vector<G4Material*>::const_iterator mat =
+    region->GetMaterialIterator();
+  for(std::size_t i=0; i<region->GetNumberOfMaterials(); ++i, ++mat)
+  {
+    sigmaMax = std::max(sigmaMax,
+      TotalCrossSection(table, *mat, GetCouple(*mat, region)));
+  }
+  return sigmaMax;
+}
+
+G4double
+G4WoodcockTrackingModel::TotalCrossSection(MajorantTable& table,
+                                           const G4Material* material,
+                                           const G4MaterialCutsCouple* couple)
+{
+  SetScratchMaterial(material, couple);
+  const std::size_t nProcesses = table.processes.size();
+  fPartialSigma.resize(nProcesses);
+  G4double sigma = 0.;
+  for(std::size_t i=0; i<nProcesses; ++i)
+  {
+    fPartialSigma[i] = CrossSection(table, i, material, couple);
+    sigma += fPartialSigma[i];
+  }
+  return sigma;
+}
+
+G4double
+G4WoodcockTrackingModel::CrossSection(const MajorantTable& table,
+                                      std::size_t i,
+                                      const G4Material* material,
+                                      const G4MaterialCutsCouple* couple)
+{
+  // The processes are queried through interfaces which leave their
+  // interaction length state, used for the tracking of the particle,
+  // unchanged
+  const G4double ekin = fTrack->GetKineticEnergy();
+  G4double sigma = 0.;
+  if(table.emProcesses[i])
+  {
+    if(couple)
+    {
+      sigma = table.emProcesses[i]->CrossSectionPerVolume(ekin, couple);
+    }
+  }
+  else if(table.hadProcesses[i])
+  {
+    G4HadronicProcess* had = table.hadProcesses[i];
+    sigma = had->CrossSectionFactor()*had->GetCrossSectionDataStore()->
+      ComputeCrossSection(fTrack->GetDynamicParticle(), material);
+  }
+  else
+  {
+    // Decay in flight, as in G4Decay::GetMeanFreePath(); particles
+    // without a lifetime or at rest are left to the standard transport
+    const G4DynamicParticle* dp = fTrack->GetDynamicParticle();
+    const G4ParticleDefinition* particle = dp->GetDefinition();
+    const G4double ctau = CLHEP::c_light*particle->GetPDGLifeTime();
+    const G4double p = dp->GetTotalMomentum();
+    if(!particle->GetPDGStable() && ctau > DBL_MIN && p > DBL_MIN)
+    {
+      sigma = dp->GetMass()/(p*ctau);
+    }
+  }
+  return std::max(sigma, 0.);
+}
+
+G4VProcess* G4WoodcockTrackingModel::SelectProcess(MajorantTable& table,
+                                                   G4double sigma)
+{
+  G4VProcess* selected = 0;
+  G4double r = G4UniformRand()*sigma;
+  for(std::size_t i=0; i<table.processes.size(); ++i)
+  {
+    if(fPartialSigma[i] <= 0.) { continue; }
+    selected = table.processes[i];
+    r -= fPartialSigma[i];
+    if(r <= 0.) { break; }
+  }
+  return selected;
+}
+
+G4double G4WoodcockTrackingModel::RaiseMajorant(MajorantTable& table,
+                                                G4double ekin, G4double sigma)
+{
+  const G4double majorant = fMajorantFactor*sigma;
+  const G4double x = (G4Log(ekin) - fLogEmin)*fInvLogBin;
+  if(x >= 0. && x < fNBins)
+  {
+    table.majorant[G4int(x)] = majorant;
+  }
+  if(!fWarned)
+  {
+    fWarned = true;
+    G4ExceptionDescription ed;
+    ed << "Model `" << GetName() << "': cross section "
+       << sigma*CLHEP::cm << " /cm at " << ekin/CLHEP::MeV
+       << " MeV exceeds the majorant; the majorant is raised and the"
+       << " flight is sampled again. Flights sampled before with the"
+       << " smaller majorant are biased: consider a larger majorant"
+       << " factor or a finer energy grid."
+       << " Further occurrences are not reported.";
+    G4Exception("G4WoodcockTrackingModel::DoIt()", "FastSim012",
+                JustWarning, ed);
+  }
+  return majorant;
+}
+
+void
+G4WoodcockTrackingModel::SetScratchMaterial(const G4Material* material,
+                                            const G4MaterialCutsCouple* couple)
+{
+  G4Material* mat = const_cast<G4Material*>(material);
+  fStep.GetPreStepPoint()->SetMaterial(mat);
+  fStep.GetPreStepPoint()->SetMaterialCutsCouple(couple);
+  fStep.GetPostStepPoint()->SetMaterial(mat);
+  fStep.GetPostStepPoint()->SetMaterialCutsCouple(couple);
+}
+
+const G4MaterialCutsCouple*
+G4WoodcockTrackingModel::GetCouple(const G4Material* material,
+                                   const G4Region* region) const
+{
+  G4ProductionCutsTable* cutsTable =
+    G4ProductionCutsTable::GetProductionCutsTable();
+  const G4MaterialCutsCouple* couple =
+    cutsTable->GetMaterialCutsCouple(material, region->GetProductionCuts());
+  if(!couple)
+  {
+    // Material placed in a daughter region: any couple of the material
+    for(std::size_t i=0; i<cutsTable->GetTableSize(); ++i)
+    {
+      const G4MaterialCutsCouple* c = cutsTable->GetMaterialCutsCouple(i);
+      if(c->GetMaterial() == material) { couple = c; break; }
+    }
+  }
+  return couple;
+}
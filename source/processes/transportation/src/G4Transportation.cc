@@ -655,7 +655,7 @@ PostStepGetPhysicalInteractionLength( const G4Track&,
 G4VParticleChange* G4Transportation::PostStepDoIt( const G4Track& track,
                                                    const G4Step& )
 {
-   G4TouchableHandle retCurrentTouchable ;   // The one to return
+   const G4TouchableHandle* retCurrentTouchable = 0;  // The one to return
    G4bool isLastStep= false; 
 
   // Initialize ParticleChange  (by setting all its members equal
@@ -686,7 +686,7 @@ G4VParticleChange* G4Transportation::PostStepDoIt( const G4Track& track,
     {
        fParticleChange.ProposeTrackStatus( fStopAndKill ) ;
     }
-    retCurrentTouchable = fCurrentTouchableHandle ;
+    retCurrentTouchable = &fCurrentTouchableHandle ;
     fParticleChange.SetTouchableHandle( fCurrentTouchableHandle ) ;
 
     // Update the Step flag which identifies the Last Step in a volume
@@ -708,7 +708,7 @@ G4VParticleChange* G4Transportation::PostStepDoIt( const G4Track& track,
     //  It must be fCurrentTouchable too ??
     //
     fParticleChange.SetTouchableHandle( track.GetTouchableHandle() ) ;
-    retCurrentTouchable = track.GetTouchableHandle() ;
+    retCurrentTouchable = &track.GetTouchableHandle() ;
 
     isLastStep= false;
   }         // endif ( fGeometryLimitedStep ) 
@@ -717,7 +717,7 @@ G4VParticleChange* G4Transportation::PostStepDoIt( const G4Track& track,
   fParticleChange.ProposeFirstStepInVolume(fFirstStepInVolume);
   fParticleChange.ProposeLastStepInVolume(isLastStep);    
 
-  const G4VPhysicalVolume* pNewVol = retCurrentTouchable->GetVolume() ;
+  const G4VPhysicalVolume* pNewVol = (*retCurrentTouchable)->GetVolume() ;
   const G4Material* pNewMaterial   = 0 ;
   const G4VSensitiveDetector* pNewSensitiveDetector   = 0 ;
                                                                                        
@@ -756,7 +756,7 @@ G4VParticleChange* G4Transportation::PostStepDoIt( const G4Track& track,
   // this must always be done because the particle change always
   // uses this value to overwrite the current touchable pointer.
   //
-  fParticleChange.SetTouchableHandle(retCurrentTouchable) ;
+  fParticleChange.SetTouchableHandle(*retCurrentTouchable) ;
 
   return &fParticleChange ;
 }
@@ -0,0 +1,80 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+//---------------------------------------------------------------
+//
+// G4VDeferredTrackGenerator
+//
+// Class Description:
+//
+//  Abstract class for producers of secondary tracks which are not
+// created at the step where they originate but kept as compact
+// records and turned into G4Tracks later (e.g. optical photons
+// produced by G4Cerenkov and G4Scintillation in deferred mode).
+//
+//  Concrete generators are thread local; they register themselves
+// at construction. G4EventManager asks registered generators for
+// tracks each time the urgent and waiting stacks become empty, so
+// tracks are created in chunks whose size is decided by the generator,
+// and calls Clear() at the beginning and at abortion of an event.
+//
+//---------------------------------------------------------------
+
+#ifndef G4VDeferredTrackGenerator_h
+#define G4VDeferredTrackGenerator_h 1
+
+#include "globals.hh"
+#include "G4TrackVector.hh"
+#include <vector>
+
+class G4VDeferredTrackGenerator
+{
+  public:
+    G4VDeferredTrackGenerator();
+    virtual ~G4VDeferredTrackGenerator();
+
+    virtual G4bool HasTracks() const = 0;
+    // True if the generator has records not yet converted into tracks
+
+    virtual void GenerateTracks(G4TrackVector& tracks) = 0;
+    // Appends the next chunk of tracks; parent ID, touchable and
+    // position have to be set, track ID is assigned by the kernel
+
+    virtual void Clear() = 0;
+    // Drops all pending records
+
+    static const std::vector<G4VDeferredTrackGenerator*>& GetGenerators();
+    // Generators registered in this thread
+
+  private:
+    G4VDeferredTrackGenerator(const G4VDeferredTrackGenerator&) = delete;
+    G4VDeferredTrackGenerator& operator=
+    (const G4VDeferredTrackGenerator&) = delete;
+
+    static G4ThreadLocal std::vector<G4VDeferredTrackGenerator*>* fGenerators;
+};
+
+#endif
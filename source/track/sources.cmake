@@ -62,6 +62,7 @@ GEANT4_DEFINE_MODULE(NAME G4track
         G4VParticleChange.icc
         G4VelocityTable.hh
         G4VAuxiliaryTrackInformation.hh
+        G4VDeferredTrackGenerator.hh
         G4VUserTrackInformation.hh
         trkdefs.hh
     SOURCES
@@ -78,6 +79,7 @@ GEANT4_DEFINE_MODULE(NAME G4track
         G4VParticleChange.cc
         G4VelocityTable.cc
         G4VAuxiliaryTrackInformation.cc
+        G4VDeferredTrackGenerator.cc
         G4VUserTrackInformation.cc
     GRANULAR_DEPENDENCIES
         G4geometrymng
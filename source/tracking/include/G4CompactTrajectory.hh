@@ -0,0 +1,170 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//---------------------------------------------------------------
+//
+// G4CompactTrajectory.hh
+//
+// class description:
+//   This class represents the trajectory of a particle tracked,
+//   stored in a compact, columnar form. It is selected with
+//   /tracking/storeTrajectory 5.
+//   Points are not allocated one by one. Their position, global
+//   time, kinetic energy, energy deposit and the index of the
+//   process which limited the step are appended to the columns of
+//   blocks shared by all compact trajectories built in a thread,
+//   which amounts to 42 bytes per point. A trajectory refers to its
+//   points through a short list of contiguous ranges in these
+//   blocks; a block is released with the last trajectory using it.
+//   GetPoint() fills a single G4CompactTrajectoryPoint owned by the
+//   trajectory, which stays valid until the next GetPoint() call.
+//   The columns can be written to a binary stream without building
+//   any point with StreamOut().
+//
+//   Created : 19/Oct/2018
+//
+// ---------------------------------------------------------------
+
+#ifndef G4CompactTrajectory_h
+#define G4CompactTrajectory_h 1
+
+#include <vector>
+
+#include "trkgdefs.hh"
+#include "G4VTrajectory.hh"
+#include "G4CompactTrajectoryPoint.hh"
+#include "G4Allocator.hh"
+#include "G4ios.hh"
+#include "globals.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Track.hh"
+#include "G4Step.hh"
+
+class G4CompactTrajectoryBlock;
+
+class G4CompactTrajectory : public G4VTrajectory
+{
+
+public: // with description
+
+  // Constructor/Destructor
+  G4CompactTrajectory();
+  G4CompactTrajectory(const G4Track* aTrack);
+  G4CompactTrajectory(G4CompactTrajectory &);
+  virtual ~G4CompactTrajectory();
+
+  // Operators
+  inline void* operator new(size_t);
+  inline void  operator delete(void*);
+  inline int operator == (const G4CompactTrajectory& right) const
+  { return (this==&right); }
+
+  // Get/Set functions
+  inline G4int GetTrackID() const
+  { return fTrackID; }
+  inline G4int GetParentID() const
+  { return fParentID; }
+  inline G4String GetParticleName() const
+  { return fpParticleDefinition ?
+           fpParticleDefinition->GetParticleName() : G4String(""); }
+  inline G4double GetCharge() const
+  { return fpParticleDefinition ? fpParticleDefinition->GetPDGCharge() : 0.; }
+  inline G4int GetPDGEncoding() const
+  { return fpParticleDefinition ? fpParticleDefinition->GetPDGEncoding() : 0; }
+  inline G4double GetInitialKineticEnergy() const
+  { return initialKineticEnergy; }
+  inline G4ThreeVector GetInitialMomentum() const
+  { return initialMomentum; }
+  inline G4ParticleDefinition* GetParticleDefinition() const
+  { return fpParticleDefinition; }
+
+  // Other member functions
+  virtual void ShowTrajectory(std::ostream& os=G4cout) const;
+  virtual void DrawTrajectory() const;
+  virtual void AppendStep(const G4Step* aStep);
+  virtual int GetPointEntries() const { return fNPoints; }
+  virtual G4VTrajectoryPoint* GetPoint(G4int i) const;
+  virtual void MergeTrajectory(G4VTrajectory* secondTrajectory);
+
+  // Direct access to the columns, without going through a point
+  G4ThreeVector GetPointPosition(G4int i) const;
+  G4double GetPointGlobalTime(G4int i) const;
+  G4double GetPointKineticEnergy(G4int i) const;
+
+  void StreamOut(std::ostream& os) const;
+  // Writes the trajectory in binary form: a header with track ID,
+  // parent ID, PDG encoding, charge, initial kinetic energy and
+  // momentum and number of points, the table of process names used,
+  // then the columns x, y, z, t (double), kinetic energy, energy
+  // deposit (float) and process index (short, -1 for none).
+
+  virtual const std::map<G4String,G4AttDef>* GetAttDefs() const;
+  virtual std::vector<G4AttValue>* CreateAttValues() const;
+
+  static void ReleaseBlock();
+  // Gives up the block being filled by the calling thread, which is
+  // deleted once no trajectory uses it. Called at the end of the
+  // thread by G4TrackingManager.
+
+private:
+
+  struct Segment
+  {
+    G4CompactTrajectoryBlock* block;
+    G4int first;
+    G4int count;
+  };
+
+  void AppendPoint(const G4ThreeVector& pos, G4double time, G4double ekin,
+                   G4double edep, const G4VProcess* process);
+  const Segment& Locate(G4int i, G4int& index) const;
+
+  std::vector<Segment>  fSegments;
+  G4int                 fNPoints;
+  G4int                 fTrackID;
+  G4int                 fParentID;
+  G4ParticleDefinition* fpParticleDefinition;
+  G4double              initialKineticEnergy;
+  G4ThreeVector         initialMomentum;
+
+  mutable G4CompactTrajectoryPoint fPoint;
+};
+
+extern G4TRACKING_DLL
+G4Allocator<G4CompactTrajectory>*& aCompactTrajectoryAllocator();
+
+inline void* G4CompactTrajectory::operator new(size_t)
+{
+  if (!aCompactTrajectoryAllocator())
+  { aCompactTrajectoryAllocator() = new G4Allocator<G4CompactTrajectory>; }
+  return (void*)aCompactTrajectoryAllocator()->MallocSingle();
+}
+
+inline void G4CompactTrajectory::operator delete(void* aTrajectory)
+{
+  aCompactTrajectoryAllocator()->FreeSingle((G4CompactTrajectory*)aTrajectory);
+}
+
+#endif
@@ -0,0 +1,95 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//---------------------------------------------------------------
+//
+// G4CompactTrajectoryPoint.hh
+//
+// class description:
+//   This class is the trajectory point handed out by
+//   G4CompactTrajectory::GetPoint(). The points of a compact
+//   trajectory are not stored as objects: the trajectory fills one
+//   instance of this class from its columnar storage on request.
+//   The returned point is therefore only valid until the next call
+//   of GetPoint() on the same trajectory. It includes
+//     1) Position,
+//     2) Global time,
+//     3) Kinetic energy at the point,
+//     4) Total energy deposit of the step ending at the point,
+//     5) Process defining the end of the step.
+//
+//   Created : 19/Oct/2018
+//
+// ---------------------------------------------------------------
+
+#ifndef G4CompactTrajectoryPoint_h
+#define G4CompactTrajectoryPoint_h 1
+
+#include "globals.hh"
+#include "G4VTrajectoryPoint.hh"
+#include "G4ThreeVector.hh"
+
+class G4VProcess;
+
+class G4CompactTrajectoryPoint : public G4VTrajectoryPoint
+{
+
+public: // with description
+
+  // Constructor/Destructor
+  G4CompactTrajectoryPoint();
+  virtual ~G4CompactTrajectoryPoint();
+
+  // Get/Set functions
+  inline const G4ThreeVector GetPosition() const
+  { return fPosition; }
+  inline G4double GetGlobalTime() const
+  { return fGlobalTime; }
+  inline G4double GetKineticEnergy() const
+  { return fKineticEnergy; }
+  inline G4double GetTotalEnergyDeposit() const
+  { return fTotEDep; }
+  inline const G4VProcess* GetProcess() const
+  { return fpProcess; }
+
+  inline void Set(const G4ThreeVector& pos, G4double time, G4double ekin,
+                  G4double edep, const G4VProcess* process)
+  { fPosition = pos; fGlobalTime = time; fKineticEnergy = ekin;
+    fTotEDep = edep; fpProcess = process; }
+
+  // Get methods for HepRep style attributes
+  virtual const std::map<G4String,G4AttDef>* GetAttDefs() const;
+  virtual std::vector<G4AttValue>* CreateAttValues() const;
+
+private:
+
+  G4ThreeVector fPosition;
+  G4double fGlobalTime;
+  G4double fKineticEnergy;
+  G4double fTotEDep;
+  const G4VProcess* fpProcess;
+};
+
+#endif
@@ -47,6 +47,8 @@ GEANT4_DEFINE_MODULE(NAME G4tracking
         G4AdjointCrossSurfChecker.hh
         G4AdjointSteppingAction.hh
         G4AdjointTrackingAction.hh
+        G4CompactTrajectory.hh
+        G4CompactTrajectoryPoint.hh
         G4RichTrajectory.hh
         G4RichTrajectoryPoint.hh
         G4SmoothTrajectory.hh
@@ -69,6 +71,8 @@ GEANT4_DEFINE_MODULE(NAME G4tracking
         G4AdjointCrossSurfChecker.cc
         G4AdjointSteppingAction.cc
         G4AdjointTrackingAction.cc
+        G4CompactTrajectory.cc
+        G4CompactTrajectoryPoint.cc
         G4RichTrajectory.cc
         G4RichTrajectoryPoint.cc
         G4SmoothTrajectory.cc
@@ -0,0 +1,465 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//---------------------------------------------------------------
+//
+// G4CompactTrajectory.cc
+//
+//   Created : 19/Oct/2018
+//
+// ---------------------------------------------------------------
+
+#include "G4CompactTrajectory.hh"
+#include "G4VProcess.hh"
+#include "G4AttDefStore.hh"
+#include "G4AttDef.hh"
+#include "G4AttValue.hh"
+#include "G4UIcommand.hh"
+#include "G4UnitsTable.hh"
+
+#include <atomic>
+
+#ifdef G4ATTDEBUG
+#include "G4AttCheck.hh"
+#endif
+
+// Columnar storage of trajectory points. The block being filled is
+// referenced by the thread which fills it, and each full block by the
+// trajectories using it; the last one releasing a block deletes it,
+// possibly from another thread.
+class G4CompactTrajectoryBlock
+{
+  public:
+
+    enum { kSize = 4096, kMaxProcesses = 512 };
+
+    G4CompactTrajectoryBlock() : fNProcesses(0), fUsed(0), fNRef(1) {}
+
+    static G4CompactTrajectoryBlock* GetBlockToFill(const G4VProcess* process)
+    {
+      // A new block is started when the current one is full, or when
+      // its table of processes is full, as the table cannot grow
+      G4CompactTrajectoryBlock*& current = Current();
+      if(current && (current->fUsed == kSize ||
+         (current->fNProcesses == kMaxProcesses &&
+          current->FindProcess(process) < 0)))
+      {
+        current->Release();
+        current = nullptr;
+      }
+      if(!current) { current = new G4CompactTrajectoryBlock; }
+      return current;
+    }
+
+    static void ReleaseBlockToFill()
+    {
+      G4CompactTrajectoryBlock*& current = Current();
+      if(current)
+      {
+        current->Release();
+        current = nullptr;
+      }
+    }
+
+    G4int Append(const G4ThreeVector& pos, G4double time, G4double ekin,
+                 G4double edep, const G4VProcess* process)
+    {
+      G4int i = fUsed++;
+      fX[i] = pos.x();
+      fY[i] = pos.y();
+      fZ[i] = pos.z();
+      fTime[i] = time;
+      fKineticEnergy[i] = G4float(ekin);
+      fTotEDep[i] = G4float(edep);
+      fProcessIndex[i] = ProcessIndex(process);
+      return i;
+    }
+
+    G4ThreeVector GetPosition(G4int i) const
+    { return G4ThreeVector(fX[i],fY[i],fZ[i]); }
+
+    const G4VProcess* GetProcess(G4int i) const
+    { return fProcessIndex[i] < 0 ? nullptr : fProcesses[fProcessIndex[i]]; }
+
+    void AddRef() { ++fNRef; }
+    void Release() { if(--fNRef == 0) delete this; }
+
+  private:
+
+    static G4CompactTrajectoryBlock*& Current()
+    {
+      G4ThreadLocalStatic G4CompactTrajectoryBlock* current = nullptr;
+      return current;
+    }
+
+    G4int FindProcess(const G4VProcess* process) const
+    {
+      if(!process) return -1;
+      // Successive steps are mostly limited by the same few processes
+      for(G4int k = fNProcesses; k > 0; --k)
+      {
+        if(fProcesses[k-1] == process) return k-1;
+      }
+      return -1;
+    }
+
+    short ProcessIndex(const G4VProcess* process)
+    {
+      if(!process) return -1;
+      G4int k = FindProcess(process);
+      if(k >= 0) return short(k);
+      // The table is never reallocated, as blocks may be read by
+      // another thread while being filled; GetBlockToFill() made
+      // sure that there is room for a new process
+      fProcesses[fNProcesses] = process;
+      return short(fNProcesses++);
+    }
+
+  public:
+
+    G4double fX[kSize];
+    G4double fY[kSize];
+    G4double fZ[kSize];
+    G4double fTime[kSize];
+    G4float  fKineticEnergy[kSize];
+    G4float  fTotEDep[kSize];
+    short  fProcessIndex[kSize];
+    const G4VProcess* fProcesses[kMaxProcesses];
+
+  private:
+
+    G4int fNProcesses;
+    G4int fUsed;
+    std::atomic<G4int> fNRef;
+};
+
+G4Allocator<G4CompactTrajectory>*& aCompactTrajectoryAllocator()
+{
+    G4ThreadLocalStatic G4Allocator<G4CompactTrajectory>* _instance = nullptr;
+    return _instance;
+}
+
+G4CompactTrajectory::G4CompactTrajectory()
+  : fNPoints(0), fTrackID(0), fParentID(0), fpParticleDefinition(0),
+    initialKineticEnergy(0.), initialMomentum(G4ThreeVector())
+{
+}
+
+G4CompactTrajectory::G4CompactTrajectory(const G4Track* aTrack)
+  : fNPoints(0)
+{
+  fpParticleDefinition = aTrack->GetDefinition();
+  fTrackID = aTrack->GetTrackID();
+  fParentID = aTrack->GetParentID();
+  initialKineticEnergy = aTrack->GetKineticEnergy();
+  initialMomentum = aTrack->GetMomentum();
+  // Following is for the first trajectory point
+  AppendPoint(aTrack->GetPosition(), aTrack->GetGlobalTime(),
+              aTrack->GetKineticEnergy(), 0., 0);
+}
+
+G4CompactTrajectory::G4CompactTrajectory(G4CompactTrajectory & right)
+  : G4VTrajectory(), fSegments(right.fSegments), fNPoints(right.fNPoints),
+    fTrackID(right.fTrackID), fParentID(right.fParentID),
+    fpParticleDefinition(right.fpParticleDefinition),
+    initialKineticEnergy(right.initialKineticEnergy),
+    initialMomentum(right.initialMomentum)
+{
+  // Points are shared, they are never modified once appended
+  for(std::size_t k=0; k<fSegments.size(); ++k)
+  { fSegments[k].block->AddRef(); }
+}
+
+G4CompactTrajectory::~G4CompactTrajectory()
+{
+  for(std::size_t k=0; k<fSegments.size(); ++k)
+  { fSegments[k].block->Release(); }
+}
+
+void G4CompactTrajectory::ReleaseBlock()
+{
+  G4CompactTrajectoryBlock::ReleaseBlockToFill();
+}
+
+void G4CompactTrajectory::ShowTrajectory(std::ostream& os) const
+{
+  // Invoke the default implementation in G4VTrajectory...
+  G4VTrajectory::ShowTrajectory(os);
+  // ... or override with your own code here.
+}
+
+void G4CompactTrajectory::DrawTrajectory() const
+{
+  // Invoke the default implementation in G4VTrajectory...
+  G4VTrajectory::DrawTrajectory();
+  // ... or override with your own code here.
+}
+
+void G4CompactTrajectory::AppendPoint(const G4ThreeVector& pos,
+                                      G4double time, G4double ekin,
+                                      G4double edep,
+                                      const G4VProcess* process)
+{
+  G4CompactTrajectoryBlock* block =
+    G4CompactTrajectoryBlock::GetBlockToFill(process);
+  G4int index = block->Append(pos, time, ekin, edep, process);
+  if(!fSegments.empty() && fSegments.back().block == block &&
+     fSegments.back().first + fSegments.back().count == index)
+  {
+    ++(fSegments.back().count);
+  }
+  else
+  {
+    block->AddRef();
+    Segment segment = { block, index, 1 };
+    fSegments.push_back(segment);
+  }
+  ++fNPoints;
+}
+
+void G4CompactTrajectory::AppendStep(const G4Step* aStep)
+{
+  const G4StepPoint* postStepPoint = aStep->GetPostStepPoint();
+  AppendPoint(postStepPoint->GetPosition(),
+              postStepPoint->GetGlobalTime(),
+              postStepPoint->GetKineticEnergy(),
+              aStep->GetTotalEnergyDeposit(),
+              postStepPoint->GetProcessDefinedStep());
+}
+
+const G4CompactTrajectory::Segment&
+G4CompactTrajectory::Locate(G4int i, G4int& index) const
+{
+  if(i < 0 || i >= fNPoints)
+  {
+    G4ExceptionDescription ed;
+    ed << "Point " << i << " requested from a trajectory of "
+       << fNPoints << " points.";
+    G4Exception("G4CompactTrajectory::GetPoint()", "Tracking0016",
+                FatalException, ed);
+  }
+  std::size_t k = 0;
+  while(i >= fSegments[k].count)
+  {
+    i -= fSegments[k].count;
+    ++k;
+  }
+  index = fSegments[k].first + i;
+  return fSegments[k];
+}
+
+G4VTrajectoryPoint* G4CompactTrajectory::GetPoint(G4int i) const
+{
+  G4int index;
+  const Segment& segment = Locate(i, index);
+  const G4CompactTrajectoryBlock* block = segment.block;
+  fPoint.Set(block->GetPosition(index), block->fTime[index],
+             block->fKineticEnergy[index], block->fTotEDep[index],
+             block->GetProcess(index));
+  return &fPoint;
+}
+
+G4ThreeVector G4CompactTrajectory::GetPointPosition(G4int i) const
+{
+  G4int index;
+  return Locate(i, index).block->GetPosition(index);
+}
+
+G4double G4CompactTrajectory::GetPointGlobalTime(G4int i) const
+{
+  G4int index;
+  return Locate(i, index).block->fTime[index];
+}
+
+G4double G4CompactTrajectory::GetPointKineticEnergy(G4int i) const
+{
+  G4int index;
+  return Locate(i, index).block->fKineticEnergy[index];
+}
+
+void G4CompactTrajectory::MergeTrajectory(G4VTrajectory* secondTrajectory)
+{
+  if(!secondTrajectory) return;
+
+  G4CompactTrajectory* seco = (G4CompactTrajectory*)secondTrajectory;
+  if(seco->fSegments.empty()) return;
+
+  // initial point of the second trajectory should not be merged;
+  // segments are moved together with the block references they hold
+  Segment& head = seco->fSegments.front();
+  ++(head.first);
+  if(--(head.count) == 0)
+  {
+    head.block->Release();
+    seco->fSegments.erase(seco->fSegments.begin());
+  }
+  fSegments.insert(fSegments.end(),
+                   seco->fSegments.begin(), seco->fSegments.end());
+  fNPoints += seco->fNPoints - 1;
+  seco->fSegments.clear();
+  seco->fNPoints = 0;
+}
+
+void G4CompactTrajectory::StreamOut(std::ostream& os) const
+{
+  G4int header[4] = { fTrackID, fParentID, GetPDGEncoding(), fNPoints };
+  G4double kinematics[5] = { GetCharge(), initialKineticEnergy,
+                             initialMomentum.x(), initialMomentum.y(),
+                             initialMomentum.z() };
+  os.write((const char*)header, sizeof(header));
+  os.write((const char*)kinematics, sizeof(kinematics));
+
+  // Process indices are local to each block: rebuild a table for the
+  // trajectory and translate them while writing
+  std::vector<const G4VProcess*> processes;
+  std::vector<short> processIndex;
+  processIndex.reserve(fNPoints);
+  for(std::size_t k=0; k<fSegments.size(); ++k)
+  {
+    const Segment& segment = fSegments[k];
+    for(G4int i=segment.first; i<segment.first+segment.count; ++i)
+    {
+      const G4VProcess* process = segment.block->GetProcess(i);
+      short index = -1;
+      if(process)
+      {
+        std::size_t n = 0;
+        while(n < processes.size() && processes[n] != process) ++n;
+        if(n == processes.size()) processes.push_back(process);
+        index = short(n);
+      }
+      processIndex.push_back(index);
+    }
+  }
+  G4int nProcesses = processes.size();
+  os.write((const char*)&nProcesses, sizeof(nProcesses));
+  for(std::size_t n=0; n<processes.size(); ++n)
+  {
+    const G4String& name = processes[n]->GetProcessName();
+    G4int length = name.size();
+    os.write((const char*)&length, sizeof(length));
+    os.write(name.data(), length);
+  }
+
+  // One column after the other, each made of the segment ranges
+#define G4COMPACT_WRITE_COLUMN(column)                                  \
+  for(std::size_t k=0; k<fSegments.size(); ++k)                         \
+  {                                                                     \
+    const Segment& segment = fSegments[k];                              \
+    os.write((const char*)(segment.block->column + segment.first),      \
+             segment.count*sizeof(segment.block->column[0]));           \
+  }
+  G4COMPACT_WRITE_COLUMN(fX)
+  G4COMPACT_WRITE_COLUMN(fY)
+  G4COMPACT_WRITE_COLUMN(fZ)
+  G4COMPACT_WRITE_COLUMN(fTime)
+  G4COMPACT_WRITE_COLUMN(fKineticEnergy)
+  G4COMPACT_WRITE_COLUMN(fTotEDep)
+#undef G4COMPACT_WRITE_COLUMN
+  if(fNPoints > 0)
+  {
+    os.write((const char*)&processIndex[0], fNPoints*sizeof(short));
+  }
+}
+
+const std::map<G4String,G4AttDef>* G4CompactTrajectory::GetAttDefs() const
+{
+  G4bool isNew;
+  std::map<G4String,G4AttDef>* store
+    = G4AttDefStore::GetInstance("G4CompactTrajectory",isNew);
+  if (isNew) {
+
+    G4String ID("ID");
+    (*store)[ID] = G4AttDef(ID,"Track ID","Physics","","G4int");
+
+    G4String PID("PID");
+    (*store)[PID] = G4AttDef(PID,"Parent ID","Physics","","G4int");
+
+    G4String PN("PN");
+    (*store)[PN] = G4AttDef(PN,"Particle Name","Physics","","G4String");
+
+    G4String Ch("Ch");
+    (*store)[Ch] = G4AttDef(Ch,"Charge","Physics","e+","G4double");
+
+    G4String PDG("PDG");
+    (*store)[PDG] = G4AttDef(PDG,"PDG Encoding","Physics","","G4int");
+
+    G4String IKE("IKE");
+    (*store)[IKE] = 
+      G4AttDef(IKE, "Initial kinetic energy",
+               "Physics","G4BestUnit","G4double");
+
+    G4String IMom("IMom");
+    (*store)[IMom] = G4AttDef(IMom, "Initial momentum",
+                              "Physics","G4BestUnit","G4ThreeVector");
+
+    G4String IMag("IMag");
+    (*store)[IMag] = 
+      G4AttDef(IMag, "Initial momentum magnitude",
+               "Physics","G4BestUnit","G4double");
+
+    G4String NTP("NTP");
+    (*store)[NTP] = G4AttDef(NTP,"No. of points","Physics","","G4int");
+
+  }
+  return store;
+}
+
+std::vector<G4AttValue>* G4CompactTrajectory::CreateAttValues() const
+{
+  std::vector<G4AttValue>* values = new std::vector<G4AttValue>;
+
+  values->push_back
+    (G4AttValue("ID",G4UIcommand::ConvertToString(fTrackID),""));
+
+  values->push_back
+    (G4AttValue("PID",G4UIcommand::ConvertToString(fParentID),""));
+
+  values->push_back(G4AttValue("PN",GetParticleName(),""));
+
+  values->push_back
+    (G4AttValue("Ch",G4UIcommand::ConvertToString(GetCharge()),""));
+
+  values->push_back
+    (G4AttValue("PDG",G4UIcommand::ConvertToString(GetPDGEncoding()),""));
+
+  values->push_back
+    (G4AttValue("IKE",G4BestUnit(initialKineticEnergy,"Energy"),""));
+
+  values->push_back
+    (G4AttValue("IMom",G4BestUnit(initialMomentum,"Energy"),""));
+
+  values->push_back
+    (G4AttValue("IMag",G4BestUnit(initialMomentum.mag(),"Energy"),""));
+
+  values->push_back
+    (G4AttValue("NTP",G4UIcommand::ConvertToString(fNPoints),""));
+
+#ifdef G4ATTDEBUG
+  G4cout << G4AttCheck(values,GetAttDefs());
+#endif
+
+  return values;
+}
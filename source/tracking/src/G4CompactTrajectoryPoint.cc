@@ -0,0 +1,113 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//---------------------------------------------------------------
+//
+// G4CompactTrajectoryPoint.cc
+//
+//   Created : 19/Oct/2018
+//
+// ---------------------------------------------------------------
+
+#include "G4CompactTrajectoryPoint.hh"
+
+#include "G4VProcess.hh"
+#include "G4AttDefStore.hh"
+#include "G4AttDef.hh"
+#include "G4AttValue.hh"
+#include "G4UnitsTable.hh"
+
+//#define G4ATTDEBUG
+#ifdef G4ATTDEBUG
+#include "G4AttCheck.hh"
+#endif
+
+G4CompactTrajectoryPoint::G4CompactTrajectoryPoint()
+  : fGlobalTime(0.), fKineticEnergy(0.), fTotEDep(0.), fpProcess(0)
+{
+}
+
+G4CompactTrajectoryPoint::~G4CompactTrajectoryPoint()
+{
+}
+
+const std::map<G4String,G4AttDef>*
+G4CompactTrajectoryPoint::GetAttDefs() const
+{
+  G4bool isNew;
+  std::map<G4String,G4AttDef>* store
+    = G4AttDefStore::GetInstance("G4CompactTrajectoryPoint",isNew);
+  if (isNew) {
+    G4String Pos("Pos");
+    (*store)[Pos] =
+      G4AttDef(Pos, "Position", "Physics","G4BestUnit","G4ThreeVector");
+
+    G4String Time("Time");
+    (*store)[Time] =
+      G4AttDef(Time, "Global time", "Physics","G4BestUnit","G4double");
+
+    G4String KE("KE");
+    (*store)[KE] =
+      G4AttDef(KE, "Kinetic energy", "Physics","G4BestUnit","G4double");
+
+    G4String TED("TED");
+    (*store)[TED] =
+      G4AttDef(TED, "Total Energy Deposit",
+               "Physics","G4BestUnit","G4double");
+
+    G4String PDS("PDS");
+    (*store)[PDS] =
+      G4AttDef(PDS, "Post-step-point-defining process",
+               "Physics","","G4String");
+  }
+  return store;
+}
+
+std::vector<G4AttValue>* G4CompactTrajectoryPoint::CreateAttValues() const
+{
+  std::vector<G4AttValue>* values = new std::vector<G4AttValue>;
+
+  values->push_back(G4AttValue("Pos",G4BestUnit(fPosition,"Length"),""));
+
+  values->push_back(G4AttValue("Time",G4BestUnit(fGlobalTime,"Time"),""));
+
+  values->push_back
+    (G4AttValue("KE",G4BestUnit(fKineticEnergy,"Energy"),""));
+
+  values->push_back(G4AttValue("TED",G4BestUnit(fTotEDep,"Energy"),""));
+
+  if (fpProcess) {
+    values->push_back
+      (G4AttValue("PDS",fpProcess->GetProcessName(),""));
+  } else {
+    values->push_back(G4AttValue("PDS","None",""));
+  }
+
+#ifdef G4ATTDEBUG
+  G4cout << G4AttCheck(values,GetAttDefs());
+#endif
+
+  return values;
+}
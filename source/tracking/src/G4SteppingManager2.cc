@@ -363,7 +363,7 @@ void G4SteppingManager::InvokeAtRestDoItProcs()
          tempSecondaryTrack->SetParentID( fTrack->GetTrackID() );
 
 	 // Set the process pointer which created this track 
-	 tempSecondaryTrack->SetCreatorProcess( fCurrentProcess );
+	 tempSecondaryTrack->SetCreatorProcess( fCurrentProcess->GetCreatorProcess() );
 	 
 	 // If this 2ndry particle has 'zero' kinetic energy, make sure
 	 // it invokes a rest process at the beginning of the tracking
@@ -455,7 +455,7 @@ void G4SteppingManager::InvokeAlongStepDoItProcs()
          tempSecondaryTrack->SetParentID( fTrack->GetTrackID() );
 
 	 // Set the process pointer which created this track 
-	 tempSecondaryTrack->SetCreatorProcess( fCurrentProcess );
+	 tempSecondaryTrack->SetCreatorProcess( fCurrentProcess->GetCreatorProcess() );
 
 	 // If this 2ndry particle has 'zero' kinetic energy, make sure
 	 // it invokes a rest process at the beginning of the tracking
@@ -589,7 +589,7 @@ void G4SteppingManager::InvokePSDIP(size_t np)
             tempSecondaryTrack->SetParentID( fTrack->GetTrackID() );
 	    
 	    // Set the process pointer which created this track 
-	    tempSecondaryTrack->SetCreatorProcess( fCurrentProcess );
+	    tempSecondaryTrack->SetCreatorProcess( fCurrentProcess->GetCreatorProcess() );
 
             // If this 2ndry particle has 'zero' kinetic energy, make sure
             // it invokes a rest process at the beginning of the tracking
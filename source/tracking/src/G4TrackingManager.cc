@@ -41,6 +41,7 @@
 #include "G4Trajectory.hh"
 #include "G4SmoothTrajectory.hh"
 #include "G4RichTrajectory.hh"
+#include "G4CompactTrajectory.hh"
 #include "G4ios.hh"
 class G4VSteppingVerbose;
 
@@ -61,6 +62,7 @@ G4TrackingManager::~G4TrackingManager()
   delete messenger;
   delete fpSteppingManager;
   if (fpUserTrackingAction) delete fpUserTrackingAction;
+  G4CompactTrajectory::ReleaseBlock();
 }
 
 ////////////////////////////////////////////////////////////////
@@ -103,6 +105,7 @@ void G4TrackingManager::ProcessOneTrack(G4Track* apValueG4Track)
     case 2: fpTrajectory = new G4SmoothTrajectory(fpTrack); break;
     case 3: fpTrajectory = new G4RichTrajectory(fpTrack); break;
     case 4: fpTrajectory = new G4RichTrajectory(fpTrack); break;
+    case 5: fpTrajectory = new G4CompactTrajectory(fpTrack); break;
     }
   }
 #endif
@@ -81,9 +81,12 @@ G4TrackingMessenger::G4TrackingMessenger(G4TrackingManager * trMan)
   StoreTrajectoryCmd->SetGuidance(" 2 : Choose G4SmoothTrajectory as default.");
   StoreTrajectoryCmd->SetGuidance(" 3 : Choose G4RichTrajectory as default.");
   StoreTrajectoryCmd->SetGuidance(" 4 : Choose G4RichTrajectory with auxiliary points as default.");
+  StoreTrajectoryCmd->SetGuidance(" 5 : Choose G4CompactTrajectory as default.");
+  StoreTrajectoryCmd->SetGuidance("     Points are kept in columnar blocks (position, time,");
+  StoreTrajectoryCmd->SetGuidance("     kinetic energy, energy deposit, process index).");
   StoreTrajectoryCmd->SetParameterName("Store",true);
   StoreTrajectoryCmd->SetDefaultValue(0);
-  StoreTrajectoryCmd->SetRange("Store >=0 && Store <= 4"); 
+  StoreTrajectoryCmd->SetRange("Store >=0 && Store <= 5"); 
 
 
   VerboseCmd = new G4UIcmdWithAnInteger("/tracking/verbose",this);